@@ -0,0 +1,160 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   windows.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      The Win32 calls the library's sampler and history sources make,
+//!\brief      for the simulated EC build of the Python extension
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_POSIX_WINDOWS_INC
+#define __ITE8528_EC_POSIX_WINDOWS_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// setup.py puts this directory on the include path everywhere but Windows, so ITE8528_EC_Sampler.cpp,
+// ITE8528_EC_History.cpp and the modules the sampler runs each sample through build unchanged against the simulated
+// EC. Only what those sources use is here, implemented in ite8528_ec_win32.cpp over pthreads and mmap(). A HANDLE
+// is an event, a thread, a file or a file mapping; a thread's HANDLE is signalled once it has exited.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef int                BOOL;
+typedef uint8_t            BYTE;
+typedef uint16_t           WORD;
+typedef uint32_t           DWORD;
+typedef int32_t            LONG;                   // 32 bits, as on Windows - long is 64 outside it
+typedef int64_t            LONG64;
+typedef int64_t            LONGLONG;
+typedef size_t             SIZE_T;
+typedef void *             HANDLE;
+typedef void *             PVOID;
+typedef void *             LPVOID;
+typedef const char *       LPCSTR;
+
+typedef union _LARGE_INTEGER {
+                                struct {
+                                          DWORD      LowPart;
+                                          LONG       HighPart;
+                                       };
+                                LONGLONG   QuadPart;
+
+                             } LARGE_INTEGER, *PLARGE_INTEGER;
+
+typedef struct _SRWLOCK {
+                           PVOID      Ptr;          // the pthread_rwlock_t, made on first use
+
+                        } SRWLOCK, *PSRWLOCK;
+
+#define SRWLOCK_INIT                    { NULL }
+
+#define WINAPI
+#define TRUE                            1
+#define FALSE                           0
+#define INFINITE                        0xFFFFFFFF
+#define WAIT_OBJECT_0                   0
+#define WAIT_TIMEOUT                    258
+#define WAIT_FAILED                     0xFFFFFFFF
+#define INVALID_HANDLE_VALUE            ( ( HANDLE )( intptr_t ) -1 )
+
+#define GENERIC_READ                    0x80000000
+#define GENERIC_WRITE                   0x40000000
+#define FILE_SHARE_READ                 0x00000001
+#define OPEN_ALWAYS                     4
+#define FILE_ATTRIBUTE_NORMAL           0x00000080
+#define PAGE_READONLY                   0x02
+#define PAGE_READWRITE                  0x04
+#define FILE_MAP_WRITE                  0x0002
+#define FILE_MAP_READ                   0x0004
+
+#define UNREFERENCED_PARAMETER( P )     ( void )( P )
+
+//
+// __declspec( align( n ) ) and the export specifiers, spelled for GCC
+//
+
+#define __declspec( Attribute )         __declspec_##Attribute
+#define __declspec_align( Bytes )       __attribute__(( aligned( Bytes ) ))
+#define __declspec_dllexport            __attribute__(( visibility( "default" ) ))
+#define __declspec_dllimport
+
+typedef DWORD ( WINAPI *LPTHREAD_START_ROUTINE )( LPVOID pParam );
+
+//
+// the interlocked calls are full barriers, as on Windows
+//
+
+static inline void MemoryBarrier( void )                                        { __atomic_thread_fence( __ATOMIC_SEQ_CST ); }
+static inline LONG InterlockedIncrement( LONG volatile *pTarget )               { return __atomic_add_fetch( pTarget, 1, __ATOMIC_SEQ_CST ); }
+static inline LONG InterlockedDecrement( LONG volatile *pTarget )               { return __atomic_sub_fetch( pTarget, 1, __ATOMIC_SEQ_CST ); }
+static inline LONG InterlockedExchange( LONG volatile *pTarget, LONG Value )    { return __atomic_exchange_n( pTarget, Value, __ATOMIC_SEQ_CST ); }
+static inline LONG InterlockedExchangeAdd( LONG volatile *pTarget, LONG Value ) { return __atomic_fetch_add( pTarget, Value, __ATOMIC_SEQ_CST ); }
+static inline LONG64 InterlockedAdd64( LONG64 volatile *pTarget, LONG64 Value ) { return __atomic_add_fetch( pTarget, Value, __ATOMIC_SEQ_CST ); }
+
+static inline LONG InterlockedCompareExchange( LONG volatile *pTarget, LONG Value, LONG Comparand )
+{
+   __atomic_compare_exchange_n( pTarget, &Comparand, Value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST );
+
+   return Comparand;
+}
+
+void     AcquireSRWLockExclusive( PSRWLOCK pLock );
+void     ReleaseSRWLockExclusive( PSRWLOCK pLock );
+void     AcquireSRWLockShared( PSRWLOCK pLock );
+void     ReleaseSRWLockShared( PSRWLOCK pLock );
+
+HANDLE   CreateEventA( void *pAttributes, BOOL ManualReset, BOOL InitialState, LPCSTR pName );
+BOOL     SetEvent( HANDLE Event );
+BOOL     ResetEvent( HANDLE Event );
+DWORD    WaitForSingleObject( HANDLE Handle, DWORD TimeoutMs );
+DWORD    WaitForMultipleObjects( DWORD Count, const HANDLE *pHandles, BOOL WaitAll, DWORD TimeoutMs );
+BOOL     WaitOnAddress( volatile void *pAddress, PVOID pCompare, SIZE_T Bytes, DWORD TimeoutMs );
+void     WakeByAddressAll( PVOID pAddress );
+BOOL     CloseHandle( HANDLE Handle );
+
+HANDLE   CreateThread( void *pAttributes, SIZE_T StackBytes, LPTHREAD_START_ROUTINE pRoutine, LPVOID pParam, DWORD Flags, DWORD *pId );
+HANDLE   GetCurrentThread( void );
+int      GetThreadPriority( HANDLE Thread );
+BOOL     SetThreadPriority( HANDLE Thread, int Priority );
+
+BOOL     QueryPerformanceCounter( PLARGE_INTEGER pCount );
+BOOL     QueryPerformanceFrequency( PLARGE_INTEGER pFrequency );
+
+HANDLE   CreateFileA( LPCSTR pPath, DWORD Access, DWORD Share, void *pAttributes, DWORD Disposition, DWORD Flags, HANDLE Template );
+BOOL     GetFileSizeEx( HANDLE File, PLARGE_INTEGER pSize );
+BOOL     FlushFileBuffers( HANDLE File );
+HANDLE   CreateFileMappingA( HANDLE File, void *pAttributes, DWORD Protect, DWORD SizeHigh, DWORD SizeLow, LPCSTR pName );
+LPVOID   MapViewOfFile( HANDLE Mapping, DWORD Access, DWORD OffsetHigh, DWORD OffsetLow, SIZE_T Bytes );
+BOOL     UnmapViewOfFile( const void *pView );
+BOOL     FlushViewOfFile( const void *pView, SIZE_T Bytes );
+
+#define CreateEvent                     CreateEventA
+#define CreateFile                      CreateFileA
+#define CreateFileMapping               CreateFileMappingA
+
+#endif
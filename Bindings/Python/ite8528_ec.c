@@ -0,0 +1,956 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ite8528_ec.c
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      Python extension over the library's batch sensor query, sample ring
+//      and history store. Samples and rollup points are handed to Python as
+//      RecordArray objects, which export their records through the buffer
+//      protocol - numpy.asarray( records ) gives a structured array over the
+//      same memory, with fields named as in SAMPLE_FORMAT and POINT_FORMAT.
+//
+//        query()          one sweep of the sensors
+//        stream()         iterator over the sample ring, one RecordArray per
+//                         run of new samples, pointing into the ring itself
+//        history_append() samples added to the history file
+//        history()        a time range of the history file, decoded once
+//                         into one array
+//        rollup()         a time range of a rollup level
+//        history_block()  a memoryview straight onto a block of the mapped
+//                         history file
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//    10/19/26      0.2       waits with SMP_WaitForSamples(), builds on Linux
+//                            against ite8528_ec_sim.cpp
+//    10/19/26      0.3       lent runs are pinned, history_append()
+//
+///****************************************************************************
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#if defined( _WIN32 )
+#include <windows.h>
+#endif
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_History.h>
+
+#define EC_WAIT_SLICE_MS      100                   // how often a waiting stream checks for Ctrl-C
+
+#ifndef UNREFERENCED_PARAMETER
+#define UNREFERENCED_PARAMETER( P )     ( void )( P )
+#endif
+
+//
+// PEP 3118 layouts of EC_SAMPLE_STRUCT and HIST_POINT_STRUCT, both naturally aligned with no padding
+//
+
+#define EC_SAMPLE_FORMAT      "T{Q:timestamp_ms:I:sequence:H:valid_mask:H:reserved:(8)H:raw:}"
+#define EC_POINT_FORMAT       "T{Q:start_ms:I:samples:H:valid_mask:H:reserved:(8)H:min:(8)H:max:(8)H:mean:}"
+
+/*!\struct _RECORD_ARRAY_OBJECT
+ * \brief  A run of samples or rollup points, either owned or lent by the library
+ */
+typedef struct _RECORD_ARRAY_OBJECT {
+                                       PyObject_HEAD
+                                       char *         pData;
+                                       Py_ssize_t     Count;
+                                       Py_ssize_t     ItemSize;
+                                       const char *   pFormat;
+                                       Py_ssize_t     Exports;      // buffers handed out and not yet released
+                                       int            Owned;        // pData was allocated for this object
+                                       int            Valid;        // 0 once a lent run has been given back
+
+                                    } RECORD_ARRAY_OBJECT, *P_RECORD_ARRAY_OBJECT;
+
+/*!\struct _SAMPLE_STREAM_OBJECT
+ * \brief  Iterator over the sample ring
+ */
+typedef struct _SAMPLE_STREAM_OBJECT {
+                                        PyObject_HEAD
+                                        long                    TimeoutMs;      // < 0 = wait for ever
+                                        P_RECORD_ARRAY_OBJECT   pBatch;         // run lent out, released on the next step
+                                        unsigned long long      Dropped;        // samples the sampler dropped while a run was lent
+
+                                     } SAMPLE_STREAM_OBJECT, *P_SAMPLE_STREAM_OBJECT;
+
+static PyTypeObject   RecordArrayType;
+static PyTypeObject   SampleStreamType;
+static PyObject       *pEcError = NULL;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_Raise                                                        */
+/*                                                                            */
+/*!\brief  Raises ite8528_ec.Error for a failed library call                 */
+/*                                                                            */
+/*!\param   const char *    name of the library function                      */
+/*!\param   WINSYS_ERROR    what it returned                                  */
+/*!\return  PyObject *      NULL                                              */
+/*                                                                            */
+/*!\note    The exception's args are ( function name, error code )           */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_Raise( const char *pFunction, WINSYS_ERROR Results )
+{
+   PyObject   *pArgs = Py_BuildValue( "(sk)", pFunction, ( unsigned long ) Results );
+
+   if ( pArgs )
+   {
+      PyErr_SetObject( pEcError, pArgs );
+      Py_DECREF( pArgs );
+   }
+
+   return NULL;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: RecordArray_New                                                 */
+/*                                                                            */
+/*!\brief  Makes a RecordArray over library memory, or over new memory       */
+/*                                                                            */
+/*!\param   void *          the records, NULL to allocate room for Count      */
+/*!\param   Py_ssize_t      number of records                                 */
+/*!\param   Py_ssize_t      size of a record                                  */
+/*!\param   const char *    PEP 3118 format of a record                       */
+/*!\return  P_RECORD_ARRAY_OBJECT  new reference, NULL with an exception set */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static P_RECORD_ARRAY_OBJECT RecordArray_New( void *pData, Py_ssize_t Count, Py_ssize_t ItemSize, const char *pFormat )
+{
+   P_RECORD_ARRAY_OBJECT   pSelf = PyObject_New( RECORD_ARRAY_OBJECT, &RecordArrayType );
+
+   if ( pSelf == NULL )
+   {
+      return NULL;
+   }
+
+   pSelf->Count = Count;
+   pSelf->ItemSize = ItemSize;
+   pSelf->pFormat = pFormat;
+   pSelf->Exports = 0;
+   pSelf->Valid = 1;
+   pSelf->Owned = ( pData == NULL );
+   pSelf->pData = ( pData ) ? ( char * ) pData : ( char * ) PyMem_Calloc( ( Count ) ? Count : 1, ItemSize );
+
+   if ( pSelf->pData == NULL )
+   {
+      pSelf->Owned = 0;
+      Py_DECREF( pSelf );
+      return ( P_RECORD_ARRAY_OBJECT ) PyErr_NoMemory();
+   }
+
+   return pSelf;
+}
+
+static void RecordArray_Dealloc( P_RECORD_ARRAY_OBJECT pSelf )
+{
+   if ( pSelf->Owned )
+   {
+      PyMem_Free( pSelf->pData );
+   }
+
+   PyObject_Del( pSelf );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: RecordArray_GetBuffer                                           */
+/*                                                                            */
+/*!\brief  Exports the records as a one dimensional array of structs          */
+/*                                                                            */
+/*!\param   P_RECORD_ARRAY_OBJECT  the records                                */
+/*!\param   Py_buffer *     the view to fill in                               */
+/*!\param   int             PyBUF_ flags asked for                            */
+/*!\return  int             0, or -1 with an exception set                    */
+/*                                                                            */
+/*!\note    Records lent from the sample ring are read-only, and cannot be    */
+/*!\note    exported once the stream has moved past them.                    */
+/*                                                                            */
+/******************************************************************************/
+static int RecordArray_GetBuffer( P_RECORD_ARRAY_OBJECT pSelf, Py_buffer *pView, int Flags )
+{
+   if ( ! pSelf->Valid )
+   {
+      PyErr_SetString( PyExc_BufferError, "the stream has moved past these samples - copy a batch to keep it" );
+      return -1;
+   }
+
+   if ( ( Flags & PyBUF_WRITABLE ) && ( ! pSelf->Owned ) )
+   {
+      PyErr_SetString( PyExc_BufferError, "samples in the ring are read-only" );
+      return -1;
+   }
+
+   pView->buf = pSelf->pData;
+   pView->obj = ( PyObject * ) pSelf;
+   pView->len = pSelf->Count * pSelf->ItemSize;
+   pView->readonly = ! pSelf->Owned;
+   pView->itemsize = pSelf->ItemSize;
+   pView->format = ( Flags & PyBUF_FORMAT ) ? ( char * ) pSelf->pFormat : NULL;
+   pView->ndim = 1;
+   pView->shape = ( Flags & PyBUF_ND ) ? &pSelf->Count : NULL;
+   pView->strides = ( ( Flags & PyBUF_STRIDES ) == PyBUF_STRIDES ) ? &pSelf->ItemSize : NULL;
+   pView->suboffsets = NULL;
+   pView->internal = NULL;
+
+   Py_INCREF( pSelf );
+   pSelf->Exports++;
+
+   return 0;
+}
+
+static void RecordArray_ReleaseBuffer( P_RECORD_ARRAY_OBJECT pSelf, Py_buffer *pView )
+{
+   UNREFERENCED_PARAMETER( pView );
+
+   pSelf->Exports--;
+}
+
+static Py_ssize_t RecordArray_Length( P_RECORD_ARRAY_OBJECT pSelf )
+{
+   return pSelf->Count;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: RecordArray_Item                                                */
+/*                                                                            */
+/*!\brief  Returns one record as a tuple, for use without NumPy              */
+/*                                                                            */
+/*!\param   P_RECORD_ARRAY_OBJECT  the records                                */
+/*!\param   Py_ssize_t      index of the record                               */
+/*!\return  PyObject *      ( timestamp_ms, sequence, valid_mask, raw ) or    */
+/*!\return                  ( start_ms, samples, valid_mask, min, max, mean ) */
+/*                                                                            */
+/*!\note    Builds Python objects per record - use the buffer for bulk work  */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *RecordArray_Item( P_RECORD_ARRAY_OBJECT pSelf, Py_ssize_t Index )
+{
+   const uint16_t   *pRaw;
+
+   if ( ( Index < 0 ) || ( Index >= pSelf->Count ) )
+   {
+      PyErr_SetString( PyExc_IndexError, "record index out of range" );
+      return NULL;
+   }
+
+   if ( ! pSelf->Valid )
+   {
+      PyErr_SetString( PyExc_BufferError, "the stream has moved past these samples - copy a batch to keep it" );
+      return NULL;
+   }
+
+   if ( pSelf->ItemSize == sizeof( EC_SAMPLE_STRUCT ) )
+       {
+          P_EC_SAMPLE_STRUCT   pSample = ( P_EC_SAMPLE_STRUCT )( pSelf->pData + Index * pSelf->ItemSize );
+
+          pRaw = pSample->Raw;
+
+          return Py_BuildValue( "(KkH(HHHHHHHH))", pSample->TimestampMs, ( unsigned long ) pSample->Sequence, pSample->ValidMask,
+                                pRaw[ 0 ], pRaw[ 1 ], pRaw[ 2 ], pRaw[ 3 ], pRaw[ 4 ], pRaw[ 5 ], pRaw[ 6 ], pRaw[ 7 ] );
+       }
+   else
+       {
+          P_HIST_POINT_STRUCT   pPoint = ( P_HIST_POINT_STRUCT )( pSelf->pData + Index * pSelf->ItemSize );
+
+          return Py_BuildValue( "(KkH(HHHHHHHH)(HHHHHHHH)(HHHHHHHH))", pPoint->StartMs, ( unsigned long ) pPoint->Samples,
+                                pPoint->ValidMask,
+                                pPoint->Min[ 0 ], pPoint->Min[ 1 ], pPoint->Min[ 2 ], pPoint->Min[ 3 ],
+                                pPoint->Min[ 4 ], pPoint->Min[ 5 ], pPoint->Min[ 6 ], pPoint->Min[ 7 ],
+                                pPoint->Max[ 0 ], pPoint->Max[ 1 ], pPoint->Max[ 2 ], pPoint->Max[ 3 ],
+                                pPoint->Max[ 4 ], pPoint->Max[ 5 ], pPoint->Max[ 6 ], pPoint->Max[ 7 ],
+                                pPoint->Mean[ 0 ], pPoint->Mean[ 1 ], pPoint->Mean[ 2 ], pPoint->Mean[ 3 ],
+                                pPoint->Mean[ 4 ], pPoint->Mean[ 5 ], pPoint->Mean[ 6 ], pPoint->Mean[ 7 ] );
+       }
+}
+
+static PyObject *RecordArray_GetLent( P_RECORD_ARRAY_OBJECT pSelf, void *pClosure )
+{
+   UNREFERENCED_PARAMETER( pClosure );
+
+   return PyBool_FromLong( ! pSelf->Owned );
+}
+
+static PyBufferProcs        RecordArrayBuffer = { ( getbufferproc ) RecordArray_GetBuffer, ( releasebufferproc ) RecordArray_ReleaseBuffer };
+
+static PySequenceMethods    RecordArraySequence = { ( lenfunc ) RecordArray_Length, NULL, NULL, ( ssizeargfunc ) RecordArray_Item };
+
+static PyGetSetDef          RecordArrayGetSet[] = {
+                               { "lent", ( getter ) RecordArray_GetLent, NULL, "True if the records are the library's own memory", NULL },
+                               { NULL } };
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SampleStream_Release                                            */
+/*                                                                            */
+/*!\brief  Gives the run lent out last back to the sampler                   */
+/*                                                                            */
+/*!\param   P_SAMPLE_STREAM_OBJECT  the stream                                */
+/*!\param   int             1 = release even with buffers still exported      */
+/*!\return  int             0, or -1 with BufferError set if buffers exported */
+/*!\return                  from the run have not been released               */
+/*                                                                            */
+/*!\note    An exported buffer points into the ring, where the run is pinned  */
+/*!\note    - the sampler drops samples rather than overwrite it - until it   */
+/*!\note    is released, so the run is kept until every view of it is gone.  */
+/*!\note    Only a stream being destroyed forces the release.                 */
+/*                                                                            */
+/******************************************************************************/
+static int SampleStream_Release( P_SAMPLE_STREAM_OBJECT pSelf, int Force )
+{
+   uint32_t   Dropped = 0;
+
+   if ( pSelf->pBatch )
+   {
+      if ( ( pSelf->pBatch->Exports > 0 ) && ( ! Force ) )
+      {
+         PyErr_SetString( PyExc_BufferError, "views of the last batch are still held - delete them, or copy the batch, "
+                                             "before taking the next" );
+         return -1;
+      }
+
+      SMP_ReleaseSamples( ( uint32_t ) pSelf->pBatch->Count, &Dropped );
+
+      pSelf->Dropped += Dropped;
+      pSelf->pBatch->Valid = 0;
+      Py_CLEAR( pSelf->pBatch );
+   }
+
+   return 0;
+}
+
+static void SampleStream_Dealloc( P_SAMPLE_STREAM_OBJECT pSelf )
+{
+   SampleStream_Release( pSelf, 1 );
+   PyObject_Del( pSelf );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SampleStream_Next                                               */
+/*                                                                            */
+/*!\brief  Returns the next run of samples in the ring, waiting for one       */
+/*                                                                            */
+/*!\param   P_SAMPLE_STREAM_OBJECT  the stream                                */
+/*!\return  PyObject *      a RecordArray lent from the ring, or NULL at the  */
+/*!\return                  end of the stream                                 */
+/*                                                                            */
+/*!\note    The previous run is released first, so each batch is good until  */
+/*!\note    the next is asked for, which raises BufferError while views of   */
+/*!\note    the previous run are held. The stream ends when no sample        */
+/*!\note    arrives within its timeout.                                       */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *SampleStream_Next( P_SAMPLE_STREAM_OBJECT pSelf )
+{
+   const EC_SAMPLE_STRUCT   *pSamples;
+   uint32_t                 Count;
+   long                     WaitedMs = 0;
+   WINSYS_ERROR             Results,
+                            Wait;
+
+   if ( SampleStream_Release( pSelf, 0 ) != 0 )
+   {
+      return NULL;
+   }
+
+   for ( ;; )
+   {
+      if ( ( Results = SMP_PeekSamples( &pSamples, &Count ) ) != STATUS_SUCCESS )
+      {
+         return EC_Raise( "SMP_PeekSamples", Results );
+      }
+
+      if ( Count )
+      {
+         if ( ( pSelf->pBatch = RecordArray_New( ( void * ) pSamples, Count, sizeof( EC_SAMPLE_STRUCT ), EC_SAMPLE_FORMAT ) ) == NULL )
+         {
+            return NULL;
+         }
+
+         Py_INCREF( pSelf->pBatch );
+         return ( PyObject * ) pSelf->pBatch;
+      }
+
+      if ( ( pSelf->TimeoutMs >= 0 ) && ( WaitedMs >= pSelf->TimeoutMs ) )
+      {
+         return NULL;
+      }
+
+      Py_BEGIN_ALLOW_THREADS
+      Wait = SMP_WaitForSamples( EC_WAIT_SLICE_MS );
+      Py_END_ALLOW_THREADS
+
+      WaitedMs += ( Wait != STATUS_SUCCESS ) ? EC_WAIT_SLICE_MS : 0;
+
+      if ( PyErr_CheckSignals() != 0 )
+      {
+         return NULL;
+      }
+   }
+}
+
+static PyObject *SampleStream_GetDropped( P_SAMPLE_STREAM_OBJECT pSelf, void *pClosure )
+{
+   UNREFERENCED_PARAMETER( pClosure );
+
+   return PyLong_FromUnsignedLongLong( pSelf->Dropped );
+}
+
+static PyGetSetDef          SampleStreamGetSet[] = {
+                               { "dropped", ( getter ) SampleStream_GetDropped, NULL,
+                                 "samples the sampler dropped because a batch held it up", NULL },
+                               { NULL } };
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_Query                                                        */
+/*                                                                            */
+/*!\brief  query( mask=SENSOR_MASK_ALL ) - one sweep of the sensors          */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      positional arguments                              */
+/*!\param   PyObject *      keyword arguments                                 */
+/*!\return  PyObject *      a RecordArray of one sample                       */
+/*                                                                            */
+/*!\note    Reads the EC, with the GIL released                              */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_Query( PyObject *pModule, PyObject *pArgs, PyObject *pKeywords )
+{
+   static char             *Keywords[] = { "mask", NULL };
+   unsigned long           SensorMask = EC_SENSOR_MASK_ALL;
+   P_RECORD_ARRAY_OBJECT   pRecords;
+   WINSYS_ERROR            Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+
+   if ( ( ! PyArg_ParseTupleAndKeywords( pArgs, pKeywords, "|k", Keywords, &SensorMask ) ) ||
+        ( ( pRecords = RecordArray_New( NULL, 1, sizeof( EC_SAMPLE_STRUCT ), EC_SAMPLE_FORMAT ) ) == NULL ) )
+   {
+      return NULL;
+   }
+
+   Py_BEGIN_ALLOW_THREADS
+   Results = SMP_QuerySensors( ( uint32_t ) SensorMask, ( P_EC_SAMPLE_STRUCT ) pRecords->pData );
+   Py_END_ALLOW_THREADS
+
+   if ( Results != STATUS_SUCCESS )
+   {
+      Py_DECREF( pRecords );
+      return EC_Raise( "SMP_QuerySensors", Results );
+   }
+
+   return ( PyObject * ) pRecords;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_Latest                                                       */
+/*                                                                            */
+/*!\brief  latest() - the sampler's most recent sample                       */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      unused                                            */
+/*!\return  PyObject *      a RecordArray of one sample                       */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_Latest( PyObject *pModule, PyObject *pUnused )
+{
+   P_RECORD_ARRAY_OBJECT   pRecords;
+   WINSYS_ERROR            Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+   UNREFERENCED_PARAMETER( pUnused );
+
+   if ( ( pRecords = RecordArray_New( NULL, 1, sizeof( EC_SAMPLE_STRUCT ), EC_SAMPLE_FORMAT ) ) == NULL )
+   {
+      return NULL;
+   }
+
+   if ( ( Results = SMP_GetLatest( ( P_EC_SAMPLE_STRUCT ) pRecords->pData ) ) != STATUS_SUCCESS )
+   {
+      Py_DECREF( pRecords );
+      return EC_Raise( "SMP_GetLatest", Results );
+   }
+
+   return ( PyObject * ) pRecords;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_Start                                                        */
+/*                                                                            */
+/*!\brief  start( interval_ms=1000, mask=SENSOR_MASK_ALL ) - starts sampling  */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      positional arguments                              */
+/*!\param   PyObject *      keyword arguments                                 */
+/*!\return  PyObject *      None                                              */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_Start( PyObject *pModule, PyObject *pArgs, PyObject *pKeywords )
+{
+   static char       *Keywords[] = { "interval_ms", "mask", NULL };
+   unsigned long     IntervalMs = SMP_DEFAULT_INTERVAL_MS,
+                     SensorMask = EC_SENSOR_MASK_ALL;
+   WINSYS_ERROR      Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+
+   if ( ! PyArg_ParseTupleAndKeywords( pArgs, pKeywords, "|kk", Keywords, &IntervalMs, &SensorMask ) )
+   {
+      return NULL;
+   }
+
+   if ( ( Results = SMP_Start( ( uint32_t ) IntervalMs, ( uint32_t ) SensorMask ) ) != STATUS_SUCCESS )
+   {
+      return EC_Raise( "SMP_Start", Results );
+   }
+
+   Py_RETURN_NONE;
+}
+
+static PyObject *EC_Stop( PyObject *pModule, PyObject *pUnused )
+{
+   WINSYS_ERROR   Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+   UNREFERENCED_PARAMETER( pUnused );
+
+   Py_BEGIN_ALLOW_THREADS
+   Results = SMP_Stop();
+   Py_END_ALLOW_THREADS
+
+   if ( Results != STATUS_SUCCESS )
+   {
+      return EC_Raise( "SMP_Stop", Results );
+   }
+
+   Py_RETURN_NONE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_Stream                                                       */
+/*                                                                            */
+/*!\brief  stream( timeout_ms=-1 ) - iterator over new samples in the ring   */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      positional arguments                              */
+/*!\param   PyObject *      keyword arguments                                 */
+/*!\return  PyObject *      a SampleStream                                    */
+/*                                                                            */
+/*!\note    The sampler must be running. The stream is the ring's drainer -  */
+/*!\note    do not use SMP_DrainSamples, or a second stream, alongside it.    */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_Stream( PyObject *pModule, PyObject *pArgs, PyObject *pKeywords )
+{
+   static char              *Keywords[] = { "timeout_ms", NULL };
+   long                     TimeoutMs = -1;
+   P_SAMPLE_STREAM_OBJECT   pStream;
+   WINSYS_ERROR             Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+
+   if ( ! PyArg_ParseTupleAndKeywords( pArgs, pKeywords, "|l", Keywords, &TimeoutMs ) )
+   {
+      return NULL;
+   }
+
+   //
+   // a timeout is fine - it only says that nothing is waiting yet
+   //
+
+   if ( ( Results = SMP_WaitForSamples( 0 ) ) ==
+        ( WINSYS_ERROR ) WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING ) )
+   {
+      return EC_Raise( "SMP_WaitForSamples", Results );
+   }
+
+   if ( ( pStream = PyObject_New( SAMPLE_STREAM_OBJECT, &SampleStreamType ) ) == NULL )
+   {
+      return NULL;
+   }
+
+   pStream->TimeoutMs = TimeoutMs;
+   pStream->pBatch = NULL;
+   pStream->Dropped = 0;
+
+   return ( PyObject * ) pStream;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_HistoryOpen                                                  */
+/*                                                                            */
+/*!\brief  history_open( path, blocks=0 ) - opens or creates a history file  */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      positional arguments                              */
+/*!\param   PyObject *      keyword arguments                                 */
+/*!\return  PyObject *      None                                              */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_HistoryOpen( PyObject *pModule, PyObject *pArgs, PyObject *pKeywords )
+{
+   static char       *Keywords[] = { "path", "blocks", NULL };
+   const char        *pPath;
+   unsigned long     BlockCount = 0;
+   WINSYS_ERROR      Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+
+   if ( ! PyArg_ParseTupleAndKeywords( pArgs, pKeywords, "s|k", Keywords, &pPath, &BlockCount ) )
+   {
+      return NULL;
+   }
+
+   Py_BEGIN_ALLOW_THREADS
+   Results = HIST_Open( pPath, ( uint32_t ) BlockCount );
+   Py_END_ALLOW_THREADS
+
+   if ( Results != STATUS_SUCCESS )
+   {
+      return EC_Raise( "HIST_Open", Results );
+   }
+
+   Py_RETURN_NONE;
+}
+
+static PyObject *EC_HistoryClose( PyObject *pModule, PyObject *pUnused )
+{
+   WINSYS_ERROR   Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+   UNREFERENCED_PARAMETER( pUnused );
+
+   if ( ( Results = HIST_Close() ) != STATUS_SUCCESS )
+   {
+      return EC_Raise( "HIST_Close", Results );
+   }
+
+   Py_RETURN_NONE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_HistoryAppend                                                */
+/*                                                                            */
+/*!\brief  history_append( samples ) - adds samples to the history          */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      the samples, as records laid out as SAMPLE_FORMAT */
+/*!\return  PyObject *      None                                              */
+/*                                                                            */
+/*!\note    Takes any contiguous buffer of whole samples - a batch from       */
+/*!\note    stream() or query(), a NumPy array of SAMPLE_FORMAT's dtype, or   */
+/*!\note    bytes. Each sample is copied out first, as the buffer need not be */
+/*!\note    aligned.                                                          */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_HistoryAppend( PyObject *pModule, PyObject *pSamples )
+{
+   Py_buffer          View;
+   EC_SAMPLE_STRUCT   Sample;
+   Py_ssize_t         Index;
+   WINSYS_ERROR       Results = STATUS_SUCCESS;
+
+   UNREFERENCED_PARAMETER( pModule );
+
+   if ( PyObject_GetBuffer( pSamples, &View, PyBUF_C_CONTIGUOUS ) != 0 )
+   {
+      return NULL;
+   }
+
+   if ( View.len % sizeof( EC_SAMPLE_STRUCT ) )
+   {
+      PyBuffer_Release( &View );
+      PyErr_SetString( PyExc_ValueError, "the buffer does not hold a whole number of samples" );
+      return NULL;
+   }
+
+   Py_BEGIN_ALLOW_THREADS
+
+   for ( Index = 0; ( Index < View.len / ( Py_ssize_t ) sizeof( EC_SAMPLE_STRUCT ) ) && ( Results == STATUS_SUCCESS ); Index++ )
+   {
+      memcpy( &Sample, ( const char * ) View.buf + Index * sizeof( EC_SAMPLE_STRUCT ), sizeof( Sample ) );
+      Results = HIST_Append( &Sample );
+   }
+
+   Py_END_ALLOW_THREADS
+
+   PyBuffer_Release( &View );
+
+   if ( Results != STATUS_SUCCESS )
+   {
+      return EC_Raise( "HIST_Append", Results );
+   }
+
+   Py_RETURN_NONE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_History                                                      */
+/*                                                                            */
+/*!\brief  history( start_ms, end_ms, max_samples=0 ) - a range of history   */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      positional arguments                              */
+/*!\param   PyObject *      keyword arguments                                 */
+/*!\return  PyObject *      a RecordArray of the samples, oldest first        */
+/*                                                                            */
+/*!\note    The history is delta encoded, so the range is decoded once into  */
+/*!\note    a single array - no Python object per sample. max_samples of 0   */
+/*!\note    makes room for everything the history holds.                     */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_History( PyObject *pModule, PyObject *pArgs, PyObject *pKeywords )
+{
+   static char             *Keywords[] = { "start_ms", "end_ms", "max_samples", NULL };
+   unsigned long long      StartMs,
+                           EndMs;
+   unsigned long           MaxSamples = 0;
+   uint32_t                Count = 0;
+   HIST_STATS_STRUCT       Stats;
+   P_RECORD_ARRAY_OBJECT   pRecords;
+   WINSYS_ERROR            Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+
+   if ( ! PyArg_ParseTupleAndKeywords( pArgs, pKeywords, "KK|k", Keywords, &StartMs, &EndMs, &MaxSamples ) )
+   {
+      return NULL;
+   }
+
+   if ( MaxSamples == 0 )
+   {
+      if ( ( Results = HIST_GetStats( &Stats ) ) != STATUS_SUCCESS )
+      {
+         return EC_Raise( "HIST_GetStats", Results );
+      }
+
+      MaxSamples = ( unsigned long ) Stats.Samples;
+   }
+
+   if ( ( pRecords = RecordArray_New( NULL, MaxSamples, sizeof( EC_SAMPLE_STRUCT ), EC_SAMPLE_FORMAT ) ) == NULL )
+   {
+      return NULL;
+   }
+
+   Py_BEGIN_ALLOW_THREADS
+   Results = HIST_Query( StartMs, EndMs, ( P_EC_SAMPLE_STRUCT ) pRecords->pData, ( uint32_t ) MaxSamples, &Count );
+   Py_END_ALLOW_THREADS
+
+   if ( Results != STATUS_SUCCESS )
+   {
+      Py_DECREF( pRecords );
+      return EC_Raise( "HIST_Query", Results );
+   }
+
+   pRecords->Count = Count;
+
+   return ( PyObject * ) pRecords;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_Rollup                                                       */
+/*                                                                            */
+/*!\brief  rollup( start_ms, end_ms, max_points=1000 ) - a range of rollups   */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      positional arguments                              */
+/*!\param   PyObject *      keyword arguments                                 */
+/*!\return  PyObject *      ( RecordArray of points, resolution in msecs )    */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_Rollup( PyObject *pModule, PyObject *pArgs, PyObject *pKeywords )
+{
+   static char             *Keywords[] = { "start_ms", "end_ms", "max_points", NULL };
+   unsigned long long      StartMs,
+                           EndMs;
+   unsigned long           MaxPoints = 1000;
+   uint32_t                Count = 0,
+                           ResolutionMs = 0;
+   P_RECORD_ARRAY_OBJECT   pRecords;
+   WINSYS_ERROR            Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+
+   if ( ( ! PyArg_ParseTupleAndKeywords( pArgs, pKeywords, "KK|k", Keywords, &StartMs, &EndMs, &MaxPoints ) ) ||
+        ( ( pRecords = RecordArray_New( NULL, MaxPoints, sizeof( HIST_POINT_STRUCT ), EC_POINT_FORMAT ) ) == NULL ) )
+   {
+      return NULL;
+   }
+
+   Py_BEGIN_ALLOW_THREADS
+   Results = HIST_QueryRollup( StartMs, EndMs, ( uint32_t ) MaxPoints, ( P_HIST_POINT_STRUCT ) pRecords->pData, &Count, &ResolutionMs );
+   Py_END_ALLOW_THREADS
+
+   if ( Results != STATUS_SUCCESS )
+   {
+      Py_DECREF( pRecords );
+      return EC_Raise( "HIST_QueryRollup", Results );
+   }
+
+   pRecords->Count = Count;
+
+   return Py_BuildValue( "(Nk)", pRecords, ( unsigned long ) ResolutionMs );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_HistoryBlock                                                 */
+/*                                                                            */
+/*!\brief  history_block( index ) - one block of the mapped history file     */
+/*                                                                            */
+/*!\param   PyObject *      the module                                        */
+/*!\param   PyObject *      the block index                                   */
+/*!\return  PyObject *      a read-only memoryview onto the block             */
+/*                                                                            */
+/*!\note    No copy is made. The view is only good while the history stays   */
+/*!\note    open, and the writer reuses the oldest block when the ring is    */
+/*!\note    full - check the header's Sequence after using it.               */
+/*                                                                            */
+/******************************************************************************/
+static PyObject *EC_HistoryBlock( PyObject *pModule, PyObject *pIndex )
+{
+   unsigned long   Index;
+   const void      *pBlock;
+   uint32_t        Bytes;
+   WINSYS_ERROR    Results;
+
+   UNREFERENCED_PARAMETER( pModule );
+
+   if ( ( ( Index = PyLong_AsUnsignedLong( pIndex ) ) == ( unsigned long ) -1 ) && ( PyErr_Occurred() ) )
+   {
+      return NULL;
+   }
+
+   if ( ( Results = HIST_GetBlock( ( uint32_t ) Index, &pBlock, &Bytes ) ) != STATUS_SUCCESS )
+   {
+      return EC_Raise( "HIST_GetBlock", Results );
+   }
+
+   return PyMemoryView_FromMemory( ( char * ) pBlock, Bytes, PyBUF_READ );
+}
+
+static PyMethodDef          EcMethods[] = {
+   { "query", ( PyCFunction ) EC_Query, METH_VARARGS | METH_KEYWORDS, "query(mask=SENSOR_MASK_ALL) -> RecordArray of one sample, read now" },
+   { "latest", EC_Latest, METH_NOARGS, "latest() -> RecordArray of the sampler's most recent sample" },
+   { "start", ( PyCFunction ) EC_Start, METH_VARARGS | METH_KEYWORDS, "start(interval_ms=1000, mask=SENSOR_MASK_ALL) - start the sampler" },
+   { "stop", EC_Stop, METH_NOARGS, "stop() - stop the sampler" },
+   { "stream", ( PyCFunction ) EC_Stream, METH_VARARGS | METH_KEYWORDS,
+     "stream(timeout_ms=-1) -> iterator of RecordArrays lent from the sample ring, each good until the next is taken" },
+   { "history_open", ( PyCFunction ) EC_HistoryOpen, METH_VARARGS | METH_KEYWORDS, "history_open(path, blocks=0) - open the history file" },
+   { "history_close", EC_HistoryClose, METH_NOARGS, "history_close() - close the history file" },
+   { "history_append", EC_HistoryAppend, METH_O, "history_append(samples) - add a buffer of samples to the history file" },
+   { "history", ( PyCFunction ) EC_History, METH_VARARGS | METH_KEYWORDS,
+     "history(start_ms, end_ms, max_samples=0) -> RecordArray of the samples in [start_ms, end_ms]" },
+   { "rollup", ( PyCFunction ) EC_Rollup, METH_VARARGS | METH_KEYWORDS,
+     "rollup(start_ms, end_ms, max_points=1000) -> (RecordArray of points, resolution_ms)" },
+   { "history_block", EC_HistoryBlock, METH_O, "history_block(index) -> read-only memoryview onto a block of the history file" },
+   { NULL } };
+
+static struct PyModuleDef   EcModule = { PyModuleDef_HEAD_INIT, "ite8528_ec", "ITE8528 embedded controller sensors, sampler and history",
+                                         -1, EcMethods };
+
+PyMODINIT_FUNC PyInit_ite8528_ec( void )
+{
+   PyObject   *pModule;
+
+   RecordArrayType.tp_name = "ite8528_ec.RecordArray";
+   RecordArrayType.tp_doc = "Samples or rollup points, exported through the buffer protocol";
+   RecordArrayType.tp_basicsize = sizeof( RECORD_ARRAY_OBJECT );
+   RecordArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+   RecordArrayType.tp_dealloc = ( destructor ) RecordArray_Dealloc;
+   RecordArrayType.tp_as_buffer = &RecordArrayBuffer;
+   RecordArrayType.tp_as_sequence = &RecordArraySequence;
+   RecordArrayType.tp_getset = RecordArrayGetSet;
+
+   SampleStreamType.tp_name = "ite8528_ec.SampleStream";
+   SampleStreamType.tp_doc = "Iterator over the sample ring";
+   SampleStreamType.tp_basicsize = sizeof( SAMPLE_STREAM_OBJECT );
+   SampleStreamType.tp_flags = Py_TPFLAGS_DEFAULT;
+   SampleStreamType.tp_dealloc = ( destructor ) SampleStream_Dealloc;
+   SampleStreamType.tp_iter = PyObject_SelfIter;
+   SampleStreamType.tp_iternext = ( iternextfunc ) SampleStream_Next;
+   SampleStreamType.tp_getset = SampleStreamGetSet;
+
+   if ( ( PyType_Ready( &RecordArrayType ) < 0 ) || ( PyType_Ready( &SampleStreamType ) < 0 ) ||
+        ( ( pModule = PyModule_Create( &EcModule ) ) == NULL ) )
+   {
+      return NULL;
+   }
+
+   pEcError = PyErr_NewException( "ite8528_ec.Error", NULL, NULL );
+
+   Py_INCREF( &RecordArrayType );
+   Py_INCREF( &SampleStreamType );
+
+   if ( ( PyModule_AddObject( pModule, "Error", pEcError ) < 0 ) ||
+        ( PyModule_AddObject( pModule, "RecordArray", ( PyObject * ) &RecordArrayType ) < 0 ) ||
+        ( PyModule_AddObject( pModule, "SampleStream", ( PyObject * ) &SampleStreamType ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_CPU_TEMP", SENSOR_CPU_TEMP ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_SYS_TEMP", SENSOR_SYS_TEMP ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_VCORE", SENSOR_VCORE ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_V3P3", SENSOR_V3P3 ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_V5", SENSOR_V5 ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_V12", SENSOR_V12 ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_VDIMM", SENSOR_VDIMM ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_CPU_FAN", SENSOR_CPU_FAN ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_COUNT", SENSOR_COUNT ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "SENSOR_MASK_ALL", EC_SENSOR_MASK_ALL ) < 0 ) ||
+        ( PyModule_AddIntConstant( pModule, "RING_SIZE", SMP_RING_SIZE ) < 0 ) ||
+        ( PyModule_AddStringConstant( pModule, "SAMPLE_FORMAT", EC_SAMPLE_FORMAT ) < 0 ) ||
+        ( PyModule_AddStringConstant( pModule, "POINT_FORMAT", EC_POINT_FORMAT ) < 0 ) )
+   {
+      Py_DECREF( pModule );
+      return NULL;
+   }
+
+   return pModule;
+}
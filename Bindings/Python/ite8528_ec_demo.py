@@ -0,0 +1,78 @@
+#****************************************************************************
+#
+#    Copyright 2026 by WinSystems Inc.
+#
+#    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+#    and CPU products incorporating a GPIO device, to distribute any binary
+#    file or files compiled using this source code directly or in any work
+#    derived by the user from this file. In no case may the source code,
+#    original or derived from this file, be distributed to any third party
+#    except by explicit permission of WinSystems. This file is distributed
+#    on an "As-is" basis and no warranty as to performance or fitness of pur-
+#    poses is expressed or implied. In no case shall WinSystems be liable for
+#    any direct or indirect loss or damage, real or consequential resulting
+#    from the usage of this source code. It is the user's sole responsibility
+#    to determine fitness for any considered purpose.
+#
+#****************************************************************************
+#
+#    Name       : ite8528_ec_demo.py
+#
+#    Project    : ACPI Embedded Controller Routines
+#
+#    Author     : agent
+#
+#    Description:
+#      Reads the sensors once, then streams the sample ring at 10 ms for
+#      five seconds as NumPy arrays over the ring, and checks that no sample
+#      was missed or dropped
+#
+#****************************************************************************
+#
+#      Date      Revision    Description
+#    --------    --------    ---------------------------------------------
+#    10/19/26      0.1       Original
+#
+#****************************************************************************
+
+import time
+import numpy
+import ite8528_ec
+
+RUN_SECONDS = 5
+INTERVAL_MS = 10
+
+Sample = numpy.asarray( ite8528_ec.query() )[ 0 ]
+print( 'CPU %u C, system %u C, fan %u RPM' % ( Sample[ 'raw' ][ ite8528_ec.SENSOR_CPU_TEMP ],
+                                               Sample[ 'raw' ][ ite8528_ec.SENSOR_SYS_TEMP ],
+                                               Sample[ 'raw' ][ ite8528_ec.SENSOR_CPU_FAN ] ) )
+
+ite8528_ec.start( interval_ms = INTERVAL_MS )
+
+Stream = ite8528_ec.stream( timeout_ms = 1000 )
+Stop = time.monotonic() + RUN_SECONDS
+Expected = None
+Samples = 0
+Gaps = 0
+HottestCpu = 0
+
+for Batch in Stream:
+   Samples += len( Batch )
+   Ring = numpy.asarray( Batch )                     # no copy - good until the next batch is taken
+
+   if ( Expected is not None ) and ( Ring[ 'sequence' ][ 0 ] != Expected ):
+      Gaps += 1
+
+   Expected = ( int( Ring[ 'sequence' ][ -1 ] ) + 1 ) & 0xFFFFFFFF
+   HottestCpu = max( HottestCpu, int( Ring[ 'raw' ][ :, ite8528_ec.SENSOR_CPU_TEMP ].max() ) )
+
+   del Ring
+
+   if time.monotonic() >= Stop:
+      break
+
+Dropped = Stream.dropped
+del Stream
+ite8528_ec.stop()
+
+print( '%u samples in %u s, hottest CPU %u C, %u gaps, %u dropped' % ( Samples, RUN_SECONDS, HottestCpu, Gaps, Dropped ) )
@@ -0,0 +1,249 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ite8528_ec_sim.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      The EC access of ITE8528_EC_Lib.cpp, for builds without the DLL -
+//      setup.py links it in everywhere but Windows, with the library's own
+//      sampler, history store and the modules the sampler feeds, built over
+//      Posix/windows.h. The EC is the driver of ITE8528_EC_Driver.h over
+//      SimulatedPorts, with the sensor registers holding plausible readings
+//      and the fan count wandering from sweep to sweep. ITE8528_EC_RECORD=
+//      <trace> in the environment records the simulated EC's port traffic,
+//      and ITE8528_EC_REPLAY=<trace> answers from a trace instead, recorded
+//      here or on a board - the sweeps fail with STATUS_FILE_ERROR if it can
+//      not be read. The simulated EC raises no SCI events.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Driver.h>
+#include "ITE8528_EC_Internal.h"
+#include "ITE8528_EC_RegMap.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_FAN_COUNT         540                   // 2500 RPM
+#define SIM_FAN_WANDER        8                     // tach counts either side of SIM_FAN_COUNT
+
+static ite8528::EcDriver< ite8528::RecordingPorts< ite8528::SimulatedPorts >, ite8528::SpinWait, ite8528::ThreadLock >   SimDriver;
+static ite8528::EcDriver< ite8528::ReplayPorts, ite8528::SpinWait, ite8528::ThreadLock >                                 ReplayDriver;
+static std::once_flag                SimOnce;
+static bool                          SimReplaying = false;
+static bool                          SimTraceLoaded = false;
+static uint32_t                      SimSweeps = 0;
+
+
+//
+// at interpreter exit - a sampler thread still running when the statics are destroyed would sweep a destroyed
+// driver, and the trace is written a buffer at a time, so the last of it would be lost
+//
+
+static void SIM_Exit( void )
+{
+   SMP_Stop();
+   SimDriver.GetPorts().Close();
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SIM_Setup                                                       */
+/*                                                                            */
+/*!\brief  Fills in the simulated EC, or opens the trace to replay, and      */
+/*         starts recording if asked to                                       */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Runs once, on the first EC access                                 */
+/*                                                                            */
+/******************************************************************************/
+static void SIM_Setup( void )
+{
+   ite8528::SimulatedPorts   &Ec = SimDriver.GetPorts().GetInner();
+   const char                *pReplay = getenv( "ITE8528_EC_REPLAY" );
+   const char                *pRecord = getenv( "ITE8528_EC_RECORD" );
+
+   atexit( SIM_Exit );
+
+   if ( ( pReplay ) && ( *pReplay ) )
+   {
+      SimReplaying = true;
+      SimTraceLoaded = ReplayDriver.GetPorts().Open( pReplay );
+      return;
+   }
+
+   Ec.Sram[ CPU_TEMPERATURE_OFFSET ] = 45;
+   Ec.Sram[ SYS_TEMPERATURE_OFFSET ] = 38;
+   Ec.Sram[ VCORE_H_OFFSET ] = 0x01;                            // 0x0119 x VCORE_SCALE_FACTOR = 0.82V
+   Ec.Sram[ VCORE_L_OFFSET ] = 0x19;
+   Ec.Sram[ V3P3V_H_OFFSET ] = 0x02;                            // 3.30V
+   Ec.Sram[ V3P3V_L_OFFSET ] = 0x33;
+   Ec.Sram[ V5_H_OFFSET ] = 0x02;                               // 5.00V
+   Ec.Sram[ V5_L_OFFSET ] = 0x15;
+   Ec.Sram[ V12_H_OFFSET ] = 0x02;                              // 12.00V
+   Ec.Sram[ V12_L_OFFSET ] = 0x6C;
+   Ec.Sram[ VDIMM_H_OFFSET ] = 0x01;                            // 1.20V
+   Ec.Sram[ VDIMM_L_OFFSET ] = 0x99;
+   Ec.Sram[ CPU_FAN_H_OFFSET ] = ( uint8_t )( SIM_FAN_COUNT >> 8 );
+   Ec.Sram[ CPU_FAN_L_OFFSET ] = ( uint8_t ) SIM_FAN_COUNT;
+
+   if ( ( pRecord ) && ( *pRecord ) )
+   {
+      SimDriver.GetPorts().Open( pRecord );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SIM_Wander                                                      */
+/*                                                                            */
+/*!\brief  Moves the simulated fan's tach count for the next sweep           */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    A triangle wave over the sweeps, so a recording of the sweeps    */
+/*!\note    always has the same readings in it                                */
+/*                                                                            */
+/******************************************************************************/
+static void SIM_Wander( void )
+{
+   ite8528::SimulatedPorts   &Ec = SimDriver.GetPorts().GetInner();
+   uint32_t                  Step;
+   uint16_t                  Count;
+
+   SimDriver.Lock();
+
+   Step = SimSweeps++ % ( 4 * SIM_FAN_WANDER );
+   Step = ( Step < 2 * SIM_FAN_WANDER ) ? Step : 4 * SIM_FAN_WANDER - Step;
+   Count = ( uint16_t )( SIM_FAN_COUNT - SIM_FAN_WANDER + Step );
+
+   Ec.Sram[ CPU_FAN_H_OFFSET ] = ( uint8_t )( Count >> 8 );
+   Ec.Sram[ CPU_FAN_L_OFFSET ] = ( uint8_t ) Count;
+
+   SimDriver.Unlock();
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_ReadBlockUsingACPI                                           */
+/*                                                                            */
+/*!\brief  Reads a block of the simulated EC, or of the trace being replayed */
+/*                                                                            */
+/*!\param   uint8_t         Offset in EC memory space to read from            */
+/*!\param   uint8_t         number of bytes                                   */
+/*!\param   puint8_t        where to return them                              */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The fan count wanders each time the fan is read, which is once a  */
+/*!\note    sweep                                                             */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EC_ReadBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData )
+{
+   if ( pData == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   std::call_once( SimOnce, SIM_Setup );
+
+   if ( SimReplaying )
+   {
+      return ( SimTraceLoaded ) ? ReplayDriver.ReadBlock( Offset, Count, pData ) :
+                                  WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+   }
+
+   if ( ( Offset <= CPU_FAN_L_OFFSET ) && ( Offset + Count > CPU_FAN_L_OFFSET ) )
+   {
+      SIM_Wander();
+   }
+
+   return SimDriver.ReadBlock( Offset, Count, pData );
+}
+
+//
+// the IO space window of dual mode reads the same simulated SRAM
+//
+
+WINSYS_ERROR EC_ReadByteUsingIOSpace( uint8_t Offset, puint8_t pData )
+{
+   return EC_ReadBlockUsingACPI( Offset, 1, pData );
+}
+
+WINSYS_ERROR EC_QueryEventsUsingACPI( puint8_t pCodes, uint8_t MaxCodes, puint8_t pCount )
+{
+   UNREFERENCED_PARAMETER( MaxCodes );
+
+   if ( ( pCodes == NULL ) || ( pCount == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   *pCount = 0;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_GetMicroSecs                                                 */
+/*                                                                            */
+/*!\brief  Returns a monotonic microsecond count for latency measurements    */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  uint64_t        microseconds from the steady clock                */
+/*                                                                            */
+/******************************************************************************/
+uint64_t EC_GetMicroSecs( void )
+{
+   return ( uint64_t ) std::chrono::duration_cast< std::chrono::microseconds >(
+                          std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_GetSystemTimeMs                                              */
+/*                                                                            */
+/*!\brief  UTC msecs since 1970, for sample timestamps                       */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  uint64_t        the time                                          */
+/*                                                                            */
+/******************************************************************************/
+uint64_t EC_GetSystemTimeMs( void )
+{
+   return ( uint64_t ) std::chrono::duration_cast< std::chrono::milliseconds >(
+                          std::chrono::system_clock::now().time_since_epoch() ).count();
+}
@@ -0,0 +1,631 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ite8528_ec_win32.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      The Win32 calls declared by Posix/windows.h, over pthreads and mmap(),
+//      for the simulated EC build of the Python extension. Events, threads
+//      and the waits on them share one mutex and condition variable: the
+//      library only ever waits on a handful of objects, a sweep at a time,
+//      so a wakeup that was for another object costs nothing that matters.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define WIN32_MAX_VIEWS       8
+
+typedef enum _WIN32_OBJECT_ENUM_TYPE {
+                                        WIN32_EVENT,
+                                        WIN32_THREAD,
+                                        WIN32_FILE,
+                                        WIN32_MAPPING
+
+                                     } WIN32_OBJECT_ENUM_TYPE;
+
+/*!\struct _WIN32_OBJECT_STRUCT
+ * \brief  What a HANDLE points at
+ */
+typedef struct _WIN32_OBJECT_STRUCT {
+                                       WIN32_OBJECT_ENUM_TYPE   Kind;
+                                       BOOL                     ManualReset;
+                                       BOOL                     Signalled;       // events, and threads once they exit
+                                       pthread_t                Thread;
+                                       LPTHREAD_START_ROUTINE   pRoutine;
+                                       LPVOID                   pParam;
+                                       int                      File;            // files, and mappings' own copy
+                                       SIZE_T                   Bytes;           // mappings
+
+                                    } WIN32_OBJECT_STRUCT, *P_WIN32_OBJECT_STRUCT;
+
+/*!\struct _WIN32_VIEW_STRUCT
+ * \brief  A mapped view, so it can be flushed and unmapped by its address alone
+ */
+typedef struct _WIN32_VIEW_STRUCT {
+                                     const void *   pView;
+                                     SIZE_T         Bytes;
+
+                                  } WIN32_VIEW_STRUCT, *P_WIN32_VIEW_STRUCT;
+
+static pthread_mutex_t       Win32Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t        Win32Changed;                 // an object was signalled, or a watched address written
+static pthread_once_t        Win32Once = PTHREAD_ONCE_INIT;
+static WIN32_VIEW_STRUCT     Win32Views[ WIN32_MAX_VIEWS ];
+
+
+static void Win32_Setup( void )
+{
+   pthread_condattr_t   Attributes;
+
+   pthread_condattr_init( &Attributes );
+   pthread_condattr_setclock( &Attributes, CLOCK_MONOTONIC );
+   pthread_cond_init( &Win32Changed, &Attributes );
+   pthread_condattr_destroy( &Attributes );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: Win32_Wait                                                      */
+/*                                                                            */
+/*!\brief  Waits on Win32Changed until a deadline, with Win32Lock held        */
+/*                                                                            */
+/*!\param   const struct timespec *  the deadline on CLOCK_MONOTONIC, NULL    */
+/*!\param                            for none                                 */
+/*!\return  BOOL            FALSE once the deadline has passed                */
+/*                                                                            */
+/******************************************************************************/
+static BOOL Win32_Wait( const struct timespec *pDeadline )
+{
+   if ( pDeadline == NULL )
+   {
+      pthread_cond_wait( &Win32Changed, &Win32Lock );
+      return TRUE;
+   }
+
+   return ( pthread_cond_timedwait( &Win32Changed, &Win32Lock, pDeadline ) != ETIMEDOUT );
+}
+
+static void Win32_Deadline( DWORD TimeoutMs, struct timespec *pDeadline )
+{
+   clock_gettime( CLOCK_MONOTONIC, pDeadline );
+
+   pDeadline->tv_sec += TimeoutMs / 1000;
+   pDeadline->tv_nsec += ( long )( TimeoutMs % 1000 ) * 1000000;
+
+   if ( pDeadline->tv_nsec >= 1000000000 )
+   {
+      pDeadline->tv_sec++;
+      pDeadline->tv_nsec -= 1000000000;
+   }
+}
+
+static P_WIN32_OBJECT_STRUCT Win32_New( WIN32_OBJECT_ENUM_TYPE Kind )
+{
+   P_WIN32_OBJECT_STRUCT   pObject = new WIN32_OBJECT_STRUCT();
+
+   pthread_once( &Win32Once, Win32_Setup );
+
+   pObject->Kind = Kind;
+   pObject->File = -1;
+
+   return pObject;
+}
+
+//
+// SRW locks - the pthread_rwlock_t is made on first use, so SRWLOCK_INIT needs no constructor
+//
+
+static pthread_rwlock_t *Win32_RwLock( PSRWLOCK pLock )
+{
+   pthread_rwlock_t   *pRwLock = ( pthread_rwlock_t * ) __atomic_load_n( &pLock->Ptr, __ATOMIC_ACQUIRE );
+   PVOID              pExpected = NULL;
+
+   if ( pRwLock == NULL )
+   {
+      pRwLock = new pthread_rwlock_t;
+      pthread_rwlock_init( pRwLock, NULL );
+
+      if ( ! __atomic_compare_exchange_n( &pLock->Ptr, &pExpected, ( PVOID ) pRwLock, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) )
+      {
+         pthread_rwlock_destroy( pRwLock );
+         delete pRwLock;
+         pRwLock = ( pthread_rwlock_t * ) pExpected;
+      }
+   }
+
+   return pRwLock;
+}
+
+void AcquireSRWLockExclusive( PSRWLOCK pLock )
+{
+   pthread_rwlock_wrlock( Win32_RwLock( pLock ) );
+}
+
+void ReleaseSRWLockExclusive( PSRWLOCK pLock )
+{
+   pthread_rwlock_unlock( Win32_RwLock( pLock ) );
+}
+
+void AcquireSRWLockShared( PSRWLOCK pLock )
+{
+   pthread_rwlock_rdlock( Win32_RwLock( pLock ) );
+}
+
+void ReleaseSRWLockShared( PSRWLOCK pLock )
+{
+   pthread_rwlock_unlock( Win32_RwLock( pLock ) );
+}
+
+//
+// events and waits
+//
+
+HANDLE CreateEventA( void *pAttributes, BOOL ManualReset, BOOL InitialState, LPCSTR pName )
+{
+   P_WIN32_OBJECT_STRUCT   pEvent = Win32_New( WIN32_EVENT );
+
+   UNREFERENCED_PARAMETER( pAttributes );
+   UNREFERENCED_PARAMETER( pName );
+
+   pEvent->ManualReset = ManualReset;
+   pEvent->Signalled = InitialState;
+
+   return pEvent;
+}
+
+static BOOL Win32_Signal( HANDLE Handle, BOOL Signalled )
+{
+   pthread_mutex_lock( &Win32Lock );
+
+   ( ( P_WIN32_OBJECT_STRUCT ) Handle )->Signalled = Signalled;
+
+   if ( Signalled )
+   {
+      pthread_cond_broadcast( &Win32Changed );
+   }
+
+   pthread_mutex_unlock( &Win32Lock );
+
+   return TRUE;
+}
+
+BOOL SetEvent( HANDLE Event )
+{
+   return Win32_Signal( Event, TRUE );
+}
+
+BOOL ResetEvent( HANDLE Event )
+{
+   return Win32_Signal( Event, FALSE );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WaitForMultipleObjects                                          */
+/*                                                                            */
+/*!\brief  Waits for any one of a set of events or threads                   */
+/*                                                                            */
+/*!\param   DWORD           number of handles                                 */
+/*!\param   const HANDLE *  the handles                                       */
+/*!\param   BOOL            must be FALSE - waiting for all is not needed     */
+/*!\param   DWORD           msecs to wait at most, INFINITE for ever          */
+/*!\return  DWORD           WAIT_OBJECT_0 + index of the lowest signalled     */
+/*!\return                  handle, or WAIT_TIMEOUT                           */
+/*                                                                            */
+/*!\note    An auto reset event is reset by the wait that sees it signalled  */
+/*                                                                            */
+/******************************************************************************/
+DWORD WaitForMultipleObjects( DWORD Count, const HANDLE *pHandles, BOOL WaitAll, DWORD TimeoutMs )
+{
+   struct timespec   Deadline;
+   DWORD             Results = WAIT_TIMEOUT;
+   DWORD             Index;
+   BOOL              Waiting = TRUE;
+
+   UNREFERENCED_PARAMETER( WaitAll );
+
+   Win32_Deadline( ( TimeoutMs == INFINITE ) ? 0 : TimeoutMs, &Deadline );
+
+   pthread_mutex_lock( &Win32Lock );
+
+   while ( Results == WAIT_TIMEOUT )
+   {
+      for ( Index = 0; Index < Count; Index++ )
+      {
+         P_WIN32_OBJECT_STRUCT   pObject = ( P_WIN32_OBJECT_STRUCT ) pHandles[ Index ];
+
+         if ( pObject->Signalled )
+         {
+            pObject->Signalled = ( pObject->ManualReset ) ? TRUE : FALSE;
+            Results = WAIT_OBJECT_0 + Index;
+            break;
+         }
+      }
+
+      if ( ( Results != WAIT_TIMEOUT ) || ( ! Waiting ) || ( TimeoutMs == 0 ) )
+      {
+         break;
+      }
+
+      Waiting = Win32_Wait( ( TimeoutMs == INFINITE ) ? NULL : &Deadline );
+   }
+
+   pthread_mutex_unlock( &Win32Lock );
+
+   return Results;
+}
+
+DWORD WaitForSingleObject( HANDLE Handle, DWORD TimeoutMs )
+{
+   return WaitForMultipleObjects( 1, &Handle, FALSE, TimeoutMs );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WaitOnAddress                                                   */
+/*                                                                            */
+/*!\brief  Waits while a value still holds what the caller last saw          */
+/*                                                                            */
+/*!\param   volatile void * the value                                         */
+/*!\param   PVOID           what the caller last saw                          */
+/*!\param   SIZE_T          size of the value                                 */
+/*!\param   DWORD           msecs to wait at most, INFINITE for ever          */
+/*!\return  BOOL            FALSE if the wait timed out                       */
+/*                                                                            */
+/*!\note    As on Windows, the wake may be spurious - callers check again.   */
+/*!\note    The value is compared with Win32Lock held, and WakeByAddressAll() */
+/*!\note    takes it, so a write and wake between the compare and the wait   */
+/*!\note    is not missed.                                                    */
+/*                                                                            */
+/******************************************************************************/
+BOOL WaitOnAddress( volatile void *pAddress, PVOID pCompare, SIZE_T Bytes, DWORD TimeoutMs )
+{
+   struct timespec   Deadline;
+   BOOL              Woken = TRUE;
+
+   Win32_Deadline( ( TimeoutMs == INFINITE ) ? 0 : TimeoutMs, &Deadline );
+
+   pthread_once( &Win32Once, Win32_Setup );
+   pthread_mutex_lock( &Win32Lock );
+
+   __atomic_thread_fence( __ATOMIC_SEQ_CST );
+
+   if ( memcmp( ( const void * ) pAddress, pCompare, Bytes ) == 0 )
+   {
+      Woken = Win32_Wait( ( TimeoutMs == INFINITE ) ? NULL : &Deadline );
+   }
+
+   pthread_mutex_unlock( &Win32Lock );
+
+   return Woken;
+}
+
+void WakeByAddressAll( PVOID pAddress )
+{
+   UNREFERENCED_PARAMETER( pAddress );
+
+   pthread_once( &Win32Once, Win32_Setup );
+   pthread_mutex_lock( &Win32Lock );
+   pthread_cond_broadcast( &Win32Changed );
+   pthread_mutex_unlock( &Win32Lock );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: CloseHandle                                                     */
+/*                                                                            */
+/*!\brief  Frees an event, thread, file or mapping                           */
+/*                                                                            */
+/*!\param   HANDLE          the handle                                        */
+/*!\return  BOOL            TRUE                                              */
+/*                                                                            */
+/*!\note    The library only closes a thread's handle once the thread has    */
+/*!\note    exited, so it is joined here                                      */
+/*                                                                            */
+/******************************************************************************/
+BOOL CloseHandle( HANDLE Handle )
+{
+   P_WIN32_OBJECT_STRUCT   pObject = ( P_WIN32_OBJECT_STRUCT ) Handle;
+
+   if ( pObject->Kind == WIN32_THREAD )
+   {
+      pthread_join( pObject->Thread, NULL );
+   }
+
+   if ( pObject->File >= 0 )
+   {
+      close( pObject->File );
+   }
+
+   delete pObject;
+
+   return TRUE;
+}
+
+//
+// threads - run at the one priority the process has
+//
+
+static void *Win32_Thread( void *pParam )
+{
+   P_WIN32_OBJECT_STRUCT   pThread = ( P_WIN32_OBJECT_STRUCT ) pParam;
+
+   pThread->pRoutine( pThread->pParam );
+   Win32_Signal( pThread, TRUE );
+
+   return NULL;
+}
+
+HANDLE CreateThread( void *pAttributes, SIZE_T StackBytes, LPTHREAD_START_ROUTINE pRoutine, LPVOID pParam, DWORD Flags, DWORD *pId )
+{
+   P_WIN32_OBJECT_STRUCT   pThread = Win32_New( WIN32_THREAD );
+
+   UNREFERENCED_PARAMETER( pAttributes );
+   UNREFERENCED_PARAMETER( StackBytes );
+   UNREFERENCED_PARAMETER( Flags );
+
+   pThread->ManualReset = TRUE;
+   pThread->pRoutine = pRoutine;
+   pThread->pParam = pParam;
+
+   if ( pthread_create( &pThread->Thread, NULL, Win32_Thread, pThread ) != 0 )
+   {
+      delete pThread;
+      return NULL;
+   }
+
+   if ( pId )
+   {
+      *pId = 0;
+   }
+
+   return pThread;
+}
+
+HANDLE GetCurrentThread( void )
+{
+   return NULL;
+}
+
+int GetThreadPriority( HANDLE Thread )
+{
+   UNREFERENCED_PARAMETER( Thread );
+
+   return 0;
+}
+
+BOOL SetThreadPriority( HANDLE Thread, int Priority )
+{
+   UNREFERENCED_PARAMETER( Thread );
+   UNREFERENCED_PARAMETER( Priority );
+
+   return TRUE;
+}
+
+BOOL QueryPerformanceCounter( PLARGE_INTEGER pCount )
+{
+   struct timespec   Now;
+
+   clock_gettime( CLOCK_MONOTONIC, &Now );
+   pCount->QuadPart = ( LONGLONG ) Now.tv_sec * 1000000000 + Now.tv_nsec;
+
+   return TRUE;
+}
+
+BOOL QueryPerformanceFrequency( PLARGE_INTEGER pFrequency )
+{
+   pFrequency->QuadPart = 1000000000;
+
+   return TRUE;
+}
+
+//
+// files and mappings - only what the history store does: open or create a file, map all of it read/write
+//
+
+HANDLE CreateFileA( LPCSTR pPath, DWORD Access, DWORD Share, void *pAttributes, DWORD Disposition, DWORD Flags, HANDLE Template )
+{
+   P_WIN32_OBJECT_STRUCT   pFile;
+   int                     File;
+
+   UNREFERENCED_PARAMETER( Access );
+   UNREFERENCED_PARAMETER( Share );
+   UNREFERENCED_PARAMETER( pAttributes );
+   UNREFERENCED_PARAMETER( Disposition );
+   UNREFERENCED_PARAMETER( Flags );
+   UNREFERENCED_PARAMETER( Template );
+
+   if ( ( File = open( pPath, O_RDWR | O_CREAT | O_CLOEXEC, 0644 ) ) < 0 )
+   {
+      return INVALID_HANDLE_VALUE;
+   }
+
+   pFile = Win32_New( WIN32_FILE );
+   pFile->File = File;
+
+   return pFile;
+}
+
+BOOL GetFileSizeEx( HANDLE File, PLARGE_INTEGER pSize )
+{
+   struct stat   Status;
+
+   if ( fstat( ( ( P_WIN32_OBJECT_STRUCT ) File )->File, &Status ) != 0 )
+   {
+      return FALSE;
+   }
+
+   pSize->QuadPart = ( LONGLONG ) Status.st_size;
+
+   return TRUE;
+}
+
+BOOL FlushFileBuffers( HANDLE File )
+{
+   return ( fsync( ( ( P_WIN32_OBJECT_STRUCT ) File )->File ) == 0 );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: CreateFileMappingA                                              */
+/*                                                                            */
+/*!\brief  Makes a mapping of a file, extending the file to its size         */
+/*                                                                            */
+/*!\param   HANDLE          the file                                          */
+/*!\param   void *          unused                                            */
+/*!\param   DWORD           unused - mappings are read/write                  */
+/*!\param   DWORD           size, high 32 bits                                */
+/*!\param   DWORD           size, low 32 bits - 0 and 0 for the file's size   */
+/*!\param   LPCSTR          unused                                            */
+/*!\return  HANDLE          the mapping, NULL if it can not be made           */
+/*                                                                            */
+/*!\note    Extending the file fills it with zeros, as on Windows            */
+/*                                                                            */
+/******************************************************************************/
+HANDLE CreateFileMappingA( HANDLE File, void *pAttributes, DWORD Protect, DWORD SizeHigh, DWORD SizeLow, LPCSTR pName )
+{
+   P_WIN32_OBJECT_STRUCT   pMapping;
+   LARGE_INTEGER           Size;
+   LARGE_INTEGER           Want;
+
+   UNREFERENCED_PARAMETER( pAttributes );
+   UNREFERENCED_PARAMETER( Protect );
+   UNREFERENCED_PARAMETER( pName );
+
+   Want.QuadPart = ( ( LONGLONG ) SizeHigh << 32 ) | SizeLow;
+
+   if ( ! GetFileSizeEx( File, &Size ) )
+   {
+      return NULL;
+   }
+
+   if ( Want.QuadPart > Size.QuadPart )
+   {
+      if ( ftruncate( ( ( P_WIN32_OBJECT_STRUCT ) File )->File, ( off_t ) Want.QuadPart ) != 0 )
+      {
+         return NULL;
+      }
+
+      Size = Want;
+   }
+
+   if ( Size.QuadPart == 0 )
+   {
+      return NULL;
+   }
+
+   pMapping = Win32_New( WIN32_MAPPING );
+   pMapping->File = dup( ( ( P_WIN32_OBJECT_STRUCT ) File )->File );
+   pMapping->Bytes = ( SIZE_T ) Size.QuadPart;
+
+   return pMapping;
+}
+
+LPVOID MapViewOfFile( HANDLE Mapping, DWORD Access, DWORD OffsetHigh, DWORD OffsetLow, SIZE_T Bytes )
+{
+   P_WIN32_OBJECT_STRUCT   pMapping = ( P_WIN32_OBJECT_STRUCT ) Mapping;
+   void                    *pView;
+   uint32_t                Index;
+
+   UNREFERENCED_PARAMETER( OffsetHigh );
+   UNREFERENCED_PARAMETER( OffsetLow );
+
+   Bytes = ( Bytes ) ? Bytes : pMapping->Bytes;
+   pView = mmap( NULL, Bytes, ( Access & FILE_MAP_WRITE ) ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, pMapping->File, 0 );
+
+   if ( pView == MAP_FAILED )
+   {
+      return NULL;
+   }
+
+   pthread_mutex_lock( &Win32Lock );
+
+   for ( Index = 0; Index < WIN32_MAX_VIEWS; Index++ )
+   {
+      if ( Win32Views[ Index ].pView == NULL )
+      {
+         Win32Views[ Index ].pView = pView;
+         Win32Views[ Index ].Bytes = Bytes;
+         break;
+      }
+   }
+
+   pthread_mutex_unlock( &Win32Lock );
+
+   if ( Index == WIN32_MAX_VIEWS )
+   {
+      munmap( pView, Bytes );
+      pView = NULL;
+   }
+
+   return pView;
+}
+
+static SIZE_T Win32_ViewBytes( const void *pView, BOOL Forget )
+{
+   SIZE_T     Bytes = 0;
+   uint32_t   Index;
+
+   pthread_mutex_lock( &Win32Lock );
+
+   for ( Index = 0; Index < WIN32_MAX_VIEWS; Index++ )
+   {
+      if ( Win32Views[ Index ].pView == pView )
+      {
+         Bytes = Win32Views[ Index ].Bytes;
+         Win32Views[ Index ].pView = ( Forget ) ? NULL : pView;
+         break;
+      }
+   }
+
+   pthread_mutex_unlock( &Win32Lock );
+
+   return Bytes;
+}
+
+BOOL UnmapViewOfFile( const void *pView )
+{
+   SIZE_T   Bytes = Win32_ViewBytes( pView, TRUE );
+
+   return ( ( Bytes ) && ( munmap( ( void * ) pView, Bytes ) == 0 ) );
+}
+
+BOOL FlushViewOfFile( const void *pView, SIZE_T Bytes )
+{
+   Bytes = ( Bytes ) ? Bytes : Win32_ViewBytes( pView, FALSE );
+
+   return ( ( Bytes ) && ( msync( ( void * ) pView, Bytes, MS_SYNC ) == 0 ) );
+}
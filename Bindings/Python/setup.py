@@ -0,0 +1,111 @@
+#****************************************************************************
+#
+#    Copyright 2026 by WinSystems Inc.
+#
+#    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+#    and CPU products incorporating a GPIO device, to distribute any binary
+#    file or files compiled using this source code directly or in any work
+#    derived by the user from this file. In no case may the source code,
+#    original or derived from this file, be distributed to any third party
+#    except by explicit permission of WinSystems. This file is distributed
+#    on an "As-is" basis and no warranty as to performance or fitness of pur-
+#    poses is expressed or implied. In no case shall WinSystems be liable for
+#    any direct or indirect loss or damage, real or consequential resulting
+#    from the usage of this source code. It is the user's sole responsibility
+#    to determine fitness for any considered purpose.
+#
+#****************************************************************************
+#
+#    Name       : setup.py
+#
+#    Project    : ACPI Embedded Controller Routines
+#
+#    Author     : agent
+#
+#    Description:
+#      Builds the ite8528_ec extension against the x64 build of
+#      ITE8528_EC_Lib. Build the library first, then
+#
+#        python setup.py build_ext --inplace [--configuration Debug]
+#
+#      ITE8528_EC_Lib.dll and inpoutx64.dll must be on the PATH, or next to
+#      the extension, when it is imported.
+#
+#      Anywhere else there is no DLL. The extension is built with the
+#      library's own sampler and history sources, and the modules the
+#      sampler feeds, over ite8528_ec_sim.cpp - a simulated EC behind the
+#      library's EC access - and the Win32 calls of Posix/windows.h. Build
+#      it and run the tests with
+#
+#        python setup.py build_ext --inplace
+#        python -m pytest test_ite8528_ec.py
+#
+#****************************************************************************
+#
+#      Date      Revision    Description
+#    --------    --------    ---------------------------------------------
+#    10/19/26      0.1       Original
+#    10/19/26      0.2       simulated EC build for Linux
+#    10/19/26      0.3       builds the library's sampler and history
+#
+#****************************************************************************
+
+import os
+import sys
+from setuptools import setup, Extension
+from setuptools.command.build_ext import build_ext
+
+Root = os.path.abspath( os.path.join( os.path.dirname( __file__ ), '..', '..' ) )
+Configuration = 'Release'
+
+if '--configuration' in sys.argv:
+   Index = sys.argv.index( '--configuration' )
+   Configuration = sys.argv[ Index + 1 ]
+   del sys.argv[ Index : Index + 2 ]
+
+Libraries = []
+
+
+class BuildExt( build_ext ):
+   """build_ext that builds the static libraries first, so build_ext --inplace is enough"""
+
+   def run( self ):
+      if self.distribution.has_c_libraries():
+         self.run_command( 'build_clib' )
+
+      build_ext.run( self )
+
+
+if sys.platform == 'win32':
+   Module = Extension( 'ite8528_ec',
+                       sources = [ 'ite8528_ec.c' ],
+                       include_dirs = [ os.path.join( Root, 'Include' ) ],
+                       library_dirs = [ os.path.join( Root, 'ITE8528_EC_Lib', 'x64', Configuration ),
+                                        os.path.join( Root, 'Libs' ) ],
+                       libraries = [ 'ITE8528_EC_Lib' ] )
+else:
+   #
+   # the library's sources are C++ built as the DLL builds them, with __DLL_BUILD, which the extension's C can not
+   # be - so they are a static library of their own
+   #
+
+   Sources = [ os.path.join( Root, 'ITE8528_EC_Lib', 'ITE8528_EC_%s.cpp' % Name )
+               for Name in [ 'Sampler', 'History', 'Alarms', 'Stats', 'Quantiles', 'Broadcast', 'Planner', 'Dual', 'Events' ] ]
+
+   Libraries = [ ( 'ite8528_ec_sim',
+                   { 'sources' : [ 'ite8528_ec_sim.cpp', 'ite8528_ec_win32.cpp' ] + Sources,
+                     'include_dirs' : [ 'Posix', os.path.join( Root, 'Include' ), os.path.join( Root, 'ITE8528_EC_Lib' ) ],
+                     'macros' : [ ( '__DLL_BUILD', '' ) ] } ) ]
+
+   Module = Extension( 'ite8528_ec',
+                       sources = [ 'ite8528_ec.c' ],
+                       include_dirs = [ os.path.join( Root, 'Include' ) ],
+                       extra_link_args = [ '-pthread' ],
+                       language = 'c++' )
+
+setup( name = 'ite8528_ec',
+       version = '0.2',
+       description = 'ITE8528 embedded controller sensors, sampler and history',
+       libraries = Libraries,
+       cmdclass = { 'build_ext' : BuildExt },
+       ext_modules = [ Module ] )
@@ -0,0 +1,262 @@
+#****************************************************************************
+#
+#    Copyright 2026 by WinSystems Inc.
+#
+#    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+#    and CPU products incorporating a GPIO device, to distribute any binary
+#    file or files compiled using this source code directly or in any work
+#    derived by the user from this file. In no case may the source code,
+#    original or derived from this file, be distributed to any third party
+#    except by explicit permission of WinSystems. This file is distributed
+#    on an "As-is" basis and no warranty as to performance or fitness of pur-
+#    poses is expressed or implied. In no case shall WinSystems be liable for
+#    any direct or indirect loss or damage, real or consequential resulting
+#    from the usage of this source code. It is the user's sole responsibility
+#    to determine fitness for any considered purpose.
+#
+#****************************************************************************
+#
+#    Name       : test_ite8528_ec.py
+#
+#    Project    : ACPI Embedded Controller Routines
+#
+#    Author     : agent
+#
+#    Description:
+#      pytest tests of the extension built against ite8528_ec_sim.cpp and
+#      the library's own sampler and history - see setup.py. The readings
+#      are the simulated EC's; the history tests append samples made up here
+#      so the buckets they roll up into are known. The replay test records
+#      the simulated EC's port traffic in one interpreter and plays it back
+#      in another. On Windows the extension talks to the board, so the tests
+#      are skipped there.
+#
+#****************************************************************************
+#
+#      Date      Revision    Description
+#    --------    --------    ---------------------------------------------
+#    10/19/26      0.1       Original
+#    10/19/26      0.2       history, rollup and pinned batch tests
+#
+#****************************************************************************
+
+import os
+import struct
+import subprocess
+import sys
+import time
+import pytest
+
+if sys.platform == 'win32':
+   pytest.skip( 'needs the simulated EC build', allow_module_level = True )
+
+import ite8528_ec
+
+SAMPLE_LAYOUT = '<QIHH%uH' % 8                      # EC_SAMPLE_STRUCT, as SAMPLE_FORMAT describes it
+SAMPLE_BYTES = struct.calcsize( SAMPLE_LAYOUT )
+POINT_LAYOUT = '<QIHH%uH%uH%uH' % ( 8, 8, 8 )        # HIST_POINT_STRUCT, as POINT_FORMAT describes it
+POINT_BYTES = struct.calcsize( POINT_LAYOUT )
+BLOCK_HEADER_LAYOUT = '<QQQII'                      # HIST_BLOCK_HEADER_STRUCT up to its Checksum
+HIST_BLOCK_SIZE = 4096
+SMP_RING_SIZE = 1024
+HOUR_MS = 3600000
+FAN_TACH_CLOCK = 1350000
+SIM_FAN_COUNT = 540                                 # ite8528_ec_sim.cpp
+SIM_FAN_WANDER = 8
+
+REPLAY_SCRIPT = '''
+import ite8528_ec, struct
+for Index in range( 40 ):
+   print( struct.unpack( '%s', bytes( memoryview( ite8528_ec.query() ) ) )[ 2: ] )
+''' % SAMPLE_LAYOUT
+
+
+def Unpack( Records, Layout = SAMPLE_LAYOUT ):
+   View = memoryview( Records )
+   Data = View.tobytes()
+   View.release()
+
+   return list( struct.iter_unpack( Layout, Data ) )
+
+
+def Reading( Index, Sensor ):
+   return 0x0200 + 16 * Sensor + ( Index * 7 + Sensor ) % 13
+
+
+def Samples( StartMs, Count ):
+   '''a sample a second from StartMs, each sensor's reading a known function of its index'''
+
+   return b''.join( struct.pack( SAMPLE_LAYOUT, StartMs + 1000 * Index, Index, ite8528_ec.SENSOR_MASK_ALL, 0,
+                                 *[ Reading( Index, Sensor ) for Sensor in range( 8 ) ] ) for Index in range( Count ) )
+
+
+@pytest.fixture
+def History( tmp_path ):
+   '''ten minutes of samples, starting on the hour before this one, in a fresh history file'''
+
+   Path = str( tmp_path / 'history.bin' )
+   StartMs = ( int( time.time() * 1000 ) // HOUR_MS - 1 ) * HOUR_MS
+
+   ite8528_ec.history_open( Path, 16 )
+   ite8528_ec.history_append( Samples( StartMs, 600 ) )
+   yield Path, StartMs
+   ite8528_ec.history_close()
+
+
+@pytest.fixture
+def Sampler():
+   ite8528_ec.start( interval_ms = 2 )
+   yield
+   ite8528_ec.stop()
+
+
+def test_query_reads_the_simulated_ec():
+   Records = ite8528_ec.query()
+
+   assert len( Records ) == 1
+   assert not Records.lent
+
+   View = memoryview( Records )
+   assert View.format == ite8528_ec.SAMPLE_FORMAT
+   assert View.itemsize == SAMPLE_BYTES
+   View.release()
+
+   TimestampMs, Sequence, ValidMask, Reserved, *Raw = Unpack( Records )[ 0 ]
+
+   assert ValidMask == ite8528_ec.SENSOR_MASK_ALL
+   assert Raw[ ite8528_ec.SENSOR_CPU_TEMP ] == 45
+   assert Raw[ ite8528_ec.SENSOR_SYS_TEMP ] == 38
+   assert Raw[ ite8528_ec.SENSOR_V12 ] == 0x026C
+   assert ( FAN_TACH_CLOCK // ( SIM_FAN_COUNT + SIM_FAN_WANDER + 1 ) <= Raw[ ite8528_ec.SENSOR_CPU_FAN ] <=
+            FAN_TACH_CLOCK // ( SIM_FAN_COUNT - SIM_FAN_WANDER - 1 ) )
+
+
+def test_query_reads_only_the_masked_sensors():
+   Mask = ( 1 << ite8528_ec.SENSOR_SYS_TEMP ) | ( 1 << ite8528_ec.SENSOR_VCORE )
+   TimestampMs, Sequence, ValidMask, Reserved, *Raw = Unpack( ite8528_ec.query( mask = Mask ) )[ 0 ]
+
+   assert ValidMask == Mask
+   assert Raw[ ite8528_ec.SENSOR_SYS_TEMP ] == 38
+   assert Raw[ ite8528_ec.SENSOR_VCORE ] == 0x0119
+
+
+def test_stream_lends_consecutive_samples( Sampler ):
+   Stream = ite8528_ec.stream( timeout_ms = 1000 )
+   Sequences = []
+
+   for Batch in Stream:
+      assert Batch.lent
+      Sequences += [ Sample[ 1 ] for Sample in Unpack( Batch ) ]
+
+      if len( Sequences ) >= 100:
+         break
+
+   assert Sequences == list( range( Sequences[ 0 ], Sequences[ 0 ] + len( Sequences ) ) )
+   assert Stream.dropped == 0
+   assert Unpack( ite8528_ec.latest() )[ 0 ][ 1 ] >= Sequences[ -1 ]
+
+
+def test_stream_keeps_a_batch_while_it_is_viewed( Sampler ):
+   Stream = ite8528_ec.stream( timeout_ms = 1000 )
+   Batch = next( Stream )
+   View = memoryview( Batch )
+
+   with pytest.raises( BufferError ):
+      next( Stream )
+
+   View.release()
+   assert len( next( Stream ) ) > 0
+
+
+def test_stream_batches_are_numpy_arrays_over_the_ring( Sampler ):
+   numpy = pytest.importorskip( 'numpy' )
+   Stream = ite8528_ec.stream( timeout_ms = 1000 )
+   Ring = numpy.asarray( next( Stream ) )
+
+   assert Ring.dtype.names == ( 'timestamp_ms', 'sequence', 'valid_mask', 'reserved', 'raw' )
+   assert ( Ring[ 'raw' ][ :, ite8528_ec.SENSOR_CPU_TEMP ] == 45 ).all()
+
+   del Ring
+   next( Stream )
+
+
+def test_stream_pins_a_viewed_batch_while_the_ring_laps():
+   ite8528_ec.start( interval_ms = 1 )
+
+   try:
+      Stream = ite8528_ec.stream( timeout_ms = 1000 )
+      Batch = next( Stream )
+      View = memoryview( Batch )
+      Before = View.tobytes()
+
+      time.sleep( 2 * SMP_RING_SIZE / 1000 )
+
+      assert View.tobytes() == Before
+      View.release()
+      next( Stream )
+      assert Stream.dropped > 0
+   finally:
+      ite8528_ec.stop()
+
+
+def test_history_returns_the_samples_appended( History ):
+   Path, StartMs = History
+   Appended = Unpack( Samples( StartMs, 600 ) )
+   Key = lambda Sample: ( Sample[ 0 ], Sample[ 2 ], Sample[ 4: ] )        # Sequence is the history's own
+
+   assert [ Key( Sample ) for Sample in Unpack( ite8528_ec.history( StartMs, StartMs + 600000 ) ) ] == [ Key( Sample ) for Sample in Appended ]
+   assert ( [ Key( Sample ) for Sample in Unpack( ite8528_ec.history( StartMs + 100000, StartMs + 199000 ) ) ] ==
+            [ Key( Sample ) for Sample in Appended[ 100:200 ] ] )
+
+
+def test_rollup_buckets_the_samples( History ):
+   Path, StartMs = History
+
+   Points, ResolutionMs = ite8528_ec.rollup( StartMs, StartMs + 599999, max_points = 1000 )
+   Points = Unpack( Points, POINT_LAYOUT )
+
+   assert ResolutionMs == 10000
+   assert len( Points ) == 60
+
+   for Bucket, ( PointMs, Count, ValidMask, Reserved, *Readings ) in enumerate( Points ):
+      Raw = [ [ Reading( Index, Sensor ) for Index in range( 10 * Bucket, 10 * Bucket + 10 ) ] for Sensor in range( 8 ) ]
+
+      assert PointMs == StartMs + 10000 * Bucket
+      assert Count == 10
+      assert ValidMask == ite8528_ec.SENSOR_MASK_ALL
+      assert Readings[ 0:8 ] == [ min( Sensor ) for Sensor in Raw ]
+      assert Readings[ 8:16 ] == [ max( Sensor ) for Sensor in Raw ]
+      assert all( abs( Mean - sum( Sensor ) / 10 ) <= 0.5 for Mean, Sensor in zip( Readings[ 16:24 ], Raw ) )
+
+   Points, ResolutionMs = ite8528_ec.rollup( StartMs, StartMs + 599999, max_points = 10 )
+
+   assert ResolutionMs == 60000
+   assert [ Point[ 1 ] for Point in Unpack( Points, POINT_LAYOUT ) ] == [ 60 ] * 10
+
+
+def test_history_block_is_the_file_in_place( History ):
+   Path, StartMs = History
+   Block = ite8528_ec.history_block( 0 )
+
+   assert Block.readonly
+   Sequence, FirstMs, LastMs, Commit, Checksum = struct.unpack_from( BLOCK_HEADER_LAYOUT, Block )
+   assert FirstMs == StartMs
+
+   with open( Path, 'rb' ) as File:                     # a fresh file fills block 0 first, after the file header's block
+      File.seek( HIST_BLOCK_SIZE )
+      assert File.read( len( Block ) ) == Block.tobytes()
+
+
+def test_replay_answers_as_the_recording_did( tmp_path ):
+   Trace = str( tmp_path / 'sim.trace' )
+   Environment = dict( os.environ, PYTHONPATH = os.path.dirname( os.path.abspath( ite8528_ec.__file__ ) ) )
+
+   Recorded = subprocess.run( [ sys.executable, '-c', REPLAY_SCRIPT ], env = dict( Environment, ITE8528_EC_RECORD = Trace ),
+                              capture_output = True, text = True, check = True ).stdout
+   Replayed = subprocess.run( [ sys.executable, '-c', REPLAY_SCRIPT ], env = dict( Environment, ITE8528_EC_REPLAY = Trace ),
+                              capture_output = True, text = True, check = True ).stdout
+
+   assert os.path.getsize( Trace ) > 0
+   assert len( Recorded.splitlines() ) == 40
+   assert len( set( Recorded.splitlines() ) ) > 1        # the fan count wanders from sweep to sweep
+   assert Replayed == Recorded
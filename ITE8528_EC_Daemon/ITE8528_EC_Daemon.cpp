@@ -0,0 +1,974 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Daemon.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      Telemetry daemon - owns the EC through the library and answers the
+//      requests of ITE8528_EC_Daemon.h over a Unix domain socket, and
+//      optionally OpenMetrics scrapes on 127.0.0.1:port
+//
+//      ITE8528_EC_Daemon [-s socket] [-i interval ms] [-m sensor mask]
+//                        [-h history file] [-p metrics port] [-g group]
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <winsock2.h>
+#include <windows.h>
+#include <afunix.h>
+#include <sddl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_History.h>
+#include <ITE8528_EC_Stats.h>
+#include <ITE8528_EC_Exporter.h>
+#include <ITE8528_EC_Daemon.h>
+
+#define ECD_DRAIN_BATCH       64
+
+//
+// The socket's directory gives SYSTEM and Administrators full control. The group named with -g may list the
+// directory and read and write the files in it - enough to connect - but not create, rename or delete them.
+//
+
+#define ECD_DIRECTORY_SDDL    "D:P(A;OICI;FA;;;SY)(A;OICI;FA;;;BA)"
+#define ECD_GROUP_SDDL        "(A;;FRFX;;;%s)(A;OIIO;FRFWFX;;;%s)"
+
+//
+// Everything a request can be answered from without calling into the library, refreshed by the snapshot
+// thread after each drain of the sampler
+//
+
+typedef struct _ECD_SNAPSHOT_STRUCT {
+                                       EC_SAMPLE_STRUCT     Latest;
+                                       SMP_STATS_STRUCT     Sampler;
+                                       HIST_STATS_STRUCT    History;
+                                       STAT_SENSOR_STRUCT   Stats[ SENSOR_COUNT ];
+                                       uint32_t             Valid;          // a sample has been taken
+
+                                    } ECD_SNAPSHOT_STRUCT, *P_ECD_SNAPSHOT_STRUCT;
+
+//
+// A connection and the buffers its requests are answered in. The slots are allocated once at start up, so a
+// response is built without allocating and written with one vectored send - the response header, then a
+// result header and its payload per item - without copying the parts together.
+//
+
+typedef struct _ECD_CLIENT_STRUCT {
+                                     volatile LONG                InUse;
+                                     SOCKET                       Socket;
+                                     HANDLE                       Thread;
+                                     ECD_REQUEST_HEADER_STRUCT    Request;
+                                     ECD_ITEM_STRUCT              Items[ ECD_MAX_ITEMS ];
+                                     ECD_RESPONSE_HEADER_STRUCT   Response;
+                                     ECD_RESULT_STRUCT            Results[ ECD_MAX_ITEMS ];
+                                     uint32_t                     Offsets[ ECD_MAX_ITEMS ];   // of each payload
+                                     WSABUF                       Buffers[ 1 + 2 * ECD_MAX_ITEMS ];
+                                     uint64_t                     Payload[ ECD_PAYLOAD_SIZE / sizeof( uint64_t ) ];
+
+                                  } ECD_CLIENT_STRUCT, *P_ECD_CLIENT_STRUCT;
+
+static ECD_SNAPSHOT_STRUCT    EcdSnapshot;
+static SRWLOCK                EcdSnapshotLock = SRWLOCK_INIT;
+static P_ECD_CLIENT_STRUCT    pEcdClients = NULL;
+static SOCKET                 EcdListener = INVALID_SOCKET;
+static HANDLE                 EcdStopEvent = NULL;
+static uint32_t               EcdHistoryOpen = 0;
+
+static volatile LONG64        EcdRequests = 0;
+static volatile LONG64        EcdItems = 0;
+static volatile LONG64        EcdBytesSent = 0;
+static volatile LONG64        EcdSnapshots = 0;
+static volatile LONG          EcdClientCount = 0;
+static volatile LONG          EcdAccepted = 0;
+static volatile LONG          EcdRefused = 0;
+static volatile LONG          EcdMalformed = 0;
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_Refresh                                                     */
+/*                                                                            */
+/*!\brief  Rebuilds the snapshot from the library                            */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Only called from the snapshot thread. The snapshot is built aside */
+/*!\note    and copied in, so readers hold the lock for a copy only.          */
+/*                                                                            */
+/******************************************************************************/
+static void ECD_Refresh( void )
+{
+   ECD_SNAPSHOT_STRUCT   Snapshot;
+   uint32_t              Sensor;
+
+   memset( &Snapshot, 0, sizeof( Snapshot ) );
+
+   Snapshot.Valid = ( SMP_GetLatest( &Snapshot.Latest ) == STATUS_SUCCESS );
+   SMP_GetStats( &Snapshot.Sampler );
+
+   if ( EcdHistoryOpen )
+   {
+      HIST_GetStats( &Snapshot.History );
+   }
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      STAT_Get( Sensor, &Snapshot.Stats[ Sensor ] );
+   }
+
+   AcquireSRWLockExclusive( &EcdSnapshotLock );
+   EcdSnapshot = Snapshot;
+   ReleaseSRWLockExclusive( &EcdSnapshotLock );
+
+   InterlockedIncrement64( &EcdSnapshots );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_SnapshotThread                                              */
+/*                                                                            */
+/*!\brief  Drains the sampler into the history file and refreshes the       */
+/*         snapshot, each time samples are taken                              */
+/*                                                                            */
+/*!\param   LPVOID          the sampler's notification handle                 */
+/*!\return  DWORD           thread exit code                                  */
+/*                                                                            */
+/*!\note    The daemon is the sampler's only drainer                          */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI ECD_SnapshotThread( LPVOID pParam )
+{
+   EC_SAMPLE_STRUCT   Samples[ ECD_DRAIN_BATCH ];
+   HANDLE             Handles[ 2 ] = { EcdStopEvent, ( HANDLE ) pParam };
+   uint32_t           Count,
+                      Index;
+
+   while ( WaitForMultipleObjects( 2, Handles, FALSE, INFINITE ) == ( WAIT_OBJECT_0 + 1 ) )
+   {
+      do
+      {
+         if ( SMP_DrainSamples( Samples, ECD_DRAIN_BATCH, &Count ) != STATUS_SUCCESS )
+         {
+            Count = 0;
+         }
+
+         for ( Index = 0; ( Index < Count ) && ( EcdHistoryOpen ); Index++ )
+         {
+            HIST_Append( &Samples[ Index ] );
+         }
+
+      } while ( Count == ECD_DRAIN_BATCH );
+
+      ECD_Refresh();
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_GetStats                                                    */
+/*                                                                            */
+/*!\brief  Returns the daemon's counters                                      */
+/*                                                                            */
+/*!\param   P_ECD_STATS_STRUCT  pointer to structure to return counters in    */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void ECD_GetStats( P_ECD_STATS_STRUCT pStats )
+{
+   pStats->Requests = ( uint64_t ) EcdRequests;
+   pStats->Items = ( uint64_t ) EcdItems;
+   pStats->BytesSent = ( uint64_t ) EcdBytesSent;
+   pStats->Snapshots = ( uint64_t ) EcdSnapshots;
+   pStats->Clients = ( uint32_t ) EcdClientCount;
+   pStats->Accepted = ( uint32_t ) EcdAccepted;
+   pStats->Refused = ( uint32_t ) EcdRefused;
+   pStats->Malformed = ( uint32_t ) EcdMalformed;
+
+   AcquireSRWLockShared( &EcdSnapshotLock );
+   pStats->SnapshotMs = ( EcdSnapshot.Valid ) ? EcdSnapshot.Latest.TimestampMs : 0;
+   ReleaseSRWLockShared( &EcdSnapshotLock );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_AnswerItem                                                  */
+/*                                                                            */
+/*!\brief  Fills in the result and payload of one item                       */
+/*                                                                            */
+/*!\param   P_ECD_ITEM_STRUCT    the item asked for                           */
+/*!\param   P_ECD_RESULT_STRUCT  result to fill in                            */
+/*!\param   puint8_t             where the payload goes                       */
+/*!\param   uint32_t             room left for the payload, in bytes          */
+/*!\return  WINSYS_ERROR    value indicating success or failure of the item   */
+/*                                                                            */
+/*!\note    The caller holds the snapshot lock shared                         */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR ECD_AnswerItem( P_ECD_ITEM_STRUCT pItem, P_ECD_RESULT_STRUCT pResult, puint8_t pPayload, uint32_t Room )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   uint32_t       Size = 0,
+                  Max,
+                  Sensor;
+
+   switch ( pItem->Type )
+   {
+      case ECD_ITEM_SENSORS:
+
+         Size = sizeof( EC_SAMPLE_STRUCT );
+
+         if ( Room < Size )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+             }
+         else if ( !EcdSnapshot.Valid )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+             }
+         else
+             {
+                P_EC_SAMPLE_STRUCT   pSample = ( P_EC_SAMPLE_STRUCT ) pPayload;
+
+                *pSample = EcdSnapshot.Latest;
+                pSample->ValidMask &= ( uint16_t ) pItem->SensorMask;
+
+                for ( Sensor = 0; Sensor < EC_SENSOR_MAX; Sensor++ )
+                {
+                   if ( ( pSample->ValidMask & EC_SENSOR_MASK( Sensor ) ) == 0 )
+                   {
+                      pSample->Raw[ Sensor ] = 0;
+                   }
+                }
+
+                pResult->Count = 1;
+             }
+         break;
+
+      case ECD_ITEM_HISTORY:
+
+         Size = sizeof( EC_SAMPLE_STRUCT );
+         Max = ( pItem->MaxCount < Room / Size ) ? pItem->MaxCount : Room / Size;
+
+         if ( pItem->MaxCount == 0 )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+             }
+         else if ( Max == 0 )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+             }
+         else
+             {
+                Results = HIST_Query( pItem->StartMs, pItem->EndMs, ( P_EC_SAMPLE_STRUCT ) pPayload, Max, &pResult->Count );
+             }
+         break;
+
+      case ECD_ITEM_ROLLUP:
+
+         Size = sizeof( HIST_POINT_STRUCT );
+         Max = ( pItem->MaxCount < Room / Size ) ? pItem->MaxCount : Room / Size;
+
+         if ( pItem->MaxCount == 0 )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+             }
+         else if ( Max == 0 )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+             }
+         else
+             {
+                Results = HIST_QueryRollup( pItem->StartMs, pItem->EndMs, Max, ( P_HIST_POINT_STRUCT ) pPayload, &pResult->Count,
+                                            &pResult->ResolutionMs );
+             }
+         break;
+
+      case ECD_ITEM_SENSOR_STATS:
+
+         Size = sizeof( STAT_SENSOR_STRUCT );
+
+         for ( Sensor = 0; ( Sensor < SENSOR_COUNT ) && ( Results == STATUS_SUCCESS ); Sensor++ )
+         {
+            if ( pItem->SensorMask & EC_SENSOR_MASK( Sensor ) )
+            {
+               if ( Room < ( pResult->Count + 1 ) * Size )
+                   {
+                      Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+                   }
+               else
+                   {
+                      ( ( P_STAT_SENSOR_STRUCT ) pPayload )[ pResult->Count++ ] = EcdSnapshot.Stats[ Sensor ];
+                   }
+            }
+         }
+         break;
+
+      case ECD_ITEM_SAMPLER_STATS:
+
+         Size = sizeof( SMP_STATS_STRUCT );
+
+         if ( Room < Size )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+             }
+         else
+             {
+                *( P_SMP_STATS_STRUCT ) pPayload = EcdSnapshot.Sampler;
+                pResult->Count = 1;
+             }
+         break;
+
+      case ECD_ITEM_HISTORY_STATS:
+
+         Size = sizeof( HIST_STATS_STRUCT );
+
+         if ( Room < Size )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+             }
+         else if ( !EcdHistoryOpen )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+             }
+         else
+             {
+                *( P_HIST_STATS_STRUCT ) pPayload = EcdSnapshot.History;
+                pResult->Count = 1;
+             }
+         break;
+
+      case ECD_ITEM_DAEMON_STATS:
+
+         Size = sizeof( ECD_STATS_STRUCT );
+
+         if ( Room < Size )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+             }
+         else
+             {
+                ECD_STATS_STRUCT   Stats;
+
+                ECD_GetStats( &Stats );
+                memcpy( pPayload, &Stats, sizeof( Stats ) );
+                pResult->Count = 1;
+             }
+         break;
+
+      default:
+
+         Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ENUMERATION_OUT_OF_RANGE );
+         break;
+   }
+
+   if ( Results != STATUS_SUCCESS )
+   {
+      pResult->Count = 0;
+   }
+
+   pResult->Bytes = pResult->Count * Size;
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_Answer                                                      */
+/*                                                                            */
+/*!\brief  Builds the response to a client's request and lays it out in the  */
+/*         client's send buffers                                              */
+/*                                                                            */
+/*!\param   P_ECD_CLIENT_STRUCT  the client, holding its request             */
+/*!\return  uint32_t             buffers to send                              */
+/*                                                                            */
+/*!\note    The fixed size items are answered first and the history ranges   */
+/*!\note    share what is left, so a long range cannot crowd out a reading.  */
+/*!\note    The send buffers put the payloads back in item order. Every      */
+/*!\note    record size is a multiple of 8, so each payload stays aligned.   */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t ECD_Answer( P_ECD_CLIENT_STRUCT pClient )
+{
+   puint8_t   pPayload = ( puint8_t ) pClient->Payload;
+   uint32_t   Used = 0,
+              BufferCount = 1,
+              Pass,
+              Index;
+
+   pClient->Response.Magic = ECD_MAGIC;
+   pClient->Response.Tag = pClient->Request.Tag;
+   pClient->Response.ItemCount = pClient->Request.ItemCount;
+   pClient->Response.Bytes = 0;
+
+   pClient->Buffers[ 0 ].buf = ( CHAR * ) &pClient->Response;
+   pClient->Buffers[ 0 ].len = sizeof( pClient->Response );
+
+   AcquireSRWLockShared( &EcdSnapshotLock );
+
+   for ( Pass = 0; Pass < 2; Pass++ )
+   {
+      for ( Index = 0; Index < pClient->Request.ItemCount; Index++ )
+      {
+         P_ECD_RESULT_STRUCT   pResult = &pClient->Results[ Index ];
+         uint32_t              Range = ( pClient->Items[ Index ].Type == ECD_ITEM_HISTORY ) ||
+                                       ( pClient->Items[ Index ].Type == ECD_ITEM_ROLLUP );
+
+         if ( Range == Pass )
+         {
+            memset( pResult, 0, sizeof( *pResult ) );
+            pResult->Type = pClient->Items[ Index ].Type;
+            pResult->Status = ECD_AnswerItem( &pClient->Items[ Index ], pResult, pPayload + Used, ECD_PAYLOAD_SIZE - Used );
+
+            pClient->Offsets[ Index ] = Used;
+            Used += pResult->Bytes;
+         }
+      }
+   }
+
+   ReleaseSRWLockShared( &EcdSnapshotLock );
+
+   for ( Index = 0; Index < pClient->Request.ItemCount; Index++ )
+   {
+      P_ECD_RESULT_STRUCT   pResult = &pClient->Results[ Index ];
+
+      pClient->Buffers[ BufferCount ].buf = ( CHAR * ) pResult;
+      pClient->Buffers[ BufferCount++ ].len = sizeof( *pResult );
+
+      if ( pResult->Bytes )
+      {
+         pClient->Buffers[ BufferCount ].buf = ( CHAR * )( pPayload + pClient->Offsets[ Index ] );
+         pClient->Buffers[ BufferCount++ ].len = pResult->Bytes;
+      }
+
+      pClient->Response.Bytes += sizeof( *pResult ) + pResult->Bytes;
+   }
+
+   return BufferCount;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_Receive                                                     */
+/*                                                                            */
+/*!\brief  Reads exactly the bytes asked for from a socket                   */
+/*                                                                            */
+/*!\param   SOCKET          the connection                                    */
+/*!\param   void *          buffer to read into                               */
+/*!\param   uint32_t        bytes to read                                     */
+/*!\return  BOOL            FALSE if the connection closed or failed          */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static BOOL ECD_Receive( SOCKET Socket, void *pBuffer, uint32_t Bytes )
+{
+   char   *pNext = ( char * ) pBuffer;
+   int    Got;
+
+   while ( Bytes )
+   {
+      if ( ( Got = recv( Socket, pNext, ( int ) Bytes, 0 ) ) <= 0 )
+      {
+         return FALSE;
+      }
+
+      pNext += Got;
+      Bytes -= ( uint32_t ) Got;
+   }
+
+   return TRUE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_Send                                                        */
+/*                                                                            */
+/*!\brief  Writes a set of buffers to a socket in one vectored send          */
+/*                                                                            */
+/*!\param   SOCKET          the connection                                    */
+/*!\param   WSABUF *        the buffers, which are advanced past what is sent */
+/*!\param   uint32_t        number of buffers                                 */
+/*!\return  BOOL            FALSE if the connection closed or failed          */
+/*                                                                            */
+/*!\note    A blocking WSASend() normally sends everything; a short send is   */
+/*!\note    continued from where it stopped                                   */
+/*                                                                            */
+/******************************************************************************/
+static BOOL ECD_Send( SOCKET Socket, WSABUF *pBuffers, uint32_t Count )
+{
+   DWORD   Sent;
+
+   while ( Count )
+   {
+      if ( WSASend( Socket, pBuffers, Count, &Sent, 0, NULL, NULL ) != 0 )
+      {
+         return FALSE;
+      }
+
+      InterlockedExchangeAdd64( &EcdBytesSent, Sent );
+
+      while ( ( Count ) && ( Sent >= pBuffers->len ) )
+      {
+         Sent -= pBuffers->len;
+         pBuffers++;
+         Count--;
+      }
+
+      if ( Count )
+      {
+         pBuffers->buf += Sent;
+         pBuffers->len -= Sent;
+      }
+   }
+
+   return TRUE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_ClientThread                                                */
+/*                                                                            */
+/*!\brief  Answers one connection's requests until it closes                 */
+/*                                                                            */
+/*!\param   LPVOID          the client's P_ECD_CLIENT_STRUCT                  */
+/*!\return  DWORD           thread exit code                                  */
+/*                                                                            */
+/*!\note    Frees the client slot on the way out                             */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI ECD_ClientThread( LPVOID pParam )
+{
+   P_ECD_CLIENT_STRUCT   pClient = ( P_ECD_CLIENT_STRUCT ) pParam;
+
+   while ( ECD_Receive( pClient->Socket, &pClient->Request, sizeof( pClient->Request ) ) )
+   {
+      if ( ( pClient->Request.Magic != ECD_MAGIC ) || ( pClient->Request.ItemCount == 0 ) ||
+           ( pClient->Request.ItemCount > ECD_MAX_ITEMS ) )
+      {
+         InterlockedIncrement( &EcdMalformed );
+         break;
+      }
+
+      if ( ( !ECD_Receive( pClient->Socket, pClient->Items, pClient->Request.ItemCount * sizeof( ECD_ITEM_STRUCT ) ) ) ||
+           ( !ECD_Send( pClient->Socket, pClient->Buffers, ECD_Answer( pClient ) ) ) )
+      {
+         break;
+      }
+
+      InterlockedIncrement64( &EcdRequests );
+      InterlockedExchangeAdd64( &EcdItems, pClient->Request.ItemCount );
+   }
+
+   closesocket( pClient->Socket );
+   pClient->Socket = INVALID_SOCKET;
+
+   InterlockedDecrement( &EcdClientCount );
+   InterlockedExchange( &pClient->InUse, 0 );
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_Accept                                                      */
+/*                                                                            */
+/*!\brief  Hands a new connection to a free client slot and its thread       */
+/*                                                                            */
+/*!\param   SOCKET          the connection                                    */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    The connection is closed if every slot is busy                    */
+/*                                                                            */
+/******************************************************************************/
+static void ECD_Accept( SOCKET Socket )
+{
+   P_ECD_CLIENT_STRUCT   pClient;
+   uint32_t              Index;
+
+   for ( Index = 0; Index < ECD_MAX_CLIENTS; Index++ )
+   {
+      pClient = &pEcdClients[ Index ];
+
+      if ( InterlockedCompareExchange( &pClient->InUse, 1, 0 ) == 0 )
+      {
+         if ( pClient->Thread )
+         {
+            WaitForSingleObject( pClient->Thread, INFINITE );     // has freed the slot, and is exiting
+            CloseHandle( pClient->Thread );
+         }
+
+         pClient->Socket = Socket;
+         InterlockedIncrement( &EcdClientCount );
+
+         if ( ( pClient->Thread = CreateThread( NULL, 0, ECD_ClientThread, pClient, 0, NULL ) ) == NULL )
+         {
+            InterlockedDecrement( &EcdClientCount );
+            InterlockedExchange( &pClient->InUse, 0 );
+            break;
+         }
+
+         InterlockedIncrement( &EcdAccepted );
+         return;
+      }
+   }
+
+   InterlockedIncrement( &EcdRefused );
+   closesocket( Socket );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_CtrlHandler                                                 */
+/*                                                                            */
+/*!\brief  Stops the daemon on Ctrl-C, Ctrl-Break or close                   */
+/*                                                                            */
+/*!\param   DWORD           the control event                                 */
+/*!\return  BOOL            TRUE, handled                                     */
+/*                                                                            */
+/*!\note    Closing the listening socket ends the accept loop in main()       */
+/*                                                                            */
+/******************************************************************************/
+static BOOL WINAPI ECD_CtrlHandler( DWORD CtrlType )
+{
+   UNREFERENCED_PARAMETER( CtrlType );
+
+   SetEvent( EcdStopEvent );
+   closesocket( EcdListener );
+
+   return TRUE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_SecureDirectory                                             */
+/*                                                                            */
+/*!\brief  Creates the socket's directory, or resets the ACL of an existing */
+/*!\brief  one, so that only the daemon's accounts and a group may connect   */
+/*                                                                            */
+/*!\param   const char *    the directory                                     */
+/*!\param   const char *    group allowed to connect, NULL = none             */
+/*!\return  BOOL            FALSE if the group is unknown or the ACL could    */
+/*!\return                  not be set                                        */
+/*                                                                            */
+/*!\note    The ACL is protected, so nothing is inherited from the parent,   */
+/*!\note    and the socket file inherits it when bound                        */
+/*                                                                            */
+/******************************************************************************/
+static BOOL ECD_SecureDirectory( const char *pDirectory, const char *pGroup )
+{
+   SECURITY_ATTRIBUTES    Security;
+   PSECURITY_DESCRIPTOR   pDescriptor = NULL;
+   BYTE                   Sid[ SECURITY_MAX_SID_SIZE ];
+   char                   Domain[ 256 ],
+                          Group[ 400 ] = "",
+                          Sddl[ sizeof( ECD_DIRECTORY_SDDL ) + sizeof( Group ) ];
+   char                   *pSidString = NULL;
+   DWORD                  SidSize = sizeof( Sid ),
+                          DomainSize = sizeof( Domain );
+   SID_NAME_USE           Use;
+   BOOL                   Ok = TRUE;
+
+   if ( pGroup )
+   {
+      Ok = ( LookupAccountNameA( NULL, pGroup, Sid, &SidSize, Domain, &DomainSize, &Use ) ) &&
+           ( ConvertSidToStringSidA( Sid, &pSidString ) );
+
+      if ( Ok )
+      {
+         sprintf_s( Group, sizeof( Group ), ECD_GROUP_SDDL, pSidString, pSidString );
+         LocalFree( pSidString );
+      }
+   }
+
+   if ( Ok )
+   {
+      sprintf_s( Sddl, sizeof( Sddl ), "%s%s", ECD_DIRECTORY_SDDL, Group );
+
+      Ok = ConvertStringSecurityDescriptorToSecurityDescriptorA( Sddl, SDDL_REVISION_1, &pDescriptor, NULL );
+   }
+
+   if ( Ok )
+   {
+      Security.nLength = sizeof( Security );
+      Security.lpSecurityDescriptor = pDescriptor;
+      Security.bInheritHandle = FALSE;
+
+      Ok = ( CreateDirectoryA( pDirectory, &Security ) ) ||
+           ( ( GetLastError() == ERROR_ALREADY_EXISTS ) && ( SetFileSecurityA( pDirectory, DACL_SECURITY_INFORMATION, pDescriptor ) ) );
+
+      LocalFree( pDescriptor );
+   }
+
+   return Ok;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ECD_Listen                                                      */
+/*                                                                            */
+/*!\brief  Creates the socket file and listens on it                         */
+/*                                                                            */
+/*!\param   const char *    path of the socket, which must name a directory   */
+/*!\param   const char *    group allowed to connect, NULL = none             */
+/*!\return  SOCKET          the listening socket, INVALID_SOCKET on failure   */
+/*                                                                            */
+/*!\note    A socket file left by a daemon that did not exit cleanly is      */
+/*!\note    removed first. The directory's ACL, set by ECD_SecureDirectory(), */
+/*!\note    decides which accounts may connect.                               */
+/*                                                                            */
+/******************************************************************************/
+static SOCKET ECD_Listen( const char *pPath, const char *pGroup )
+{
+   SOCKADDR_UN   Address;
+   SOCKET        Socket;
+   char          Directory[ sizeof( Address.sun_path ) ];
+   char          *pSlash;
+
+   if ( strlen( pPath ) >= sizeof( Address.sun_path ) )
+   {
+      return INVALID_SOCKET;
+   }
+
+   memset( &Address, 0, sizeof( Address ) );
+   Address.sun_family = AF_UNIX;
+   strcpy_s( Address.sun_path, sizeof( Address.sun_path ), pPath );
+
+   strcpy_s( Directory, sizeof( Directory ), pPath );
+
+   if ( ( pSlash = strrchr( Directory, '\\' ) ) == NULL )
+   {
+      return INVALID_SOCKET;
+   }
+
+   *pSlash = '\0';
+
+   if ( ! ECD_SecureDirectory( Directory, pGroup ) )
+   {
+      printf( "cannot set the ACL of %s, %u\n", Directory, GetLastError() );
+      return INVALID_SOCKET;
+   }
+
+   DeleteFileA( pPath );
+
+   if ( ( Socket = socket( AF_UNIX, SOCK_STREAM, 0 ) ) != INVALID_SOCKET )
+   {
+      if ( ( bind( Socket, ( SOCKADDR * ) &Address, sizeof( Address ) ) != 0 ) || ( listen( Socket, SOMAXCONN ) != 0 ) )
+      {
+         closesocket( Socket );
+         Socket = INVALID_SOCKET;
+      }
+   }
+
+   return Socket;
+}
+
+WINSYS_ERROR main( int argc, char *argv[] )
+{
+   WSADATA        WsaData;
+   HANDLE         Notify,
+                  Snapshot;
+   SOCKET         Socket;
+   const char     *pPath = ECD_DEFAULT_SOCKET_PATH,
+                  *pHistory = NULL,
+                  *pGroup = NULL;
+   uint32_t       IntervalMs = SMP_DEFAULT_INTERVAL_MS,
+                  SensorMask = EC_SENSOR_MASK_ALL,
+                  Port = 0,
+                  Index;
+   int            Arg;
+   WINSYS_ERROR   Results;
+
+   for ( Arg = 1; Arg + 1 < argc; Arg += 2 )
+   {
+      if ( strcmp( argv[ Arg ], "-s" ) == 0 )
+          {
+             pPath = argv[ Arg + 1 ];
+          }
+      else if ( strcmp( argv[ Arg ], "-i" ) == 0 )
+          {
+             IntervalMs = strtoul( argv[ Arg + 1 ], NULL, 0 );
+          }
+      else if ( strcmp( argv[ Arg ], "-m" ) == 0 )
+          {
+             SensorMask = strtoul( argv[ Arg + 1 ], NULL, 0 );
+          }
+      else if ( strcmp( argv[ Arg ], "-h" ) == 0 )
+          {
+             pHistory = argv[ Arg + 1 ];
+          }
+      else if ( strcmp( argv[ Arg ], "-p" ) == 0 )
+          {
+             Port = strtoul( argv[ Arg + 1 ], NULL, 0 );
+          }
+      else if ( strcmp( argv[ Arg ], "-g" ) == 0 )
+          {
+             pGroup = argv[ Arg + 1 ];
+          }
+      else
+          {
+             break;
+          }
+   }
+
+   if ( ( Arg < argc ) || ( Port > 0xFFFF ) )
+   {
+      printf( "usage: ITE8528_EC_Daemon [-s socket] [-i interval ms] [-m sensor mask] [-h history file] [-p metrics port] [-g group]\n" );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   if ( WSAStartup( MAKEWORD( 2, 2 ), &WsaData ) != 0 )
+   {
+      printf( "WSAStartup failed\n" );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+   }
+
+   pEcdClients = ( P_ECD_CLIENT_STRUCT ) VirtualAlloc( NULL, ECD_MAX_CLIENTS * sizeof( ECD_CLIENT_STRUCT ), MEM_COMMIT | MEM_RESERVE,
+                                                       PAGE_READWRITE );
+   EcdStopEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
+
+   if ( ( pEcdClients == NULL ) || ( EcdStopEvent == NULL ) )
+   {
+      printf( "out of memory\n" );
+      WSACleanup();
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+   }
+
+   if ( pHistory )
+   {
+      if ( ( Results = HIST_Open( pHistory, 0 ) ) != STATUS_SUCCESS )
+      {
+         printf( "HIST_Open( %s ) failed, 0x%08X\n", pHistory, Results );
+         WSACleanup();
+         return Results;
+      }
+
+      EcdHistoryOpen = 1;
+   }
+
+   if ( ( ( Results = SMP_Start( IntervalMs, SensorMask ) ) != STATUS_SUCCESS ) ||
+        ( ( Results = SMP_GetNotifyHandle( &Notify ) ) != STATUS_SUCCESS ) )
+   {
+      printf( "SMP_Start failed, 0x%08X\n", Results );
+      HIST_Close();
+      WSACleanup();
+      return Results;
+   }
+
+   Snapshot = CreateThread( NULL, 0, ECD_SnapshotThread, Notify, 0, NULL );
+
+   if ( ( Snapshot == NULL ) || ( ( EcdListener = ECD_Listen( pPath, pGroup ) ) == INVALID_SOCKET ) )
+       {
+          printf( "cannot listen on %s, %d\n", pPath, WSAGetLastError() );
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+       }
+   else
+       {
+          SetConsoleCtrlHandler( ECD_CtrlHandler, TRUE );
+          printf( "serving %s, sampling 0x%02X every %u ms\n", pPath, SensorMask, IntervalMs );
+
+          if ( Port )
+          {
+             if ( ( Results = OMX_Start( ( uint16_t ) Port, IntervalMs ) ) == STATUS_SUCCESS )
+                 {
+                    printf( "serving metrics on 127.0.0.1:%u\n", Port );
+                 }
+             else
+                 {
+                    printf( "OMX_Start( %u ) failed, 0x%08X - carrying on without metrics\n", Port, Results );
+                    Results = STATUS_SUCCESS;
+                    Port = 0;
+                 }
+          }
+
+          while ( ( Socket = accept( EcdListener, NULL, NULL ) ) != INVALID_SOCKET )
+          {
+             ECD_Accept( Socket );
+          }
+
+          if ( WaitForSingleObject( EcdStopEvent, 0 ) != WAIT_OBJECT_0 )
+          {
+             printf( "accept failed, %d\n", WSAGetLastError() );
+             closesocket( EcdListener );
+          }
+       }
+
+   //
+   // shut down in the reverse order - connections and the exporter, then the snapshot thread, then the sampler
+   // and history
+   //
+
+   if ( Port )
+   {
+      OMX_Stop();
+   }
+
+   for ( Index = 0; Index < ECD_MAX_CLIENTS; Index++ )
+   {
+      if ( pEcdClients[ Index ].Thread )
+      {
+         if ( pEcdClients[ Index ].InUse )
+         {
+            shutdown( pEcdClients[ Index ].Socket, SD_BOTH );
+         }
+
+         WaitForSingleObject( pEcdClients[ Index ].Thread, INFINITE );
+         CloseHandle( pEcdClients[ Index ].Thread );
+      }
+   }
+
+   SetEvent( EcdStopEvent );
+
+   if ( Snapshot )
+   {
+      WaitForSingleObject( Snapshot, INFINITE );
+      CloseHandle( Snapshot );
+   }
+
+   SMP_Stop();
+
+   if ( EcdHistoryOpen )
+   {
+      HIST_Flush();
+      HIST_Close();
+   }
+
+   DeleteFileA( pPath );
+   WSACleanup();
+
+   return Results;
+}
@@ -0,0 +1,463 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Alarms.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the alarm engine - rule compilation into a flat
+//      comparison table, and the per sample evaluation run by the sampler thread.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Alarms.h>
+#include "ITE8528_EC_Internal.h"
+
+
+#define ALRM_NO_ENTRY               0xffff
+#define ALRM_INPUT_COUNT            ( EC_SENSOR_MAX * 2 )           // reading and rate of each sensor
+
+/*!\struct _ALRM_ENTRY_STRUCT
+ * \brief  A compiled rule. Every kind becomes "raise above, clear below" on a signed input - BELOW and FALLING
+ *         rules negate their input. Bound is indexed by Active.
+ */
+typedef struct _ALRM_ENTRY_STRUCT {
+                                     int32_t      Bound[ 2 ];          // [0] raise while Sign * input > it,
+                                                                      // [1] clear while Sign * input < it
+                                     int16_t      Sign;
+                                     uint8_t      Input;               // Sensor * 2, + 1 for the rate
+                                     uint8_t      Active;
+                                     uint16_t     Debounce;
+                                     uint16_t     Count;               // consecutive samples toward the other state
+                                     uint32_t     Id;
+
+                                  } ALRM_ENTRY_STRUCT, *P_ALRM_ENTRY_STRUCT;
+
+static SRWLOCK               AlrmLock = SRWLOCK_INIT;                 // guards everything below, held to evaluate
+static ALRM_ENTRY_STRUCT     AlrmTable[ ALRM_MAX_RULES ];             // dense, in no particular order
+static uint32_t              AlrmCount = 0;
+static uint16_t              AlrmIndex[ ALRM_MAX_RULES ];             // rule id -> table entry
+static BOOL                  AlrmIndexReady = FALSE;
+
+static uint16_t              AlrmPrevRaw[ EC_SENSOR_MAX ];            // previous readings, for the rates
+static uint64_t              AlrmPrevMs[ EC_SENSOR_MAX ];             // 0 = no previous reading
+
+static uint32_t              AlrmDeliver = ALRM_DELIVER_EVENT_QUEUE;
+static ALRM_CALLBACK         AlrmCallback = NULL;
+static PVOID                 AlrmContext = NULL;
+static ALRM_STATS_STRUCT     AlrmStats;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ALRM_Deliver                                                    */
+/*                                                                            */
+/*!\brief  Sends a raised or cleared alarm to the callback and/or the event   */
+/*         queue                                                              */
+/*                                                                            */
+/*!\param   P_ALRM_EVENT_STRUCT  the alarm                                    */
+/*!\param   uint32_t             ALRM_DELIVER_xxx flags                       */
+/*!\param   ALRM_CALLBACK        the callback, may be NULL                    */
+/*!\param   PVOID                context passed back to the callback          */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called without AlrmLock, with the delivery settings as they were  */
+/*!\note    when the alarm fired                                              */
+/*                                                                            */
+/******************************************************************************/
+static void ALRM_Deliver( P_ALRM_EVENT_STRUCT pAlarm, uint32_t Deliver, ALRM_CALLBACK Callback, PVOID pContext )
+{
+   if ( ( Deliver & ALRM_DELIVER_CALLBACK ) && ( Callback ) )
+   {
+      Callback( pAlarm, pContext );
+   }
+
+   if ( Deliver & ALRM_DELIVER_EVENT_QUEUE )
+   {
+      EC_EVENT_STRUCT   Event = { EVT_CLASS_ALARM };
+
+      Event.Param = pAlarm->Raised;
+      Event.Id = ( uint16_t ) pAlarm->Rule;
+      Event.TimestampUs = EC_GetMicroSecs();
+
+      EVT_Post( &Event );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ALRM_Evaluate                                                   */
+/*                                                                            */
+/*!\brief  Runs every rule over a sample                                     */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample - sensors not in ValidMask are    */
+/*!\param                       skipped                                      */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Alarms are delivered after the table has been run and AlrmLock   */
+/*!\note    released, on the caller's thread, so the callback and the event   */
+/*!\note    subscribers may call the ALRM_ functions.                         */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ALRM_Evaluate( P_EC_SAMPLE_STRUCT pSample )
+{
+   int32_t             Inputs[ ALRM_INPUT_COUNT ] = { 0 };
+   ALRM_EVENT_STRUCT   Fired[ ALRM_MAX_RULES ];
+   ALRM_CALLBACK       Callback;
+   PVOID               pContext;
+   uint32_t            Deliver,
+                       FiredCount = 0,
+                       Valid = 0,
+                       Sensor,
+                       Index;
+   LARGE_INTEGER       Start,
+                       End,
+                       Frequency;
+
+   if ( pSample == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockExclusive( &AlrmLock );
+
+   QueryPerformanceCounter( &Start );
+
+   //
+   // build the input vector - readings, and rates where there is an earlier reading to compare with
+   //
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      if ( pSample->ValidMask & EC_SENSOR_MASK( Sensor ) )
+      {
+         uint16_t   Raw = pSample->Raw[ Sensor ];
+
+         Inputs[ Sensor * 2 ] = Raw;
+         Valid |= 1 << ( Sensor * 2 );
+
+         if ( ( AlrmPrevMs[ Sensor ] != 0 ) && ( pSample->TimestampMs > AlrmPrevMs[ Sensor ] ) )
+         {
+            Inputs[ Sensor * 2 + 1 ] = ( int32_t )( ( ( int64_t ) Raw - AlrmPrevRaw[ Sensor ] ) * 1000 / ( int64_t )( pSample->TimestampMs - AlrmPrevMs[ Sensor ] ) );
+            Valid |= 1 << ( Sensor * 2 + 1 );
+         }
+
+         AlrmPrevRaw[ Sensor ] = Raw;
+         AlrmPrevMs[ Sensor ] = pSample->TimestampMs;
+      }
+   }
+
+   //
+   // the table - one signed compare per rule, and the debounce count
+   //
+
+   for ( Index = 0; Index < AlrmCount; Index++ )
+   {
+      P_ALRM_ENTRY_STRUCT   pEntry = &AlrmTable[ Index ];
+      int32_t               Value;
+
+      if ( ( Valid & ( 1 << pEntry->Input ) ) == 0 )
+      {
+         continue;                                    // sensor not in this sample - leave the debounce count alone
+      }
+
+      Value = Inputs[ pEntry->Input ] * pEntry->Sign;
+
+      if ( ( pEntry->Active ) ? ( Value < pEntry->Bound[ 1 ] ) : ( Value > pEntry->Bound[ 0 ] ) )
+          {
+             if ( ++pEntry->Count >= pEntry->Debounce )
+             {
+                P_ALRM_EVENT_STRUCT   pAlarm = &Fired[ FiredCount++ ];
+
+                pEntry->Active ^= 1;
+                pEntry->Count = 0;
+
+                pAlarm->Rule = pEntry->Id;
+                pAlarm->Sensor = ( uint8_t )( pEntry->Input >> 1 );
+                pAlarm->Raised = pEntry->Active;
+                pAlarm->Raw = pSample->Raw[ pEntry->Input >> 1 ];
+                pAlarm->Value = Value * pEntry->Sign;
+                pAlarm->TimestampMs = pSample->TimestampMs;
+
+                if ( pEntry->Active )
+                    {
+                       AlrmStats.Raised++;
+                    }
+                else
+                    {
+                       AlrmStats.Cleared++;
+                    }
+             }
+          }
+      else
+          {
+             pEntry->Count = 0;
+          }
+   }
+
+   QueryPerformanceCounter( &End );
+   QueryPerformanceFrequency( &Frequency );
+
+   AlrmStats.Evaluations++;
+   AlrmStats.LastEvalNs = ( uint32_t )( ( End.QuadPart - Start.QuadPart ) * 1000000000 / Frequency.QuadPart );
+   if ( AlrmStats.LastEvalNs > AlrmStats.MaxEvalNs )
+   {
+      AlrmStats.MaxEvalNs = AlrmStats.LastEvalNs;
+   }
+
+   Deliver = AlrmDeliver;
+   Callback = AlrmCallback;
+   pContext = AlrmContext;
+
+   ReleaseSRWLockExclusive( &AlrmLock );
+
+   for ( Index = 0; Index < FiredCount; Index++ )
+   {
+      ALRM_Deliver( &Fired[ Index ], Deliver, Callback, pContext );
+   }
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ALRM_AddRule                                                    */
+/*                                                                            */
+/*!\brief  Compiles a rule into the table                                    */
+/*                                                                            */
+/*!\param   P_ALRM_RULE_STRUCT  the rule                                      */
+/*!\param   puint32_t           returns the rule id                           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The rule starts cleared                                          */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ALRM_AddRule( P_ALRM_RULE_STRUCT pRule, puint32_t pRuleId )
+{
+   WINSYS_ERROR   Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_QUEUE_FULL );
+   uint32_t       Id;
+
+   if ( ( pRule == NULL ) || ( pRuleId == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( ( pRule->Sensor >= SENSOR_COUNT ) || ( pRule->Kind >= ALRM_KIND_COUNT ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ENUMERATION_OUT_OF_RANGE );
+   }
+
+   if ( ( pRule->Threshold > 0xffff ) || ( pRule->Hysteresis > 0xffff ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockExclusive( &AlrmLock );
+
+   if ( ! AlrmIndexReady )
+   {
+      for ( Id = 0; Id < ALRM_MAX_RULES; Id++ )
+      {
+         AlrmIndex[ Id ] = ALRM_NO_ENTRY;
+      }
+      AlrmIndexReady = TRUE;
+   }
+
+   for ( Id = 0; Id < ALRM_MAX_RULES; Id++ )
+   {
+      if ( AlrmIndex[ Id ] == ALRM_NO_ENTRY )
+      {
+         P_ALRM_ENTRY_STRUCT   pEntry = &AlrmTable[ AlrmCount ];
+         BOOL                  Negate = ( pRule->Kind == ALRM_BELOW ) || ( pRule->Kind == ALRM_FALLING );
+
+         pEntry->Sign = ( Negate ) ? -1 : 1;
+         pEntry->Bound[ 0 ] = pEntry->Sign * ( int32_t ) pRule->Threshold;
+         pEntry->Bound[ 1 ] = pEntry->Bound[ 0 ] - ( int32_t ) pRule->Hysteresis;
+         pEntry->Input = ( uint8_t )( pRule->Sensor * 2 + ( ( pRule->Kind == ALRM_RISING ) || ( pRule->Kind == ALRM_FALLING ) ) );
+         pEntry->Debounce = ( pRule->Debounce ) ? pRule->Debounce : 1;
+         pEntry->Count = 0;
+         pEntry->Active = 0;
+         pEntry->Id = Id;
+
+         AlrmIndex[ Id ] = ( uint16_t ) AlrmCount++;
+         AlrmStats.Rules = AlrmCount;
+
+         *pRuleId = Id;
+         Results = STATUS_SUCCESS;
+         break;
+      }
+   }
+
+   ReleaseSRWLockExclusive( &AlrmLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ALRM_RemoveRule                                                 */
+/*                                                                            */
+/*!\brief  Removes a rule from the table                                     */
+/*                                                                            */
+/*!\param   uint32_t        rule id from ALRM_AddRule()                       */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The last entry moves into the hole, keeping the table dense      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ALRM_RemoveRule( uint32_t RuleId )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   AcquireSRWLockExclusive( &AlrmLock );
+
+   if ( ( AlrmIndexReady ) && ( RuleId < ALRM_MAX_RULES ) && ( AlrmIndex[ RuleId ] != ALRM_NO_ENTRY ) )
+       {
+          uint16_t   Hole = AlrmIndex[ RuleId ];
+
+          AlrmTable[ Hole ] = AlrmTable[ --AlrmCount ];
+          AlrmIndex[ AlrmTable[ Hole ].Id ] = Hole;
+          AlrmIndex[ RuleId ] = ALRM_NO_ENTRY;
+          AlrmStats.Rules = AlrmCount;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+       }
+
+   ReleaseSRWLockExclusive( &AlrmLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ALRM_SetDelivery                                                */
+/*                                                                            */
+/*!\brief  Chooses where raised and cleared alarms go                        */
+/*                                                                            */
+/*!\param   uint32_t        ALRM_DELIVER_xxx flags                            */
+/*!\param   ALRM_CALLBACK   callback for ALRM_DELIVER_CALLBACK, or NULL       */
+/*!\param   PVOID           context passed back to the callback               */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The default is ALRM_DELIVER_EVENT_QUEUE only                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ALRM_SetDelivery( uint32_t Flags, ALRM_CALLBACK Callback, PVOID pContext )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( Flags & ALRM_DELIVER_CALLBACK ) && ( Callback == NULL ) )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+   else
+       {
+          AcquireSRWLockExclusive( &AlrmLock );
+          AlrmDeliver = Flags;
+          AlrmCallback = Callback;
+          AlrmContext = pContext;
+          ReleaseSRWLockExclusive( &AlrmLock );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ALRM_IsActive                                                   */
+/*                                                                            */
+/*!\brief  Returns whether a rule is currently raised                        */
+/*                                                                            */
+/*!\param   uint32_t        rule id from ALRM_AddRule()                       */
+/*!\param   puint32_t       returns 1 raised, 0 cleared                       */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ALRM_IsActive( uint32_t RuleId, puint32_t pActive )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pActive == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockShared( &AlrmLock );
+
+   if ( ( AlrmIndexReady ) && ( RuleId < ALRM_MAX_RULES ) && ( AlrmIndex[ RuleId ] != ALRM_NO_ENTRY ) )
+       {
+          *pActive = AlrmTable[ AlrmIndex[ RuleId ] ].Active;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+       }
+
+   ReleaseSRWLockShared( &AlrmLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ALRM_GetStats                                                   */
+/*                                                                            */
+/*!\brief  Returns the alarm engine's counters                                */
+/*                                                                            */
+/*!\param   P_ALRM_STATS_STRUCT  pointer to structure to return counters in   */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ALRM_GetStats( P_ALRM_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStats )
+       {
+          AcquireSRWLockShared( &AlrmLock );
+          *pStats = AlrmStats;
+          ReleaseSRWLockShared( &AlrmLock );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
@@ -0,0 +1,1091 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Async.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the asynchronous EC interface - a fixed pool of
+//      request slots, a submission list, a completion ring, and the single I/O
+//      worker thread that serves submissions in batches.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Async.h>
+#include "ITE8528_EC_Internal.h"
+
+
+#define ASYNC_BLOCK_MERGE_GAP       4                  // read ranges closer than this share a burst
+#define ASYNC_NO_SLOT               0xffff
+
+#define ASYNC_SLOT_FREE             0
+#define ASYNC_SLOT_QUEUED           1                  // submitted, completion not yet posted
+#define ASYNC_SLOT_DONE             2                  // completion posted, waiting to be reaped
+
+/*!\struct _ASYNC_REQUEST_STRUCT
+ * \brief  A request slot in the pool. The completion is built in place.
+ */
+typedef struct _ASYNC_REQUEST_STRUCT {
+                                        ASYNC_COMPLETION_STRUCT    Completion;
+                                        uint8_t                    Value;          // byte to write, or WDT minutes
+                                        uint8_t                    Value2;         // WDT seconds
+                                        uint16_t                   Next;           // free list / submission list link
+                                        uint8_t                    State;          // ASYNC_SLOT_xxx, guarded by AsyncLock
+                                        uint8_t                    Priority;       // ASYNC_PRIO_xxx class
+                                        volatile LONG              Cancelled;      // set by ASYNC_Cancel
+                                        uint64_t                   DeadlineUs;     // 0 = none, else EC_GetMicroSecs() limit
+                                        uint64_t                   SubmitUs;       // EC_GetMicroSecs() at submission
+                                        uint64_t                   ScheduleUs;     // deadline the class is ordered by
+                                        uint32_t                   Sequence;       // submission order, breaks ties
+
+                                     } ASYNC_REQUEST_STRUCT, *P_ASYNC_REQUEST_STRUCT;
+
+static ASYNC_REQUEST_STRUCT   AsyncPool[ ASYNC_QUEUE_DEPTH ];
+
+static SRWLOCK                AsyncLock = SRWLOCK_INIT;              // guards the lists and the completion ring
+static uint16_t               AsyncFreeHead = ASYNC_NO_SLOT;
+static uint16_t               AsyncSubmitHead = ASYNC_NO_SLOT;
+static uint16_t               AsyncSubmitTail = ASYNC_NO_SLOT;
+static uint16_t               AsyncCompleted[ ASYNC_QUEUE_DEPTH ];   // ring of completed slots
+static uint32_t               AsyncCompletedHead = 0;
+static uint32_t               AsyncCompletedTail = 0;
+static uint32_t               AsyncSequence = 0;                     // guarded by AsyncLock
+static ASYNC_STATS_STRUCT     AsyncStats;                            // guarded by AsyncLock
+static ASYNC_STATS_STRUCT     AsyncWorkerStats;                      // owned by the worker, published by ASYNC_PostCompletions
+
+static uint16_t               AsyncReady[ ASYNC_PRIO_COUNT ][ ASYNC_QUEUE_DEPTH ];   // class queues, owned by the worker
+static uint32_t               AsyncReadyCount[ ASYNC_PRIO_COUNT ];
+
+static const uint32_t         AsyncBudgetUs[ ASYNC_PRIO_COUNT ] = { 0, ASYNC_WATCHDOG_BUDGET_US, ASYNC_CONTROL_BUDGET_US, ASYNC_TELEMETRY_BUDGET_US };
+
+static HANDLE                 AsyncThread = NULL;
+static HANDLE                 AsyncSubmitEvent = NULL;               // auto reset, wakes the worker
+static HANDLE                 AsyncStopEvent = NULL;
+static HANDLE                 AsyncCompletionEvent = NULL;           // manual reset, set while completions wait
+static uint32_t               AsyncRunning = 0;                      // guarded by AsyncLock
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_PostCompletions                                           */
+/*                                                                            */
+/*!\brief  Moves a batch of finished slots to the completion ring            */
+/*                                                                            */
+/*!\param   uint16_t *      slots to complete, in completion order            */
+/*!\param   uint32_t        number of slots                                   */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    The ring is as large as the pool, so it can not overflow. Also    */
+/*!\note    publishes the worker's counters for ASYNC_GetStats()              */
+/*                                                                            */
+/******************************************************************************/
+static void ASYNC_PostCompletions( uint16_t *pSlots, uint32_t Count )
+{
+   uint32_t   Index;
+
+   AcquireSRWLockExclusive( &AsyncLock );
+
+   for ( Index = 0; Index < Count; Index++ )
+   {
+      AsyncPool[ pSlots[ Index ] ].State = ASYNC_SLOT_DONE;
+      AsyncCompleted[ AsyncCompletedHead++ & ( ASYNC_QUEUE_DEPTH - 1 ) ] = pSlots[ Index ];
+   }
+
+   AsyncWorkerStats.Submitted = AsyncStats.Submitted;                // the only counters kept under the lock
+   AsyncWorkerStats.Completed = AsyncStats.Completed + Count;
+   AsyncStats = AsyncWorkerStats;
+
+   ReleaseSRWLockExclusive( &AsyncLock );
+
+   if ( Count > 0 )
+   {
+      SetEvent( AsyncCompletionEvent );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_Abandoned                                                 */
+/*                                                                            */
+/*!\brief  Checks whether a request was cancelled or has passed its deadline */
+/*         and if so completes it without touching the EC                     */
+/*                                                                            */
+/*!\param   P_ASYNC_REQUEST_STRUCT   the request about to be started          */
+/*!\param   uint64_t        current EC_GetMicroSecs() time                    */
+/*!\return  BOOL            TRUE if the request must not be started           */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static BOOL ASYNC_Abandoned( P_ASYNC_REQUEST_STRUCT pRequest, uint64_t NowUs )
+{
+   if ( pRequest->Cancelled )
+   {
+      pRequest->Completion.Status = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_CANCELLED );
+      AsyncWorkerStats.Cancelled++;
+      return TRUE;
+   }
+
+   if ( ( pRequest->DeadlineUs != 0 ) && ( NowUs > pRequest->DeadlineUs ) )
+   {
+      pRequest->Completion.Status = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_TIMEOUT );
+      AsyncWorkerStats.TimedOut++;
+      return TRUE;
+   }
+
+   return FALSE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_RecordStart                                               */
+/*                                                                            */
+/*!\brief  Adds a request's queueing delay to its class statistics           */
+/*                                                                            */
+/*!\param   P_ASYNC_REQUEST_STRUCT   the request being issued to the EC       */
+/*!\param   uint64_t        current EC_GetMicroSecs() time                    */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void ASYNC_RecordStart( P_ASYNC_REQUEST_STRUCT pRequest, uint64_t NowUs )
+{
+   P_ASYNC_CLASS_STATS_STRUCT   pClass = &AsyncWorkerStats.Class[ pRequest->Priority ];
+   uint64_t                     DelayUs = NowUs - pRequest->SubmitUs;
+
+   pClass->Started++;
+   pClass->TotalDelayUs += DelayUs;
+
+   if ( DelayUs > pClass->MaxDelayUs )
+   {
+      pClass->MaxDelayUs = ( DelayUs > 0xffffffff ) ? 0xffffffff : ( uint32_t ) DelayUs;
+   }
+
+   if ( NowUs > pRequest->ScheduleUs )
+   {
+      pClass->DeadlineMisses++;
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_SubmittedBefore                                           */
+/*                                                                            */
+/*!\brief  Compares the submission order of two requests                     */
+/*                                                                            */
+/*!\param   P_ASYNC_REQUEST_STRUCT   first request                            */
+/*!\param   P_ASYNC_REQUEST_STRUCT   second request                           */
+/*!\return  BOOL            TRUE if the first was submitted before the second */
+/*                                                                            */
+/*!\note    Sequence numbers wrap, but never by half their range within the  */
+/*!\note    pool                                                              */
+/*                                                                            */
+/******************************************************************************/
+static BOOL ASYNC_SubmittedBefore( P_ASYNC_REQUEST_STRUCT pFirst, P_ASYNC_REQUEST_STRUCT pSecond )
+{
+   return ( ( int32_t )( pFirst->Sequence - pSecond->Sequence ) < 0 );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_Unqueue                                                   */
+/*                                                                            */
+/*!\brief  Removes entries from a class queue, keeping the rest in order      */
+/*                                                                            */
+/*!\param   uint32_t        ASYNC_PRIO_ENUM_TYPE of the queue                 */
+/*!\param   uint32_t        index of the first entry to remove                */
+/*!\param   uint32_t        number of entries to remove                       */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void ASYNC_Unqueue( uint32_t Class, uint32_t Index, uint32_t Count )
+{
+   memmove( &AsyncReady[ Class ][ Index ], &AsyncReady[ Class ][ Index + Count ], ( AsyncReadyCount[ Class ] - Index - Count ) * sizeof( uint16_t ) );
+   AsyncReadyCount[ Class ] -= Count;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_Earliest                                                  */
+/*                                                                            */
+/*!\brief  Finds the entry of a class queue with the earliest deadline       */
+/*                                                                            */
+/*!\param   uint32_t        ASYNC_PRIO_ENUM_TYPE of the queue, not empty     */
+/*!\return  uint32_t        index of the entry                                */
+/*                                                                            */
+/*!\note    The earlier submitted of equal deadlines wins, which keeps FIFO   */
+/*!\note    order for requests submitted without a timeout                    */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t ASYNC_Earliest( uint32_t Class )
+{
+   uint32_t   Best = 0,
+              Index;
+
+   for ( Index = 1; Index < AsyncReadyCount[ Class ]; Index++ )
+   {
+      P_ASYNC_REQUEST_STRUCT   pRequest = &AsyncPool[ AsyncReady[ Class ][ Index ] ];
+      P_ASYNC_REQUEST_STRUCT   pBest = &AsyncPool[ AsyncReady[ Class ][ Best ] ];
+
+      if ( ( pRequest->ScheduleUs < pBest->ScheduleUs ) ||
+           ( ( pRequest->ScheduleUs == pBest->ScheduleUs ) && ( ASYNC_SubmittedBefore( pRequest, pBest ) ) ) )
+      {
+         Best = Index;
+      }
+   }
+
+   return Best;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_OldestWrite                                               */
+/*                                                                            */
+/*!\brief  Finds the first submitted write still queued to an EC offset      */
+/*                                                                            */
+/*!\param   uint8_t         EC offset written                                 */
+/*!\param   puint32_t       in, the class and index of a queued write to the  */
+/*!\param   puint32_t       offset; out, those of the oldest such write       */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Writes only queue in the watchdog and control classes. Serving   */
+/*!\note    the oldest first keeps the last value submitted in the register,  */
+/*!\note    whatever the deadlines of the writes                              */
+/*                                                                            */
+/******************************************************************************/
+static void ASYNC_OldestWrite( uint8_t Offset, puint32_t pClass, puint32_t pIndex )
+{
+   uint32_t   Class,
+              Index;
+
+   for ( Class = ASYNC_PRIO_WATCHDOG; Class <= ASYNC_PRIO_CONTROL; Class++ )
+   {
+      for ( Index = 0; Index < AsyncReadyCount[ Class ]; Index++ )
+      {
+         P_ASYNC_REQUEST_STRUCT   pRequest = &AsyncPool[ AsyncReady[ Class ][ Index ] ];
+
+         if ( ( pRequest->Completion.Op == ASYNC_OP_WRITE ) && ( pRequest->Completion.Offset == Offset ) &&
+              ( ASYNC_SubmittedBefore( pRequest, &AsyncPool[ AsyncReady[ *pClass ][ *pIndex ] ] ) ) )
+         {
+            *pClass = Class;
+            *pIndex = Index;
+         }
+      }
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_RunOne                                                    */
+/*                                                                            */
+/*!\brief  Issues the most urgent watchdog or control request                */
+/*                                                                            */
+/*!\param   uint32_t        ASYNC_PRIO_ENUM_TYPE of the queue, not empty     */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    A read queued in these classes is served on its own. A write     */
+/*!\note    waits for any write to the same offset submitted before it        */
+/*                                                                            */
+/******************************************************************************/
+static void ASYNC_RunOne( uint32_t Class )
+{
+   uint32_t                 Index = ASYNC_Earliest( Class );
+   uint16_t                 Slot;
+   P_ASYNC_REQUEST_STRUCT   pRequest;
+   uint64_t                 NowUs = EC_GetMicroSecs();
+
+   if ( AsyncPool[ AsyncReady[ Class ][ Index ] ].Completion.Op == ASYNC_OP_WRITE )
+   {
+      ASYNC_OldestWrite( AsyncPool[ AsyncReady[ Class ][ Index ] ].Completion.Offset, &Class, &Index );
+   }
+
+   Slot = AsyncReady[ Class ][ Index ];
+   pRequest = &AsyncPool[ Slot ];
+
+   ASYNC_Unqueue( Class, Index, 1 );
+
+   if ( ! ASYNC_Abandoned( pRequest, NowUs ) )
+   {
+      ASYNC_RecordStart( pRequest, NowUs );
+
+      switch ( pRequest->Completion.Op )
+      {
+         case ASYNC_OP_WRITE:
+            pRequest->Completion.Status = EC_WriteByteUsingACPI( pRequest->Completion.Offset, pRequest->Value );
+            AsyncWorkerStats.Bursts++;
+            break;
+
+         case ASYNC_OP_PET_WDT:
+            pRequest->Completion.Status = WDT_PetTimer( pRequest->Value, pRequest->Value2 );
+            AsyncWorkerStats.Bursts += 2;
+            break;
+
+         default:
+            pRequest->Completion.Status = EC_ReadBlockUsingACPI( pRequest->Completion.Offset, pRequest->Completion.Count, pRequest->Completion.Data );
+            AsyncWorkerStats.Bursts++;
+            break;
+      }
+   }
+
+   ASYNC_PostCompletions( &Slot, 1 );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_RunTelemetry                                              */
+/*                                                                            */
+/*!\brief  Issues one burst serving the most urgent telemetry read and every */
+/*         queued telemetry read near it                                      */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Telemetry holds only reads, so reordering it by offset is safe.   */
+/*!\note    Reads of the same offset still complete in submission order       */
+/*                                                                            */
+/******************************************************************************/
+static void ASYNC_RunTelemetry( void )
+{
+   uint16_t    *pQueue = AsyncReady[ ASYNC_PRIO_TELEMETRY ];
+   uint16_t    Done[ ASYNC_QUEUE_DEPTH ];
+   uint8_t     Sram[ 256 ];
+   uint64_t    NowUs = EC_GetMicroSecs();
+   uint32_t    DoneCount = 0,
+               Index,
+               Anchor,
+               Lo,
+               Hi,
+               Start,
+               End;
+
+   //
+   // abandoned requests already hold their completion status - complete them without a burst
+   //
+
+   for ( Index = 0; Index < AsyncReadyCount[ ASYNC_PRIO_TELEMETRY ]; )
+   {
+      if ( ASYNC_Abandoned( &AsyncPool[ pQueue[ Index ] ], NowUs ) )
+          {
+             Done[ DoneCount++ ] = pQueue[ Index ];
+             ASYNC_Unqueue( ASYNC_PRIO_TELEMETRY, Index, 1 );
+          }
+      else
+          {
+             Index++;
+          }
+   }
+
+   if ( AsyncReadyCount[ ASYNC_PRIO_TELEMETRY ] > 0 )
+   {
+      //
+      // insertion sort by offset and then submission order, then grow a burst outwards from the most urgent read
+      // while its neighbours are close enough and the burst stays short
+      //
+
+      for ( Index = 1; Index < AsyncReadyCount[ ASYNC_PRIO_TELEMETRY ]; Index++ )
+      {
+         uint16_t   Slot = pQueue[ Index ];
+         uint32_t   Scan = Index;
+
+         while ( ( Scan > 0 ) &&
+                 ( ( AsyncPool[ pQueue[ Scan - 1 ] ].Completion.Offset > AsyncPool[ Slot ].Completion.Offset ) ||
+                   ( ( AsyncPool[ pQueue[ Scan - 1 ] ].Completion.Offset == AsyncPool[ Slot ].Completion.Offset ) &&
+                     ( ASYNC_SubmittedBefore( &AsyncPool[ Slot ], &AsyncPool[ pQueue[ Scan - 1 ] ] ) ) ) ) )
+         {
+            pQueue[ Scan ] = pQueue[ Scan - 1 ];
+            Scan--;
+         }
+
+         pQueue[ Scan ] = Slot;
+      }
+
+      Anchor = ASYNC_Earliest( ASYNC_PRIO_TELEMETRY );
+      Lo = Anchor;
+      Hi = Anchor + 1;
+      Start = AsyncPool[ pQueue[ Anchor ] ].Completion.Offset;
+      End = Start + AsyncPool[ pQueue[ Anchor ] ].Completion.Count;
+
+      while ( Hi < AsyncReadyCount[ ASYNC_PRIO_TELEMETRY ] )
+      {
+         P_ASYNC_COMPLETION_STRUCT   pNext = &AsyncPool[ pQueue[ Hi ] ].Completion;
+         uint32_t                    NextEnd = ( uint32_t ) pNext->Offset + pNext->Count;
+
+         if ( ( pNext->Offset > End + ASYNC_BLOCK_MERGE_GAP ) || ( ( ( NextEnd > End ) ? NextEnd : End ) - Start > ASYNC_TELEMETRY_MAX_BURST ) )
+         {
+            break;
+         }
+
+         End = ( NextEnd > End ) ? NextEnd : End;
+         Hi++;
+      }
+
+      while ( Lo > 0 )
+      {
+         P_ASYNC_COMPLETION_STRUCT   pPrev = &AsyncPool[ pQueue[ Lo - 1 ] ].Completion;
+         uint32_t                    PrevEnd = ( uint32_t ) pPrev->Offset + pPrev->Count;
+
+         if ( ( PrevEnd + ASYNC_BLOCK_MERGE_GAP < Start ) || ( ( ( PrevEnd > End ) ? PrevEnd : End ) - pPrev->Offset > ASYNC_TELEMETRY_MAX_BURST ) )
+         {
+            break;
+         }
+
+         Start = pPrev->Offset;
+         End = ( PrevEnd > End ) ? PrevEnd : End;
+         Lo--;
+      }
+
+      {
+         WINSYS_ERROR   Results;
+
+         for ( Index = Lo; Index < Hi; Index++ )
+         {
+            ASYNC_RecordStart( &AsyncPool[ pQueue[ Index ] ], NowUs );
+         }
+
+         Results = EC_ReadBlockUsingACPI( ( uint8_t ) Start, ( uint8_t )( End - Start ), &Sram[ Start ] );
+         AsyncWorkerStats.Bursts++;
+         AsyncWorkerStats.ReadsMerged += ( Hi - Lo ) - 1;
+
+         for ( Index = Lo; Index < Hi; Index++ )
+         {
+            P_ASYNC_COMPLETION_STRUCT   pCompletion = &AsyncPool[ pQueue[ Index ] ].Completion;
+
+            pCompletion->Status = Results;
+            if ( Results == STATUS_SUCCESS )
+            {
+               memcpy( pCompletion->Data, &Sram[ pCompletion->Offset ], pCompletion->Count );
+            }
+
+            Done[ DoneCount++ ] = pQueue[ Index ];
+         }
+
+         ASYNC_Unqueue( ASYNC_PRIO_TELEMETRY, Lo, Hi - Lo );
+      }
+   }
+
+   ASYNC_PostCompletions( Done, DoneCount );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_TakeSubmissions                                           */
+/*                                                                            */
+/*!\brief  Moves every submitted request to the queue of its class           */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  uint32_t        number of requests queued, in all classes         */
+/*                                                                            */
+/*!\note    The class queues belong to the I/O worker, or to ASYNC_Stop()     */
+/*!\note    once the worker has exited                                        */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t ASYNC_TakeSubmissions( void )
+{
+   uint16_t   Slot;
+
+   AcquireSRWLockExclusive( &AsyncLock );
+
+   Slot = AsyncSubmitHead;
+   AsyncSubmitHead = AsyncSubmitTail = ASYNC_NO_SLOT;
+
+   ReleaseSRWLockExclusive( &AsyncLock );
+
+   while ( Slot != ASYNC_NO_SLOT )
+   {
+      uint32_t   Class = AsyncPool[ Slot ].Priority;
+
+      AsyncReady[ Class ][ AsyncReadyCount[ Class ]++ ] = Slot;
+      Slot = AsyncPool[ Slot ].Next;
+   }
+
+   return AsyncReadyCount[ ASYNC_PRIO_WATCHDOG ] + AsyncReadyCount[ ASYNC_PRIO_CONTROL ] + AsyncReadyCount[ ASYNC_PRIO_TELEMETRY ];
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_Thread                                                    */
+/*                                                                            */
+/*!\brief  The I/O worker - the only thread that talks to the EC for the     */
+/*         asynchronous interface                                             */
+/*                                                                            */
+/*!\param   LPVOID          unused                                            */
+/*!\return  DWORD           thread exit code                                  */
+/*                                                                            */
+/*!\note    Each pass issues one transaction from the most urgent non empty  */
+/*!\note    class, then looks at the submissions again                        */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI ASYNC_Thread( LPVOID pParam )
+{
+   HANDLE     Handles[ 2 ] = { AsyncStopEvent, AsyncSubmitEvent };
+   uint32_t   Queued = 0;
+
+   UNREFERENCED_PARAMETER( pParam );
+
+   while ( WaitForMultipleObjects( 2, Handles, FALSE, ( Queued ) ? 0 : INFINITE ) != WAIT_OBJECT_0 )
+   {
+      if ( ( Queued = ASYNC_TakeSubmissions() ) > 0 )
+      {
+         AsyncWorkerStats.Batches++;
+
+         if ( AsyncReadyCount[ ASYNC_PRIO_WATCHDOG ] )
+             {
+                ASYNC_RunOne( ASYNC_PRIO_WATCHDOG );
+             }
+         else if ( AsyncReadyCount[ ASYNC_PRIO_CONTROL ] )
+             {
+                ASYNC_RunOne( ASYNC_PRIO_CONTROL );
+             }
+         else
+             {
+                ASYNC_RunTelemetry();
+             }
+
+         Queued = AsyncReadyCount[ ASYNC_PRIO_WATCHDOG ] + AsyncReadyCount[ ASYNC_PRIO_CONTROL ] + AsyncReadyCount[ ASYNC_PRIO_TELEMETRY ];
+      }
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_Submit                                                    */
+/*                                                                            */
+/*!\brief  Takes a slot from the pool, fills it in and queues it             */
+/*                                                                            */
+/*!\param   uint8_t         ASYNC_OP_ENUM_TYPE of the request                 */
+/*!\param   uint8_t         EC offset                                         */
+/*!\param   uint8_t         byte count for reads                              */
+/*!\param   uint8_t         byte to write, or WDT minutes                     */
+/*!\param   uint8_t         WDT seconds                                       */
+/*!\param   uint8_t         ASYNC_PRIO_ENUM_TYPE class, or ASYNC_PRIO_DEFAULT */
+/*!\param   uint32_t        usecs the request may wait to start, 0 = forever  */
+/*!\param   uint64_t        caller's tag, returned in the completion          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR ASYNC_Submit( uint8_t Op, uint8_t Offset, uint8_t Count, uint8_t Value, uint8_t Value2, uint8_t Priority, uint32_t TimeoutUs, uint64_t UserTag )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   uint16_t       Slot;
+
+   if ( Priority == ASYNC_PRIO_DEFAULT )
+       {
+          Priority = ( Op == ASYNC_OP_PET_WDT ) ? ASYNC_PRIO_WATCHDOG : ( Op == ASYNC_OP_WRITE ) ? ASYNC_PRIO_CONTROL : ASYNC_PRIO_TELEMETRY;
+       }
+   else if ( Priority >= ASYNC_PRIO_COUNT )
+       {
+          return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ENUMERATION_OUT_OF_RANGE );
+       }
+   else if ( ( Priority == ASYNC_PRIO_TELEMETRY ) && ( ( Op == ASYNC_OP_WRITE ) || ( Op == ASYNC_OP_PET_WDT ) ) )
+       {
+          return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );   // telemetry is read only
+       }
+
+   AcquireSRWLockExclusive( &AsyncLock );
+
+   if ( AsyncRunning )
+       {
+          if ( ( Slot = AsyncFreeHead ) != ASYNC_NO_SLOT )
+              {
+                 P_ASYNC_REQUEST_STRUCT   pRequest = &AsyncPool[ Slot ];
+
+                 AsyncFreeHead = pRequest->Next;
+
+                 pRequest->Completion.UserTag = UserTag;
+                 pRequest->Completion.Status = STATUS_SUCCESS;
+                 pRequest->Completion.Op = Op;
+                 pRequest->Completion.Offset = Offset;
+                 pRequest->Completion.Count = Count;
+                 pRequest->Value = Value;
+                 pRequest->Value2 = Value2;
+                 pRequest->Next = ASYNC_NO_SLOT;
+                 pRequest->State = ASYNC_SLOT_QUEUED;
+                 pRequest->Priority = Priority;
+                 pRequest->Cancelled = 0;
+                 pRequest->SubmitUs = EC_GetMicroSecs();
+                 pRequest->DeadlineUs = ( TimeoutUs ) ? ( pRequest->SubmitUs + TimeoutUs ) : 0;
+                 pRequest->ScheduleUs = ( TimeoutUs ) ? pRequest->DeadlineUs : ( pRequest->SubmitUs + AsyncBudgetUs[ Priority ] );
+                 pRequest->Sequence = AsyncSequence++;
+
+                 if ( AsyncSubmitTail == ASYNC_NO_SLOT )
+                     {
+                        AsyncSubmitHead = Slot;
+                     }
+                 else
+                     {
+                        AsyncPool[ AsyncSubmitTail ].Next = Slot;
+                     }
+
+                 AsyncSubmitTail = Slot;
+                 AsyncStats.Submitted++;
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_QUEUE_FULL );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockExclusive( &AsyncLock );
+
+   if ( Results == STATUS_SUCCESS )
+   {
+      SetEvent( AsyncSubmitEvent );
+   }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_Start                                                     */
+/*                                                                            */
+/*!\brief  Builds the request pool and starts the I/O worker                  */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_Start( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( AsyncThread == NULL )
+       {
+          uint16_t   Slot;
+
+          for ( Slot = 0; Slot < ASYNC_QUEUE_DEPTH; Slot++ )
+          {
+             AsyncPool[ Slot ].Next = ( Slot + 1 < ASYNC_QUEUE_DEPTH ) ? ( uint16_t )( Slot + 1 ) : ASYNC_NO_SLOT;
+             AsyncPool[ Slot ].State = ASYNC_SLOT_FREE;
+          }
+
+          AsyncFreeHead = 0;
+          AsyncSubmitHead = AsyncSubmitTail = ASYNC_NO_SLOT;
+          memset( AsyncReadyCount, 0, sizeof( AsyncReadyCount ) );
+          AsyncCompletedHead = AsyncCompletedTail = 0;
+
+          if ( AsyncCompletionEvent == NULL )
+          {
+             AsyncCompletionEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
+          }
+
+          AsyncSubmitEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+          AsyncStopEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
+
+          if ( ( AsyncCompletionEvent ) && ( AsyncSubmitEvent ) && ( AsyncStopEvent ) )
+          {
+             ResetEvent( AsyncCompletionEvent );
+             AsyncThread = CreateThread( NULL, 0, ASYNC_Thread, NULL, 0, NULL );
+          }
+
+          if ( AsyncThread != NULL )
+              {
+                 AcquireSRWLockExclusive( &AsyncLock );
+                 AsyncRunning = 1;
+                 ReleaseSRWLockExclusive( &AsyncLock );
+              }
+          else
+              {
+                 if ( AsyncSubmitEvent )
+                 {
+                    CloseHandle( AsyncSubmitEvent );
+                    AsyncSubmitEvent = NULL;
+                 }
+
+                 if ( AsyncStopEvent )
+                 {
+                    CloseHandle( AsyncStopEvent );
+                    AsyncStopEvent = NULL;
+                 }
+
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ALREADY_RUNNING );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_Stop                                                      */
+/*                                                                            */
+/*!\brief  Stops the I/O worker                                              */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Requests the worker had not taken are completed with              */
+/*!\note    STATUS_CANCELLED, so every submission gets a completion           */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_Stop( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( AsyncThread != NULL )
+       {
+          uint32_t   Class,
+                     Index;
+
+          AcquireSRWLockExclusive( &AsyncLock );
+          AsyncRunning = 0;                                  // no submissions are accepted past this point
+          ReleaseSRWLockExclusive( &AsyncLock );
+
+          SetEvent( AsyncStopEvent );
+          WaitForSingleObject( AsyncThread, INFINITE );
+
+          ASYNC_TakeSubmissions();
+          for ( Class = ASYNC_PRIO_WATCHDOG; Class < ASYNC_PRIO_COUNT; Class++ )
+          {
+             for ( Index = 0; Index < AsyncReadyCount[ Class ]; Index++ )
+             {
+                AsyncPool[ AsyncReady[ Class ][ Index ] ].Completion.Status = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_CANCELLED );
+             }
+             ASYNC_PostCompletions( AsyncReady[ Class ], AsyncReadyCount[ Class ] );
+             AsyncReadyCount[ Class ] = 0;
+          }
+
+          CloseHandle( AsyncThread );
+          CloseHandle( AsyncSubmitEvent );
+          CloseHandle( AsyncStopEvent );
+          AsyncThread = NULL;
+          AsyncSubmitEvent = NULL;
+          AsyncStopEvent = NULL;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_SubmitRead                                                */
+/*                                                                            */
+/*!\brief  Queues a one byte read                                            */
+/*                                                                            */
+/*!\param   uint8_t         offset in EC memory space to read                 */
+/*!\param   uint64_t        caller's tag, returned in the completion          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_SubmitRead( uint8_t Offset, uint64_t UserTag )
+{
+   return ASYNC_Submit( ASYNC_OP_READ, Offset, 1, 0, 0, ASYNC_PRIO_DEFAULT, 0, UserTag );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_SubmitWrite                                               */
+/*                                                                            */
+/*!\brief  Queues a one byte write                                           */
+/*                                                                            */
+/*!\param   uint8_t         offset in EC memory space to write                */
+/*!\param   uint8_t         value to write                                   */
+/*!\param   uint64_t        caller's tag, returned in the completion          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_SubmitWrite( uint8_t Offset, uint8_t Value, uint64_t UserTag )
+{
+   return ASYNC_Submit( ASYNC_OP_WRITE, Offset, 0, Value, 0, ASYNC_PRIO_DEFAULT, 0, UserTag );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_SubmitReadBlock                                           */
+/*                                                                            */
+/*!\brief  Queues a read of consecutive bytes                                */
+/*                                                                            */
+/*!\param   uint8_t         offset of the first byte                          */
+/*!\param   uint8_t         number of bytes, 1 to ASYNC_MAX_BLOCK             */
+/*!\param   uint64_t        caller's tag, returned in the completion          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_SubmitReadBlock( uint8_t Offset, uint8_t Count, uint64_t UserTag )
+{
+   if ( ( Count == 0 ) || ( Count > ASYNC_MAX_BLOCK ) || ( ( ( uint32_t ) Offset + Count ) > 256 ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   return ASYNC_Submit( ASYNC_OP_READ_BLOCK, Offset, Count, 0, 0, ASYNC_PRIO_DEFAULT, 0, UserTag );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_SubmitPet                                                 */
+/*                                                                            */
+/*!\brief  Queues a WDT pet                                                  */
+/*                                                                            */
+/*!\param   uint8_t         minutes to reload                                 */
+/*!\param   uint8_t         seconds to reload                                 */
+/*!\param   uint64_t        caller's tag, returned in the completion          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_SubmitPet( uint8_t Mins, uint8_t Secs, uint64_t UserTag )
+{
+   return ASYNC_Submit( ASYNC_OP_PET_WDT, WDT_MINUTES_COUNTER_OFFSET, 0, Mins, Secs, ASYNC_PRIO_DEFAULT, 0, UserTag );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_SubmitEx                                                  */
+/*                                                                            */
+/*!\brief  Queues a request with every option, including a timeout          */
+/*                                                                            */
+/*!\param   P_ASYNC_SUBMIT_STRUCT   the request to queue                      */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_SubmitEx( P_ASYNC_SUBMIT_STRUCT pSubmit )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pSubmit )
+       {
+          switch ( pSubmit->Op )
+          {
+             case ASYNC_OP_READ:
+                Results = ASYNC_Submit( ASYNC_OP_READ, pSubmit->Offset, 1, 0, 0, pSubmit->Priority, pSubmit->TimeoutUs, pSubmit->UserTag );
+                break;
+
+             case ASYNC_OP_WRITE:
+                Results = ASYNC_Submit( ASYNC_OP_WRITE, pSubmit->Offset, 0, pSubmit->Value, 0, pSubmit->Priority, pSubmit->TimeoutUs, pSubmit->UserTag );
+                break;
+
+             case ASYNC_OP_READ_BLOCK:
+                if ( ( pSubmit->Count == 0 ) || ( pSubmit->Count > ASYNC_MAX_BLOCK ) || ( ( ( uint32_t ) pSubmit->Offset + pSubmit->Count ) > 256 ) )
+                    {
+                       Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+                    }
+                else
+                    {
+                       Results = ASYNC_Submit( ASYNC_OP_READ_BLOCK, pSubmit->Offset, pSubmit->Count, 0, 0, pSubmit->Priority, pSubmit->TimeoutUs, pSubmit->UserTag );
+                    }
+                break;
+
+             case ASYNC_OP_PET_WDT:
+                Results = ASYNC_Submit( ASYNC_OP_PET_WDT, WDT_MINUTES_COUNTER_OFFSET, 0, pSubmit->Value, pSubmit->Value2, pSubmit->Priority, pSubmit->TimeoutUs, pSubmit->UserTag );
+                break;
+
+             default:
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ENUMERATION_OUT_OF_RANGE );
+                break;
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_Cancel                                                    */
+/*                                                                            */
+/*!\brief  Cancels every queued request carrying the given tag               */
+/*                                                                            */
+/*!\param   uint64_t        tag given when the requests were submitted        */
+/*!\return  WINSYS_ERROR    STATUS_NOT_FOUND if no such request is queued     */
+/*                                                                            */
+/*!\note    Best effort - a request the worker has already started runs to    */
+/*!\note    completion. The completion status tells which happened.           */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_Cancel( uint64_t UserTag )
+{
+   WINSYS_ERROR   Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+   uint32_t       Slot;
+
+   AcquireSRWLockShared( &AsyncLock );
+
+   for ( Slot = 0; Slot < ASYNC_QUEUE_DEPTH; Slot++ )
+   {
+      if ( ( AsyncPool[ Slot ].State == ASYNC_SLOT_QUEUED ) && ( AsyncPool[ Slot ].Completion.UserTag == UserTag ) )
+      {
+         InterlockedExchange( &AsyncPool[ Slot ].Cancelled, 1 );
+         Results = STATUS_SUCCESS;
+      }
+   }
+
+   ReleaseSRWLockShared( &AsyncLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_GetCompletionHandle                                       */
+/*                                                                            */
+/*!\brief  Returns a waitable handle that is signalled while completions are  */
+/*         waiting to be reaped                                               */
+/*                                                                            */
+/*!\param   HANDLE *        pointer to return the event handle in             */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Owned by the library, do not close                                */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_GetCompletionHandle( HANDLE *pHandle )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pHandle )
+       {
+          if ( ( *pHandle = AsyncCompletionEvent ) == NULL )
+          {
+             Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_ReapCompletions                                           */
+/*                                                                            */
+/*!\brief  Copies out finished requests and returns their slots to the pool  */
+/*                                                                            */
+/*!\param   P_ASYNC_COMPLETION_STRUCT   buffer to return completions in       */
+/*!\param   uint32_t                    size of the buffer                    */
+/*!\param   puint32_t                   returns the number of completions     */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Never blocks                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_ReapCompletions( P_ASYNC_COMPLETION_STRUCT pCompletions, uint32_t MaxCompletions, puint32_t pCount )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( pCompletions ) && ( pCount ) )
+       {
+          uint32_t   Count = 0;
+
+          AcquireSRWLockExclusive( &AsyncLock );
+
+          while ( ( AsyncCompletedTail != AsyncCompletedHead ) && ( Count < MaxCompletions ) )
+          {
+             uint16_t   Slot = AsyncCompleted[ AsyncCompletedTail++ & ( ASYNC_QUEUE_DEPTH - 1 ) ];
+
+             pCompletions[ Count++ ] = AsyncPool[ Slot ].Completion;
+
+             AsyncPool[ Slot ].State = ASYNC_SLOT_FREE;
+             AsyncPool[ Slot ].Next = AsyncFreeHead;
+             AsyncFreeHead = Slot;
+          }
+
+          if ( ( AsyncCompletedTail == AsyncCompletedHead ) && ( AsyncCompletionEvent ) )
+          {
+             ResetEvent( AsyncCompletionEvent );
+          }
+
+          ReleaseSRWLockExclusive( &AsyncLock );
+
+          *pCount = Count;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: ASYNC_GetStats                                                  */
+/*                                                                            */
+/*!\brief  Returns the I/O worker's counters                                  */
+/*                                                                            */
+/*!\param   P_ASYNC_STATS_STRUCT  pointer to structure to return counters in  */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR ASYNC_GetStats( P_ASYNC_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStats )
+       {
+          AcquireSRWLockShared( &AsyncLock );
+          *pStats = AsyncStats;
+          ReleaseSRWLockShared( &AsyncLock );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
@@ -0,0 +1,399 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Broadcast.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the broadcast ring, which hands every sample to any
+//      number of subscribers, each reading from its own cursor. The one writer
+//      never locks, waits or looks at the subscribers.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Broadcast.h>
+#include "ITE8528_EC_Internal.h"
+
+
+//
+// Sample n goes in slot n % BRD_RING_SIZE. The writer marks the slot 2n+1 while it copies the sample in and 2n+2
+// once it is whole, so a reader wanting sample n reads the mark, copies the sample and reads the mark again: 2n+2
+// both times means it has sample n, anything else means the writer has lapped it. Slots and subscribers each get
+// their own cache lines, so readers only ever share lines with the writer, never with each other.
+//
+
+#define BRD_CACHE_LINE                      64
+
+/*!\struct _BRD_SLOT_STRUCT
+ * \brief  One sample in the broadcast ring
+ */
+typedef struct __declspec( align( BRD_CACHE_LINE ) ) _BRD_SLOT_STRUCT {
+                                    volatile LONG64     Mark;          // 2n+1 while sample n is written, 2n+2 once it is
+                                    EC_SAMPLE_STRUCT    Sample;
+
+                                 } BRD_SLOT_STRUCT, *P_BRD_SLOT_STRUCT;
+
+/*!\struct _BRD_SUBSCRIBER_STRUCT
+ * \brief  A subscription slot, only read and written by its reader
+ */
+typedef struct __declspec( align( BRD_CACHE_LINE ) ) _BRD_SUBSCRIBER_STRUCT {
+                                    volatile LONG       InUse;
+                                    uint64_t            Cursor;        // next sample to read
+                                    uint64_t            Missed;
+
+                                 } BRD_SUBSCRIBER_STRUCT, *P_BRD_SUBSCRIBER_STRUCT;
+
+static BRD_SLOT_STRUCT           BrdRing[ BRD_RING_SIZE ];
+static BRD_SUBSCRIBER_STRUCT     BrdSubscribers[ BRD_MAX_SUBSCRIBERS ];
+
+static __declspec( align( BRD_CACHE_LINE ) ) volatile LONG64   BrdHead = 0;     // samples published
+static __declspec( align( BRD_CACHE_LINE ) ) volatile LONG     BrdWaiters = 0;  // readers inside BRD_Wait
+static volatile LONG64           BrdMissed = 0;
+static volatile LONG             BrdSubscriberCount = 0;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: BRD_Subscribe                                                   */
+/*                                                                            */
+/*!\brief  Adds a subscriber, starting with the next sample published         */
+/*                                                                            */
+/*!\param   puint32_t       returns a handle for the other BRD_ functions     */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Takes a free slot without locking, so never delays the writer     */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR BRD_Subscribe( puint32_t pHandle )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   uint32_t       Index;
+
+   if ( pHandle )
+       {
+          for ( Index = 0; ( Index < BRD_MAX_SUBSCRIBERS ) &&
+                           ( InterlockedCompareExchange( &BrdSubscribers[ Index ].InUse, 1, 0 ) != 0 ); Index++ )
+          {
+          }
+
+          if ( Index < BRD_MAX_SUBSCRIBERS )
+              {
+                 BrdSubscribers[ Index ].Cursor = ( uint64_t ) BrdHead;
+                 BrdSubscribers[ Index ].Missed = 0;
+                 InterlockedIncrement( &BrdSubscriberCount );
+                 *pHandle = Index;
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: BRD_Unsubscribe                                                 */
+/*                                                                            */
+/*!\brief  Removes a subscriber                                               */
+/*                                                                            */
+/*!\param   uint32_t        handle returned by BRD_Subscribe                  */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Must not race a BRD_Read or BRD_Wait on the same handle           */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR BRD_Unsubscribe( uint32_t Handle )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( Handle < BRD_MAX_SUBSCRIBERS )
+       {
+          if ( InterlockedCompareExchange( &BrdSubscribers[ Handle ].InUse, 0, 1 ) == 1 )
+              {
+                 InterlockedDecrement( &BrdSubscriberCount );
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_INDEX_OUT_OF_RANGE );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: BRD_Read                                                        */
+/*                                                                            */
+/*!\brief  Copies out the samples published since the subscriber last read,  */
+/*         oldest first, without blocking                                     */
+/*                                                                            */
+/*!\param   uint32_t             handle returned by BRD_Subscribe             */
+/*!\param   P_EC_SAMPLE_STRUCT   array receiving the samples                  */
+/*!\param   uint32_t             number of entries in the array               */
+/*!\param   puint32_t            returns the number of samples copied         */
+/*!\param   puint32_t            optional, returns the number of samples      */
+/*!\param                        overwritten before this subscriber read them */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Never waits for or delays the writer. A subscriber lapped by the  */
+/*!\note    writer skips to the oldest sample still in the ring.              */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR BRD_Read( uint32_t Handle, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount, puint32_t pMissed )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( pSamples ) && ( pCount ) )
+       {
+          if ( ( Handle < BRD_MAX_SUBSCRIBERS ) && ( BrdSubscribers[ Handle ].InUse ) )
+              {
+                 P_BRD_SUBSCRIBER_STRUCT   pSubscriber = &BrdSubscribers[ Handle ];
+                 P_BRD_SLOT_STRUCT         pSlot;
+                 uint64_t                  Head = ( uint64_t ) BrdHead,
+                                           Cursor = pSubscriber->Cursor,
+                                           Missed = 0;
+                 LONG64                    Mark;
+                 uint32_t                  Count = 0;
+
+                 MemoryBarrier();
+
+                 while ( ( Count < MaxSamples ) && ( Cursor < Head ) )
+                 {
+                    if ( Head - Cursor > BRD_RING_SIZE )
+                    {
+                       Missed += Head - BRD_RING_SIZE - Cursor;
+                       Cursor = Head - BRD_RING_SIZE;
+                    }
+
+                    pSlot = &BrdRing[ Cursor & ( BRD_RING_SIZE - 1 ) ];
+                    Mark = pSlot->Mark;
+                    MemoryBarrier();
+
+                    pSamples[ Count ] = pSlot->Sample;
+
+                    MemoryBarrier();
+
+                    if ( ( Mark == ( LONG64 )( 2 * Cursor + 2 ) ) && ( pSlot->Mark == Mark ) )
+                        {
+                           Count++;
+                           Cursor++;
+                        }
+                    else
+                        {
+                           //
+                           // lapped while copying - whatever the writer has overwritten since is gone too
+                           //
+
+                           Head = ( uint64_t ) BrdHead;
+                           MemoryBarrier();
+
+                           if ( Head - Cursor <= BRD_RING_SIZE )
+                           {
+                              Missed++;
+                              Cursor++;
+                           }
+                        }
+                 }
+
+                 pSubscriber->Cursor = Cursor;
+
+                 if ( Missed )
+                 {
+                    pSubscriber->Missed += Missed;
+                    InterlockedAdd64( &BrdMissed, ( LONG64 ) Missed );
+                 }
+
+                 *pCount = Count;
+
+                 if ( pMissed )
+                 {
+                    *pMissed = ( uint32_t ) Missed;
+                 }
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: BRD_Wait                                                        */
+/*                                                                            */
+/*!\brief  Waits until a sample the subscriber has not read is published     */
+/*                                                                            */
+/*!\param   uint32_t        handle returned by BRD_Subscribe                  */
+/*!\param   uint32_t        msecs to wait, or INFINITE                        */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Returns STATUS_TIMEOUT if nothing is published in time. The       */
+/*!\note    writer only pays for a wake up while someone is waiting.          */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR BRD_Wait( uint32_t Handle, uint32_t TimeoutMs )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( Handle < BRD_MAX_SUBSCRIBERS ) && ( BrdSubscribers[ Handle ].InUse ) )
+       {
+          LONG64     Cursor = ( LONG64 ) BrdSubscribers[ Handle ].Cursor;
+          uint64_t   Deadline = EC_GetMicroSecs() + ( uint64_t ) TimeoutMs * 1000,
+                     Now;
+          DWORD      WaitMs = TimeoutMs;
+
+          InterlockedIncrement( &BrdWaiters );
+
+          while ( BrdHead == Cursor )
+          {
+             if ( TimeoutMs != INFINITE )
+             {
+                if ( ( Now = EC_GetMicroSecs() ) >= Deadline )
+                {
+                   Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_TIMEOUT );
+                   break;
+                }
+
+                WaitMs = ( DWORD )( ( Deadline - Now + 999 ) / 1000 );
+             }
+
+             WaitOnAddress( &BrdHead, &Cursor, sizeof( Cursor ), WaitMs );
+          }
+
+          InterlockedDecrement( &BrdWaiters );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: BRD_Publish                                                     */
+/*                                                                            */
+/*!\brief  Adds a sample to the broadcast ring                               */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample to publish                         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Single writer: called by the sampler thread, or by the            */
+/*!\note    application only while the sampler is stopped. Touches no         */
+/*!\note    subscriber state, so costs the same however many there are.       */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR BRD_Publish( P_EC_SAMPLE_STRUCT pSample )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pSample )
+       {
+          uint64_t            Sequence = ( uint64_t ) BrdHead;
+          P_BRD_SLOT_STRUCT   pSlot = &BrdRing[ Sequence & ( BRD_RING_SIZE - 1 ) ];
+
+          pSlot->Mark = ( LONG64 )( 2 * Sequence + 1 );
+          MemoryBarrier();
+
+          pSlot->Sample = *pSample;
+
+          MemoryBarrier();
+          pSlot->Mark = ( LONG64 )( 2 * Sequence + 2 );
+          BrdHead = ( LONG64 )( Sequence + 1 );
+
+          //
+          // pairs with the increment in BRD_Wait, so either the waiter sees the new head or we see the waiter
+          //
+
+          MemoryBarrier();
+
+          if ( BrdWaiters )
+          {
+             WakeByAddressAll( ( PVOID ) &BrdHead );
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: BRD_GetStats                                                    */
+/*                                                                            */
+/*!\brief  Returns the broadcast ring's counters                              */
+/*                                                                            */
+/*!\param   P_BRD_STATS_STRUCT  pointer to the counters to fill in           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR BRD_GetStats( P_BRD_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStats )
+       {
+          pStats->Published = ( uint64_t ) BrdHead;
+          pStats->Missed = ( uint64_t ) BrdMissed;
+          pStats->Subscribers = ( uint32_t ) BrdSubscriberCount;
+          pStats->Reserved = 0;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
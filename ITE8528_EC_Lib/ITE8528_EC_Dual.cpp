@@ -0,0 +1,778 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Dual.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains dual path acquisition - sweeps split between
+//      ACPI bursts on the calling thread and IO space reads on a helper
+//      thread - and the self-test that decides whether the board allows it.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Dual.h>
+#include "ITE8528_EC_Internal.h"
+
+
+#define DUAL_PROBE_COUNT            2
+#define DUAL_MAX_RANGES             ( SENSOR_COUNT + DUAL_PROBE_COUNT )
+#define DUAL_CALIBRATE_BYTES        16
+
+//
+// registers that only change when written, so both paths must read them the same
+//
+
+static const EC_READ_RANGE_STRUCT   DualProbes[ DUAL_PROBE_COUNT ] = { { WDT_CONFIG_OFFSET, 1 },
+                                                                      { SMART_FAN_CFG_OFFSET, sizeof( FAN_SMART_CONFIG_STRUCT ) } };
+
+/*!\struct _DUAL_JOB_STRUCT
+ * \brief  The helper thread's share of a sweep
+ */
+typedef struct _DUAL_JOB_STRUCT {
+                                   const EC_READ_RANGE_STRUCT *   pRanges;
+                                   uint32_t                       Count;
+                                   uint32_t                       Mask;       // bit n set = read pRanges[ n ]
+                                   puint8_t                       pSram;      // indexed by offset
+                                   uint32_t                       Tears;
+                                   uint32_t                       Bytes;
+                                   uint32_t                       Failed;     // bit n set = pRanges[ n ] was not read
+
+                                } DUAL_JOB_STRUCT, *P_DUAL_JOB_STRUCT;
+
+static SRWLOCK               DualLock = SRWLOCK_INIT;                 // one split sweep at a time, and guards
+                                                                      // everything below
+static volatile uint32_t     DualMode = DUAL_MODE_SINGLE;
+static DUAL_STATS_STRUCT     DualStats;
+static uint32_t              DualFailures = 0;                        // failed split sweeps in a row
+
+static double                DualAcpiBurstUs = 30.0;                  // the cost model, until calibrated
+static double                DualAcpiByteUs = 6.0;
+static double                DualIoByteUs = 2.0;
+static double                DualHandoffUs = 20.0;
+
+static HANDLE                DualThread = NULL;
+static HANDLE                DualStopEvent = NULL;
+static HANDLE                DualWorkEvent = NULL;
+static HANDLE                DualDoneEvent = NULL;
+static DUAL_JOB_STRUCT       DualJob;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_ReadIo                                                     */
+/*                                                                            */
+/*!\brief  Reads a range through the IO space window until two reads agree  */
+/*                                                                            */
+/*!\param   uint8_t         offset of the first byte                          */
+/*!\param   uint8_t         number of bytes                                   */
+/*!\param   puint8_t        where to store them                               */
+/*!\param   puint32_t       incremented if the range had to be reread         */
+/*!\return  WINSYS_ERROR    STATUS_TIMEOUT if no two reads agreed             */
+/*                                                                            */
+/*!\note    Gives up after DUAL_IO_READS reads. On failure pDest may hold a   */
+/*!\note    torn range and must be read again some other way.                 */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR DUAL_ReadIo( uint8_t Offset, uint8_t Count, puint8_t pDest, puint32_t pTears )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   uint8_t        Again[ 256 ];
+   uint32_t       Reads,
+                  Index;
+
+   for ( Index = 0; ( Index < Count ) && ( Results == STATUS_SUCCESS ); Index++ )
+   {
+      Results = EC_ReadByteUsingIOSpace( ( uint8_t )( Offset + Index ), &pDest[ Index ] );
+   }
+
+   for ( Reads = 1; ( Reads < DUAL_IO_READS ) && ( Results == STATUS_SUCCESS ); Reads++ )
+   {
+      for ( Index = 0; ( Index < Count ) && ( Results == STATUS_SUCCESS ); Index++ )
+      {
+         Results = EC_ReadByteUsingIOSpace( ( uint8_t )( Offset + Index ), &Again[ Index ] );
+      }
+
+      if ( ( Results == STATUS_SUCCESS ) && ( memcmp( Again, pDest, Count ) == 0 ) )
+      {
+         *pTears += ( Reads > 1 );
+         return STATUS_SUCCESS;
+      }
+
+      memcpy( pDest, Again, Count );
+   }
+
+   *pTears += ( Reads > 1 );
+
+   return ( Results == STATUS_SUCCESS ) ? WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_TIMEOUT ) : Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_RunJob                                                     */
+/*                                                                            */
+/*!\brief  Reads the ranges of a job through the IO space window            */
+/*                                                                            */
+/*!\param   P_DUAL_JOB_STRUCT  the job                                        */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Ranges that could not be read are left in pJob->Failed           */
+/*                                                                            */
+/******************************************************************************/
+static void DUAL_RunJob( P_DUAL_JOB_STRUCT pJob )
+{
+   uint32_t   Index;
+
+   for ( Index = 0; Index < pJob->Count; Index++ )
+   {
+      if ( pJob->Mask & ( 1 << Index ) )
+      {
+         if ( DUAL_ReadIo( pJob->pRanges[ Index ].Offset, pJob->pRanges[ Index ].Count,
+                           &pJob->pSram[ pJob->pRanges[ Index ].Offset ], &pJob->Tears ) != STATUS_SUCCESS )
+         {
+            pJob->Failed |= 1 << Index;
+         }
+
+         pJob->Bytes += pJob->pRanges[ Index ].Count;
+      }
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_ReadAcpi                                                   */
+/*                                                                            */
+/*!\brief  Reads ranges through ACPI bursts                                  */
+/*                                                                            */
+/*!\param   const EC_READ_RANGE_STRUCT *  the ranges                          */
+/*!\param   uint32_t        number of ranges                                  */
+/*!\param   uint32_t        bit n set = read range n                          */
+/*!\param   puint8_t        where to store them, indexed by offset            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR DUAL_ReadAcpi( const EC_READ_RANGE_STRUCT *pRanges, uint32_t Count, uint32_t Mask, puint8_t pSram )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   uint32_t       Index;
+
+   for ( Index = 0; ( Index < Count ) && ( Results == STATUS_SUCCESS ); Index++ )
+   {
+      if ( Mask & ( 1 << Index ) )
+      {
+         Results = EC_ReadBlockUsingACPI( pRanges[ Index ].Offset, pRanges[ Index ].Count, &pSram[ pRanges[ Index ].Offset ] );
+      }
+   }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_Helper                                                     */
+/*                                                                            */
+/*!\brief  The helper thread - runs DualJob each time it is signalled        */
+/*                                                                            */
+/*!\param   LPVOID          not used                                          */
+/*!\return  DWORD           0                                                 */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI DUAL_Helper( LPVOID pParam )
+{
+   HANDLE   Handles[ 2 ] = { DualStopEvent, DualWorkEvent };
+
+   UNREFERENCED_PARAMETER( pParam );
+
+   while ( WaitForMultipleObjects( 2, Handles, FALSE, INFINITE ) == WAIT_OBJECT_0 + 1 )
+   {
+      DUAL_RunJob( &DualJob );
+      SetEvent( DualDoneEvent );
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_StopHelper                                                 */
+/*                                                                            */
+/*!\brief  Stops the helper thread and closes its events                     */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called with DualLock held exclusively                            */
+/*                                                                            */
+/******************************************************************************/
+static void DUAL_StopHelper( void )
+{
+   if ( DualThread )
+   {
+      SetEvent( DualStopEvent );
+      WaitForSingleObject( DualThread, INFINITE );
+      CloseHandle( DualThread );
+      DualThread = NULL;
+   }
+
+   if ( DualStopEvent )
+   {
+      CloseHandle( DualStopEvent );
+      DualStopEvent = NULL;
+   }
+
+   if ( DualWorkEvent )
+   {
+      CloseHandle( DualWorkEvent );
+      DualWorkEvent = NULL;
+   }
+
+   if ( DualDoneEvent )
+   {
+      CloseHandle( DualDoneEvent );
+      DualDoneEvent = NULL;
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_StartHelper                                                */
+/*                                                                            */
+/*!\brief  Starts the helper thread if it is not running                     */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Called with DualLock held exclusively. The helper runs at the    */
+/*!\note    caller's priority so the two halves of a sweep finish together.  */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR DUAL_StartHelper( void )
+{
+   if ( DualThread )
+   {
+      return STATUS_SUCCESS;
+   }
+
+   if ( ( ( DualStopEvent = CreateEvent( NULL, TRUE, FALSE, NULL ) ) != NULL ) &&
+        ( ( DualWorkEvent = CreateEvent( NULL, FALSE, FALSE, NULL ) ) != NULL ) &&
+        ( ( DualDoneEvent = CreateEvent( NULL, FALSE, FALSE, NULL ) ) != NULL ) )
+   {
+      DualThread = CreateThread( NULL, 0, DUAL_Helper, NULL, 0, NULL );
+   }
+
+   if ( DualThread == NULL )
+   {
+      DUAL_StopHelper();
+
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+   }
+
+   SetThreadPriority( DualThread, GetThreadPriority( GetCurrentThread() ) );
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_Sweep                                                      */
+/*                                                                            */
+/*!\brief  Reads ranges through both paths at once                           */
+/*                                                                            */
+/*!\param   const EC_READ_RANGE_STRUCT *  the ranges                          */
+/*!\param   uint32_t        number of ranges                                  */
+/*!\param   uint32_t        ranges for the IO space path, bit per range       */
+/*!\param   puint8_t        where the IO space path stores them               */
+/*!\param   uint32_t        ranges for the ACPI path, bit per range           */
+/*!\param   puint8_t        where the ACPI path stores them                   */
+/*!\return  WINSYS_ERROR    the ACPI path's result                           */
+/*                                                                            */
+/*!\note    Called with DualLock held exclusively and the helper running.    */
+/*!\note    The masks may overlap, as the self-test does, if the buffers     */
+/*!\note    are different.                                                    */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR DUAL_Sweep( const EC_READ_RANGE_STRUCT *pRanges, uint32_t Count, uint32_t IoMask, puint8_t pIoSram,
+                                uint32_t AcpiMask, puint8_t pAcpiSram )
+{
+   WINSYS_ERROR   Results;
+
+   DualJob.pRanges = pRanges;
+   DualJob.Count = Count;
+   DualJob.Mask = IoMask;
+   DualJob.pSram = pIoSram;
+   DualJob.Tears = 0;
+   DualJob.Bytes = 0;
+   DualJob.Failed = 0;
+
+   SetEvent( DualWorkEvent );
+
+   Results = DUAL_ReadAcpi( pRanges, Count, AcpiMask, pAcpiSram );
+
+   WaitForSingleObject( DualDoneEvent, INFINITE );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_Split                                                      */
+/*                                                                            */
+/*!\brief  Chooses the ranges of a sweep to read through the IO space path  */
+/*                                                                            */
+/*!\param   const EC_READ_RANGE_STRUCT *  the ranges                          */
+/*!\param   uint32_t        number of ranges                                  */
+/*!\return  uint32_t        bit n set = read range n through IO space, 0 if   */
+/*!\return                  splitting would not be faster                     */
+/*                                                                            */
+/*!\note    Largest first, each range goes to whichever path would finish    */
+/*!\note    it sooner under the cost model                                    */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t DUAL_Split( const EC_READ_RANGE_STRUCT *pRanges, uint32_t Count )
+{
+   uint32_t   Order[ DUAL_MAX_RANGES ],
+              IoMask = 0,
+              Index,
+              Next;
+   double     AcpiUs = 0.0,
+              IoUs = DualHandoffUs,
+              SingleUs = 0.0;
+
+   for ( Index = 0; Index < Count; Index++ )
+   {
+      for ( Next = Index; ( Next > 0 ) && ( pRanges[ Order[ Next - 1 ] ].Count < pRanges[ Index ].Count ); Next-- )
+      {
+         Order[ Next ] = Order[ Next - 1 ];
+      }
+
+      Order[ Next ] = Index;
+   }
+
+   for ( Index = 0; Index < Count; Index++ )
+   {
+      double   Acpi = DualAcpiBurstUs + DualAcpiByteUs * pRanges[ Order[ Index ] ].Count,
+               Io = DualIoByteUs * pRanges[ Order[ Index ] ].Count;
+
+      SingleUs += Acpi;
+
+      if ( IoUs + Io < AcpiUs + Acpi )
+          {
+             IoUs += Io;
+             IoMask |= 1 << Order[ Index ];
+          }
+      else
+          {
+             AcpiUs += Acpi;
+          }
+   }
+
+   return ( ( ( IoUs > AcpiUs ) ? IoUs : AcpiUs ) < SingleUs ) ? IoMask : 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_ReadRanges                                                 */
+/*                                                                            */
+/*!\brief  Reads the ranges of a sweep, split across both paths in dual mode */
+/*                                                                            */
+/*!\param   const EC_READ_RANGE_STRUCT *  the ranges, at most SENSOR_COUNT    */
+/*!\param   uint32_t        number of ranges                                  */
+/*!\param   puint8_t        where to store them, indexed by offset            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Called by SMP_QuerySensors(). A split sweep whose ACPI share     */
+/*!\note    fails is read again on ACPI alone, and IO space ranges that did   */
+/*!\note    not settle or failed are read again on ACPI.                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR DUAL_ReadRanges( const EC_READ_RANGE_STRUCT *pRanges, uint32_t Count, puint8_t pSram )
+{
+   WINSYS_ERROR   Results;
+   uint32_t       AllMask = ( 1 << Count ) - 1,
+                  IoMask = 0,
+                  Index;
+
+   if ( DualMode == DUAL_MODE_DUAL )
+   {
+      AcquireSRWLockExclusive( &DualLock );
+
+      if ( DualMode == DUAL_MODE_DUAL )
+      {
+         if ( ( IoMask = DUAL_Split( pRanges, Count ) ) == 0 )
+         {
+            DualStats.AcpiSweeps++;
+         }
+      }
+
+      if ( IoMask )
+      {
+         Results = DUAL_Sweep( pRanges, Count, IoMask, pSram, AllMask & ~IoMask, pSram );
+
+         for ( Index = 0; Index < Count; Index++ )
+         {
+            DualStats.AcpiBytes += ( IoMask & ( 1 << Index ) ) ? 0 : pRanges[ Index ].Count;
+         }
+
+         DualStats.SplitSweeps++;
+         DualStats.IoBytes += DualJob.Bytes;
+         DualStats.Tears += DualJob.Tears;
+
+         if ( Results == STATUS_SUCCESS )
+             {
+                DualFailures = 0;
+
+                if ( DualJob.Failed )
+                {
+                   for ( Index = 0; Index < Count; Index++ )
+                   {
+                      DualStats.IoFallbacks += ( DualJob.Failed >> Index ) & 1;
+                   }
+
+                   Results = DUAL_ReadAcpi( pRanges, Count, DualJob.Failed, pSram );
+                }
+             }
+         else
+             {
+                DualStats.Retries++;
+
+                if ( ++DualFailures >= DUAL_MAX_FAILURES )
+                {
+                   DualMode = DUAL_MODE_SINGLE;
+                   DualStats.Fault = DUAL_FAULT_RUNTIME;
+                   DUAL_StopHelper();
+                }
+
+                Results = DUAL_ReadAcpi( pRanges, Count, AllMask, pSram );
+             }
+
+         ReleaseSRWLockExclusive( &DualLock );
+
+         return Results;
+      }
+
+      ReleaseSRWLockExclusive( &DualLock );
+   }
+
+   return DUAL_ReadAcpi( pRanges, Count, AllMask, pSram );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_SelfTest                                                   */
+/*                                                                            */
+/*!\brief  Checks whether both paths can be used at once, calibrates the     */
+/*         cost model, and turns dual mode on if it passes and is faster      */
+/*                                                                            */
+/*!\param   uint32_t            rounds of each phase, 0 = DUAL_DEFAULT_ITERATIONS */
+/*!\param   P_DUAL_TEST_STRUCT  the findings                                  */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Success means the test ran - Fault and Enabled say how it went.  */
+/*!\note    Sweeps wait for the test in dual mode and go straight to ACPI    */
+/*!\note    otherwise, so stop the sampler first for clean timings.           */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR DUAL_SelfTest( uint32_t Iterations, P_DUAL_TEST_STRUCT pResult )
+{
+   WINSYS_ERROR           Results;
+   EC_READ_RANGE_STRUCT   Ranges[ DUAL_MAX_RANGES ];
+   EC_READ_RANGE_STRUCT   Calibrate[ 2 ] = { { VCORE_L_OFFSET, 1 }, { VCORE_L_OFFSET, DUAL_CALIBRATE_BYTES } };
+   uint8_t                Reference[ 256 ],
+                          AcpiSram[ 256 ],
+                          IoSram[ 256 ];
+   uint32_t               SensorRanges,
+                          IoMask,
+                          Round,
+                          Index;
+   uint64_t               StartUs;
+   double                 OneUs,
+                          ManyUs;
+
+   if ( pResult == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   memset( pResult, 0, sizeof( *pResult ) );
+   pResult->Iterations = ( Iterations ) ? Iterations : DUAL_DEFAULT_ITERATIONS;
+
+   SensorRanges = SMP_BuildReadRanges( EC_SENSOR_MASK_ALL, Ranges );
+   memcpy( &Ranges[ SensorRanges ], DualProbes, sizeof( DualProbes ) );
+
+   AcquireSRWLockExclusive( &DualLock );
+
+   DualMode = DUAL_MODE_SINGLE;
+
+   if ( ( Results = DUAL_StartHelper() ) != STATUS_SUCCESS )
+   {
+      ReleaseSRWLockExclusive( &DualLock );
+      return Results;
+   }
+
+   //
+   // the probes must read the same through the IO space window as through ACPI
+   //
+
+   if ( DUAL_ReadAcpi( DualProbes, DUAL_PROBE_COUNT, 0x3, Reference ) != STATUS_SUCCESS )
+       {
+          pResult->Fault = DUAL_FAULT_ACPI;
+       }
+   else
+       {
+          DUAL_JOB_STRUCT   Job = { DualProbes, DUAL_PROBE_COUNT, 0x3, IoSram };
+
+          DUAL_RunJob( &Job );
+
+          for ( Index = 0; Index < DUAL_PROBE_COUNT; Index++ )
+          {
+             if ( ( Job.Failed & ( 1 << Index ) ) || ( memcmp( &IoSram[ DualProbes[ Index ].Offset ], &Reference[ DualProbes[ Index ].Offset ], DualProbes[ Index ].Count ) ) )
+             {
+                pResult->Fault = DUAL_FAULT_WINDOW;
+             }
+          }
+       }
+
+   //
+   // calibrate the cost model, and time whole sweeps on each path alone
+   //
+
+   if ( pResult->Fault == DUAL_FAULT_NONE )
+   {
+      DUAL_JOB_STRUCT   Job = { Calibrate, 2, 0x2, IoSram };
+
+      for ( StartUs = EC_GetMicroSecs(), Round = 0; Round < pResult->Iterations; Round++ )
+      {
+         pResult->AcpiErrorsAlone += ( DUAL_ReadAcpi( Calibrate, 2, 0x1, AcpiSram ) != STATUS_SUCCESS );
+      }
+
+      OneUs = ( double )( EC_GetMicroSecs() - StartUs ) / pResult->Iterations;
+
+      for ( StartUs = EC_GetMicroSecs(), Round = 0; Round < pResult->Iterations; Round++ )
+      {
+         pResult->AcpiErrorsAlone += ( DUAL_ReadAcpi( Calibrate, 2, 0x2, AcpiSram ) != STATUS_SUCCESS );
+      }
+
+      ManyUs = ( double )( EC_GetMicroSecs() - StartUs ) / pResult->Iterations;
+
+      pResult->AcpiByteUs = ( ManyUs > OneUs ) ? ( ManyUs - OneUs ) / ( DUAL_CALIBRATE_BYTES - 1 ) : 0.0;
+      pResult->AcpiBurstUs = ( OneUs > pResult->AcpiByteUs ) ? OneUs - pResult->AcpiByteUs : 0.0;
+
+      for ( StartUs = EC_GetMicroSecs(), Round = 0; Round < pResult->Iterations; Round++ )
+      {
+         DUAL_RunJob( &Job );
+      }
+
+      pResult->IoByteUs = ( double )( EC_GetMicroSecs() - StartUs ) / pResult->Iterations / DUAL_CALIBRATE_BYTES;
+
+      for ( StartUs = EC_GetMicroSecs(), Round = 0; Round < pResult->Iterations; Round++ )
+      {
+         DUAL_Sweep( Ranges, 0, 0, IoSram, 0, AcpiSram );
+      }
+
+      pResult->HandoffUs = ( double )( EC_GetMicroSecs() - StartUs ) / pResult->Iterations;
+
+      for ( StartUs = EC_GetMicroSecs(), Round = 0; Round < pResult->Iterations; Round++ )
+      {
+         pResult->AcpiErrorsAlone += ( DUAL_ReadAcpi( Ranges, SensorRanges, ( 1 << SensorRanges ) - 1, AcpiSram ) != STATUS_SUCCESS );
+      }
+
+      pResult->AcpiSweepUs = ( double )( EC_GetMicroSecs() - StartUs ) / pResult->Iterations;
+
+      Job.pRanges = Ranges;
+      Job.Count = SensorRanges;
+      Job.Mask = ( 1 << SensorRanges ) - 1;
+
+      for ( StartUs = EC_GetMicroSecs(), Round = 0; Round < pResult->Iterations; Round++ )
+      {
+         DUAL_RunJob( &Job );
+      }
+
+      pResult->IoSweepUs = ( double )( EC_GetMicroSecs() - StartUs ) / pResult->Iterations;
+
+      DualAcpiBurstUs = pResult->AcpiBurstUs;
+      DualAcpiByteUs = pResult->AcpiByteUs;
+      DualIoByteUs = pResult->IoByteUs;
+      DualHandoffUs = pResult->HandoffUs;
+
+      pResult->Fault = ( pResult->AcpiErrorsAlone ) ? DUAL_FAULT_ACPI : DUAL_FAULT_NONE;
+   }
+
+   //
+   // both paths over the sensors and probes at once, each into its own buffer
+   //
+
+   if ( pResult->Fault == DUAL_FAULT_NONE )
+   {
+      uint32_t   AllMask = ( 1 << ( SensorRanges + DUAL_PROBE_COUNT ) ) - 1;
+
+      for ( Round = 0; Round < pResult->Iterations; Round++ )
+      {
+         BOOL   AcpiOk = ( DUAL_Sweep( Ranges, SensorRanges + DUAL_PROBE_COUNT, AllMask, IoSram, AllMask, AcpiSram ) == STATUS_SUCCESS );
+
+         pResult->AcpiErrorsShared += ! AcpiOk;
+         pResult->Tears += DualJob.Tears;
+
+         for ( Index = 0; Index < DUAL_PROBE_COUNT; Index++ )
+         {
+            uint8_t   Offset = DualProbes[ Index ].Offset,
+                      Count = DualProbes[ Index ].Count;
+
+            pResult->Mismatches += ( memcmp( &IoSram[ Offset ], &Reference[ Offset ], Count ) != 0 ) +
+                                   ( ( AcpiOk ) && ( memcmp( &AcpiSram[ Offset ], &Reference[ Offset ], Count ) != 0 ) );
+         }
+      }
+
+      if ( ( pResult->AcpiErrorsShared ) || ( pResult->Mismatches ) )
+      {
+         pResult->Fault = DUAL_FAULT_INTERFERENCE;
+      }
+   }
+
+   //
+   // and split sweeps, as they would be run
+   //
+
+   if ( pResult->Fault == DUAL_FAULT_NONE )
+   {
+      uint32_t   AllMask = ( 1 << SensorRanges ) - 1;
+
+      IoMask = DUAL_Split( Ranges, SensorRanges );
+
+      for ( StartUs = EC_GetMicroSecs(), Round = 0; ( Round < pResult->Iterations ) && ( pResult->Fault == DUAL_FAULT_NONE ); Round++ )
+      {
+         if ( DUAL_Sweep( Ranges, SensorRanges, IoMask, AcpiSram, AllMask & ~IoMask, AcpiSram ) != STATUS_SUCCESS )
+         {
+            pResult->AcpiErrorsShared++;
+            pResult->Fault = DUAL_FAULT_INTERFERENCE;
+         }
+      }
+
+      pResult->DualSweepUs = ( double )( EC_GetMicroSecs() - StartUs ) / pResult->Iterations;
+
+      if ( ( pResult->Fault == DUAL_FAULT_NONE ) && ( ( IoMask == 0 ) || ( pResult->DualSweepUs > pResult->AcpiSweepUs * DUAL_MIN_GAIN ) ) )
+      {
+         pResult->Fault = DUAL_FAULT_NO_GAIN;
+      }
+   }
+
+   if ( pResult->Fault == DUAL_FAULT_NONE )
+       {
+          pResult->Enabled = 1;
+          DualMode = DUAL_MODE_DUAL;
+          DualFailures = 0;
+       }
+   else
+       {
+          DUAL_StopHelper();
+       }
+
+   DualStats.Fault = pResult->Fault;
+
+   ReleaseSRWLockExclusive( &DualLock );
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_SetMode                                                    */
+/*                                                                            */
+/*!\brief  Turns dual mode on or off                                         */
+/*                                                                            */
+/*!\param   uint32_t        DUAL_MODE_ENUM_TYPE                               */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Turning dual mode on without a passed DUAL_SelfTest() uses the   */
+/*!\note    default cost model and trusts the firmware                        */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR DUAL_SetMode( uint32_t Mode )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( Mode > DUAL_MODE_DUAL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockExclusive( &DualLock );
+
+   if ( Mode == DUAL_MODE_DUAL )
+       {
+          if ( ( Results = DUAL_StartHelper() ) == STATUS_SUCCESS )
+          {
+             DualMode = DUAL_MODE_DUAL;
+             DualFailures = 0;
+             DualStats.Fault = DUAL_FAULT_NONE;
+          }
+       }
+   else
+       {
+          DualMode = DUAL_MODE_SINGLE;
+          DUAL_StopHelper();
+       }
+
+   ReleaseSRWLockExclusive( &DualLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: DUAL_GetStats                                                   */
+/*                                                                            */
+/*!\brief  Returns the dual mode counters                                    */
+/*                                                                            */
+/*!\param   P_DUAL_STATS_STRUCT  where to store the counters                  */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Waits for a split sweep in progress                              */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR DUAL_GetStats( P_DUAL_STATS_STRUCT pStats )
+{
+   if ( pStats == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockShared( &DualLock );
+   *pStats = DualStats;
+   pStats->Mode = DualMode;
+   ReleaseSRWLockShared( &DualLock );
+
+   return STATUS_SUCCESS;
+}
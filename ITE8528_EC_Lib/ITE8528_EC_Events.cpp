@@ -0,0 +1,577 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Events.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the SCI event handling. Pending events are detected
+//      with a cheap read of the ACPI status register, drained with QUERY_EC_CMD
+//      in one burst, and dispatched to callbacks registered by event class.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Events.h>
+#include "ITE8528_EC_Internal.h"
+
+
+/*!\struct _EVT_REGISTRATION_STRUCT
+ * \brief  A callback registration slot
+ */
+typedef struct _EVT_REGISTRATION_STRUCT {
+                                           uint8_t          InUse;
+                                           uint8_t          Class;
+                                           EVT_CALLBACK     Callback;
+                                           PVOID            pContext;
+
+                                        } EVT_REGISTRATION_STRUCT, *P_EVT_REGISTRATION_STRUCT;
+
+#define EVT_CLASS_FLAG_MAPPABLE   0x01                                  // may be assigned to an EC query code
+
+static const uint8_t             EvtClassFlags[] = {
+                                                     EVT_CLASS_FLAG_MAPPABLE,   // EVT_CLASS_UNKNOWN
+                                                     EVT_CLASS_FLAG_MAPPABLE,   // EVT_CLASS_THERMAL_TRIP
+                                                     EVT_CLASS_FLAG_MAPPABLE,   // EVT_CLASS_FAN_FAULT
+                                                     EVT_CLASS_FLAG_MAPPABLE,   // EVT_CLASS_WDT
+                                                     0,                         // EVT_CLASS_FALLBACK_POLL, raised by the event thread
+                                                     0,                         // EVT_CLASS_ALARM, raised by ALRM_
+                                                     0,                         // EVT_CLASS_ANOMALY, raised by STAT_
+                                                     0                          // EVT_CLASS_GOVERNOR, raised by GOV_
+                                                  };
+
+static_assert( sizeof( EvtClassFlags ) == EVT_CLASS_COUNT, "EvtClassFlags needs an entry for every event class" );
+
+static SRWLOCK                   EvtRegistryLock = SRWLOCK_INIT;           // guards the class map and callback table
+static uint8_t                   EvtClassMap[ 256 ];                       // query code -> EVT_CLASS_ENUM_TYPE
+static EVT_REGISTRATION_STRUCT   EvtCallbacks[ EVT_MAX_CALLBACKS ];
+static EVT_STATS_STRUCT          EvtStats;
+
+static SRWLOCK                   EvtQueueLock = SRWLOCK_INIT;              // guards the event queue
+static EC_EVENT_STRUCT           EvtQueue[ EVT_QUEUE_SIZE ];
+static uint32_t                  EvtQueueHead = 0;                         // events queued
+static uint32_t                  EvtQueueTail = 0;                         // events drained
+static HANDLE                    EvtNotifyEvent = NULL;                    // manual reset, set while events are queued
+
+static HANDLE                    EvtThread = NULL;
+static HANDLE                    EvtStopEvent = NULL;
+static uint32_t                  EvtWatchIntervalMs;
+static uint32_t                  EvtFallbackPollMs;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_Dispatch                                                    */
+/*                                                                            */
+/*!\brief  Delivers an event to every callback registered for its class      */
+/*                                                                            */
+/*!\param   P_EC_EVENT_STRUCT   the event to deliver                          */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    The event is queued for EVT_DrainEvents() first. The registry is  */
+/*!\note    held shared while the callbacks run, so that an unregistered      */
+/*!\note    callback is never called after EVT_UnregisterCallback() returns   */
+/*                                                                            */
+/******************************************************************************/
+static void EVT_Dispatch( P_EC_EVENT_STRUCT pEvent )
+{
+   uint32_t   Index;
+
+   AcquireSRWLockExclusive( &EvtQueueLock );
+
+   if ( ( EvtQueueHead - EvtQueueTail ) == EVT_QUEUE_SIZE )
+   {
+      EvtQueueTail++;                                                  // full, drop the oldest event
+      EvtStats.QueueOverruns++;
+   }
+
+   EvtQueue[ EvtQueueHead++ & ( EVT_QUEUE_SIZE - 1 ) ] = *pEvent;
+
+   if ( EvtNotifyEvent )
+   {
+      SetEvent( EvtNotifyEvent );
+   }
+
+   ReleaseSRWLockExclusive( &EvtQueueLock );
+
+   AcquireSRWLockShared( &EvtRegistryLock );
+
+   for ( Index = 0; Index < EVT_MAX_CALLBACKS; Index++ )
+   {
+      if ( ( EvtCallbacks[ Index ].InUse ) &&
+           ( ( EvtCallbacks[ Index ].Class == EVT_CLASS_ALL ) || ( EvtCallbacks[ Index ].Class == pEvent->Class ) ) )
+      {
+         EvtCallbacks[ Index ].Callback( pEvent, EvtCallbacks[ Index ].pContext );
+      }
+   }
+
+   ReleaseSRWLockShared( &EvtRegistryLock );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_Post                                                        */
+/*                                                                            */
+/*!\brief  Delivers an event raised inside the library rather than by the EC */
+/*                                                                            */
+/*!\param   P_EC_EVENT_STRUCT   the event to deliver                          */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    The callbacks run on the caller's thread                          */
+/*                                                                            */
+/******************************************************************************/
+void EVT_Post( P_EC_EVENT_STRUCT pEvent )
+{
+   EVT_Dispatch( pEvent );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_MapQueryCode                                                */
+/*                                                                            */
+/*!\brief  Assigns an event class to an EC query code                         */
+/*                                                                            */
+/*!\param   uint8_t               query code as returned by QUERY_EC_CMD      */
+/*!\param   EVT_CLASS_ENUM_TYPE   class to deliver the code as                */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Query code values are defined by the EC firmware. Classes the     */
+/*!\note    library raises itself are not flagged mappable and are refused    */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_MapQueryCode( uint8_t QueryCode, EVT_CLASS_ENUM_TYPE Class )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( QueryCode != 0 ) && ( Class < EVT_CLASS_COUNT ) && ( EvtClassFlags[ Class ] & EVT_CLASS_FLAG_MAPPABLE ) )
+       {
+          AcquireSRWLockExclusive( &EvtRegistryLock );
+          EvtClassMap[ QueryCode ] = ( uint8_t ) Class;
+          ReleaseSRWLockExclusive( &EvtRegistryLock );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_RegisterCallback                                            */
+/*                                                                            */
+/*!\brief  Registers a callback for a class of events                         */
+/*                                                                            */
+/*!\param   EVT_CLASS_ENUM_TYPE   class to receive, or EVT_CLASS_ALL          */
+/*!\param   EVT_CALLBACK          function to call for each event             */
+/*!\param   PVOID                 context passed back to the callback         */
+/*!\param   puint32_t             returns a handle for EVT_UnregisterCallback */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_RegisterCallback( EVT_CLASS_ENUM_TYPE Class, EVT_CALLBACK Callback, PVOID pContext, puint32_t pHandle )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( Callback ) && ( pHandle ) )
+       {
+          if ( ( Class < EVT_CLASS_COUNT ) || ( Class == EVT_CLASS_ALL ) )
+              {
+                 uint32_t   Index;
+
+                 AcquireSRWLockExclusive( &EvtRegistryLock );
+
+                 for ( Index = 0; ( Index < EVT_MAX_CALLBACKS ) && ( EvtCallbacks[ Index ].InUse ); Index++ )
+                 {
+                 }
+
+                 if ( Index < EVT_MAX_CALLBACKS )
+                     {
+                        EvtCallbacks[ Index ].Class = ( uint8_t ) Class;
+                        EvtCallbacks[ Index ].Callback = Callback;
+                        EvtCallbacks[ Index ].pContext = pContext;
+                        EvtCallbacks[ Index ].InUse = 1;
+                        *pHandle = Index;
+                     }
+                 else
+                     {
+                        Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+                     }
+
+                 ReleaseSRWLockExclusive( &EvtRegistryLock );
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ENUMERATION_OUT_OF_RANGE );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_UnregisterCallback                                          */
+/*                                                                            */
+/*!\brief  Removes a callback registration                                    */
+/*                                                                            */
+/*!\param   uint32_t        handle returned by EVT_RegisterCallback           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Waits for any dispatch in progress to finish, so must not be      */
+/*!\note    called from inside a callback                                     */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_UnregisterCallback( uint32_t Handle )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( Handle < EVT_MAX_CALLBACKS )
+       {
+          AcquireSRWLockExclusive( &EvtRegistryLock );
+          EvtCallbacks[ Handle ].InUse = 0;
+          ReleaseSRWLockExclusive( &EvtRegistryLock );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_INDEX_OUT_OF_RANGE );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_Poll                                                        */
+/*                                                                            */
+/*!\brief  Checks Sci_Evt once, and if set drains and dispatches the pending  */
+/*         query codes                                                        */
+/*                                                                            */
+/*!\param   puint32_t       optional, returns the number of events dispatched */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Costs a single status port read when no event is pending. May be  */
+/*!\note    called directly by applications that do not use EVT_Start().      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_Poll( puint32_t pDispatched )
+{
+   WINSYS_ERROR      Results;
+   uint8_t           Codes[ EVT_MAX_QUERY_BURST ];
+   uint8_t           Count = 0;
+
+   InterlockedIncrement( ( LONG volatile * ) &EvtStats.StatusReads );
+
+   Results = EC_QueryEventsUsingACPI( Codes, EVT_MAX_QUERY_BURST, &Count );
+
+   if ( Count > 0 )
+   {
+      EC_EVENT_STRUCT   Event = { EVT_CLASS_UNKNOWN };
+      uint8_t           Classes[ EVT_MAX_QUERY_BURST ];
+      uint8_t           Index;
+
+      InterlockedIncrement( ( LONG volatile * ) &EvtStats.DrainBursts );
+      InterlockedExchangeAdd( ( LONG volatile * ) &EvtStats.EventsDispatched, Count );
+
+      Event.TimestampUs = EC_GetMicroSecs();
+
+      AcquireSRWLockShared( &EvtRegistryLock );
+
+      for ( Index = 0; Index < Count; Index++ )
+      {
+         Classes[ Index ] = EvtClassMap[ Codes[ Index ] ];
+      }
+
+      ReleaseSRWLockShared( &EvtRegistryLock );
+
+      for ( Index = 0; Index < Count; Index++ )
+      {
+         Event.QueryCode = Codes[ Index ];
+         Event.Class = ( EVT_CLASS_ENUM_TYPE ) Classes[ Index ];
+         EVT_Dispatch( &Event );
+      }
+   }
+
+   if ( pDispatched )
+   {
+      *pDispatched = Count;
+   }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_Thread                                                      */
+/*                                                                            */
+/*!\brief  Background thread that watches Sci_Evt and runs the fallback poll  */
+/*                                                                            */
+/*!\param   LPVOID          unused                                            */
+/*!\return  DWORD           thread exit code                                  */
+/*                                                                            */
+/*!\note    The stop event doubles as the watch interval timer                */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI EVT_Thread( LPVOID pParam )
+{
+   uint64_t   NextPollUs = EC_GetMicroSecs() + ( ( uint64_t ) EvtFallbackPollMs * 1000 );
+
+   UNREFERENCED_PARAMETER( pParam );
+
+   while ( WaitForSingleObject( EvtStopEvent, EvtWatchIntervalMs ) == WAIT_TIMEOUT )
+   {
+      EVT_Poll( NULL );
+
+      if ( ( EvtFallbackPollMs ) && ( EC_GetMicroSecs() >= NextPollUs ) )
+      {
+         EC_EVENT_STRUCT   Event = { EVT_CLASS_UNKNOWN };
+
+         Event.Class = EVT_CLASS_FALLBACK_POLL;
+         Event.QueryCode = 0;
+         Event.TimestampUs = EC_GetMicroSecs();
+
+         InterlockedIncrement( ( LONG volatile * ) &EvtStats.FallbackPolls );
+         EVT_Dispatch( &Event );
+
+         NextPollUs = Event.TimestampUs + ( ( uint64_t ) EvtFallbackPollMs * 1000 );
+      }
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_Start                                                       */
+/*                                                                            */
+/*!\brief  Starts the event thread                                            */
+/*                                                                            */
+/*!\param   uint32_t        period of the Sci_Evt check in msecs, 0 = default */
+/*!\param   uint32_t        period of the fallback poll in msecs, 0 = none    */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Callbacks for EVT_CLASS_FALLBACK_POLL are called every            */
+/*!\note    FallbackPollMs, so consumers can re-read sensors at a low rate in */
+/*!\note    case an event was missed                                          */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_Start( uint32_t WatchIntervalMs, uint32_t FallbackPollMs )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( EvtThread == NULL )
+       {
+          EvtWatchIntervalMs = ( WatchIntervalMs ) ? WatchIntervalMs : EVT_DEFAULT_WATCH_INTERVAL_MS;
+          EvtFallbackPollMs = FallbackPollMs;
+
+          if ( ( EvtStopEvent = CreateEvent( NULL, TRUE, FALSE, NULL ) ) != NULL )
+          {
+             EvtThread = CreateThread( NULL, 0, EVT_Thread, NULL, 0, NULL );
+          }
+
+          if ( EvtThread == NULL )
+          {
+             if ( EvtStopEvent )
+             {
+                CloseHandle( EvtStopEvent );
+                EvtStopEvent = NULL;
+             }
+
+             Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ALREADY_RUNNING );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_Stop                                                        */
+/*                                                                            */
+/*!\brief  Stops the event thread and waits for it to exit                    */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_Stop( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( EvtThread != NULL )
+       {
+          SetEvent( EvtStopEvent );
+          WaitForSingleObject( EvtThread, INFINITE );
+
+          CloseHandle( EvtThread );
+          CloseHandle( EvtStopEvent );
+          EvtThread = NULL;
+          EvtStopEvent = NULL;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_GetNotifyHandle                                             */
+/*                                                                            */
+/*!\brief  Returns a waitable handle that is signalled while events are      */
+/*         queued                                                             */
+/*                                                                            */
+/*!\param   HANDLE *        pointer to return the event handle in             */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The handle is a manual reset event owned by the library, and must */
+/*!\note    not be closed. It is cleared by EVT_DrainEvents() once the queue  */
+/*!\note    is empty.                                                         */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_GetNotifyHandle( HANDLE *pHandle )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pHandle )
+       {
+          AcquireSRWLockExclusive( &EvtQueueLock );
+
+          if ( EvtNotifyEvent == NULL )
+          {
+             EvtNotifyEvent = CreateEvent( NULL, TRUE, ( EvtQueueHead != EvtQueueTail ), NULL );
+          }
+
+          ReleaseSRWLockExclusive( &EvtQueueLock );
+
+          if ( ( *pHandle = EvtNotifyEvent ) == NULL )
+          {
+             Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_DrainEvents                                                 */
+/*                                                                            */
+/*!\brief  Copies queued events, oldest first, without blocking              */
+/*                                                                            */
+/*!\param   P_EC_EVENT_STRUCT   buffer to return events in                    */
+/*!\param   uint32_t            size of the buffer, in events                 */
+/*!\param   puint32_t           returns the number of events copied           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_DrainEvents( P_EC_EVENT_STRUCT pEvents, uint32_t MaxEvents, puint32_t pCount )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( pEvents ) && ( pCount ) )
+       {
+          uint32_t   Count = 0;
+
+          AcquireSRWLockExclusive( &EvtQueueLock );
+
+          while ( ( EvtQueueTail != EvtQueueHead ) && ( Count < MaxEvents ) )
+          {
+             pEvents[ Count++ ] = EvtQueue[ EvtQueueTail++ & ( EVT_QUEUE_SIZE - 1 ) ];
+          }
+
+          if ( ( EvtQueueTail == EvtQueueHead ) && ( EvtNotifyEvent ) )
+          {
+             ResetEvent( EvtNotifyEvent );
+          }
+
+          ReleaseSRWLockExclusive( &EvtQueueLock );
+
+          *pCount = Count;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EVT_GetStats                                                    */
+/*                                                                            */
+/*!\brief  Returns the event subsystem's counters                             */
+/*                                                                            */
+/*!\param   P_EVT_STATS_STRUCT  pointer to structure to return counters in    */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Copied under the queue lock, which the overrun count is kept under */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EVT_GetStats( P_EVT_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStats )
+       {
+          AcquireSRWLockShared( &EvtQueueLock );
+          *pStats = EvtStats;
+          ReleaseSRWLockShared( &EvtQueueLock );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
@@ -0,0 +1,810 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Exporter.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the OpenMetrics exporter - a refresh thread that
+//      snapshots the readings and counters, and a pool of workers that render
+//      the snapshot for each scrape into buffers of their own.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <winsock2.h>
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Units.h>
+#include <ITE8528_EC_Exporter.h>
+#include "ITE8528_EC_Internal.h"
+
+
+#define OMX_HEADER_SIZE             256
+
+/*!\struct _OMX_SNAPSHOT_STRUCT
+ * \brief  Everything a scrape publishes, collected by the refresh thread
+ */
+typedef struct _OMX_SNAPSHOT_STRUCT {
+                                       EC_SAMPLE_STRUCT                Sample;
+                                       uint32_t                        Milli[ SENSOR_COUNT ];
+                                       BOOL                            HaveSample;
+                                       WDT_STATUS_STRUCT               Wdt;
+                                       BOOL                            HaveWdt;
+                                       EC_TRANSACTION_STATS_STRUCT     Ec;
+                                       SMP_STATS_STRUCT                Sampler;
+
+                                    } OMX_SNAPSHOT_STRUCT, *P_OMX_SNAPSHOT_STRUCT;
+
+/*!\struct _OMX_WORKER_STRUCT
+ * \brief  A scrape worker and the buffers it reuses for every scrape
+ */
+typedef struct _OMX_WORKER_STRUCT {
+                                     HANDLE                  Thread;
+                                     OMX_SNAPSHOT_STRUCT     Snapshot;
+                                     WSABUF                  Buffers[ 2 ];
+                                     char                    Request[ OMX_REQUEST_SIZE ];
+                                     char                    Header[ OMX_HEADER_SIZE ];
+                                     char                    Body[ OMX_BODY_SIZE ];
+
+                                  } OMX_WORKER_STRUCT, *P_OMX_WORKER_STRUCT;
+
+/*!\struct _OMX_TEXT_STRUCT
+ * \brief  Where the next character of a response goes. Full is set, and nothing more written, once it runs out
+ */
+typedef struct _OMX_TEXT_STRUCT {
+                                   char *       pNext;
+                                   char *       pEnd;
+                                   BOOL         Full;
+
+                                } OMX_TEXT_STRUCT, *P_OMX_TEXT_STRUCT;
+
+/*!\struct _OMX_FAMILY_STRUCT
+ * \brief  A metric family of sensors, and the name and labels of each sensor's sample
+ */
+typedef struct _OMX_FAMILY_STRUCT {
+                                     const char *   pMetadata;
+                                     uint32_t       First;
+                                     uint32_t       Last;
+
+                                  } OMX_FAMILY_STRUCT, *P_OMX_FAMILY_STRUCT;
+
+static const OMX_FAMILY_STRUCT   OmxFamilies[] = {
+                                   { "# TYPE ite8528_temperature_celsius gauge\n"
+                                     "# UNIT ite8528_temperature_celsius celsius\n"
+                                     "# HELP ite8528_temperature_celsius Temperatures read by the EC.\n", SENSOR_CPU_TEMP, SENSOR_SYS_TEMP },
+                                   { "# TYPE ite8528_voltage_volts gauge\n"
+                                     "# UNIT ite8528_voltage_volts volts\n"
+                                     "# HELP ite8528_voltage_volts Power rails read by the EC.\n", SENSOR_VCORE, SENSOR_VDIMM },
+                                   { "# TYPE ite8528_fan_speed_rpm gauge\n"
+                                     "# UNIT ite8528_fan_speed_rpm rpm\n"
+                                     "# HELP ite8528_fan_speed_rpm Fan speeds read by the EC.\n", SENSOR_CPU_FAN, SENSOR_CPU_FAN } };
+
+static const char *              OmxSamples[ SENSOR_COUNT ] = { "ite8528_temperature_celsius{sensor=\"cpu\"} ",
+                                                                "ite8528_temperature_celsius{sensor=\"system\"} ",
+                                                                "ite8528_voltage_volts{rail=\"vcore\"} ",
+                                                                "ite8528_voltage_volts{rail=\"3v3\"} ",
+                                                                "ite8528_voltage_volts{rail=\"5v\"} ",
+                                                                "ite8528_voltage_volts{rail=\"12v\"} ",
+                                                                "ite8528_voltage_volts{rail=\"vdimm\"} ",
+                                                                "ite8528_fan_speed_rpm{fan=\"cpu\"} " };
+
+static const char                OmxNotFound[] = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+static const char                OmxBadMethod[] = "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET\r\nContent-Length: 0\r\n"
+                                                  "Connection: close\r\n\r\n";
+static const char                OmxTooBig[] = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+static SRWLOCK                   OmxControlLock = SRWLOCK_INIT;           // serializes OMX_Start and OMX_Stop
+static SRWLOCK                   OmxSnapshotLock = SRWLOCK_INIT;          // guards OmxSnapshot
+static OMX_SNAPSHOT_STRUCT       OmxSnapshot;
+static OMX_WORKER_STRUCT         OmxWorkers[ OMX_WORKER_COUNT ];
+
+static BOOL                      OmxRunning = FALSE;
+static uint32_t                  OmxRefreshMs;
+static SOCKET                    OmxListener = INVALID_SOCKET;
+static HANDLE                    OmxStopEvent = NULL;
+static HANDLE                    OmxRefreshThread = NULL;
+
+static volatile LONG64           OmxScrapes = 0;
+static volatile LONG64           OmxRejected = 0;
+static volatile LONG64           OmxErrors = 0;
+static volatile LONG64           OmxRefreshes = 0;
+static volatile LONG64           OmxRenderUs = 0;
+static volatile LONG             OmxMaxRenderUs = 0;
+static volatile LONG             OmxLastBytes = 0;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_Put                                                         */
+/*                                                                            */
+/*!\brief  Appends a string to a response                                    */
+/*                                                                            */
+/*!\param   P_OMX_TEXT_STRUCT  the response                                   */
+/*!\param   const char *    the string                                        */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void OMX_Put( P_OMX_TEXT_STRUCT pText, const char *pString )
+{
+   while ( *pString )
+   {
+      if ( pText->pNext == pText->pEnd )
+      {
+         pText->Full = TRUE;
+         return;
+      }
+
+      *pText->pNext++ = *pString++;
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_PutNumber                                                   */
+/*                                                                            */
+/*!\brief  Appends an unsigned number in decimal to a response               */
+/*                                                                            */
+/*!\param   P_OMX_TEXT_STRUCT  the response                                   */
+/*!\param   uint64_t        the number                                        */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void OMX_PutNumber( P_OMX_TEXT_STRUCT pText, uint64_t Value )
+{
+   char       Digits[ 21 ];
+   uint32_t   Index = sizeof( Digits ) - 1;
+
+   Digits[ Index ] = '\0';
+
+   do
+   {
+      Digits[ --Index ] = ( char )( '0' + Value % 10 );
+      Value /= 10;
+   } while ( Value );
+
+   OMX_Put( pText, &Digits[ Index ] );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_PutMilli                                                    */
+/*                                                                            */
+/*!\brief  Appends a number of thousandths as a decimal with three places     */
+/*                                                                            */
+/*!\param   P_OMX_TEXT_STRUCT  the response                                   */
+/*!\param   uint64_t        the number, in thousandths                        */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void OMX_PutMilli( P_OMX_TEXT_STRUCT pText, uint64_t Milli )
+{
+   char   Fraction[ 5 ] = { '.', ( char )( '0' + Milli / 100 % 10 ), ( char )( '0' + Milli / 10 % 10 ),
+                            ( char )( '0' + Milli % 10 ), '\0' };
+
+   OMX_PutNumber( pText, Milli / 1000 );
+   OMX_Put( pText, Fraction );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_PutSample                                                   */
+/*                                                                            */
+/*!\brief  Appends one sample with an integer value                          */
+/*                                                                            */
+/*!\param   P_OMX_TEXT_STRUCT  the response                                   */
+/*!\param   const char *    name and labels of the sample, with the space     */
+/*!\param   uint64_t        the count                                         */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void OMX_PutSample( P_OMX_TEXT_STRUCT pText, const char *pName, uint64_t Value )
+{
+   OMX_Put( pText, pName );
+   OMX_PutNumber( pText, Value );
+   OMX_Put( pText, "\n" );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_Render                                                      */
+/*                                                                            */
+/*!\brief  Writes a snapshot out in the OpenMetrics text format              */
+/*                                                                            */
+/*!\param   P_OMX_SNAPSHOT_STRUCT  the snapshot                               */
+/*!\param   char *          the buffer                                        */
+/*!\param   uint32_t        its size                                          */
+/*!\return  uint32_t        bytes written, 0 if the buffer was too small      */
+/*                                                                            */
+/*!\note    Only sensors in the sample's ValidMask are published             */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t OMX_Render( P_OMX_SNAPSHOT_STRUCT pSnapshot, char *pBuffer, uint32_t Size )
+{
+   OMX_TEXT_STRUCT   Text = { pBuffer, pBuffer + Size, FALSE };
+   uint32_t          Family,
+                     Sensor;
+
+   for ( Family = 0; Family < sizeof( OmxFamilies ) / sizeof( OmxFamilies[ 0 ] ); Family++ )
+   {
+      OMX_Put( &Text, OmxFamilies[ Family ].pMetadata );
+
+      for ( Sensor = OmxFamilies[ Family ].First; ( pSnapshot->HaveSample ) && ( Sensor <= OmxFamilies[ Family ].Last ); Sensor++ )
+      {
+         if ( pSnapshot->Sample.ValidMask & EC_SENSOR_MASK( Sensor ) )
+         {
+            OMX_Put( &Text, OmxSamples[ Sensor ] );
+            OMX_PutMilli( &Text, pSnapshot->Milli[ Sensor ] );
+            OMX_Put( &Text, "\n" );
+         }
+      }
+   }
+
+   OMX_Put( &Text, "# TYPE ite8528_sample_timestamp_seconds gauge\n"
+                   "# UNIT ite8528_sample_timestamp_seconds seconds\n"
+                   "# HELP ite8528_sample_timestamp_seconds When the published sensor readings were taken.\n" );
+
+   if ( pSnapshot->HaveSample )
+   {
+      OMX_Put( &Text, "ite8528_sample_timestamp_seconds " );
+      OMX_PutMilli( &Text, pSnapshot->Sample.TimestampMs );
+      OMX_Put( &Text, "\n" );
+   }
+
+   //
+   // a family's samples must follow its own metadata, so the WDT families are written out one at a time
+   //
+
+   OMX_Put( &Text, "# TYPE ite8528_wdt_enabled gauge\n"
+                   "# HELP ite8528_wdt_enabled 1 while the WDT is counting down.\n" );
+
+   if ( pSnapshot->HaveWdt )
+   {
+      OMX_PutSample( &Text, "ite8528_wdt_enabled ", pSnapshot->Wdt.Enabled );
+   }
+
+   OMX_Put( &Text, "# TYPE ite8528_wdt_remaining_seconds gauge\n"
+                   "# UNIT ite8528_wdt_remaining_seconds seconds\n"
+                   "# HELP ite8528_wdt_remaining_seconds Least time left before the WDT fires.\n" );
+
+   if ( pSnapshot->HaveWdt )
+   {
+      OMX_Put( &Text, "ite8528_wdt_remaining_seconds " );
+      OMX_PutMilli( &Text, pSnapshot->Wdt.RemainingMs );
+      OMX_Put( &Text, "\n" );
+   }
+
+   OMX_Put( &Text, "# TYPE ite8528_wdt_mode stateset\n"
+                   "# HELP ite8528_wdt_mode WDT countdown mode.\n" );
+
+   if ( pSnapshot->HaveWdt )
+   {
+      OMX_PutSample( &Text, "ite8528_wdt_mode{ite8528_wdt_mode=\"seconds\"} ", pSnapshot->Wdt.Mode == SECOND_MODE_ENUM );
+      OMX_PutSample( &Text, "ite8528_wdt_mode{ite8528_wdt_mode=\"minutes\"} ", pSnapshot->Wdt.Mode == MINUTE_MODE_ENUM );
+   }
+
+   OMX_Put( &Text, "# TYPE ite8528_ec_transactions counter\n"
+                   "# HELP ite8528_ec_transactions ACPI burst transactions made.\n" );
+   OMX_PutSample( &Text, "ite8528_ec_transactions_total{kind=\"read\"} ", pSnapshot->Ec.ReadBursts );
+   OMX_PutSample( &Text, "ite8528_ec_transactions_total{kind=\"write\"} ", pSnapshot->Ec.WriteBursts );
+   OMX_PutSample( &Text, "ite8528_ec_transactions_total{kind=\"query\"} ", pSnapshot->Ec.QueryBursts );
+
+   OMX_Put( &Text, "# TYPE ite8528_ec_bytes counter\n"
+                   "# HELP ite8528_ec_bytes Bytes moved by successful ACPI transactions.\n" );
+   OMX_PutSample( &Text, "ite8528_ec_bytes_total{direction=\"read\"} ", pSnapshot->Ec.BytesRead );
+   OMX_PutSample( &Text, "ite8528_ec_bytes_total{direction=\"written\"} ", pSnapshot->Ec.BytesWritten );
+
+   OMX_Put( &Text, "# TYPE ite8528_ec_timeouts counter\n"
+                   "# HELP ite8528_ec_timeouts Handshakes the EC did not answer in time.\n" );
+   OMX_PutSample( &Text, "ite8528_ec_timeouts_total{wait=\"ibf\"} ", pSnapshot->Ec.IbfTimeouts );
+   OMX_PutSample( &Text, "ite8528_ec_timeouts_total{wait=\"obf\"} ", pSnapshot->Ec.ObfTimeouts );
+   OMX_PutSample( &Text, "ite8528_ec_timeouts_total{wait=\"burst\"} ", pSnapshot->Ec.BurstTimeouts );
+
+   OMX_Put( &Text, "# TYPE ite8528_sampler_samples counter\n"
+                   "# HELP ite8528_sampler_samples Samples taken by the sampler.\n" );
+   OMX_PutSample( &Text, "ite8528_sampler_samples_total ", pSnapshot->Sampler.Samples );
+   OMX_Put( &Text, "# TYPE ite8528_sampler_errors counter\n"
+                   "# HELP ite8528_sampler_errors Sampler sweeps that failed.\n" );
+   OMX_PutSample( &Text, "ite8528_sampler_errors_total ", pSnapshot->Sampler.Errors );
+   OMX_Put( &Text, "# TYPE ite8528_sampler_overruns counter\n"
+                   "# HELP ite8528_sampler_overruns Samples lost because the ring was full.\n" );
+   OMX_PutSample( &Text, "ite8528_sampler_overruns_total ", pSnapshot->Sampler.Overruns );
+
+   OMX_Put( &Text, "# TYPE ite8528_exporter_scrapes counter\n"
+                   "# HELP ite8528_exporter_scrapes Scrapes answered by the exporter.\n" );
+   OMX_PutSample( &Text, "ite8528_exporter_scrapes_total ", ( uint64_t ) OmxScrapes + 1 );
+
+   OMX_Put( &Text, "# EOF\n" );
+
+   return ( Text.Full ) ? 0 : ( uint32_t )( Text.pNext - pBuffer );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_TakeSnapshot                                                */
+/*                                                                            */
+/*!\brief  Collects the latest sample, the WDT state and the counters         */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called by OMX_Start and the refresh thread only. Reading the WDT  */
+/*!\note    is the exporter's only EC access, and is done here so scrapes    */
+/*!\note    never wait on the EC.                                            */
+/*                                                                            */
+/******************************************************************************/
+static void OMX_TakeSnapshot( void )
+{
+   static OMX_SNAPSHOT_STRUCT   Snapshot;
+   uint32_t                     Sensor;
+
+   memset( &Snapshot, 0, sizeof( Snapshot ) );
+
+   if ( SMP_GetLatest( &Snapshot.Sample ) == STATUS_SUCCESS )
+   {
+      Snapshot.HaveSample = TRUE;
+
+      for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+      {
+         if ( Snapshot.Sample.ValidMask & EC_SENSOR_MASK( Sensor ) )
+         {
+            UNIT_ToMilli( Sensor, &Snapshot.Sample.Raw[ Sensor ], &Snapshot.Milli[ Sensor ], 1 );
+         }
+      }
+   }
+
+   Snapshot.HaveWdt = ( WDT_GetStatus( &Snapshot.Wdt ) == STATUS_SUCCESS );
+
+   EC_GetTransactionStats( &Snapshot.Ec );
+   SMP_GetStats( &Snapshot.Sampler );
+
+   AcquireSRWLockExclusive( &OmxSnapshotLock );
+   OmxSnapshot = Snapshot;
+   ReleaseSRWLockExclusive( &OmxSnapshotLock );
+
+   InterlockedIncrement64( &OmxRefreshes );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_RefreshThread                                               */
+/*                                                                            */
+/*!\brief  Takes a snapshot every OmxRefreshMs until the exporter is stopped  */
+/*                                                                            */
+/*!\param   LPVOID          unused                                            */
+/*!\return  DWORD           0                                                 */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI OMX_RefreshThread( LPVOID pParam )
+{
+   UNREFERENCED_PARAMETER( pParam );
+
+   while ( WaitForSingleObject( OmxStopEvent, OmxRefreshMs ) == WAIT_TIMEOUT )
+   {
+      OMX_TakeSnapshot();
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_Send                                                        */
+/*                                                                            */
+/*!\brief  Writes a set of buffers to a socket in one vectored send          */
+/*                                                                            */
+/*!\param   SOCKET          the connection                                    */
+/*!\param   WSABUF *        the buffers, which are advanced past what is sent */
+/*!\param   uint32_t        number of buffers                                 */
+/*!\return  BOOL            TRUE if everything was sent                       */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static BOOL OMX_Send( SOCKET Socket, WSABUF *pBuffers, uint32_t Count )
+{
+   DWORD   Sent;
+
+   while ( Count )
+   {
+      if ( WSASend( Socket, pBuffers, Count, &Sent, 0, NULL, NULL ) != 0 )
+      {
+         return FALSE;
+      }
+
+      while ( ( Count ) && ( Sent >= pBuffers->len ) )
+      {
+         Sent -= pBuffers->len;
+         pBuffers++;
+         Count--;
+      }
+
+      if ( Count )
+      {
+         pBuffers->buf += Sent;
+         pBuffers->len -= Sent;
+      }
+   }
+
+   return TRUE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_Serve                                                       */
+/*                                                                            */
+/*!\brief  Reads one request from a connection and answers it                */
+/*                                                                            */
+/*!\param   P_OMX_WORKER_STRUCT  the worker, whose buffers are used          */
+/*!\param   SOCKET          the connection                                    */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Only the request line is looked at; the rest of the header is    */
+/*!\note    read and ignored.                                                 */
+/*                                                                            */
+/******************************************************************************/
+static void OMX_Serve( P_OMX_WORKER_STRUCT pWorker, SOCKET Socket )
+{
+   OMX_TEXT_STRUCT   Text = { pWorker->Header, pWorker->Header + sizeof( pWorker->Header ), FALSE };
+   uint32_t          Got = 0,
+                     Bytes,
+                     Count = 1;
+   uint64_t          Start,
+                     Us;
+   LONG              Max;
+   int               Read;
+
+   do
+   {
+      if ( ( Got == sizeof( pWorker->Request ) - 1 ) ||
+           ( ( Read = recv( Socket, &pWorker->Request[ Got ], sizeof( pWorker->Request ) - 1 - Got, 0 ) ) <= 0 ) )
+      {
+         InterlockedIncrement64( &OmxErrors );
+         return;
+      }
+
+      Got += Read;
+      pWorker->Request[ Got ] = '\0';
+   } while ( strstr( pWorker->Request, "\r\n\r\n" ) == NULL );
+
+   if ( strncmp( pWorker->Request, "GET ", 4 ) != 0 )
+       {
+          pWorker->Buffers[ 0 ].buf = ( char * ) OmxBadMethod;
+          pWorker->Buffers[ 0 ].len = sizeof( OmxBadMethod ) - 1;
+          InterlockedIncrement64( &OmxRejected );
+       }
+   else if ( ( strncmp( &pWorker->Request[ 4 ], "/metrics", 8 ) != 0 ) ||
+             ( ( pWorker->Request[ 12 ] != ' ' ) && ( pWorker->Request[ 12 ] != '?' ) ) )
+       {
+          pWorker->Buffers[ 0 ].buf = ( char * ) OmxNotFound;
+          pWorker->Buffers[ 0 ].len = sizeof( OmxNotFound ) - 1;
+          InterlockedIncrement64( &OmxRejected );
+       }
+   else
+       {
+          Start = EC_GetMicroSecs();
+
+          AcquireSRWLockShared( &OmxSnapshotLock );
+          pWorker->Snapshot = OmxSnapshot;
+          ReleaseSRWLockShared( &OmxSnapshotLock );
+
+          if ( ( Bytes = OMX_Render( &pWorker->Snapshot, pWorker->Body, sizeof( pWorker->Body ) ) ) == 0 )
+              {
+                 pWorker->Buffers[ 0 ].buf = ( char * ) OmxTooBig;
+                 pWorker->Buffers[ 0 ].len = sizeof( OmxTooBig ) - 1;
+                 InterlockedIncrement64( &OmxErrors );
+              }
+          else
+              {
+                 OMX_Put( &Text, "HTTP/1.1 200 OK\r\n"
+                                 "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                                 "Content-Length: " );
+                 OMX_PutNumber( &Text, Bytes );
+                 OMX_Put( &Text, "\r\nConnection: close\r\n\r\n" );
+
+                 pWorker->Buffers[ 0 ].buf = pWorker->Header;
+                 pWorker->Buffers[ 0 ].len = ( ULONG )( Text.pNext - pWorker->Header );
+                 pWorker->Buffers[ 1 ].buf = pWorker->Body;
+                 pWorker->Buffers[ 1 ].len = Bytes;
+                 Count = 2;
+
+                 Us = EC_GetMicroSecs() - Start;
+
+                 InterlockedIncrement64( &OmxScrapes );
+                 InterlockedExchangeAdd64( &OmxRenderUs, Us );
+                 InterlockedExchange( &OmxLastBytes, Bytes );
+
+                 while ( ( ( Max = OmxMaxRenderUs ) < ( LONG ) Us ) &&
+                         ( InterlockedCompareExchange( &OmxMaxRenderUs, ( LONG ) Us, Max ) != Max ) )
+                 {
+                 }
+              }
+       }
+
+   if ( ! OMX_Send( Socket, pWorker->Buffers, Count ) )
+   {
+      InterlockedIncrement64( &OmxErrors );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_WorkerThread                                                */
+/*                                                                            */
+/*!\brief  Accepts connections and answers them, one at a time              */
+/*                                                                            */
+/*!\param   LPVOID          the worker                                        */
+/*!\return  DWORD           0                                                 */
+/*                                                                            */
+/*!\note    Every worker blocks in accept() on the same listener; closing it  */
+/*!\note    in OMX_Stop ends them all.                                        */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI OMX_WorkerThread( LPVOID pParam )
+{
+   P_OMX_WORKER_STRUCT   pWorker = ( P_OMX_WORKER_STRUCT ) pParam;
+   DWORD                 Timeout = OMX_RECEIVE_TIMEOUT_MS;
+   SOCKET                Socket;
+
+   while ( ( Socket = accept( OmxListener, NULL, NULL ) ) != INVALID_SOCKET )
+   {
+      setsockopt( Socket, SOL_SOCKET, SO_RCVTIMEO, ( const char * ) &Timeout, sizeof( Timeout ) );
+
+      OMX_Serve( pWorker, Socket );
+
+      closesocket( Socket );
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_Shutdown                                                    */
+/*                                                                            */
+/*!\brief  Stops and closes whatever OMX_Start got as far as creating        */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called with OmxControlLock held exclusively                      */
+/*                                                                            */
+/******************************************************************************/
+static void OMX_Shutdown( void )
+{
+   uint32_t   Index;
+
+   if ( OmxStopEvent )
+   {
+      SetEvent( OmxStopEvent );
+   }
+
+   if ( OmxListener != INVALID_SOCKET )
+   {
+      closesocket( OmxListener );
+      OmxListener = INVALID_SOCKET;
+   }
+
+   for ( Index = 0; Index < OMX_WORKER_COUNT; Index++ )
+   {
+      if ( OmxWorkers[ Index ].Thread )
+      {
+         WaitForSingleObject( OmxWorkers[ Index ].Thread, INFINITE );
+         CloseHandle( OmxWorkers[ Index ].Thread );
+         OmxWorkers[ Index ].Thread = NULL;
+      }
+   }
+
+   if ( OmxRefreshThread )
+   {
+      WaitForSingleObject( OmxRefreshThread, INFINITE );
+      CloseHandle( OmxRefreshThread );
+      OmxRefreshThread = NULL;
+   }
+
+   if ( OmxStopEvent )
+   {
+      CloseHandle( OmxStopEvent );
+      OmxStopEvent = NULL;
+   }
+
+   WSACleanup();
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_Start                                                       */
+/*                                                                            */
+/*!\brief  Starts serving OpenMetrics scrapes on 127.0.0.1                    */
+/*                                                                            */
+/*!\param   uint16_t        TCP port to listen on                             */
+/*!\param   uint32_t        msecs between snapshots                           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Takes the first snapshot before returning, so the first scrape   */
+/*!\note    already has the WDT state and counters                           */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR OMX_Start( uint16_t Port, uint32_t RefreshMs )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   WSADATA        WsaData;
+   SOCKADDR_IN    Address;
+   uint32_t       Index;
+
+   if ( ( Port == 0 ) || ( RefreshMs == 0 ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockExclusive( &OmxControlLock );
+
+   if ( OmxRunning )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ALREADY_RUNNING );
+       }
+   else if ( WSAStartup( MAKEWORD( 2, 2 ), &WsaData ) != 0 )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+       }
+   else
+       {
+          memset( &Address, 0, sizeof( Address ) );
+          Address.sin_family = AF_INET;
+          Address.sin_port = htons( Port );
+          Address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+          OmxRefreshMs = RefreshMs;
+          OmxStopEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
+
+          if ( ( OmxListener = socket( AF_INET, SOCK_STREAM, IPPROTO_TCP ) ) != INVALID_SOCKET )
+          {
+             if ( ( bind( OmxListener, ( SOCKADDR * ) &Address, sizeof( Address ) ) != 0 ) ||
+                  ( listen( OmxListener, SOMAXCONN ) != 0 ) )
+             {
+                closesocket( OmxListener );
+                OmxListener = INVALID_SOCKET;
+             }
+          }
+
+          if ( ( OmxStopEvent == NULL ) || ( OmxListener == INVALID_SOCKET ) )
+          {
+             Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+          }
+
+          if ( Results == STATUS_SUCCESS )
+          {
+             OMX_TakeSnapshot();
+
+             if ( ( OmxRefreshThread = CreateThread( NULL, 0, OMX_RefreshThread, NULL, 0, NULL ) ) == NULL )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+             }
+          }
+
+          for ( Index = 0; ( Index < OMX_WORKER_COUNT ) && ( Results == STATUS_SUCCESS ); Index++ )
+          {
+             if ( ( OmxWorkers[ Index ].Thread = CreateThread( NULL, 0, OMX_WorkerThread, &OmxWorkers[ Index ], 0, NULL ) ) == NULL )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+             }
+          }
+
+          if ( Results == STATUS_SUCCESS )
+              {
+                 OmxRunning = TRUE;
+              }
+          else
+              {
+                 OMX_Shutdown();
+              }
+       }
+
+   ReleaseSRWLockExclusive( &OmxControlLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_Stop                                                        */
+/*                                                                            */
+/*!\brief  Stops the exporter                                                 */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    A scrape being answered is finished first; one whose request is  */
+/*!\note    still arriving may hold this up to OMX_RECEIVE_TIMEOUT_MS.        */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR OMX_Stop( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   AcquireSRWLockExclusive( &OmxControlLock );
+
+   if ( OmxRunning )
+       {
+          OMX_Shutdown();
+          OmxRunning = FALSE;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockExclusive( &OmxControlLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OMX_GetStats                                                    */
+/*                                                                            */
+/*!\brief  Returns the exporter's counters                                    */
+/*                                                                            */
+/*!\param   P_OMX_STATS_STRUCT  pointer to return the counters in             */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The counters keep counting across OMX_Stop and OMX_Start          */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR OMX_GetStats( P_OMX_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStats )
+       {
+          pStats->Scrapes = OmxScrapes;
+          pStats->Rejected = OmxRejected;
+          pStats->Errors = OmxErrors;
+          pStats->Refreshes = OmxRefreshes;
+          pStats->RenderUs = OmxRenderUs;
+          pStats->MaxRenderUs = OmxMaxRenderUs;
+          pStats->LastBytes = OmxLastBytes;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
@@ -0,0 +1,792 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Governor.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the thermal governor - a thread running a PID
+//      loop from the temperatures to a smart fan target register, with
+//      deadband limited writes, override and fail-safe modes, and period
+//      jitter statistics.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <math.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Governor.h>
+#include "ITE8528_EC_Internal.h"
+#include "ITE8528_EC_RegMap.h"
+
+
+#define GOV_INPUT_MASK              ( EC_SENSOR_MASK( SENSOR_CPU_TEMP ) | EC_SENSOR_MASK( SENSOR_SYS_TEMP ) )
+
+/*!\struct _GOV_LOOP_STRUCT
+ * \brief  The loop state, touched only by the governor thread while it runs
+ */
+typedef struct _GOV_LOOP_STRUCT {
+                                   GOV_MODE_ENUM_TYPE       Mode;
+                                   GOV_FAILSAFE_ENUM_TYPE   Reason;
+                                   uint32_t                 RequestSeq;     // last request acted on
+                                   uint8_t                  Bias;           // target register value at start
+                                   uint8_t                  Override;       // GOV_MODE_OVERRIDE output
+                                   uint8_t                  Output;         // last value written
+                                   uint8_t                  Reserved;
+                                   uint16_t                 Rpm;
+                                   uint16_t                 Reserved2;
+                                   uint64_t                 Writes;
+                                   uint64_t                 Suppressed;
+                                   uint32_t                 Errors;
+                                   double                   TempC;
+                                   double                   Derivative;     // smoothed d(TempC)/dt
+                                   double                   Integral;
+                                   double                   Demand;
+                                   uint64_t                 ReadUs;         // when TempC was read, 0 before the first
+                                   uint64_t                 WrittenUs;      // when Output was written
+                                   uint32_t                 ErrorRun;       // EC failures in a row
+                                   uint32_t                 StallRun;       // stalled periods in a row
+                                   double                   JitterMean;     // Welford, over every period
+                                   double                   JitterM2;
+
+                                } GOV_LOOP_STRUCT, *P_GOV_LOOP_STRUCT;
+
+static SRWLOCK               GovLock = SRWLOCK_INIT;                  // guards the requests and GovStatus
+static GOV_STATUS_STRUCT     GovStatus;
+static uint32_t              GovRequestSeq = 0;
+static GOV_MODE_ENUM_TYPE    GovRequestMode;
+static uint8_t               GovRequestOutput;
+
+static HANDLE                GovThread = NULL;
+static HANDLE                GovStopEvent = NULL;
+static GOV_CONFIG_STRUCT     GovConfig;                               // only changed while stopped
+static GOV_LOOP_STRUCT       GovLoop;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_ReadTarget                                                  */
+/*                                                                            */
+/*!\brief  Reads the smart fan target register being driven                 */
+/*                                                                            */
+/*!\param   puint16_t       where to store the value                          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR GOV_ReadTarget( puint16_t pValue )
+{
+   return ( GovConfig.Target == GOV_TARGET_2 ) ? ite8528::EcRead< ite8528::EcRegSmartFanTarget2 >( pValue ) :
+                                                 ite8528::EcRead< ite8528::EcRegSmartFanTarget1 >( pValue );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_WriteTarget                                                 */
+/*                                                                            */
+/*!\brief  Writes the smart fan target register being driven                */
+/*                                                                            */
+/*!\param   uint8_t         the value                                         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR GOV_WriteTarget( uint8_t Value )
+{
+   return ( GovConfig.Target == GOV_TARGET_2 ) ? ite8528::EcWrite< ite8528::EcRegSmartFanTarget2 >( Value ) :
+                                                 ite8528::EcWrite< ite8528::EcRegSmartFanTarget1 >( Value );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_PostMode                                                    */
+/*                                                                            */
+/*!\brief  Posts an EVT_CLASS_GOVERNOR event for a change of mode            */
+/*                                                                            */
+/*!\param   GOV_MODE_ENUM_TYPE      the new mode                              */
+/*!\param   GOV_FAILSAFE_ENUM_TYPE  why, for GOV_MODE_FAILSAFE                */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void GOV_PostMode( GOV_MODE_ENUM_TYPE Mode, GOV_FAILSAFE_ENUM_TYPE Reason )
+{
+   EC_EVENT_STRUCT   Event = { EVT_CLASS_GOVERNOR };
+
+   Event.Param = ( uint8_t ) Mode;
+   Event.Id = ( uint16_t ) Reason;
+   Event.TimestampUs = EC_GetMicroSecs();
+
+   EVT_Post( &Event );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_SetMode                                                     */
+/*                                                                            */
+/*!\brief  Changes the loop's mode                                           */
+/*                                                                            */
+/*!\param   GOV_MODE_ENUM_TYPE      the new mode                              */
+/*!\param   GOV_FAILSAFE_ENUM_TYPE  why, for GOV_MODE_FAILSAFE                */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called on the governor thread                                    */
+/*                                                                            */
+/******************************************************************************/
+static void GOV_SetMode( GOV_MODE_ENUM_TYPE Mode, GOV_FAILSAFE_ENUM_TYPE Reason )
+{
+   if ( GovLoop.Mode != Mode )
+   {
+      GovLoop.Mode = Mode;
+      GovLoop.Reason = Reason;
+
+      GOV_PostMode( Mode, Reason );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Control                                                     */
+/*                                                                            */
+/*!\brief  Runs one step of the PID loop                                     */
+/*                                                                            */
+/*!\param   double          seconds since the previous step                   */
+/*!\return  double          the demanded output, before clamping             */
+/*                                                                            */
+/*!\note    The integral only moves when doing so does not push the demand   */
+/*!\note    further past OutputMin or OutputMax, so it cannot wind up while  */
+/*!\note    the output is saturated.                                          */
+/*                                                                            */
+/******************************************************************************/
+static double GOV_Control( double Seconds )
+{
+   double   Error = GovLoop.TempC - GovConfig.SetpointC,
+            Fixed = GovLoop.Bias + GovConfig.Kp * Error + GovConfig.Kd * GovLoop.Derivative,
+            Step = GovConfig.Ki * Error * Seconds,
+            Demand = Fixed + GovLoop.Integral + Step;
+
+   if ( ( ( Demand > GovConfig.OutputMax ) && ( Step > 0.0 ) ) || ( ( Demand < GovConfig.OutputMin ) && ( Step < 0.0 ) ) )
+       {
+          Demand -= Step;
+       }
+   else
+       {
+          GovLoop.Integral += Step;
+       }
+
+   return Demand;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Request                                                     */
+/*                                                                            */
+/*!\brief  Acts on the last mode request from the application               */
+/*                                                                            */
+/*!\param   GOV_MODE_ENUM_TYPE  the mode asked for                            */
+/*!\param   uint8_t             the output, for GOV_MODE_OVERRIDE             */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Resuming sets the integral so the loop starts from the value     */
+/*!\note    last written, without a bump.                                     */
+/*                                                                            */
+/******************************************************************************/
+static void GOV_Request( GOV_MODE_ENUM_TYPE Mode, uint8_t Output )
+{
+   if ( Mode == GOV_MODE_AUTO )
+       {
+          if ( GovLoop.Mode != GOV_MODE_AUTO )
+          {
+             GovLoop.Integral = GovLoop.Output - GovLoop.Bias - GovConfig.Kp * ( GovLoop.TempC - GovConfig.SetpointC ) -
+                                GovConfig.Kd * GovLoop.Derivative;
+             GovLoop.ErrorRun = 0;
+             GovLoop.StallRun = 0;
+
+             GOV_SetMode( GOV_MODE_AUTO, GOV_FAILSAFE_NONE );
+          }
+       }
+   else if ( Mode == GOV_MODE_OVERRIDE )
+       {
+          GovLoop.Override = Output;
+
+          if ( GovLoop.Mode != GOV_MODE_FAILSAFE )
+          {
+             GOV_SetMode( GOV_MODE_OVERRIDE, GOV_FAILSAFE_NONE );
+          }
+       }
+   else
+       {
+          GOV_SetMode( GOV_MODE_FAILSAFE, GOV_FAILSAFE_FORCED );
+       }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Period                                                      */
+/*                                                                            */
+/*!\brief  Runs one control period - read, check, control and maybe write    */
+/*                                                                            */
+/*!\param   uint64_t        time the period started, in usecs                 */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called on the governor thread                                    */
+/*                                                                            */
+/******************************************************************************/
+static void GOV_Period( uint64_t NowUs )
+{
+   EC_SAMPLE_STRUCT     Sample;
+   GOV_MODE_ENUM_TYPE   RequestMode;
+   uint8_t              RequestOutput,
+                        Output;
+   uint32_t             RequestSeq;
+   BOOL                 ReadOk,
+                        Write;
+   double               Seconds = 0.0;
+
+   AcquireSRWLockShared( &GovLock );
+   RequestSeq = GovRequestSeq;
+   RequestMode = GovRequestMode;
+   RequestOutput = GovRequestOutput;
+   ReleaseSRWLockShared( &GovLock );
+
+   //
+   // one sweep for the temperatures and the fan
+   //
+
+   ReadOk = ( SMP_QuerySensors( GovConfig.InputMask | EC_SENSOR_MASK( SENSOR_CPU_FAN ), &Sample ) == STATUS_SUCCESS );
+
+   if ( ReadOk )
+       {
+          double   TempC = 0.0;
+
+          if ( GovConfig.InputMask & EC_SENSOR_MASK( SENSOR_CPU_TEMP ) )
+          {
+             TempC = Sample.Raw[ SENSOR_CPU_TEMP ];
+          }
+
+          if ( ( GovConfig.InputMask & EC_SENSOR_MASK( SENSOR_SYS_TEMP ) ) && ( Sample.Raw[ SENSOR_SYS_TEMP ] > TempC ) )
+          {
+             TempC = Sample.Raw[ SENSOR_SYS_TEMP ];
+          }
+
+          if ( GovLoop.ReadUs )
+          {
+             Seconds = ( NowUs - GovLoop.ReadUs ) / 1000000.0;
+             GovLoop.Derivative += GovConfig.DerivativeAlpha * ( ( TempC - GovLoop.TempC ) / Seconds - GovLoop.Derivative );
+          }
+
+          GovLoop.TempC = TempC;
+          GovLoop.ReadUs = NowUs;
+          GovLoop.Rpm = Sample.Raw[ SENSOR_CPU_FAN ];
+          GovLoop.ErrorRun = 0;
+       }
+   else
+       {
+          GovLoop.ErrorRun++;
+          GovLoop.Errors++;
+       }
+
+   if ( RequestSeq != GovLoop.RequestSeq )
+   {
+      GovLoop.RequestSeq = RequestSeq;
+      GOV_Request( RequestMode, RequestOutput );
+   }
+
+   //
+   // fail-safe latches until GOV_Resume()
+   //
+
+   if ( GovLoop.Mode != GOV_MODE_FAILSAFE )
+   {
+      if ( ( ReadOk ) && ( GovConfig.StallRpm ) && ( GovLoop.Output > GovConfig.OutputMin ) && ( GovLoop.Rpm < GovConfig.StallRpm ) )
+          {
+             GovLoop.StallRun++;
+          }
+      else if ( ReadOk )
+          {
+             GovLoop.StallRun = 0;
+          }
+
+      if ( GovLoop.ErrorRun >= GovConfig.MaxErrors )
+          {
+             GOV_SetMode( GOV_MODE_FAILSAFE, GOV_FAILSAFE_EC_ERRORS );
+          }
+      else if ( ( GovConfig.FailsafeTempC > 0.0 ) && ( GovLoop.TempC >= GovConfig.FailsafeTempC ) )
+          {
+             GOV_SetMode( GOV_MODE_FAILSAFE, GOV_FAILSAFE_OVER_TEMP );
+          }
+      else if ( ( GovConfig.StallRpm ) && ( GovLoop.StallRun >= GovConfig.StallPeriods ) )
+          {
+             GOV_SetMode( GOV_MODE_FAILSAFE, GOV_FAILSAFE_FAN_STALL );
+          }
+   }
+
+   //
+   // work out the output and whether it is worth a write
+   //
+
+   if ( GovLoop.Mode == GOV_MODE_AUTO )
+       {
+          if ( ReadOk )
+          {
+             GovLoop.Demand = GOV_Control( Seconds );
+          }
+
+          Output = ( uint8_t )( ( GovLoop.Demand <= GovConfig.OutputMin ) ? GovConfig.OutputMin :
+                                ( GovLoop.Demand >= GovConfig.OutputMax ) ? GovConfig.OutputMax : lround( GovLoop.Demand ) );
+
+          Write = ( Output >= GovLoop.Output + GovConfig.Deadband ) || ( Output + GovConfig.Deadband <= GovLoop.Output ) ||
+                  ( ( Output != GovLoop.Output ) && ( ( Output == GovConfig.OutputMin ) || ( Output == GovConfig.OutputMax ) ) );
+       }
+   else
+       {
+          Output = ( GovLoop.Mode == GOV_MODE_OVERRIDE ) ? GovLoop.Override : GovConfig.FailsafeOutput;
+          GovLoop.Demand = Output;
+
+          Write = ( Output != GovLoop.Output );
+       }
+
+   if ( ( GovConfig.RefreshMs ) && ( NowUs - GovLoop.WrittenUs >= GovConfig.RefreshMs * 1000ull ) )
+   {
+      Write = TRUE;
+   }
+
+   if ( Write )
+       {
+          if ( GOV_WriteTarget( Output ) == STATUS_SUCCESS )
+              {
+                 GovLoop.Output = Output;
+                 GovLoop.WrittenUs = NowUs;
+                 GovLoop.Writes++;
+              }
+          else
+              {
+                 GovLoop.ErrorRun++;                       // tried again next period
+                 GovLoop.Errors++;
+              }
+       }
+   else if ( Output != GovLoop.Output )
+       {
+          GovLoop.Suppressed++;
+       }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Publish                                                     */
+/*                                                                            */
+/*!\brief  Updates GovStatus at the end of a period                          */
+/*                                                                            */
+/*!\param   int32_t         how late the period started, in usecs            */
+/*!\param   uint32_t        how long the period took, in usecs               */
+/*!\param   uint32_t        periods skipped after it                          */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static void GOV_Publish( int32_t JitterUs, uint32_t LoopUs, uint32_t Skipped )
+{
+   uint64_t   Periods = GovStatus.Periods + 1;
+   double     Delta = JitterUs - GovLoop.JitterMean;
+
+   GovLoop.JitterMean += Delta / Periods;
+   GovLoop.JitterM2 += Delta * ( JitterUs - GovLoop.JitterMean );
+
+   AcquireSRWLockExclusive( &GovLock );
+
+   GovStatus.Mode = GovLoop.Mode;
+   GovStatus.FailsafeReason = GovLoop.Reason;
+   GovStatus.Periods = Periods;
+   GovStatus.Writes = GovLoop.Writes;
+   GovStatus.Suppressed = GovLoop.Suppressed;
+   GovStatus.Errors = GovLoop.Errors;
+   GovStatus.Overruns += Skipped;
+   GovStatus.TempC = GovLoop.TempC;
+   GovStatus.Demand = GovLoop.Demand;
+   GovStatus.Integral = GovLoop.Integral;
+   GovStatus.Rpm = GovLoop.Rpm;
+   GovStatus.Output = GovLoop.Output;
+   GovStatus.JitterLastUs = JitterUs;
+   GovStatus.JitterMinUs = ( ( Periods == 1 ) || ( JitterUs < GovStatus.JitterMinUs ) ) ? JitterUs : GovStatus.JitterMinUs;
+   GovStatus.JitterMaxUs = ( ( Periods == 1 ) || ( JitterUs > GovStatus.JitterMaxUs ) ) ? JitterUs : GovStatus.JitterMaxUs;
+   GovStatus.JitterMeanUs = GovLoop.JitterMean;
+   GovStatus.JitterStdDevUs = ( Periods > 1 ) ? sqrt( GovLoop.JitterM2 / ( Periods - 1 ) ) : 0.0;
+   GovStatus.LoopLastUs = LoopUs;
+   GovStatus.LoopMaxUs = ( LoopUs > GovStatus.LoopMaxUs ) ? LoopUs : GovStatus.LoopMaxUs;
+
+   ReleaseSRWLockExclusive( &GovLock );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Thread                                                      */
+/*                                                                            */
+/*!\brief  The governor thread                                               */
+/*                                                                            */
+/*!\param   LPVOID          not used                                          */
+/*!\return  DWORD           0                                                 */
+/*                                                                            */
+/*!\note    Each period is due PeriodMs after the previous one was due, not  */
+/*!\note    after it finished, so the rate does not drift. A period that     */
+/*!\note    runs past the next one skips it rather than running back to back. */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI GOV_Thread( LPVOID pParam )
+{
+   uint64_t   PeriodUs = GovConfig.PeriodMs * 1000ull,
+              DueUs = EC_GetMicroSecs(),
+              StartUs,
+              DoneUs;
+   int32_t    JitterUs;
+   uint32_t   Skipped;
+   DWORD      WaitMs;
+
+   UNREFERENCED_PARAMETER( pParam );
+
+   do
+   {
+      StartUs = EC_GetMicroSecs();
+      JitterUs = ( int32_t )( ( int64_t ) StartUs - ( int64_t ) DueUs );
+
+      GOV_Period( StartUs );
+
+      DoneUs = EC_GetMicroSecs();
+
+      for ( Skipped = 0, DueUs += PeriodUs; DueUs <= DoneUs; DueUs += PeriodUs )
+      {
+         Skipped++;
+      }
+
+      GOV_Publish( JitterUs, ( uint32_t )( DoneUs - StartUs ), Skipped );
+
+      WaitMs = ( DWORD )( ( DueUs - DoneUs + 999 ) / 1000 );       // never early by a part millisecond
+
+   } while ( WaitForSingleObject( GovStopEvent, WaitMs ) == WAIT_TIMEOUT );
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_GetDefaultConfig                                            */
+/*                                                                            */
+/*!\brief  Fills in the default governor config                              */
+/*                                                                            */
+/*!\param   P_GOV_CONFIG_STRUCT  where to store the config                    */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Both temperatures, target register 1 over its full range, and no */
+/*!\note    stall check - a fan may legitimately stop at low targets.         */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR GOV_GetDefaultConfig( P_GOV_CONFIG_STRUCT pConfig )
+{
+   if ( pConfig == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   memset( pConfig, 0, sizeof( *pConfig ) );
+
+   pConfig->PeriodMs = GOV_DEFAULT_PERIOD_MS;
+   pConfig->InputMask = GOV_INPUT_MASK;
+   pConfig->Target = GOV_TARGET_1;
+   pConfig->OutputMin = 0x00;
+   pConfig->OutputMax = 0xFF;
+   pConfig->Deadband = GOV_DEFAULT_DEADBAND;
+   pConfig->FailsafeOutput = 0xFF;
+   pConfig->RestoreOnStop = 1;
+   pConfig->StallPeriods = GOV_DEFAULT_STALL_PERIODS;
+   pConfig->MaxErrors = GOV_DEFAULT_MAX_ERRORS;
+   pConfig->RefreshMs = GOV_DEFAULT_REFRESH_MS;
+   pConfig->SetpointC = GOV_DEFAULT_SETPOINT_C;
+   pConfig->Kp = GOV_DEFAULT_KP;
+   pConfig->Ki = GOV_DEFAULT_KI;
+   pConfig->Kd = GOV_DEFAULT_KD;
+   pConfig->DerivativeAlpha = GOV_DEFAULT_DERIVATIVE_ALPHA;
+   pConfig->FailsafeTempC = GOV_DEFAULT_FAILSAFE_TEMP_C;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Start                                                       */
+/*                                                                            */
+/*!\brief  Starts the governor thread                                        */
+/*                                                                            */
+/*!\param   P_GOV_CONFIG_STRUCT  the config, NULL for the defaults           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Reads the target register first, which becomes the bias. The EC */
+/*!\note    smart fan config is left alone - the firmware must be in a mode  */
+/*!\note    that follows the target register.                                 */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR GOV_Start( P_GOV_CONFIG_STRUCT pConfig )
+{
+   WINSYS_ERROR        Results;
+   GOV_CONFIG_STRUCT   Config;
+   uint16_t            Bias;
+
+   if ( GovThread != NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ALREADY_RUNNING );
+   }
+
+   if ( pConfig )
+       {
+          Config = *pConfig;
+       }
+   else
+       {
+          GOV_GetDefaultConfig( &Config );
+       }
+
+   if ( ( Config.PeriodMs < GOV_MIN_PERIOD_MS ) || ( ( Config.InputMask & GOV_INPUT_MASK ) == 0 ) || ( Config.InputMask & ~GOV_INPUT_MASK ) ||
+        ( ( Config.Target != GOV_TARGET_1 ) && ( Config.Target != GOV_TARGET_2 ) ) || ( Config.OutputMin > Config.OutputMax ) ||
+        ( Config.Deadband == 0 ) || ( Config.MaxErrors == 0 ) || ( ( Config.StallRpm ) && ( Config.StallPeriods == 0 ) ) ||
+        ( Config.DerivativeAlpha <= 0.0 ) || ( Config.DerivativeAlpha > 1.0 ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   GovConfig = Config;
+
+   if ( ( Results = GOV_ReadTarget( &Bias ) ) != STATUS_SUCCESS )
+   {
+      return Results;
+   }
+
+   memset( &GovLoop, 0, sizeof( GovLoop ) );
+   GovLoop.Mode = GOV_MODE_AUTO;
+   GovLoop.Bias = ( uint8_t ) Bias;
+   GovLoop.Output = ( uint8_t ) Bias;
+   GovLoop.Demand = ( uint8_t ) Bias;
+   GovLoop.WrittenUs = EC_GetMicroSecs();
+
+   AcquireSRWLockExclusive( &GovLock );
+   memset( &GovStatus, 0, sizeof( GovStatus ) );
+   GovStatus.Mode = GOV_MODE_AUTO;
+   GovStatus.Bias = ( uint8_t ) Bias;
+   GovStatus.Output = ( uint8_t ) Bias;
+   GovLoop.RequestSeq = GovRequestSeq;
+   ReleaseSRWLockExclusive( &GovLock );
+
+   if ( ( GovStopEvent = CreateEvent( NULL, TRUE, FALSE, NULL ) ) != NULL )
+   {
+      GovThread = CreateThread( NULL, 0, GOV_Thread, NULL, 0, NULL );
+   }
+
+   if ( GovThread == NULL )
+   {
+      if ( GovStopEvent )
+      {
+         CloseHandle( GovStopEvent );
+         GovStopEvent = NULL;
+      }
+
+      AcquireSRWLockExclusive( &GovLock );
+      GovStatus.Mode = GOV_MODE_STOPPED;
+      ReleaseSRWLockExclusive( &GovLock );
+
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+   }
+
+   GOV_PostMode( GOV_MODE_AUTO, GOV_FAILSAFE_NONE );
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Stop                                                        */
+/*                                                                            */
+/*!\brief  Stops the governor thread and waits for it to exit                */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    With RestoreOnStop the bias is written back, handing the fan     */
+/*!\note    back to the EC as it was found.                                   */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR GOV_Stop( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( GovThread == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+   }
+
+   SetEvent( GovStopEvent );
+   WaitForSingleObject( GovThread, INFINITE );
+
+   CloseHandle( GovThread );
+   CloseHandle( GovStopEvent );
+   GovThread = NULL;
+   GovStopEvent = NULL;
+
+   AcquireSRWLockExclusive( &GovLock );
+
+   if ( GovConfig.RestoreOnStop )
+   {
+      if ( ( Results = GOV_WriteTarget( GovStatus.Bias ) ) == STATUS_SUCCESS )
+      {
+         GovStatus.Output = GovStatus.Bias;
+      }
+   }
+
+   GovStatus.Mode = GOV_MODE_STOPPED;
+   ReleaseSRWLockExclusive( &GovLock );
+
+   GOV_PostMode( GOV_MODE_STOPPED, GOV_FAILSAFE_NONE );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Ask                                                         */
+/*                                                                            */
+/*!\brief  Queues a mode request for the governor thread                     */
+/*                                                                            */
+/*!\param   GOV_MODE_ENUM_TYPE  the mode asked for                            */
+/*!\param   uint8_t             the output, for GOV_MODE_OVERRIDE             */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Acted on at the start of the next period; only the last request  */
+/*!\note    made before then counts.                                          */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR GOV_Ask( GOV_MODE_ENUM_TYPE Mode, uint8_t Output )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   AcquireSRWLockExclusive( &GovLock );
+
+   if ( GovThread != NULL )
+       {
+          GovRequestMode = Mode;
+          GovRequestOutput = Output;
+          GovRequestSeq++;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockExclusive( &GovLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_SetOverride                                                 */
+/*                                                                            */
+/*!\brief  Holds the target register at a fixed value                        */
+/*                                                                            */
+/*!\param   uint8_t         the value                                         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The loop keeps reading and checking for fail-safe, which still   */
+/*!\note    takes over. GOV_Resume() hands back to the loop.                 */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR GOV_SetOverride( uint8_t Output )
+{
+   return GOV_Ask( GOV_MODE_OVERRIDE, Output );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Failsafe                                                    */
+/*                                                                            */
+/*!\brief  Puts the governor into fail-safe                                  */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR GOV_Failsafe( void )
+{
+   return GOV_Ask( GOV_MODE_FAILSAFE, 0 );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_Resume                                                      */
+/*                                                                            */
+/*!\brief  Returns to the PID loop from override or fail-safe                */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    If the cause of a fail-safe is still there it trips again.       */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR GOV_Resume( void )
+{
+   return GOV_Ask( GOV_MODE_AUTO, 0 );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: GOV_GetStatus                                                   */
+/*                                                                            */
+/*!\brief  Returns the state of the governor as of the last period           */
+/*                                                                            */
+/*!\param   P_GOV_STATUS_STRUCT  where to store the status                    */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Kept after GOV_Stop(), until the next GOV_Start()                */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR GOV_GetStatus( P_GOV_STATUS_STRUCT pStatus )
+{
+   if ( pStatus == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockShared( &GovLock );
+   *pStatus = GovStatus;
+   ReleaseSRWLockShared( &GovLock );
+
+   return STATUS_SUCCESS;
+}
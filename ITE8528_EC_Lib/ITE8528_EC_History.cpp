@@ -0,0 +1,1140 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_History.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the sample history store - the memory mapped ring
+//      of blocks, the sample encoder and decoder, and range queries.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_History.h>
+#include "ITE8528_EC_Internal.h"
+
+
+#define HIST_MAX_RECORD             ( 5 + 10 + SENSOR_COUNT * 3 )      // 32 bit control, 64 bit varint, 16 bit varints
+#define HIST_TIME_FLAG              0x01
+#define HIST_SENSOR_FLAG( Sensor )  ( 2u << ( Sensor ) )
+
+static_assert( SENSOR_COUNT < 32, "the record control word holds the time flag and one bit per sensor" );
+#define HIST_NO_BLOCK               0xffffffff
+
+static SRWLOCK                      HistLock = SRWLOCK_INIT;           // one writer, many readers in this process
+static HANDLE                       HistFile = INVALID_HANDLE_VALUE;
+static HANDLE                       HistMapping = NULL;
+static uint8_t                      *pHistView = NULL;
+static uint32_t                     HistBlockCount = 0;
+static uint32_t                     HistActive = HIST_NO_BLOCK;        // block being appended to
+
+//
+// encoder state for the active block, rebuilt by decoding it on open
+//
+
+static uint64_t                     HistLastMs;
+static int64_t                      HistLastDeltaMs;
+static uint16_t                     HistLastRaw[ EC_SENSOR_MAX ];
+
+//
+// rollups - a ring of buckets per level, a bucket is in use when its StartMs matches the time it covers
+//
+
+typedef struct _HIST_BUCKET_STRUCT {
+                                      uint64_t     StartMs;
+                                      uint64_t     Sum[ EC_SENSOR_MAX ];
+                                      uint32_t     Count[ EC_SENSOR_MAX ];
+                                      uint32_t     Samples;
+                                      uint16_t     ValidMask;
+                                      uint16_t     Min[ EC_SENSOR_MAX ];
+                                      uint16_t     Max[ EC_SENSOR_MAX ];
+
+                                   } HIST_BUCKET_STRUCT, *P_HIST_BUCKET_STRUCT;
+
+typedef struct _HIST_LEVEL_STRUCT {
+                                     uint32_t     PeriodMs;
+                                     uint32_t     Buckets;
+                                     uint32_t     First;          // index of its first bucket in HistBuckets
+
+                                  } HIST_LEVEL_STRUCT;
+
+static const HIST_LEVEL_STRUCT      HistLevels[ HIST_ROLLUP_LEVELS ] = {
+                                                                          {    10000, 8640,     0 },
+                                                                          {    60000, 4320,  8640 },
+                                                                          {   600000, 4320, 12960 },
+                                                                          {  3600000, 4392, 17280 }
+                                                                       };
+
+static HIST_BUCKET_STRUCT           HistBuckets[ 17280 + 4392 ];
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_Fnv                                                        */
+/*                                                                            */
+/*!\brief  FNV-1a hash of a byte range, used for the header checksums        */
+/*                                                                            */
+/*!\param   uint32_t        hash so far, 2166136261 to start                  */
+/*!\param   const void *    bytes to add                                      */
+/*!\param   uint32_t        number of bytes                                   */
+/*!\return  uint32_t        updated hash                                      */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t HIST_Fnv( uint32_t Hash, const void *pData, uint32_t Bytes )
+{
+   const uint8_t   *pByte = ( const uint8_t * ) pData;
+
+   while ( Bytes-- )
+   {
+      Hash = ( Hash ^ *pByte++ ) * 16777619;
+   }
+
+   return Hash;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_BlockChecksum                                              */
+/*                                                                            */
+/*!\brief  Checksum of the fields fixed when a block is started              */
+/*                                                                            */
+/*!\param   const HIST_BLOCK_HEADER_STRUCT *   the block                      */
+/*!\return  uint32_t        the checksum                                      */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t HIST_BlockChecksum( const HIST_BLOCK_HEADER_STRUCT *pHeader )
+{
+   uint32_t   Hash = 2166136261;
+
+   Hash = HIST_Fnv( Hash, &pHeader->Sequence, sizeof( pHeader->Sequence ) );
+   Hash = HIST_Fnv( Hash, &pHeader->FirstMs, sizeof( pHeader->FirstMs ) );
+   Hash = HIST_Fnv( Hash, &pHeader->ValidMask, sizeof( pHeader->ValidMask ) );
+   Hash = HIST_Fnv( Hash, pHeader->Base, sizeof( pHeader->Base ) );
+
+   return Hash;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_Block                                                      */
+/*                                                                            */
+/*!\brief  Returns the header of a block of the ring                         */
+/*                                                                            */
+/*!\param   uint32_t        block number, 0 to HistBlockCount - 1             */
+/*!\return  P_HIST_BLOCK_HEADER_STRUCT                                        */
+/*                                                                            */
+/*!\note    Block 0 of the file is the file header, so ring block n is file  */
+/*!\note    block n + 1                                                       */
+/*                                                                            */
+/******************************************************************************/
+static P_HIST_BLOCK_HEADER_STRUCT HIST_Block( uint32_t Block )
+{
+   return ( P_HIST_BLOCK_HEADER_STRUCT )( pHistView + ( ( size_t ) Block + 1 ) * HIST_BLOCK_SIZE );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_BlockValid                                                 */
+/*                                                                            */
+/*!\brief  Checks that a block was completely started                        */
+/*                                                                            */
+/*!\param   const HIST_BLOCK_HEADER_STRUCT *   the block                      */
+/*!\return  BOOL            TRUE if the block holds samples that can be read  */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static BOOL HIST_BlockValid( const HIST_BLOCK_HEADER_STRUCT *pHeader )
+{
+   return ( pHeader->Sequence != 0 ) &&
+          ( pHeader->Checksum == HIST_BlockChecksum( pHeader ) ) &&
+          ( HIST_COMMIT_SAMPLES( pHeader->Commit ) != 0 ) &&
+          ( HIST_COMMIT_BYTES( pHeader->Commit ) <= HIST_PAYLOAD_SIZE );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_PutVarint                                                  */
+/*                                                                            */
+/*!\brief  Writes an unsigned LEB128 varint                                  */
+/*                                                                            */
+/*!\param   uint8_t *       where to write, room for 10 bytes                 */
+/*!\param   uint64_t        the value                                         */
+/*!\return  uint32_t        bytes written                                     */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t HIST_PutVarint( uint8_t *pOut, uint64_t Value )
+{
+   uint32_t   Bytes = 0;
+
+   while ( Value >= 0x80 )
+   {
+      pOut[ Bytes++ ] = ( uint8_t )( Value | 0x80 );
+      Value >>= 7;
+   }
+
+   pOut[ Bytes++ ] = ( uint8_t ) Value;
+
+   return Bytes;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_GetVarint                                                  */
+/*                                                                            */
+/*!\brief  Reads an unsigned LEB128 varint                                   */
+/*                                                                            */
+/*!\param   const uint8_t * the payload                                       */
+/*!\param   uint32_t *      offset to read at, advanced past the varint       */
+/*!\param   uint32_t        payload bytes                                     */
+/*!\param   uint64_t *      returns the value                                 */
+/*!\return  BOOL            FALSE if the varint runs off the payload          */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static BOOL HIST_GetVarint( const uint8_t *pIn, uint32_t *pOffset, uint32_t Bytes, uint64_t *pValue )
+{
+   uint64_t   Value = 0;
+   uint32_t   Shift = 0;
+
+   while ( ( *pOffset < Bytes ) && ( Shift < 64 ) )
+   {
+      uint8_t   Byte = pIn[ ( *pOffset )++ ];
+
+      Value |= ( uint64_t )( Byte & 0x7f ) << Shift;
+      if ( ( Byte & 0x80 ) == 0 )
+      {
+         *pValue = Value;
+         return TRUE;
+      }
+
+      Shift += 7;
+   }
+
+   return FALSE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_RollupAdd                                                  */
+/*                                                                            */
+/*!\brief  Adds a sample to the bucket covering it at every rollup level    */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample                                    */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    A bucket found holding an older time is restarted, so the ring   */
+/*!\note    never needs sweeping. Samples older than a level's span are      */
+/*!\note    dropped from that level.                                          */
+/*                                                                            */
+/******************************************************************************/
+static void HIST_RollupAdd( P_EC_SAMPLE_STRUCT pSample )
+{
+   uint32_t   Level,
+              Sensor;
+
+   for ( Level = 0; Level < HIST_ROLLUP_LEVELS; Level++ )
+   {
+      const HIST_LEVEL_STRUCT   *pLevel = &HistLevels[ Level ];
+      uint64_t                  Number = pSample->TimestampMs / pLevel->PeriodMs;
+      uint64_t                  StartMs = Number * pLevel->PeriodMs;
+      P_HIST_BUCKET_STRUCT      pBucket = &HistBuckets[ pLevel->First + ( uint32_t )( Number % pLevel->Buckets ) ];
+
+      if ( pBucket->StartMs > StartMs )
+      {
+         continue;
+      }
+
+      if ( ( pBucket->StartMs != StartMs ) || ( pBucket->Samples == 0 ) )
+      {
+         memset( pBucket, 0, sizeof( *pBucket ) );
+         pBucket->StartMs = StartMs;
+      }
+
+      pBucket->Samples++;
+      pBucket->ValidMask |= ( uint16_t )( pSample->ValidMask & EC_SENSOR_MASK_ALL );
+
+      for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+      {
+         uint16_t   Raw = pSample->Raw[ Sensor ];
+
+         if ( ( pSample->ValidMask & EC_SENSOR_MASK( Sensor ) ) == 0 )
+         {
+            continue;
+         }
+
+         if ( ( pBucket->Count[ Sensor ] == 0 ) || ( Raw < pBucket->Min[ Sensor ] ) )
+         {
+            pBucket->Min[ Sensor ] = Raw;
+         }
+
+         if ( ( pBucket->Count[ Sensor ] == 0 ) || ( Raw > pBucket->Max[ Sensor ] ) )
+         {
+            pBucket->Max[ Sensor ] = Raw;
+         }
+
+         pBucket->Sum[ Sensor ] += Raw;
+         pBucket->Count[ Sensor ]++;
+      }
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_Decode                                                     */
+/*                                                                            */
+/*!\brief  Decodes the samples of a block that fall in a time range         */
+/*                                                                            */
+/*!\param   const HIST_BLOCK_HEADER_STRUCT *   the block                      */
+/*!\param   uint64_t            first timestamp wanted                        */
+/*!\param   uint64_t            last timestamp wanted                         */
+/*!\param   P_EC_SAMPLE_STRUCT  buffer for the samples, or NULL to replay    */
+/*!\param                       the block into the rollups                   */
+/*!\param   uint32_t            size of the buffer                            */
+/*!\return  uint32_t            samples returned                              */
+/*                                                                            */
+/*!\note    Reads the commit word once, so a concurrent append is either     */
+/*!\note    wholly seen or not at all. A replay also leaves the last sample   */
+/*!\note    of the block in the encoder state.                                */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t HIST_Decode( const HIST_BLOCK_HEADER_STRUCT *pHeader, uint64_t StartMs, uint64_t EndMs, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples )
+{
+   const uint8_t      *pPayload = ( const uint8_t * )( pHeader + 1 );
+   uint32_t           Commit = *( volatile const uint32_t * ) &pHeader->Commit;
+   uint32_t           Samples = HIST_COMMIT_SAMPLES( Commit );
+   uint32_t           Bytes = HIST_COMMIT_BYTES( Commit );
+   uint32_t           Offset = 0,
+                      Count = 0,
+                      Index,
+                      Sensor;
+   EC_SAMPLE_STRUCT   Sample;
+   int64_t            DeltaMs = 0;
+
+   MemoryBarrier();                                   // payload reads after the commit word
+
+   memset( &Sample, 0, sizeof( Sample ) );
+   Sample.TimestampMs = pHeader->FirstMs;
+   Sample.ValidMask = pHeader->ValidMask;
+   memcpy( Sample.Raw, pHeader->Base, sizeof( Sample.Raw ) );
+
+   for ( Index = 0; Index < Samples; Index++ )
+   {
+      if ( Index > 0 )
+      {
+         uint64_t   Control;
+         uint64_t   Value;
+
+         if ( ! HIST_GetVarint( pPayload, &Offset, Bytes, &Control ) )
+         {
+            break;
+         }
+
+         if ( Control & HIST_TIME_FLAG )
+         {
+            if ( ! HIST_GetVarint( pPayload, &Offset, Bytes, &Value ) )
+            {
+               break;
+            }
+            DeltaMs += ( int64_t )( Value >> 1 ) ^ -( int64_t )( Value & 1 );      // zigzag
+         }
+
+         Sample.TimestampMs += DeltaMs;
+
+         for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+         {
+            if ( Control & HIST_SENSOR_FLAG( Sensor ) )
+            {
+               if ( ! HIST_GetVarint( pPayload, &Offset, Bytes, &Value ) )
+               {
+                  Index = Samples;
+                  break;
+               }
+               Sample.Raw[ Sensor ] ^= ( uint16_t ) Value;
+            }
+         }
+
+         if ( Index == Samples )
+         {
+            break;
+         }
+      }
+
+      if ( pSamples == NULL )
+          {
+             HIST_RollupAdd( &Sample );
+          }
+      else if ( Sample.TimestampMs > EndMs )
+          {
+             break;
+          }
+      else if ( Sample.TimestampMs >= StartMs )
+          {
+             if ( Count == MaxSamples )
+             {
+                break;
+             }
+
+             Sample.Sequence = ( uint32_t )( pHeader->Sequence << 16 ) + Index;
+             pSamples[ Count++ ] = Sample;
+          }
+   }
+
+   if ( pSamples == NULL )
+   {
+      HistLastMs = Sample.TimestampMs;
+      HistLastDeltaMs = DeltaMs;
+      memcpy( HistLastRaw, Sample.Raw, sizeof( HistLastRaw ) );
+   }
+
+   return Count;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_StartBlock                                                 */
+/*                                                                            */
+/*!\brief  Seals the active block and starts the next one with a sample      */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample to start the block with            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    The sequence number is cleared first and set last, so a block     */
+/*!\note    caught half started by a crash fails its checksum                 */
+/*                                                                            */
+/******************************************************************************/
+static void HIST_StartBlock( P_EC_SAMPLE_STRUCT pSample )
+{
+   uint64_t                     Sequence = 1;
+   uint32_t                     Next = 0;
+   P_HIST_BLOCK_HEADER_STRUCT   pHeader;
+
+   if ( HistActive != HIST_NO_BLOCK )
+   {
+      P_HIST_BLOCK_HEADER_STRUCT   pActive = HIST_Block( HistActive );
+
+      pActive->LastMs = HistLastMs;
+      Sequence = pActive->Sequence + 1;
+      Next = ( HistActive + 1 ) % HistBlockCount;
+   }
+
+   pHeader = HIST_Block( Next );
+
+   pHeader->Sequence = 0;
+   pHeader->Checksum = 0;
+   MemoryBarrier();
+
+   pHeader->Commit = 0;
+   pHeader->FirstMs = pSample->TimestampMs;
+   pHeader->LastMs = 0;
+   pHeader->ValidMask = pSample->ValidMask;
+   memcpy( pHeader->Base, pSample->Raw, sizeof( pHeader->Base ) );
+   memset( pHeader->Reserved, 0, sizeof( pHeader->Reserved ) );
+
+   pHeader->Sequence = Sequence;
+   pHeader->Checksum = HIST_BlockChecksum( pHeader );
+   MemoryBarrier();
+
+   InterlockedExchange( ( LONG volatile * ) &pHeader->Commit, ( LONG )( 1 << 16 ) );
+
+   HistActive = Next;
+   HistLastMs = pSample->TimestampMs;
+   HistLastDeltaMs = 0;
+   memcpy( HistLastRaw, pSample->Raw, sizeof( HistLastRaw ) );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_Open                                                       */
+/*                                                                            */
+/*!\brief  Opens or creates the history file and maps it                    */
+/*                                                                            */
+/*!\param   const char *    path of the history file                          */
+/*!\param   uint32_t        blocks in the ring when creating, 0 = default    */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    An existing file keeps its own block count. Appending resumes    */
+/*!\note    after the last committed sample.                                  */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_Open( const char *pPath, uint32_t BlockCount )
+{
+   WINSYS_ERROR              Results = STATUS_SUCCESS;
+   LARGE_INTEGER             Size;
+   HIST_FILE_HEADER_STRUCT   FileHeader;
+   BOOL                      Create;
+   uint32_t                  Block;
+   uint64_t                  Newest = 0;
+
+   if ( pPath == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockExclusive( &HistLock );
+
+   if ( pHistView != NULL )
+   {
+      ReleaseSRWLockExclusive( &HistLock );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ALREADY_RUNNING );
+   }
+
+   HistFile = CreateFileA( pPath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL );
+
+   if ( ( HistFile != INVALID_HANDLE_VALUE ) && ( GetFileSizeEx( HistFile, &Size ) ) )
+       {
+          Create = ( Size.QuadPart == 0 );
+
+          if ( Create )
+              {
+                 memset( &FileHeader, 0, sizeof( FileHeader ) );
+                 FileHeader.Magic = HIST_MAGIC;
+                 FileHeader.Version = HIST_VERSION;
+                 FileHeader.BlockSize = HIST_BLOCK_SIZE;
+                 FileHeader.BlockCount = ( BlockCount ) ? BlockCount : HIST_DEFAULT_BLOCKS;
+                 FileHeader.Checksum = HIST_Fnv( 2166136261, &FileHeader, offsetof( HIST_FILE_HEADER_STRUCT, Checksum ) );
+                 Size.QuadPart = ( ( LONGLONG ) FileHeader.BlockCount + 1 ) * HIST_BLOCK_SIZE;
+              }
+          else if ( Size.QuadPart < HIST_BLOCK_SIZE * 2 )
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+       }
+
+   //
+   // mapping a new file at its full size extends it with zeros, which is an empty ring
+   //
+
+   if ( Results == STATUS_SUCCESS )
+   {
+      HistMapping = CreateFileMappingA( HistFile, NULL, PAGE_READWRITE, Size.HighPart, Size.LowPart, NULL );
+      pHistView = ( HistMapping ) ? ( uint8_t * ) MapViewOfFile( HistMapping, FILE_MAP_WRITE, 0, 0, 0 ) : NULL;
+
+      if ( pHistView == NULL )
+          {
+             Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+          }
+      else if ( Create )
+          {
+             memcpy( pHistView, &FileHeader, sizeof( FileHeader ) );
+          }
+      else
+          {
+             memcpy( &FileHeader, pHistView, sizeof( FileHeader ) );
+
+             if ( ( FileHeader.Magic != HIST_MAGIC ) || ( FileHeader.Version != HIST_VERSION ) || ( FileHeader.BlockSize != HIST_BLOCK_SIZE ) ||
+                  ( FileHeader.Checksum != HIST_Fnv( 2166136261, &FileHeader, offsetof( HIST_FILE_HEADER_STRUCT, Checksum ) ) ) ||
+                  ( ( ( LONGLONG ) FileHeader.BlockCount + 1 ) * HIST_BLOCK_SIZE > Size.QuadPart ) )
+             {
+                Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+             }
+          }
+   }
+
+   if ( Results == STATUS_SUCCESS )
+       {
+          HistBlockCount = FileHeader.BlockCount;
+          HistActive = HIST_NO_BLOCK;
+
+          for ( Block = 0; Block < HistBlockCount; Block++ )
+          {
+             P_HIST_BLOCK_HEADER_STRUCT   pHeader = HIST_Block( Block );
+
+             if ( ( HIST_BlockValid( pHeader ) ) && ( pHeader->Sequence > Newest ) )
+             {
+                Newest = pHeader->Sequence;
+                HistActive = Block;
+             }
+          }
+
+          //
+          // replay the ring oldest first, which rebuilds the rollups and leaves the encoder on the newest sample
+          //
+
+          memset( HistBuckets, 0, sizeof( HistBuckets ) );
+
+          if ( HistActive != HIST_NO_BLOCK )
+          {
+             for ( Block = 1; Block <= HistBlockCount; Block++ )
+             {
+                P_HIST_BLOCK_HEADER_STRUCT   pHeader = HIST_Block( ( HistActive + Block ) % HistBlockCount );
+
+                if ( HIST_BlockValid( pHeader ) )
+                {
+                   HIST_Decode( pHeader, 0, 0, NULL, 0 );
+                }
+             }
+          }
+       }
+   else
+       {
+          if ( pHistView )
+          {
+             UnmapViewOfFile( pHistView );
+             pHistView = NULL;
+          }
+
+          if ( HistMapping )
+          {
+             CloseHandle( HistMapping );
+             HistMapping = NULL;
+          }
+
+          if ( HistFile != INVALID_HANDLE_VALUE )
+          {
+             CloseHandle( HistFile );
+             HistFile = INVALID_HANDLE_VALUE;
+          }
+       }
+
+   ReleaseSRWLockExclusive( &HistLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_Close                                                      */
+/*                                                                            */
+/*!\brief  Flushes and unmaps the history file                               */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Pointers from HIST_GetBlock() are invalid afterwards              */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_Close( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   AcquireSRWLockExclusive( &HistLock );
+
+   if ( pHistView )
+       {
+          FlushViewOfFile( pHistView, 0 );
+          UnmapViewOfFile( pHistView );
+          CloseHandle( HistMapping );
+          CloseHandle( HistFile );
+
+          pHistView = NULL;
+          HistMapping = NULL;
+          HistFile = INVALID_HANDLE_VALUE;
+          HistActive = HIST_NO_BLOCK;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockExclusive( &HistLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_Append                                                     */
+/*                                                                            */
+/*!\brief  Adds a sample to the history                                     */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample                                    */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The sample is safe from a crash of this process on return. Use    */
+/*!\note    HIST_Flush() to also make it safe from a power failure.           */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_Append( P_EC_SAMPLE_STRUCT pSample )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pSample == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockExclusive( &HistLock );
+
+   if ( pHistView )
+       {
+          P_HIST_BLOCK_HEADER_STRUCT   pHeader = ( HistActive != HIST_NO_BLOCK ) ? HIST_Block( HistActive ) : NULL;
+          uint32_t                     Commit = ( pHeader ) ? pHeader->Commit : 0;
+          uint32_t                     Bytes = HIST_COMMIT_BYTES( Commit );
+
+          if ( ( pHeader == NULL ) || ( pHeader->ValidMask != ( pSample->ValidMask & EC_SENSOR_MASK_ALL ) ) ||
+               ( Bytes + HIST_MAX_RECORD > HIST_PAYLOAD_SIZE ) || ( HIST_COMMIT_SAMPLES( Commit ) == 0xffff ) )
+              {
+                 EC_SAMPLE_STRUCT   Sample = *pSample;
+
+                 Sample.ValidMask &= EC_SENSOR_MASK_ALL;
+                 HIST_StartBlock( &Sample );
+              }
+          else
+              {
+                 uint8_t    *pRecord = ( uint8_t * )( pHeader + 1 ) + Bytes;
+                 int64_t    DeltaMs = ( int64_t )( pSample->TimestampMs - HistLastMs );
+                 int64_t    DodMs = DeltaMs - HistLastDeltaMs;
+                 uint32_t   Length;
+                 uint32_t   Sensor;
+                 uint32_t   Control = 0;
+                 uint16_t   Xor[ SENSOR_COUNT ];
+
+                 //
+                 // the control word leads the record and is a varint, so it is worked out before anything is written
+                 //
+
+                 if ( DodMs != 0 )
+                 {
+                    Control |= HIST_TIME_FLAG;
+                 }
+
+                 for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+                 {
+                    Xor[ Sensor ] = pSample->Raw[ Sensor ] ^ HistLastRaw[ Sensor ];
+
+                    if ( ( pHeader->ValidMask & EC_SENSOR_MASK( Sensor ) ) && ( Xor[ Sensor ] ) )
+                    {
+                       Control |= HIST_SENSOR_FLAG( Sensor );
+                    }
+                 }
+
+                 Length = HIST_PutVarint( pRecord, Control );
+
+                 if ( Control & HIST_TIME_FLAG )
+                 {
+                    Length += HIST_PutVarint( &pRecord[ Length ], ( ( uint64_t ) DodMs << 1 ) ^ ( uint64_t )( DodMs >> 63 ) );
+                 }
+
+                 for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+                 {
+                    if ( Control & HIST_SENSOR_FLAG( Sensor ) )
+                    {
+                       Length += HIST_PutVarint( &pRecord[ Length ], Xor[ Sensor ] );
+                       HistLastRaw[ Sensor ] = pSample->Raw[ Sensor ];
+                    }
+                 }
+
+                 MemoryBarrier();
+
+                 InterlockedExchange( ( LONG volatile * ) &pHeader->Commit, ( LONG )( Commit + ( 1 << 16 ) + Length ) );
+
+                 HistLastMs = pSample->TimestampMs;
+                 HistLastDeltaMs = DeltaMs;
+              }
+
+          HIST_RollupAdd( pSample );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockExclusive( &HistLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_Flush                                                      */
+/*                                                                            */
+/*!\brief  Writes the mapped history through to disk                         */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_Flush( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   AcquireSRWLockShared( &HistLock );
+
+   if ( pHistView )
+       {
+          if ( ( ! FlushViewOfFile( pHistView, 0 ) ) || ( ! FlushFileBuffers( HistFile ) ) )
+          {
+             Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockShared( &HistLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_Query                                                      */
+/*                                                                            */
+/*!\brief  Returns the samples in a time range, oldest first                 */
+/*                                                                            */
+/*!\param   uint64_t            first timestamp wanted, UTC msecs             */
+/*!\param   uint64_t            last timestamp wanted, UTC msecs              */
+/*!\param   P_EC_SAMPLE_STRUCT  buffer to return samples in                   */
+/*!\param   uint32_t            size of the buffer                            */
+/*!\param   puint32_t           returns the number of samples                 */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Only the blocks that overlap the range are decoded. Sample.Sequence*/
+/*!\note    identifies the block and position of each sample.                 */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_Query( uint64_t StartMs, uint64_t EndMs, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( pSamples == NULL ) || ( pCount == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   *pCount = 0;
+
+   AcquireSRWLockShared( &HistLock );
+
+   if ( ( pHistView ) && ( HistActive != HIST_NO_BLOCK ) )
+       {
+          uint32_t   Step;
+
+          for ( Step = 1; ( Step <= HistBlockCount ) && ( *pCount < MaxSamples ); Step++ )
+          {
+             P_HIST_BLOCK_HEADER_STRUCT   pHeader = HIST_Block( ( HistActive + Step ) % HistBlockCount );
+
+             if ( ! HIST_BlockValid( pHeader ) )
+             {
+                continue;
+             }
+
+             if ( pHeader->FirstMs > EndMs )
+             {
+                break;
+             }
+
+             if ( ( pHeader->LastMs != 0 ) && ( pHeader->LastMs < StartMs ) )
+             {
+                continue;
+             }
+
+             *pCount += HIST_Decode( pHeader, StartMs, EndMs, &pSamples[ *pCount ], MaxSamples - *pCount );
+          }
+       }
+   else if ( pHistView == NULL )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockShared( &HistLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_QueryRollup                                                */
+/*                                                                            */
+/*!\brief  Returns min, max and mean over a time range at the finest        */
+/*!\brief  resolution that fits in the number of points asked for           */
+/*                                                                            */
+/*!\param   uint64_t            start of the range, UTC msecs                 */
+/*!\param   uint64_t            end of the range, UTC msecs                   */
+/*!\param   uint32_t            most points wanted, the size of pPoints       */
+/*!\param   P_HIST_POINT_STRUCT buffer to return the points in, oldest first  */
+/*!\param   puint32_t           returns the number of points                  */
+/*!\param   puint32_t           returns the bucket width used, msecs          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    A level is used only if its span reaches back to StartMs. When   */
+/*!\note    even hourly points are too many, the newest MaxPoints hours are  */
+/*!\note    returned. Buckets with no samples are left out.                  */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_QueryRollup( uint64_t StartMs, uint64_t EndMs, uint32_t MaxPoints, P_HIST_POINT_STRUCT pPoints, puint32_t pCount, puint32_t pResolutionMs )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( pPoints == NULL ) || ( pCount == NULL ) || ( pResolutionMs == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( ( MaxPoints == 0 ) || ( EndMs < StartMs ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   *pCount = 0;
+   *pResolutionMs = 0;
+
+   AcquireSRWLockShared( &HistLock );
+
+   if ( pHistView )
+       {
+          const HIST_LEVEL_STRUCT   *pLevel = NULL;
+          uint64_t                  Number,
+                                    Last;
+          uint32_t                  Level,
+                                    Sensor;
+
+          for ( Level = 0; Level < HIST_ROLLUP_LEVELS; Level++ )
+          {
+             uint64_t   Newest = HistLastMs / HistLevels[ Level ].PeriodMs;
+             uint64_t   Oldest = ( Newest >= HistLevels[ Level ].Buckets ) ? ( Newest + 1 - HistLevels[ Level ].Buckets ) * HistLevels[ Level ].PeriodMs : 0;
+
+             pLevel = &HistLevels[ Level ];
+
+             if ( ( ( EndMs - StartMs ) / pLevel->PeriodMs < MaxPoints ) && ( StartMs >= Oldest ) )
+             {
+                break;
+             }
+          }
+
+          Number = StartMs / pLevel->PeriodMs;
+          Last = EndMs / pLevel->PeriodMs;
+
+          if ( Last - Number >= MaxPoints )
+          {
+             Number = Last - MaxPoints + 1;
+          }
+
+          *pResolutionMs = pLevel->PeriodMs;
+
+          for ( ; Number <= Last; Number++ )
+          {
+             P_HIST_BUCKET_STRUCT   pBucket = &HistBuckets[ pLevel->First + ( uint32_t )( Number % pLevel->Buckets ) ];
+             P_HIST_POINT_STRUCT    pPoint = &pPoints[ *pCount ];
+
+             if ( ( pBucket->Samples == 0 ) || ( pBucket->StartMs != Number * pLevel->PeriodMs ) )
+             {
+                continue;
+             }
+
+             memset( pPoint, 0, sizeof( *pPoint ) );
+             pPoint->StartMs = pBucket->StartMs;
+             pPoint->Samples = pBucket->Samples;
+             pPoint->ValidMask = pBucket->ValidMask;
+
+             for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+             {
+                if ( pBucket->Count[ Sensor ] )
+                {
+                   pPoint->Min[ Sensor ] = pBucket->Min[ Sensor ];
+                   pPoint->Max[ Sensor ] = pBucket->Max[ Sensor ];
+                   pPoint->Mean[ Sensor ] = ( uint16_t )( ( pBucket->Sum[ Sensor ] + pBucket->Count[ Sensor ] / 2 ) / pBucket->Count[ Sensor ] );
+                }
+             }
+
+             ( *pCount )++;
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockShared( &HistLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_GetBlock                                                   */
+/*                                                                            */
+/*!\brief  Returns a block of the history in place, without copying it      */
+/*                                                                            */
+/*!\param   uint32_t        0 = oldest block holding samples                  */
+/*!\param   const void **   returns the block - a HIST_BLOCK_HEADER_STRUCT    */
+/*!\param                   and its payload                                   */
+/*!\param   puint32_t       returns the bytes in use, header included         */
+/*!\return  WINSYS_ERROR    STATUS_NOT_FOUND past the newest block            */
+/*                                                                            */
+/*!\note    The block stays mapped until HIST_Close(), but may be reused by   */
+/*!\note    the writer - compare its Sequence before and after using it       */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_GetBlock( uint32_t Index, const void **ppBlock, puint32_t pBytes )
+{
+   WINSYS_ERROR   Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+
+   if ( ( ppBlock == NULL ) || ( pBytes == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockShared( &HistLock );
+
+   if ( ( pHistView ) && ( HistActive != HIST_NO_BLOCK ) )
+   {
+      uint32_t   Step;
+
+      for ( Step = 1; Step <= HistBlockCount; Step++ )
+      {
+         P_HIST_BLOCK_HEADER_STRUCT   pHeader = HIST_Block( ( HistActive + Step ) % HistBlockCount );
+
+         if ( ( HIST_BlockValid( pHeader ) ) && ( Index-- == 0 ) )
+         {
+            *ppBlock = pHeader;
+            *pBytes = ( uint32_t ) sizeof( HIST_BLOCK_HEADER_STRUCT ) + HIST_COMMIT_BYTES( pHeader->Commit );
+            Results = STATUS_SUCCESS;
+            break;
+         }
+      }
+   }
+
+   ReleaseSRWLockShared( &HistLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_DecodeBlock                                                */
+/*                                                                            */
+/*!\brief  Decodes every sample of a block from HIST_GetBlock()              */
+/*                                                                            */
+/*!\param   const void *        the block                                     */
+/*!\param   P_EC_SAMPLE_STRUCT  buffer to return samples in                   */
+/*!\param   uint32_t            size of the buffer                            */
+/*!\param   puint32_t           returns the number of samples                 */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Works on any copy of a block, e.g. one read from a history file   */
+/*!\note    on another machine                                                */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_DecodeBlock( const void *pBlock, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( pBlock ) && ( pSamples ) && ( pCount ) )
+       {
+          if ( HIST_BlockValid( ( const HIST_BLOCK_HEADER_STRUCT * ) pBlock ) )
+              {
+                 *pCount = HIST_Decode( ( const HIST_BLOCK_HEADER_STRUCT * ) pBlock, 0, ~( uint64_t ) 0, pSamples, MaxSamples );
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: HIST_GetStats                                                   */
+/*                                                                            */
+/*!\brief  Returns the size and span of the history                          */
+/*                                                                            */
+/*!\param   P_HIST_STATS_STRUCT   pointer to structure to return them in      */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Walks the block headers, not the samples                          */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR HIST_GetStats( P_HIST_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStats == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   memset( pStats, 0, sizeof( *pStats ) );
+
+   AcquireSRWLockShared( &HistLock );
+
+   if ( pHistView )
+       {
+          uint32_t   Block;
+
+          pStats->BlockCount = HistBlockCount;
+
+          for ( Block = 0; Block < HistBlockCount; Block++ )
+          {
+             P_HIST_BLOCK_HEADER_STRUCT   pHeader = HIST_Block( Block );
+
+             if ( HIST_BlockValid( pHeader ) )
+             {
+                pStats->BlocksUsed++;
+                pStats->Samples += HIST_COMMIT_SAMPLES( pHeader->Commit );
+                pStats->Bytes += sizeof( HIST_BLOCK_HEADER_STRUCT ) + HIST_COMMIT_BYTES( pHeader->Commit );
+
+                if ( ( pStats->OldestMs == 0 ) || ( pHeader->FirstMs < pStats->OldestMs ) )
+                {
+                   pStats->OldestMs = pHeader->FirstMs;
+                }
+             }
+          }
+
+          if ( pStats->Samples )
+          {
+             pStats->BytesPerSampleX100 = ( uint32_t )( pStats->Bytes * 100 / pStats->Samples );
+          }
+
+          pStats->NewestMs = ( HistActive != HIST_NO_BLOCK ) ? HistLastMs : 0;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   ReleaseSRWLockShared( &HistLock );
+
+   return Results;
+}
+
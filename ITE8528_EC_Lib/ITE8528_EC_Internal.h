@@ -0,0 +1,64 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Internal.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Routines shared between the modules of the EC library that are
+//!            not exported from the DLL
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_INTERNAL_INC
+#define __ITE8528_EC_INTERNAL_INC
+
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Events.h>
+
+void        EC_Lock( void );
+void        EC_Unlock( void );
+
+uint64_t    EC_GetMicroSecs( void );
+uint64_t    EC_GetSystemTimeMs( void );
+
+/*!\struct _EC_READ_RANGE_STRUCT
+ * \brief  A contiguous run of EC SRAM read in one burst
+ */
+typedef struct _EC_READ_RANGE_STRUCT {
+                                        uint8_t      Offset;
+                                        uint8_t      Count;
+
+                                     } EC_READ_RANGE_STRUCT, *P_EC_READ_RANGE_STRUCT;
+
+uint32_t    SMP_BuildReadRanges( uint32_t SensorMask, P_EC_READ_RANGE_STRUCT pRanges );
+void        SMP_ExtractSensors( uint32_t SensorMask, const uint8_t *pSram, P_EC_SAMPLE_STRUCT pSample );
+
+WINSYS_ERROR DUAL_ReadRanges( const EC_READ_RANGE_STRUCT *pRanges, uint32_t Count, puint8_t pSram );
+
+void        EVT_Post( P_EC_EVENT_STRUCT pEvent );
+
+HANDLE      PLAN_GetChangedEvent( void );
+uint32_t    PLAN_NextSweep( uint64_t NowMs, puint32_t pWaitMs );
+void        PLAN_Feedback( P_EC_SAMPLE_STRUCT pSample, uint64_t NowMs );
+
+#endif      // #ifndef __ITE8528_EC_INTERNAL_INC
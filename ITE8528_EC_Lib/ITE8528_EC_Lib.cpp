@@ -39,45 +39,137 @@
 #include <WinSys_Errors.h>
 #include <ITE8528_EC_Lib.h>
 #include <inpout32.h>
+#include <ITE8528_EC_Driver.h>
+#include "ITE8528_EC_Internal.h"
+#include "ITE8528_EC_RegMap.h"
 
+//
+// The exported EC_ functions go through the driver in ITE8528_EC_Driver.h. The policies can be chosen when the
+// DLL is built, e.g. /DEC_DRIVER_LOCK=ite8528::ProcessLock when another process also talks to the EC.
+//
+// There are two instantiations over the same ports: EcDriver, and EcRecordingDriver with the ports wrapped in
+// RecordingPorts. EC_StartRecording() switches the library over to the recording one and EC_StopRecording()
+// switches it back, so while nothing is being recorded the port operations cost no more than the bare ports
+// do - one test per transaction picks the driver.
+//
+// The 62/66 command/data handshake is a multi-step transaction, so only one thread at a time may talk to the EC.
+// Both drivers take the same SharedLock, and every ACPI transaction in the library holds it for its full
+// duration. The switch is made with the lock held, so a transaction runs on one driver from start to end.
+//
 
+#ifndef EC_DRIVER_PORTS
+#define EC_DRIVER_PORTS             ite8528::InpOutPorts
+#endif
+#ifndef EC_DRIVER_WAIT
+#define EC_DRIVER_WAIT              ite8528::SpinWait
+#endif
+#ifndef EC_DRIVER_LOCK
+#define EC_DRIVER_LOCK              ite8528::ThreadLock
+#endif
+
+static ite8528::EcDriver< EC_DRIVER_PORTS, EC_DRIVER_WAIT,
+                          ite8528::SharedLock< EC_DRIVER_LOCK > >                                  EcDriver;
+static ite8528::EcDriver< ite8528::RecordingPorts< EC_DRIVER_PORTS >, EC_DRIVER_WAIT,
+                          ite8528::SharedLock< EC_DRIVER_LOCK > >                                  EcRecordingDriver;
+static std::atomic< bool >                                                                         EcRecording{ false };
 
 /******************************************************************************/
+/*                                                                            */
+/*  Function: EC_WithDriver                                                   */
+/*                                                                            */
+/*!\brief  Runs a call on the recording driver while EC_StartRecording() is */
+/*         in effect, else on the plain one                                   */
+/*                                                                            */
+/*!\param   Call            callable taking the driver, by reference          */
+/*!\return  whatever the call returns                                        */
+/*                                                                            */
+/******************************************************************************/
+template< typename Call >
+static EC_FORCEINLINE auto EC_WithDriver( Call &&DriverCall )
+{
+   return ( EcRecording.load( std::memory_order_acquire ) ) ? DriverCall( EcRecordingDriver ) : DriverCall( EcDriver );
+}
 
 /******************************************************************************/
 /*                                                                            */
-/*  Function: EC_SetBurtMode                                                  */
+/*  Function: EC_Lock / EC_Unlock                                             */
 /*                                                                            */
-/*!\brief  Send command to EC to initiate burst mode                          */
+/*!\brief  Acquire and release exclusive ownership of the ACPI EC ports      */
 /*                                                                            */
-/*!\param   <,void>                                                           */
-/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
 /*                                                                            */
-/*!\note                                                                      */
+/*!\note    The lock is not recursive                                         */
 /*                                                                            */
 /******************************************************************************/
-static WINSYS_ERROR EC_SetBurtMode( void )
+void EC_Lock( void )
 {
-   WINSYS_ERROR         Results = STATUS_SUCCESS;
-   uint8_t              Count = 100;
-   ACPI_STATUS_UNION    StatusReg;
+   EcDriver.Lock();
+}
 
-   do
-   {
-      DlPortWritePortUshort( ACPI_EC_CMND_REG, ( ( uint8_t ) BURST_ENABLE_CMD ) );
-      Sleep( BURST_SLEEP_PERIOD_MILLISECS );
-//      StatusReg.Byte = ( uint8_t ) DlPortReadPortUshort( ACPI_EC_DATA_REG );
-      StatusReg.Byte = ( uint8_t ) DlPortReadPortUshort( ACPI_EC_CMND_REG );
-      Count--;
+void EC_Unlock( void )
+{
+   EcDriver.Unlock();
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_GetMicroSecs                                                 */
+/*                                                                            */
+/*!\brief  Returns a monotonic microsecond count for latency measurements    */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  uint64_t        microseconds from the performance counter         */
+/*                                                                            */
+/*!\note    Called from many threads at once, so the counter frequency is     */
+/*!\note    read exactly once, through an INIT_ONCE                           */
+/*                                                                            */
+/******************************************************************************/
+static INIT_ONCE       EcFrequencyOnce = INIT_ONCE_STATIC_INIT;
+static LARGE_INTEGER   EcFrequency;
 
-   } while ( ( StatusReg.Bits.Burst == 0 ) && ( Count > 0 ) );
+static BOOL CALLBACK EC_ReadFrequency( PINIT_ONCE pInitOnce, PVOID pParam, PVOID *ppContext )
+{
+   UNREFERENCED_PARAMETER( pInitOnce );
+   UNREFERENCED_PARAMETER( pParam );
+   UNREFERENCED_PARAMETER( ppContext );
 
-   if ( ( Count == 0 ) || ( StatusReg.Bits.Burst == 0 ) )
-   {
-      Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BURST_ACK_TIMEOUT );
-   }
+   return QueryPerformanceFrequency( &EcFrequency );
+}
 
-   return Results;
+uint64_t EC_GetMicroSecs( void )
+{
+   LARGE_INTEGER   Counter;
+
+   InitOnceExecuteOnce( &EcFrequencyOnce, EC_ReadFrequency, NULL, NULL );
+   QueryPerformanceCounter( &Counter );
+
+   return ( uint64_t )( ( Counter.QuadPart / EcFrequency.QuadPart ) * 1000000 +
+                        ( ( Counter.QuadPart % EcFrequency.QuadPart ) * 1000000 ) / EcFrequency.QuadPart );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_GetSystemTimeMs                                              */
+/*                                                                            */
+/*!\brief  Returns the UTC time used to timestamp samples                    */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  uint64_t        msecs since 1/1/1970 UTC                          */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+uint64_t EC_GetSystemTimeMs( void )
+{
+   FILETIME         FileTime;
+   ULARGE_INTEGER   Time;
+
+   GetSystemTimeAsFileTime( &FileTime );
+   Time.LowPart = FileTime.dwLowDateTime;
+   Time.HighPart = FileTime.dwHighDateTime;
+
+   return ( Time.QuadPart / 10000 ) - 11644473600000ULL;     // 100ns units since 1601 -> msecs since 1970
 }
 
 
@@ -94,24 +186,12 @@ static WINSYS_ERROR EC_SetBurtMode( void )
 /*!\param   uint8_t         Value to write to offset in EC memory space       */
 /*!\return  WINSYS_ERROR    value indicating success or failure               */
 /*                                                                            */
-/*!\note  This function makes use of the ACPI EC port 62/66 access            */
+/*!\note    A one byte burst, paced by the IBF handshake                      */
 /*                                                                            */
 /******************************************************************************/
 WINSYS_ERROR EC_WriteByteUsingACPI( uint8_t Offset, uint8_t Value )
 {
-   WINSYS_ERROR         Results;
-
-   if ( ( Results = EC_SetBurtMode() ) == STATUS_SUCCESS )
-   {
-      DlPortWritePortUshort( ACPI_EC_CMND_REG, WRITE_EC_CMD );
-      Sleep( BURST_SLEEP_PERIOD_MILLISECS );
-      DlPortWritePortUshort( ACPI_EC_DATA_REG, Offset );
-      Sleep( BURST_SLEEP_PERIOD_MILLISECS );
-
-      DlPortWritePortUshort( ACPI_EC_DATA_REG, Value );
-   }
-
-   return Results;
+   return EC_WithDriver( [&]( auto &Driver ) { return Driver.WriteByte( Offset, Value ); } );
 }
 
 /******************************************************************************/
@@ -125,22 +205,139 @@ WINSYS_ERROR EC_WriteByteUsingACPI( uint8_t Offset, uint8_t Value )
 /*!\param   puint8_t        pointer to uint8_t to save read byte to           */
 /*!\return  WINSYS_ERROR    value indicating success or failure               */
 /*                                                                            */
-/*!\note    This function makes use of the ACPI EC port 62/66 access          */
+/*!\note    A one byte burst, paced by the IBF/OBF handshake                  */
 /*                                                                            */
 /******************************************************************************/
 WINSYS_ERROR EC_ReadByteUsingACPI( uint8_t Offset, puint8_t pData )
 {
-   WINSYS_ERROR         Results;
+   return EC_WithDriver( [&]( auto &Driver ) { return Driver.ReadByte( Offset, pData ); } );
+}
 
-   if ( pData )
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_ReadBlockUsingACPI                                           */
+/*                                                                            */
+/*!\brief  Reads consecutive bytes from the EC's SRAM in a single burst      */
+/*         using the ACPI EC port 0x62/0x66 method                            */
+/*                                                                            */
+/*!\param   uint8_t         offset into EC RAM of the first byte to read      */
+/*!\param   uint8_t         number of bytes to read                           */
+/*!\param   puint8_t        pointer to buffer of at least Count bytes         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Burst mode is negotiated once for the whole block, each byte      */
+/*!\note    waits on the IBF/OBF handshake rather than sleeping, and burst    */
+/*!\note    mode is released at the end of the transfer                       */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EC_ReadBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData )
+{
+   return EC_WithDriver( [&]( auto &Driver ) { return Driver.ReadBlock( Offset, Count, pData ); } );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_WriteBlockUsingACPI                                          */
+/*                                                                            */
+/*!\brief  Writes consecutive bytes to the EC's SRAM in a single burst       */
+/*         using the ACPI EC port 0x62/0x66 method                            */
+/*                                                                            */
+/*!\param   uint8_t         offset into EC RAM of the first byte to write     */
+/*!\param   uint8_t         number of bytes to write                          */
+/*!\param   puint8_t        pointer to buffer of at least Count bytes         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The write counterpart of EC_ReadBlockUsingACPI(), one burst for  */
+/*!\note    the whole block                                                   */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EC_WriteBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData )
+{
+   return EC_WithDriver( [&]( auto &Driver ) { return Driver.WriteBlock( Offset, Count, pData ); } );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_GetStatusUsingACPI                                           */
+/*                                                                            */
+/*!\brief  Reads the ACPI EC status register                                 */
+/*                                                                            */
+/*!\param   puint8_t        pointer to uint8_t to return the status byte in   */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    A single port read with no side effects on the EC, so it does not */
+/*!\note    take the EC lock and is cheap enough to watch Sci_Evt with        */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EC_GetStatusUsingACPI( puint8_t pStatus )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStatus )
+       {
+          *pStatus = EC_WithDriver( []( auto &Driver ) { return Driver.Status(); } );
+       }
+   else
        {
-          if ( ( Results = EC_SetBurtMode() ) == STATUS_SUCCESS )
-          {
-             DlPortWritePortUshort( ACPI_EC_CMND_REG, READ_EC_CMD );
-             DlPortWritePortUshort( ACPI_EC_DATA_REG, Offset );
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
 
-             *pData = ( uint8_t ) DlPortReadPortUshort( ACPI_EC_DATA_REG );
-          }
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_QueryEventsUsingACPI                                         */
+/*                                                                            */
+/*!\brief  Drains pending SCI query codes from the EC in a single burst      */
+/*                                                                            */
+/*!\param   puint8_t        pointer to buffer to return query codes in        */
+/*!\param   uint8_t         size of the buffer, in codes                      */
+/*!\param   puint8_t        pointer to uint8_t to return number of codes in   */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    QUERY_EC_CMD is issued while Sci_Evt is set, until the EC returns */
+/*!\note    a zero code or the buffer is full. Each query clears the event    */
+/*!\note    it returns on the EC side.                                        */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EC_QueryEventsUsingACPI( puint8_t pCodes, uint8_t MaxCodes, puint8_t pCount )
+{
+   return EC_WithDriver( [&]( auto &Driver ) { return Driver.QueryEvents( pCodes, MaxCodes, pCount ); } );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_GetTransactionStats                                          */
+/*                                                                            */
+/*!\brief  Returns the counters of the ACPI transactions made so far         */
+/*                                                                            */
+/*!\param   P_EC_TRANSACTION_STATS_STRUCT  pointer to return counters in     */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Does not touch the EC. The copy is taken without the lock, so it  */
+/*!\note    never waits on a transaction in progress. The counters of both    */
+/*!\note    drivers are added together.                                       */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EC_GetTransactionStats( P_EC_TRANSACTION_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR                  Results = STATUS_SUCCESS;
+   EC_TRANSACTION_STATS_STRUCT   Recorded;
+
+   if ( pStats )
+       {
+          EcDriver.GetStats( pStats );
+          EcRecordingDriver.GetStats( &Recorded );
+
+          pStats->ReadBursts += Recorded.ReadBursts;
+          pStats->WriteBursts += Recorded.WriteBursts;
+          pStats->QueryBursts += Recorded.QueryBursts;
+          pStats->BytesRead += Recorded.BytesRead;
+          pStats->BytesWritten += Recorded.BytesWritten;
+          pStats->IbfTimeouts += Recorded.IbfTimeouts;
+          pStats->ObfTimeouts += Recorded.ObfTimeouts;
+          pStats->BurstTimeouts += Recorded.BurstTimeouts;
        }
    else
        {
@@ -150,6 +347,93 @@ WINSYS_ERROR EC_ReadByteUsingACPI( uint8_t Offset, puint8_t pData )
    return Results;
 }
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_StartRecording                                               */
+/*                                                                            */
+/*!\brief  Starts capturing every EC port operation to a trace file          */
+/*                                                                            */
+/*!\param   const char *    path of the trace file, replaced if it exists    */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    See EC_TRACE_RECORD_STRUCT for the format, and ReplayPorts in     */
+/*!\note    ITE8528_EC_Driver.h to play it back. Switches the library to the  */
+/*!\note    recording driver between two transactions.                        */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EC_StartRecording( const char *pPath )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pPath == NULL )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+   else if ( ! EcDriver.Lock() )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+       }
+   else
+       {
+          if ( EcRecording.load( std::memory_order_relaxed ) )
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ALREADY_RUNNING );
+              }
+          else if ( ! EcRecordingDriver.GetPorts().Open( pPath ) )
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+              }
+          else
+              {
+                 EcRecording.store( true, std::memory_order_release );
+              }
+
+          EcDriver.Unlock();
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: EC_StopRecording                                                */
+/*                                                                            */
+/*!\brief  Stops capturing port operations and closes the trace file         */
+/*                                                                            */
+/*!\param   puint64_t       optional, returns the number of operations       */
+/*!\param                   captured                                         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    STATUS_FILE_ERROR if some of the trace could not be written. The  */
+/*!\note    file is closed after the lock is released, so the other threads  */
+/*!\note    do not wait on it.                                                */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR EC_StopRecording( puint64_t pRecords )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   bool           Recording;
+
+   if ( ! EcDriver.Lock() )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+   }
+
+   Recording = EcRecording.exchange( false, std::memory_order_acq_rel );
+   EcDriver.Unlock();
+
+   if ( ! Recording )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+   else if ( ! EcRecordingDriver.GetPorts().Close( pRecords ) )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+       }
+
+   return Results;
+}
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function: EC_WriteByteUsingIOSpace                                        */
@@ -170,7 +454,7 @@ WINSYS_ERROR EC_WriteByteUsingIOSpace( uint8_t Offset, uint8_t Value )
 {
    WINSYS_ERROR         Results = STATUS_SUCCESS;
 
-   DlPortWritePortUchar( ( uint16_t )( EC_IO_PORT + ( uint16_t )( Offset ) ), Value );
+   EC_WithDriver( [&]( auto &Driver ) { Driver.WriteIoSpace( Offset, Value ); } );
 
    return Results;
 }
@@ -197,7 +481,7 @@ WINSYS_ERROR EC_ReadByteUsingIOSpace( uint8_t Offset, puint8_t pData )
 
    if ( pData )
        {
-          *pData = DlPortReadPortUchar( ( uint16_t )( EC_IO_PORT + ( uint16_t )( Offset ) ) );
+          *pData = EC_WithDriver( [&]( auto &Driver ) { return Driver.ReadIoSpace( Offset ); } );
        }
    else
        {
@@ -363,6 +647,251 @@ WINSYS_ERROR WDT_PetTimer( uint8_t Mins, uint8_t Secs )
    return Results;
 }
 
+/*********************************************************************************/
+/*                                                                               */
+/*  Function:  WDT_GetStatus                                                     */
+/*                                                                               */
+/*!\brief  Reads back the WDT configuration and live countdown registers        */
+/*                                                                               */
+/*!\param   P_WDT_STATUS_STRUCT  pointer to structure to return WDT state in     */
+/*!\return  WINSYS_ERROR   value indicating success or failure                   */
+/*                                                                               */
+/*!\note   The config, minutes and seconds registers are contiguous, so they are */
+/*!\note   read in one burst. RemainingMs is the lowest time that could be left: */
+/*!\note   a counter value of N means between N-1 and N units remain.            */
+/*                                                                               */
+/*********************************************************************************/
+WINSYS_ERROR WDT_GetStatus( P_WDT_STATUS_STRUCT pStatus )
+{
+   WINSYS_ERROR Results = STATUS_SUCCESS;
+
+   if ( pStatus )
+       {
+          uint8_t                Regs[ WDT_SECONDS_COUNTER_OFFSET - WDT_CONFIG_OFFSET + 1 ];
+          WDT_CONFIG_REG_UNION   WdtConfig;
+
+          Results = EC_ReadBlockUsingACPI( WDT_CONFIG_OFFSET, sizeof( Regs ), Regs );
+          if ( Results == STATUS_SUCCESS )
+              {
+                 uint32_t   Units;
+
+                 WdtConfig.Byte = Regs[ WDT_CONFIG_OFFSET - WDT_CONFIG_OFFSET ];
+
+                 pStatus->Enabled = WdtConfig.Bits.Enable;
+                 pStatus->Mode = ( WdtConfig.Bits.Mode ) ? MINUTE_MODE_ENUM : SECOND_MODE_ENUM;
+                 pStatus->Minutes = Regs[ WDT_MINUTES_COUNTER_OFFSET - WDT_CONFIG_OFFSET ];
+                 pStatus->Seconds = Regs[ WDT_SECONDS_COUNTER_OFFSET - WDT_CONFIG_OFFSET ];
+
+                 Units = ( pStatus->Mode == MINUTE_MODE_ENUM ) ? pStatus->Minutes : pStatus->Seconds;
+                 Units = ( Units > 0 ) ? ( Units - 1 ) : 0;
+
+                 pStatus->RemainingMs = ( pStatus->Mode == MINUTE_MODE_ENUM ) ? ( Units * 60000 ) : ( Units * 1000 );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Function:  WDT_InitPetPolicy                                                 */
+/*                                                                               */
+/*!\brief  Initializes an adaptive petting policy                               */
+/*                                                                               */
+/*!\param   P_WDT_PET_POLICY_STRUCT  pointer to the policy to initialize         */
+/*!\param   uint8_t   minutes value to reload on each pet                        */
+/*!\param   uint8_t   seconds value to reload on each pet                        */
+/*!\param   uint32_t  time left, in msecs, at which the WDT must be petted       */
+/*!\return  WINSYS_ERROR   value indicating success or failure                   */
+/*                                                                               */
+/*!\note   MaxCheckIntervalMs defaults to WDT_POLICY_DEFAULT_MAX_CHECK_MS, and   */
+/*!\note   may be changed by the caller after this call. A reload value must    */
+/*!\note   leave more than the safety margin once the one unit the countdown    */
+/*!\note   may already have lost is taken off, or the policy would have to pet   */
+/*!\note   on every check - the mode is only known when the WDT is read, so a    */
+/*!\note   non zero minutes and seconds value must each pass, and one must be   */
+/*!\note   set.                                                                  */
+/*                                                                               */
+/*********************************************************************************/
+WINSYS_ERROR WDT_InitPetPolicy( P_WDT_PET_POLICY_STRUCT pPolicy, uint8_t Mins, uint8_t Secs, uint32_t SafetyMarginMs )
+{
+   WINSYS_ERROR Results = STATUS_SUCCESS;
+
+   if ( pPolicy )
+       {
+          if ( ( ( Mins == 0 ) && ( Secs == 0 ) ) ||
+               ( ( Mins > 0 ) && ( ( uint32_t )( Mins - 1 ) * 60000 <= SafetyMarginMs ) ) ||
+               ( ( Secs > 0 ) && ( ( uint32_t )( Secs - 1 ) * 1000 <= SafetyMarginMs ) ) )
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+              }
+          else
+              {
+                 memset( pPolicy, 0, sizeof( WDT_PET_POLICY_STRUCT ) );
+
+                 pPolicy->ReloadMinutes = Mins;
+                 pPolicy->ReloadSeconds = Secs;
+                 pPolicy->SafetyMarginMs = SafetyMarginMs;
+                 pPolicy->MaxCheckIntervalMs = WDT_POLICY_DEFAULT_MAX_CHECK_MS;
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Function:  WDT_UpdateLatency                                                 */
+/*                                                                               */
+/*!\brief  Folds a new latency measurement into a decaying worst case value     */
+/*                                                                               */
+/*!\param   puint32_t  pointer to the running worst case latency, in usecs       */
+/*!\param   uint32_t   latest latency measurement, in usecs                      */
+/*!\return  <void>                                                               */
+/*                                                                               */
+/*!\note   New maximums are taken at once, smaller values decay in by 1/16th     */
+/*                                                                               */
+/*********************************************************************************/
+static void WDT_UpdateLatency( puint32_t pWorstUs, uint32_t LatestUs )
+{
+   if ( LatestUs >= *pWorstUs )
+       {
+          *pWorstUs = LatestUs;
+       }
+   else
+       {
+          *pWorstUs -= ( *pWorstUs - LatestUs ) / 16;
+       }
+}
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Function:  WDT_ServicePetPolicy                                              */
+/*                                                                               */
+/*!\brief  Reads the WDT countdown and pets the WDT only if the time left has   */
+/*!        reached the policy's safety margin plus the measured EC latencies     */
+/*                                                                               */
+/*!\param   P_WDT_PET_POLICY_STRUCT  pointer to an initialized policy            */
+/*!\param   puint32_t  returns the msecs the caller may wait before calling again*/
+/*!\return  WINSYS_ERROR   value indicating success or failure                   */
+/*                                                                               */
+/*!\note   In steady state this costs one status read per call, and one pet per */
+/*!\note   WDT period, instead of petting on a short fixed interval. If the WDT  */
+/*!\note   is disabled nothing is written. If the status cannot be read the WDT  */
+/*!\note   is petted anyway, the read error is returned, and the caller is asked */
+/*!\note   to check back after WDT_POLICY_ERROR_RETRY_MS. If the active mode's   */
+/*!\note   reload no longer clears the margin plus latencies the WDT is still    */
+/*!\note   petted when due, but STATUS_BAD_PARAMETER is returned with the same   */
+/*!\note   retry interval rather than a check every few msecs.                   */
+/*                                                                               */
+/*********************************************************************************/
+WINSYS_ERROR WDT_ServicePetPolicy( P_WDT_PET_POLICY_STRUCT pPolicy, puint32_t pNextCheckMs )
+{
+   WINSYS_ERROR        Results = STATUS_SUCCESS;
+   WDT_STATUS_STRUCT   Status;
+
+   if ( ( pPolicy ) && ( pNextCheckMs ) )
+       {
+          uint64_t   StartUs = EC_GetMicroSecs();
+
+          Results = WDT_GetStatus( &Status );
+          WDT_UpdateLatency( &pPolicy->ReadLatencyUs, ( uint32_t )( EC_GetMicroSecs() - StartUs ) );
+          pPolicy->CheckCount++;
+
+          if ( Results == STATUS_SUCCESS )
+              {
+                 uint32_t   GuardMs = pPolicy->SafetyMarginMs +
+                                      ( ( pPolicy->PetLatencyUs + pPolicy->ReadLatencyUs + 999 ) / 1000 );
+                 uint32_t   RemainingMs = Status.RemainingMs;
+                 uint32_t   ReloadUnits = ( Status.Mode == MINUTE_MODE_ENUM ) ? pPolicy->ReloadMinutes : pPolicy->ReloadSeconds;
+                 uint32_t   UnitMs = ( Status.Mode == MINUTE_MODE_ENUM ) ? 60000 : 1000;
+
+                 //
+                 // the least time a pet buys - the programmed reload, less the unit the countdown may lose at once
+                 //
+
+                 uint32_t   ReloadMs = ( ReloadUnits > 0 ) ? ( ReloadUnits - 1 ) * UnitMs : 0;
+
+                 if ( ( Status.Enabled ) && ( ReloadUnits > 0 ) && ( RemainingMs <= GuardMs ) )
+                 {
+                    StartUs = EC_GetMicroSecs();
+                    Results = WDT_PetTimer( pPolicy->ReloadMinutes, pPolicy->ReloadSeconds );
+                    WDT_UpdateLatency( &pPolicy->PetLatencyUs, ( uint32_t )( EC_GetMicroSecs() - StartUs ) );
+
+                    if ( Results == STATUS_SUCCESS )
+                    {
+                       pPolicy->PetCount++;
+                       RemainingMs = ReloadMs;
+                    }
+                 }
+
+                 if ( ! Status.Enabled )
+                     {
+                        *pNextCheckMs = pPolicy->MaxCheckIntervalMs;
+                     }
+                 else if ( ReloadMs <= GuardMs )
+                     {
+                        *pNextCheckMs = WDT_POLICY_ERROR_RETRY_MS;
+
+                        if ( Results == STATUS_SUCCESS )
+                        {
+                           Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+                        }
+                     }
+                 else if ( RemainingMs > GuardMs )
+                     {
+                        *pNextCheckMs = RemainingMs - GuardMs;
+                     }
+                 else
+                     {
+                        *pNextCheckMs = WDT_POLICY_MIN_CHECK_INTERVAL_MS;
+                     }
+
+                 if ( *pNextCheckMs > pPolicy->MaxCheckIntervalMs )
+                 {
+                    *pNextCheckMs = pPolicy->MaxCheckIntervalMs;
+                 }
+
+                 if ( *pNextCheckMs < WDT_POLICY_MIN_CHECK_INTERVAL_MS )
+                 {
+                    *pNextCheckMs = WDT_POLICY_MIN_CHECK_INTERVAL_MS;
+                 }
+              }
+          else
+              {
+                 //
+                 // without the countdown there is no telling how close the WDT is to firing - reloading the
+                 // counters is harmless if it is disabled, so pet it blind and come back soon
+                 //
+
+                 StartUs = EC_GetMicroSecs();
+
+                 if ( WDT_PetTimer( pPolicy->ReloadMinutes, pPolicy->ReloadSeconds ) == STATUS_SUCCESS )
+                 {
+                    WDT_UpdateLatency( &pPolicy->PetLatencyUs, ( uint32_t )( EC_GetMicroSecs() - StartUs ) );
+                    pPolicy->PetCount++;
+                 }
+
+                 *pNextCheckMs = ( pPolicy->MaxCheckIntervalMs < WDT_POLICY_ERROR_RETRY_MS ) ?
+                                    pPolicy->MaxCheckIntervalMs : WDT_POLICY_ERROR_RETRY_MS;
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
 /*********************************************************************************/
 /*********************************************************************************/
 /*                                                                               */
@@ -453,30 +982,30 @@ WINSYS_ERROR TEMP_GetSYS( puint8_t pTemp )
 /*                                                                               */
 /*********************************************************************************/
 /*                                                                               */
-/*  Function:  PWR_GetDimmV                                                      */
+/*  Function:  PWR_GetRail                                                       */
 /*                                                                               */
-/*!\brief   Returns the voltage used by the DIMM                                 */
+/*!\brief   Reads a voltage rail and scales it                                   */
 /*                                                                               */
 /*!\param   pdouble_t      pointer to double value to return measured voltage in */
 /*!\return  WINSYS_ERROR   value indicating success or failure                   */
 /*                                                                               */
-/*!\note                                                                         */
+/*!\note    Reg is the rail's register from ITE8528_EC_RegMap.h. Both bytes come */
+/*!\note    from one burst.                                                      */
 /*                                                                               */
 /*********************************************************************************/
-WINSYS_ERROR PWR_GetDimmV( pdouble_t pVolts )
+template< typename Reg >
+static WINSYS_ERROR PWR_GetRail( pdouble_t pVolts )
 {
    WINSYS_ERROR Results = STATUS_SUCCESS;
 
    if ( pVolts )
        {
-          uint8_t    TempU8_1,
-                     TempU8_2;
+          uint16_t   Raw;
 
-          Results = EC_ReadByteUsingACPI( VDIMM_L_OFFSET, &TempU8_1 );          // retrieve low byte of voltage
+          Results = ite8528::EcRead< Reg >( &Raw );
           if ( Results == STATUS_SUCCESS )
               {
-                 Results = EC_ReadByteUsingACPI( VDIMM_L_OFFSET, &TempU8_2 );   // retrieve high byte of voltage
-                 *pVolts = ( ( double )( ( TempU8_2 << 8 ) + TempU8_1 ) ) * VCORE_SCALE_FACTOR;
+                 *pVolts = ( double ) Raw * Reg::ScaleFactor;
               }
           else
               {
@@ -491,6 +1020,23 @@ WINSYS_ERROR PWR_GetDimmV( pdouble_t pVolts )
    return Results;
 }
 
+/*********************************************************************************/
+/*                                                                               */
+/*  Function:  PWR_GetDimmV                                                      */
+/*                                                                               */
+/*!\brief   Returns the voltage used by the DIMM                                 */
+/*                                                                               */
+/*!\param   pdouble_t      pointer to double value to return measured voltage in */
+/*!\return  WINSYS_ERROR   value indicating success or failure                   */
+/*                                                                               */
+/*!\note                                                                         */
+/*                                                                               */
+/*********************************************************************************/
+WINSYS_ERROR PWR_GetDimmV( pdouble_t pVolts )
+{
+   return PWR_GetRail< ite8528::EcRegVDimm >( pVolts );
+}
+
 /*********************************************************************************/
 /*                                                                               */
 /*  Function:  PWR_Get12V                                                        */
@@ -505,30 +1051,7 @@ WINSYS_ERROR PWR_GetDimmV( pdouble_t pVolts )
 /*********************************************************************************/
 WINSYS_ERROR PWR_Get12V( pdouble_t pVolts )
 {
-   WINSYS_ERROR Results = STATUS_SUCCESS;
-
-   if ( pVolts )
-       {
-          uint8_t    TempU8_1,
-                     TempU8_2;
-
-          Results = EC_ReadByteUsingACPI( V12_L_OFFSET, &TempU8_1 );           // retrieve low byte of voltage
-          if ( Results == STATUS_SUCCESS )
-              {
-                 Results = EC_ReadByteUsingACPI( V12_L_OFFSET, &TempU8_2 );    // retrieve high byte of voltage
-                 *pVolts = ( ( double )( ( TempU8_2 << 8 ) + TempU8_1 ) ) * V12_SCALE_FACTOR;
-              }
-          else
-              {
-
-              }
-       }
-   else
-       {
-          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
-       }
-
-   return Results;
+   return PWR_GetRail< ite8528::EcRegV12 >( pVolts );
 }
 
 
@@ -545,19 +1068,74 @@ WINSYS_ERROR PWR_Get12V( pdouble_t pVolts )
 /*                                                                               */
 /*********************************************************************************/
 WINSYS_ERROR PWR_Get5V( pdouble_t pVolts )
+{
+   return PWR_GetRail< ite8528::EcRegV5 >( pVolts );
+}
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Function:  PWR_Get3p3V                                                       */
+/*                                                                               */
+/*!\brief   Returns the 3.3 volt sensor reading                                  */
+/*                                                                               */
+/*!\param   pdouble_t      pointer to double value to return measured voltage in */
+/*!\return  WINSYS_ERROR   value indicating success or failure                   */
+/*                                                                               */
+/*!\note                                                                         */
+/*                                                                               */
+/*********************************************************************************/
+WINSYS_ERROR PWR_Get3p3V( pdouble_t pVolts )
+{
+   return PWR_GetRail< ite8528::EcRegV3p3 >( pVolts );
+}
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Function:  PWR_GetVCore                                                      */
+/*                                                                               */
+/*!\brief   Reads the VCore voltage sensor                                       */
+/*                                                                               */
+/*!\param   pdouble_t      pointer to double value to return measured voltage in */
+/*!\return  WINSYS_ERROR   value indicating success or failure                   */
+/*                                                                               */
+/*!\note                                                                         */
+/*                                                                               */
+/*********************************************************************************/
+WINSYS_ERROR PWR_GetVCore( pdouble_t pVolts )
+{
+   return PWR_GetRail< ite8528::EcRegVCore >( pVolts );
+}
+
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Fan Functions                                                                */
+/*                                                                               */
+/*********************************************************************************/
+/*                                                                               */
+/*  Function:  FAN_GetCPU                                                        */
+/*                                                                               */
+/*!\brief   Returns the CPU fan speed                                            */
+/*                                                                               */
+/*!\param   puint16_t      pointer to uint16_t value to return the RPM in        */
+/*!\return  WINSYS_ERROR   value indicating success or failure                   */
+/*                                                                               */
+/*!\note    Both bytes of the tachometer count come from one burst. A stopped    */
+/*!\note    fan reads 0 RPM.                                                     */
+/*                                                                               */
+/*********************************************************************************/
+WINSYS_ERROR FAN_GetCPU( puint16_t pRpm )
 {
    WINSYS_ERROR Results = STATUS_SUCCESS;
 
-   if ( pVolts )
+   if ( pRpm )
        {
-          uint8_t    TempU8_1,
-                     TempU8_2;
+          uint16_t   Count;
 
-          Results = EC_ReadByteUsingACPI( V5_L_OFFSET, &TempU8_1 );           // retrieve low byte of voltage
+          Results = ite8528::EcRead< ite8528::EcRegCpuFan >( &Count );
           if ( Results == STATUS_SUCCESS )
               {
-                 Results = EC_ReadByteUsingACPI( V5_H_OFFSET, &TempU8_2 );    // retrieve high byte of voltage
-                 *pVolts = ( ( double )( ( TempU8_2 << 8 ) + TempU8_1 ) ) * V5_SCALE_FACTOR;
+                 *pRpm = ite8528::EcTachToRpm( Count );
               }
           else
               {
@@ -574,30 +1152,32 @@ WINSYS_ERROR PWR_Get5V( pdouble_t pVolts )
 
 /*********************************************************************************/
 /*                                                                               */
-/*  Function:  PWR_Get3p3V                                                       */
+/*  Function:  FAN_GetSmartConfig                                                */
 /*                                                                               */
-/*!\brief   Returns the 3.3 volt sensor reading                                  */
+/*!\brief   Reads the smart fan configuration and targets                        */
 /*                                                                               */
-/*!\param   pdouble_t      pointer to double value to return measured voltage in */
+/*!\param   P_FAN_SMART_CONFIG_STRUCT  pointer to structure to return them in    */
 /*!\return  WINSYS_ERROR   value indicating success or failure                   */
 /*                                                                               */
-/*!\note                                                                         */
+/*!\note    All three registers are read in one burst. The firmware's tolerance  */
+/*!\note    register, SMART_FAN_TOLERANCE_OFFSET, is the target 2 byte, so       */
+/*!\note    Target2 returns the tolerance                                        */
 /*                                                                               */
 /*********************************************************************************/
-WINSYS_ERROR PWR_Get3p3V( pdouble_t pVolts )
+WINSYS_ERROR FAN_GetSmartConfig( P_FAN_SMART_CONFIG_STRUCT pConfig )
 {
    WINSYS_ERROR Results = STATUS_SUCCESS;
 
-   if ( pVolts )
+   if ( pConfig )
        {
-          uint8_t    TempU8_1,
-                     TempU8_2;
+          uint8_t    Regs[ sizeof( FAN_SMART_CONFIG_STRUCT ) ];
 
-          Results = EC_ReadByteUsingACPI( V3P3V_L_OFFSET, &TempU8_1 );           // retrieve low byte of voltage
+          Results = EC_ReadBlockUsingACPI( SMART_FAN_CFG_OFFSET, sizeof( Regs ), Regs );
           if ( Results == STATUS_SUCCESS )
               {
-                 Results = EC_ReadByteUsingACPI( V3P3V_H_OFFSET, &TempU8_2 );    // retrieve high byte of voltage
-                 *pVolts = ( ( double )( ( TempU8_2 << 8 ) + TempU8_1 ) ) * V3P3_SCALE_FACTOR;
+                 pConfig->Config = Regs[ SMART_FAN_CFG_OFFSET - SMART_FAN_CFG_OFFSET ];
+                 pConfig->Target1 = Regs[ SMART_FAN_TARGET_REG1_OFFSET - SMART_FAN_CFG_OFFSET ];
+                 pConfig->Target2 = Regs[ SMART_FAN_TARGET_REG2_OFFSET - SMART_FAN_CFG_OFFSET ];
               }
           else
               {
@@ -614,35 +1194,31 @@ WINSYS_ERROR PWR_Get3p3V( pdouble_t pVolts )
 
 /*********************************************************************************/
 /*                                                                               */
-/*  Function:  PWR_GetVCore                                                      */
+/*  Function:  FAN_SetSmartConfig                                                */
 /*                                                                               */
-/*!\brief   Reads the VCore voltage sensor                                       */
+/*!\brief   Writes the smart fan configuration and targets                       */
 /*                                                                               */
-/*!\param   pdouble_t      pointer to double value to return measured voltage in */
+/*!\param   P_FAN_SMART_CONFIG_STRUCT  pointer to the values to write            */
 /*!\return  WINSYS_ERROR   value indicating success or failure                   */
 /*                                                                               */
-/*!\note                                                                         */
+/*!\note    All three registers are written in one burst, so the EC's fan loop   */
+/*!\note    never runs with a mix of old and new settings. Target2 is also the   */
+/*!\note    tolerance, SMART_FAN_TOLERANCE_OFFSET - setting one sets the other   */
 /*                                                                               */
 /*********************************************************************************/
-WINSYS_ERROR PWR_GetVCore( pdouble_t pVolts )
+WINSYS_ERROR FAN_SetSmartConfig( P_FAN_SMART_CONFIG_STRUCT pConfig )
 {
    WINSYS_ERROR Results = STATUS_SUCCESS;
 
-   if ( pVolts )
+   if ( pConfig )
        {
-          uint8_t    TempU8_1,
-                     TempU8_2;
+          uint8_t    Regs[ sizeof( FAN_SMART_CONFIG_STRUCT ) ];
 
-          Results = EC_ReadByteUsingACPI( VCORE_L_OFFSET, &TempU8_1 );           // retrieve low byte of voltage
-          if ( Results == STATUS_SUCCESS )
-              {
-                 Results = EC_ReadByteUsingACPI( VCORE_H_OFFSET, &TempU8_2 );    // retrieve high byte of voltage
-                 *pVolts = ( ( double )( ( TempU8_2 << 8 ) + TempU8_1 ) ) * VCORE_SCALE_FACTOR;
-              }
-          else
-              {
+          Regs[ SMART_FAN_CFG_OFFSET - SMART_FAN_CFG_OFFSET ] = pConfig->Config;
+          Regs[ SMART_FAN_TARGET_REG1_OFFSET - SMART_FAN_CFG_OFFSET ] = pConfig->Target1;
+          Regs[ SMART_FAN_TARGET_REG2_OFFSET - SMART_FAN_CFG_OFFSET ] = pConfig->Target2;
 
-              }
+          Results = EC_WriteBlockUsingACPI( SMART_FAN_CFG_OFFSET, sizeof( Regs ), Regs );
        }
    else
        {
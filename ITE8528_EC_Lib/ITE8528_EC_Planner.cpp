@@ -0,0 +1,746 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Planner.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the sensor polling planner - consumer registration,
+//      the combined per sensor schedule, and the due sensor calculation used by
+//      the planned sampler thread.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Planner.h>
+#include "ITE8528_EC_Internal.h"
+
+
+/*!\struct _PLAN_CONSUMER_STRUCT
+ * \brief  A registered consumer. A SensorMask of 0 marks a free entry.
+ */
+typedef struct _PLAN_CONSUMER_STRUCT {
+                                        uint32_t     SensorMask;
+                                        uint32_t     PeriodMs;
+
+                                     } PLAN_CONSUMER_STRUCT, *P_PLAN_CONSUMER_STRUCT;
+
+/*!\struct _PLAN_ADAPT_STATE_STRUCT
+ * \brief  An adaptively sampled sensor
+ */
+typedef struct _PLAN_ADAPT_STATE_STRUCT {
+                                           PLAN_ADAPT_STRUCT   Config;
+                                           BOOL                Enabled;
+                                           uint32_t            PeriodMs;       // current period
+                                           uint16_t            LastRaw;
+                                           uint16_t            Stable;         // stable reads at this period
+                                           uint64_t            LastMs;         // 0 = no reading yet
+
+                                        } PLAN_ADAPT_STATE_STRUCT, *P_PLAN_ADAPT_STATE_STRUCT;
+
+static SRWLOCK                 PlanLock = SRWLOCK_INIT;
+static PLAN_CONSUMER_STRUCT    PlanConsumers[ PLAN_MAX_CONSUMERS ];
+static uint32_t                PlanPeriodMs[ SENSOR_COUNT ];        // 0 = not wanted by anyone
+static uint32_t                PlanConsumerMs[ SENSOR_COUNT ];      // fastest consumer period, 0 = no consumer
+static uint64_t                PlanNextDueMs[ SENSOR_COUNT ];       // 0 = not scheduled yet
+static PLAN_ADAPT_STATE_STRUCT PlanAdapt[ SENSOR_COUNT ];
+static PLAN_STATS_STRUCT       PlanStats;
+static uint32_t                PlanGeneration = 0;                  // bumped whenever a sensor period changes
+static uint32_t                PlanEvaluated = 0;                   // generation PlannedTpsX1000 was counted for
+static HANDLE                  PlanChangedEvent = NULL;             // auto reset, wakes the planned sampler
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_Gcd                                                        */
+/*                                                                            */
+/*!\brief  Greatest common divisor                                           */
+/*                                                                            */
+/*!\param   uint64_t        first value                                       */
+/*!\param   uint64_t        second value                                      */
+/*!\return  uint64_t        the GCD, or the other value if one is 0           */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static uint64_t PLAN_Gcd( uint64_t A, uint64_t B )
+{
+   while ( B != 0 )
+   {
+      uint64_t   Rem = A % B;
+
+      A = B;
+      B = Rem;
+   }
+
+   return A;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_RoundPeriod                                                */
+/*                                                                            */
+/*!\brief  Rounds a period to the nearest multiple of PLAN_TICK_QUANTUM_MS   */
+/*                                                                            */
+/*!\param   uint32_t        period in msecs                                   */
+/*!\return  uint32_t        rounded period, at least PLAN_TICK_QUANTUM_MS     */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t PLAN_RoundPeriod( uint32_t PeriodMs )
+{
+   PeriodMs = ( ( PeriodMs + PLAN_TICK_QUANTUM_MS / 2 ) / PLAN_TICK_QUANTUM_MS ) * PLAN_TICK_QUANTUM_MS;
+
+   return ( PeriodMs ) ? PeriodMs : PLAN_TICK_QUANTUM_MS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_Retime                                                     */
+/*                                                                            */
+/*!\brief  Recomputes the tick and hyperperiod after a sensor period changed */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called with PlanLock held exclusive. PlannedTpsX1000 is left for  */
+/*!\note    PLAN_GetStats() to count, outside the lock.                       */
+/*                                                                            */
+/******************************************************************************/
+static void PLAN_Retime( void )
+{
+   uint64_t   Tick = 0,
+              Hyper = 1;
+   uint32_t   Sensor;
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      if ( PlanPeriodMs[ Sensor ] )
+      {
+         Tick = PLAN_Gcd( PlanPeriodMs[ Sensor ], Tick );
+         Hyper = Hyper / PLAN_Gcd( Hyper, PlanPeriodMs[ Sensor ] ) * PlanPeriodMs[ Sensor ];
+
+         if ( Hyper > PLAN_MAX_HYPERPERIOD_MS )
+         {
+            Hyper = PLAN_MAX_HYPERPERIOD_MS;
+         }
+      }
+   }
+
+   PlanStats.TickMs = ( uint32_t ) Tick;
+   PlanStats.HyperperiodMs = ( Tick ) ? ( uint32_t ) Hyper : 0;
+   PlanGeneration++;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_CountBursts                                                */
+/*                                                                            */
+/*!\brief  Walks one cycle of a plan, counting the bursts each tick's sweep   */
+/*         needs                                                              */
+/*                                                                            */
+/*!\param   const uint32_t *  the sensor periods, SENSOR_COUNT entries        */
+/*!\param   uint32_t        the plan's tick, in msecs                         */
+/*!\param   uint32_t        the plan's hyperperiod, in msecs                  */
+/*!\return  uint32_t        EC transactions per second x 1000                 */
+/*                                                                            */
+/*!\note    Up to PLAN_MAX_HYPERPERIOD_MS / PLAN_TICK_QUANTUM_MS ticks, so it  */
+/*!\note    works on a copy of the periods and is called without PlanLock     */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t PLAN_CountBursts( const uint32_t *pPeriods, uint32_t Tick, uint32_t Hyper )
+{
+   EC_READ_RANGE_STRUCT   Ranges[ SENSOR_COUNT ];
+   uint64_t               Planned = 0,
+                          Time;
+   uint32_t               Sensor;
+
+   if ( ( Tick == 0 ) || ( Hyper == 0 ) )
+   {
+      return 0;
+   }
+
+   for ( Time = 0; Time < Hyper; Time += Tick )
+   {
+      uint32_t   DueMask = 0;
+
+      for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+      {
+         if ( ( pPeriods[ Sensor ] ) && ( ( Time % pPeriods[ Sensor ] ) == 0 ) )
+         {
+            DueMask |= EC_SENSOR_MASK( Sensor );
+         }
+      }
+
+      Planned += SMP_BuildReadRanges( DueMask, Ranges );
+   }
+
+   return ( uint32_t )( Planned * 1000000 / Hyper );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_Period                                                     */
+/*                                                                            */
+/*!\brief  Returns the period a sensor is read at                            */
+/*                                                                            */
+/*!\param   uint32_t        EC_SENSOR_ENUM_TYPE                               */
+/*!\return  uint32_t        period in msecs, 0 = not read                     */
+/*                                                                            */
+/*!\note    The adaptive period when the sensor is adaptive, but never slower */
+/*!\note    than the fastest consumer registered for it. Called with PlanLock */
+/*!\note    held exclusive                                                    */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t PLAN_Period( uint32_t Sensor )
+{
+   uint32_t   PeriodMs = PlanConsumerMs[ Sensor ];
+
+   if ( ( PlanAdapt[ Sensor ].Enabled ) && ( ( PeriodMs == 0 ) || ( PlanAdapt[ Sensor ].PeriodMs < PeriodMs ) ) )
+   {
+      PeriodMs = PlanAdapt[ Sensor ].PeriodMs;
+   }
+
+   return PeriodMs;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_Rebuild                                                    */
+/*                                                                            */
+/*!\brief  Recomputes the per sensor periods and the plan statistics after   */
+/*         a consumer was added or removed                                    */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called with PlanLock held exclusive                               */
+/*                                                                            */
+/******************************************************************************/
+static void PLAN_Rebuild( void )
+{
+   EC_READ_RANGE_STRUCT   Ranges[ SENSOR_COUNT ];
+   uint64_t               Naive = 0;
+   uint32_t               Consumer,
+                          Sensor;
+
+   memset( PlanConsumerMs, 0, sizeof( PlanConsumerMs ) );
+   PlanStats.Consumers = 0;
+   PlanStats.SensorMask = 0;
+
+   for ( Consumer = 0; Consumer < PLAN_MAX_CONSUMERS; Consumer++ )
+   {
+      P_PLAN_CONSUMER_STRUCT   pConsumer = &PlanConsumers[ Consumer ];
+
+      if ( pConsumer->SensorMask == 0 )
+      {
+         continue;
+      }
+
+      PlanStats.Consumers++;
+      PlanStats.SensorMask |= pConsumer->SensorMask;
+
+      for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+      {
+         if ( pConsumer->SensorMask & EC_SENSOR_MASK( Sensor ) )
+         {
+            if ( ( PlanConsumerMs[ Sensor ] == 0 ) || ( pConsumer->PeriodMs < PlanConsumerMs[ Sensor ] ) )
+            {
+               PlanConsumerMs[ Sensor ] = pConsumer->PeriodMs;
+            }
+
+            //
+            // naive polling reads each register byte with its own transaction
+            //
+
+            SMP_BuildReadRanges( EC_SENSOR_MASK( Sensor ), Ranges );
+            Naive += ( uint64_t ) Ranges[ 0 ].Count * 1000000 / pConsumer->PeriodMs;
+         }
+      }
+   }
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      PlanPeriodMs[ Sensor ] = PLAN_Period( Sensor );
+
+      if ( PlanAdapt[ Sensor ].Enabled )
+      {
+         PlanStats.SensorMask |= EC_SENSOR_MASK( Sensor );
+      }
+
+      PlanNextDueMs[ Sensor ] = 0;                    // realigned on the next sweep
+   }
+
+   PlanStats.NaiveTpsX1000 = ( uint32_t ) Naive;
+   PLAN_Retime();
+
+   if ( PlanChangedEvent )
+   {
+      SetEvent( PlanChangedEvent );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_GetChangedEvent                                            */
+/*                                                                            */
+/*!\brief  Returns the event set whenever the plan changes, creating it on    */
+/*         first use                                                          */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  HANDLE          auto reset event, or NULL if it can't be created  */
+/*                                                                            */
+/*!\note    For the planned sampler thread, so a faster consumer does not     */
+/*!\note    wait out the old plan's sleep                                     */
+/*                                                                            */
+/******************************************************************************/
+HANDLE PLAN_GetChangedEvent( void )
+{
+   AcquireSRWLockExclusive( &PlanLock );
+
+   if ( PlanChangedEvent == NULL )
+   {
+      PlanChangedEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+   }
+
+   ReleaseSRWLockExclusive( &PlanLock );
+
+   return PlanChangedEvent;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_NextSweep                                                  */
+/*                                                                            */
+/*!\brief  Returns the sensors due now and how long until the next are due    */
+/*                                                                            */
+/*!\param   uint64_t        current time in msecs, from EC_GetMicroSecs()     */
+/*!\param   puint32_t       returns msecs to wait, INFINITE if nothing is     */
+/*!\param                   planned                                           */
+/*!\return  uint32_t        mask of the sensors to read now                   */
+/*                                                                            */
+/*!\note    A sensor's reads fall on multiples of its period, so sensors      */
+/*!\note    whose periods share a factor come due together                    */
+/*                                                                            */
+/******************************************************************************/
+uint32_t PLAN_NextSweep( uint64_t NowMs, puint32_t pWaitMs )
+{
+   EC_READ_RANGE_STRUCT   Ranges[ SENSOR_COUNT ];
+   uint64_t               NextMs = 0;
+   uint32_t               DueMask = 0,
+                          Sensor;
+
+   AcquireSRWLockExclusive( &PlanLock );
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      uint32_t   Period = PlanPeriodMs[ Sensor ];
+
+      if ( Period == 0 )
+      {
+         continue;
+      }
+
+      if ( PlanNextDueMs[ Sensor ] == 0 )
+      {
+         PlanNextDueMs[ Sensor ] = ( ( NowMs + Period - 1 ) / Period ) * Period;
+      }
+
+      if ( PlanNextDueMs[ Sensor ] <= NowMs )
+      {
+         DueMask |= EC_SENSOR_MASK( Sensor );
+         PlanNextDueMs[ Sensor ] += Period;
+
+         if ( PlanNextDueMs[ Sensor ] <= NowMs )
+         {
+            uint64_t   Missed = ( NowMs - PlanNextDueMs[ Sensor ] ) / Period + 1;
+
+            PlanStats.MissedTicks += ( uint32_t ) Missed;
+            PlanNextDueMs[ Sensor ] += Missed * Period;
+         }
+      }
+
+      if ( ( NextMs == 0 ) || ( PlanNextDueMs[ Sensor ] < NextMs ) )
+      {
+         NextMs = PlanNextDueMs[ Sensor ];
+      }
+   }
+
+   if ( DueMask )
+   {
+      uint32_t   Bits = DueMask;
+
+      PlanStats.Sweeps++;
+      PlanStats.Bursts += SMP_BuildReadRanges( DueMask, Ranges );
+
+      while ( Bits )
+      {
+         PlanStats.SensorReads++;
+         Bits &= Bits - 1;
+      }
+   }
+
+   ReleaseSRWLockExclusive( &PlanLock );
+
+   *pWaitMs = ( NextMs ) ? ( uint32_t )( NextMs - NowMs ) : INFINITE;
+
+   return DueMask;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_Feedback                                                   */
+/*                                                                            */
+/*!\brief  Adjusts the period of the adaptive sensors in a new sample        */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample just read                         */
+/*!\param   uint64_t            time it was read, in EC_GetMicroSecs() msecs */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    A shorter period takes effect at once - the sensor is rescheduled */
+/*!\note    and the planned sampler woken. A longer one waits for the read    */
+/*!\note    already scheduled.                                                */
+/*                                                                            */
+/******************************************************************************/
+void PLAN_Feedback( P_EC_SAMPLE_STRUCT pSample, uint64_t NowMs )
+{
+   BOOL       Faster = FALSE,
+              Changed = FALSE;
+   uint32_t   Sensor;
+
+   AcquireSRWLockExclusive( &PlanLock );
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      P_PLAN_ADAPT_STATE_STRUCT   pAdapt = &PlanAdapt[ Sensor ];
+      uint16_t                    Raw = pSample->Raw[ Sensor ];
+      uint32_t                    Delta,
+                                  Distance,
+                                  TargetMs,
+                                  NewMs;
+
+      if ( ( ! pAdapt->Enabled ) || ( ( pSample->ValidMask & EC_SENSOR_MASK( Sensor ) ) == 0 ) )
+      {
+         continue;
+      }
+
+      if ( ( pAdapt->LastMs == 0 ) || ( NowMs <= pAdapt->LastMs ) )
+      {
+         pAdapt->LastRaw = Raw;
+         pAdapt->LastMs = NowMs;
+         continue;
+      }
+
+      Delta = ( Raw > pAdapt->LastRaw ) ? ( uint32_t )( Raw - pAdapt->LastRaw ) : ( uint32_t )( pAdapt->LastRaw - Raw );
+      Distance = ( Raw > pAdapt->Config.Threshold ) ? ( uint32_t )( Raw - pAdapt->Config.Threshold ) : ( uint32_t )( pAdapt->Config.Threshold - Raw );
+      TargetMs = pAdapt->Config.MaxPeriodMs;
+
+      if ( Delta > pAdapt->Config.Deadband )
+          {
+             uint64_t   ElapsedMs = NowMs - pAdapt->LastMs;
+
+             //
+             // sample fast enough that the reading moves by about the deadband per period, and - when heading for
+             // the threshold - at least 4 times before it could get there
+             //
+
+             pAdapt->Stable = 0;
+             TargetMs = ( uint32_t )( ( ( uint64_t ) ( pAdapt->Config.Deadband ? pAdapt->Config.Deadband : 1 ) * ElapsedMs ) / Delta );
+
+             if ( ( pAdapt->Config.Threshold ) &&
+                  ( ( Raw > pAdapt->LastRaw ) == ( pAdapt->Config.Threshold > Raw ) ) )
+             {
+                uint64_t   ArrivalMs = ( uint64_t ) Distance * ElapsedMs / Delta;
+
+                if ( ArrivalMs / 4 < TargetMs )
+                {
+                   TargetMs = ( uint32_t )( ArrivalMs / 4 );
+                }
+             }
+          }
+      else
+          {
+             TargetMs = pAdapt->PeriodMs;
+
+             if ( ++pAdapt->Stable >= pAdapt->Config.StableReads )
+             {
+                pAdapt->Stable = 0;
+                TargetMs = pAdapt->PeriodMs * 2;
+             }
+          }
+
+      if ( ( pAdapt->Config.Threshold ) && ( Distance <= pAdapt->Config.Margin ) )
+      {
+         TargetMs = pAdapt->Config.MinPeriodMs;
+      }
+
+      for ( NewMs = pAdapt->Config.MinPeriodMs; ( NewMs * 2 <= TargetMs ) && ( NewMs * 2 <= pAdapt->Config.MaxPeriodMs ); NewMs *= 2 )
+      {
+      }
+
+      if ( NewMs < pAdapt->PeriodMs )
+          {
+             PlanStats.AdaptSpeedups++;
+          }
+      else if ( NewMs > pAdapt->PeriodMs )
+          {
+             PlanStats.AdaptBackoffs++;
+          }
+
+      pAdapt->PeriodMs = NewMs;
+      NewMs = PLAN_Period( Sensor );                  // a consumer may want it faster
+
+      if ( NewMs < PlanPeriodMs[ Sensor ] )
+      {
+         PlanNextDueMs[ Sensor ] = ( NowMs / NewMs + 1 ) * NewMs;
+         Faster = TRUE;
+      }
+
+      if ( NewMs != PlanPeriodMs[ Sensor ] )
+      {
+         PlanPeriodMs[ Sensor ] = NewMs;
+         Changed = TRUE;
+      }
+
+      pAdapt->LastRaw = Raw;
+      pAdapt->LastMs = NowMs;
+   }
+
+   if ( Changed )
+   {
+      PLAN_Retime();
+   }
+
+   ReleaseSRWLockExclusive( &PlanLock );
+
+   if ( ( Faster ) && ( PlanChangedEvent ) )
+   {
+      SetEvent( PlanChangedEvent );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_Register                                                   */
+/*                                                                            */
+/*!\brief  Adds a consumer that wants a set of sensors at a given period      */
+/*                                                                            */
+/*!\param   uint32_t        mask of EC_SENSOR_ENUM_TYPE bits                  */
+/*!\param   uint32_t        period in msecs, rounded to PLAN_TICK_QUANTUM_MS  */
+/*!\param   puint32_t       returns the consumer id for PLAN_Unregister()     */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Takes effect at once, including on a running planned sampler     */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR PLAN_Register( uint32_t SensorMask, uint32_t PeriodMs, puint32_t pConsumer )
+{
+   WINSYS_ERROR   Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_QUEUE_FULL );
+   uint32_t       Consumer;
+
+   if ( pConsumer == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( ( ( SensorMask & EC_SENSOR_MASK_ALL ) == 0 ) || ( PeriodMs == 0 ) || ( PeriodMs > PLAN_MAX_HYPERPERIOD_MS ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   PeriodMs = PLAN_RoundPeriod( PeriodMs );
+
+   AcquireSRWLockExclusive( &PlanLock );
+
+   for ( Consumer = 0; Consumer < PLAN_MAX_CONSUMERS; Consumer++ )
+   {
+      if ( PlanConsumers[ Consumer ].SensorMask == 0 )
+      {
+         PlanConsumers[ Consumer ].SensorMask = SensorMask & EC_SENSOR_MASK_ALL;
+         PlanConsumers[ Consumer ].PeriodMs = PeriodMs;
+         PLAN_Rebuild();
+
+         *pConsumer = Consumer;
+         Results = STATUS_SUCCESS;
+         break;
+      }
+   }
+
+   ReleaseSRWLockExclusive( &PlanLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_Unregister                                                 */
+/*                                                                            */
+/*!\brief  Removes a consumer added by PLAN_Register()                        */
+/*                                                                            */
+/*!\param   uint32_t        the consumer id                                   */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR PLAN_Unregister( uint32_t Consumer )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   AcquireSRWLockExclusive( &PlanLock );
+
+   if ( ( Consumer < PLAN_MAX_CONSUMERS ) && ( PlanConsumers[ Consumer ].SensorMask != 0 ) )
+       {
+          PlanConsumers[ Consumer ].SensorMask = 0;
+          PLAN_Rebuild();
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+       }
+
+   ReleaseSRWLockExclusive( &PlanLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_SetAdaptive                                                */
+/*                                                                            */
+/*!\brief  Samples a sensor adaptively, or stops doing so                    */
+/*                                                                            */
+/*!\param   uint32_t             EC_SENSOR_ENUM_TYPE of the sensor           */
+/*!\param   P_PLAN_ADAPT_STRUCT  bounds and deadband, NULL to stop           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    An adaptive sensor is in the plan whether or not a consumer       */
+/*!\note    registered it, and its period ignores consumer periods. It starts */
+/*!\note    at MinPeriodMs. Periods are rounded to PLAN_TICK_QUANTUM_MS.      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR PLAN_SetAdaptive( uint32_t Sensor, P_PLAN_ADAPT_STRUCT pAdapt )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( Sensor >= SENSOR_COUNT )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ENUMERATION_OUT_OF_RANGE );
+   }
+
+   if ( ( pAdapt ) &&
+        ( ( pAdapt->MinPeriodMs == 0 ) || ( pAdapt->MaxPeriodMs < pAdapt->MinPeriodMs ) || ( pAdapt->MaxPeriodMs > PLAN_MAX_HYPERPERIOD_MS ) ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockExclusive( &PlanLock );
+
+   memset( &PlanAdapt[ Sensor ], 0, sizeof( PlanAdapt[ Sensor ] ) );
+
+   if ( pAdapt )
+   {
+      PlanAdapt[ Sensor ].Config = *pAdapt;
+      PlanAdapt[ Sensor ].Config.MinPeriodMs = PLAN_RoundPeriod( pAdapt->MinPeriodMs );
+      PlanAdapt[ Sensor ].Config.MaxPeriodMs = PLAN_RoundPeriod( pAdapt->MaxPeriodMs );
+      if ( PlanAdapt[ Sensor ].Config.StableReads == 0 )
+      {
+         PlanAdapt[ Sensor ].Config.StableReads = PLAN_ADAPT_DEFAULT_STABLE_READS;
+      }
+      PlanAdapt[ Sensor ].PeriodMs = PlanAdapt[ Sensor ].Config.MinPeriodMs;
+      PlanAdapt[ Sensor ].Enabled = TRUE;
+   }
+
+   PLAN_Rebuild();
+
+   ReleaseSRWLockExclusive( &PlanLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PLAN_GetStats                                                   */
+/*                                                                            */
+/*!\brief  Returns the current plan and its counters                          */
+/*                                                                            */
+/*!\param   P_PLAN_STATS_STRUCT   pointer to structure to return them in      */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    NaiveTpsX1000 / PlannedTpsX1000 is the factor the plan saves.     */
+/*!\note    PlannedTpsX1000 is counted here, on a copy of the periods and     */
+/*!\note    outside PlanLock, the first time it is asked for after a change.  */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR PLAN_GetStats( P_PLAN_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStats )
+       {
+          uint32_t   Periods[ SENSOR_COUNT ];
+          uint32_t   Generation;
+          BOOL       Stale;
+
+          AcquireSRWLockShared( &PlanLock );
+
+          *pStats = PlanStats;
+          Generation = PlanGeneration;
+          if ( ( Stale = ( Generation != PlanEvaluated ) ) != FALSE )
+          {
+             memcpy( Periods, PlanPeriodMs, sizeof( Periods ) );
+          }
+
+          ReleaseSRWLockShared( &PlanLock );
+
+          if ( Stale )
+          {
+             pStats->PlannedTpsX1000 = PLAN_CountBursts( Periods, pStats->TickMs, pStats->HyperperiodMs );
+
+             AcquireSRWLockExclusive( &PlanLock );
+
+             if ( PlanGeneration == Generation )          // else the plan changed again while it was counted
+             {
+                PlanStats.PlannedTpsX1000 = pStats->PlannedTpsX1000;
+                PlanEvaluated = Generation;
+             }
+
+             ReleaseSRWLockExclusive( &PlanLock );
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
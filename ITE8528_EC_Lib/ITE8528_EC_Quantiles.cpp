@@ -0,0 +1,501 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Quantiles.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the DDSketch quantile sketches - adding, merging,
+//      querying and serializing them, and the per sensor sketches fed by the
+//      sampler thread.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <math.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Quantiles.h>
+#include "ITE8528_EC_Internal.h"
+
+
+#define QNT_GAMMA                   ( ( 1.0 + QNT_RELATIVE_ACCURACY ) / ( 1.0 - QNT_RELATIVE_ACCURACY ) )
+
+/*!\struct _QNT_WIRE_HEADER_STRUCT
+ * \brief  Start of a serialized sketch, little endian. Followed by a LEB128 varint count for each bin from
+ *         First up to but not including End.
+ */
+typedef struct _QNT_WIRE_HEADER_STRUCT {
+                                          uint32_t     Magic;
+                                          uint32_t     Zero;
+                                          uint64_t     Count;
+                                          uint16_t     Min;
+                                          uint16_t     Max;
+                                          uint16_t     First;
+                                          uint16_t     End;
+
+                                       } QNT_WIRE_HEADER_STRUCT, *P_QNT_WIRE_HEADER_STRUCT;
+
+static SRWLOCK               QntLock = SRWLOCK_INIT;                  // guards the sensor sketches
+static QNT_SKETCH_STRUCT     QntSensors[ SENSOR_COUNT ];
+static BOOL                  QntReady = FALSE;
+static const double          QntLogGamma = log( QNT_GAMMA );          // set when the DLL loads, before any caller
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Bin                                                         */
+/*                                                                            */
+/*!\brief  Returns the bin a reading is counted in                           */
+/*                                                                            */
+/*!\param   uint16_t        the reading, not 0                                */
+/*!\return  uint32_t        the bin                                           */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t QNT_Bin( uint16_t Raw )
+{
+   return ( uint32_t ) ceil( log( ( double ) Raw ) / QntLogGamma - 1e-9 );    // exact powers stay in the lower bin
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Init                                                        */
+/*                                                                            */
+/*!\brief  Empties a sketch                                                  */
+/*                                                                            */
+/*!\param   P_QNT_SKETCH_STRUCT   the sketch                                  */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR QNT_Init( P_QNT_SKETCH_STRUCT pSketch )
+{
+   if ( pSketch == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   memset( pSketch, 0, sizeof( *pSketch ) );
+   pSketch->Min = 0xffff;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Add                                                         */
+/*                                                                            */
+/*!\brief  Counts a reading                                                  */
+/*                                                                            */
+/*!\param   P_QNT_SKETCH_STRUCT   the sketch                                  */
+/*!\param   uint16_t              the reading, raw units                      */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR QNT_Add( P_QNT_SKETCH_STRUCT pSketch, uint16_t Raw )
+{
+   if ( pSketch == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( Raw == 0 )
+       {
+          pSketch->Zero++;
+       }
+   else
+       {
+          pSketch->Bins[ QNT_Bin( Raw ) ]++;
+       }
+
+   pSketch->Count++;
+   pSketch->Min = ( Raw < pSketch->Min ) ? Raw : pSketch->Min;
+   pSketch->Max = ( Raw > pSketch->Max ) ? Raw : pSketch->Max;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Merge                                                       */
+/*                                                                            */
+/*!\brief  Adds another sketch into a sketch                                 */
+/*                                                                            */
+/*!\param   P_QNT_SKETCH_STRUCT       the sketch to add to                    */
+/*!\param   const QNT_SKETCH_STRUCT * the sketch to add                       */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The result is the sketch of both sets of readings, exactly       */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR QNT_Merge( P_QNT_SKETCH_STRUCT pSketch, const QNT_SKETCH_STRUCT *pOther )
+{
+   uint32_t   Bin;
+
+   if ( ( pSketch == NULL ) || ( pOther == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   for ( Bin = 0; Bin < QNT_BIN_COUNT; Bin++ )
+   {
+      pSketch->Bins[ Bin ] += pOther->Bins[ Bin ];
+   }
+
+   pSketch->Count += pOther->Count;
+   pSketch->Zero += pOther->Zero;
+   pSketch->Min = ( pOther->Min < pSketch->Min ) ? pOther->Min : pSketch->Min;
+   pSketch->Max = ( pOther->Max > pSketch->Max ) ? pOther->Max : pSketch->Max;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Quantile                                                    */
+/*                                                                            */
+/*!\brief  Estimates a quantile of the readings in a sketch                  */
+/*                                                                            */
+/*!\param   const QNT_SKETCH_STRUCT * the sketch                              */
+/*!\param   double          quantile, 0 to 1 - e.g. 0.99 for p99              */
+/*!\param   pdouble_t       returns the reading, raw units                    */
+/*!\return  WINSYS_ERROR    STATUS_NOT_FOUND if the sketch is empty           */
+/*                                                                            */
+/*!\note    Within QNT_RELATIVE_ACCURACY of the reading of that rank, and    */
+/*!\note    never outside the exact min and max                              */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR QNT_Quantile( const QNT_SKETCH_STRUCT *pSketch, double Quantile, pdouble_t pValue )
+{
+   uint64_t   Rank,
+              Seen;
+   uint32_t   Bin;
+   double     Value;
+
+   if ( ( pSketch == NULL ) || ( pValue == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( ( Quantile < 0.0 ) || ( Quantile > 1.0 ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   if ( pSketch->Count == 0 )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+   }
+
+   Rank = ( uint64_t )( Quantile * ( double )( pSketch->Count - 1 ) );
+   Seen = pSketch->Zero;
+
+   if ( Rank < Seen )
+   {
+      *pValue = 0.0;
+      return STATUS_SUCCESS;
+   }
+
+   for ( Bin = 0; Bin < QNT_BIN_COUNT - 1; Bin++ )
+   {
+      Seen += pSketch->Bins[ Bin ];
+      if ( Rank < Seen )
+      {
+         break;
+      }
+   }
+
+   //
+   // the bin holds ( gamma^(Bin-1), gamma^Bin ] - this point is within the accuracy of both ends
+   //
+
+   Value = 2.0 * pow( QNT_GAMMA, ( double ) Bin ) / ( QNT_GAMMA + 1.0 );
+   Value = ( Value < pSketch->Min ) ? pSketch->Min : Value;
+   Value = ( Value > pSketch->Max ) ? pSketch->Max : Value;
+
+   *pValue = Value;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Serialize                                                   */
+/*                                                                            */
+/*!\brief  Packs a sketch into a buffer                                      */
+/*                                                                            */
+/*!\param   const QNT_SKETCH_STRUCT * the sketch                              */
+/*!\param   void *          the buffer                                        */
+/*!\param   uint32_t        size of the buffer, QNT_MAX_SERIALIZED is always  */
+/*!\param                   enough                                            */
+/*!\param   puint32_t       returns the bytes used                            */
+/*!\return  WINSYS_ERROR    STATUS_BUFFER_TOO_SMALL if it does not fit        */
+/*                                                                            */
+/*!\note    Only the bins from the lowest to the highest in use are packed,  */
+/*!\note    as varints - a day of one rail is typically under 100 bytes      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR QNT_Serialize( const QNT_SKETCH_STRUCT *pSketch, void *pBuffer, uint32_t Size, puint32_t pBytes )
+{
+   QNT_WIRE_HEADER_STRUCT   Header;
+   uint8_t                  *pOut = ( uint8_t * ) pBuffer;
+   uint32_t                 Bytes = sizeof( Header ),
+                            Bin;
+
+   if ( ( pSketch == NULL ) || ( pBuffer == NULL ) || ( pBytes == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   memset( &Header, 0, sizeof( Header ) );
+   Header.Magic = QNT_MAGIC;
+   Header.Zero = pSketch->Zero;
+   Header.Count = pSketch->Count;
+   Header.Min = pSketch->Min;
+   Header.Max = pSketch->Max;
+
+   for ( Header.First = 0; ( Header.First < QNT_BIN_COUNT ) && ( pSketch->Bins[ Header.First ] == 0 ); Header.First++ );
+   for ( Header.End = QNT_BIN_COUNT; ( Header.End > Header.First ) && ( pSketch->Bins[ Header.End - 1 ] == 0 ); Header.End-- );
+
+   if ( Size < sizeof( Header ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+   }
+
+   memcpy( pOut, &Header, sizeof( Header ) );
+
+   for ( Bin = Header.First; Bin < Header.End; Bin++ )
+   {
+      uint32_t   Value = pSketch->Bins[ Bin ];
+
+      do
+      {
+         if ( Bytes == Size )
+         {
+            return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BUFFER_TOO_SMALL );
+         }
+
+         pOut[ Bytes++ ] = ( uint8_t )( ( Value & 0x7f ) | ( ( Value > 0x7f ) ? 0x80 : 0 ) );
+         Value >>= 7;
+
+      } while ( Value );
+   }
+
+   *pBytes = Bytes;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Deserialize                                                 */
+/*                                                                            */
+/*!\brief  Unpacks a sketch packed by QNT_Serialize()                        */
+/*                                                                            */
+/*!\param   const void *          the packed sketch                           */
+/*!\param   uint32_t              its size                                    */
+/*!\param   P_QNT_SKETCH_STRUCT   returns the sketch                          */
+/*!\return  WINSYS_ERROR    STATUS_BAD_FORMAT if it is not a valid sketch     */
+/*                                                                            */
+/*!\note    Use QNT_Merge() to combine it with others. Counts must be shortest */
+/*!\note    form varints of at most 32 bits, as QNT_Serialize() writes them,  */
+/*!\note    and Bytes exactly what it returned - trailing bytes are rejected. */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR QNT_Deserialize( const void *pBuffer, uint32_t Bytes, P_QNT_SKETCH_STRUCT pSketch )
+{
+   QNT_WIRE_HEADER_STRUCT   Header;
+   const uint8_t            *pIn = ( const uint8_t * ) pBuffer;
+   uint32_t                 Offset = sizeof( Header ),
+                            Bin;
+   uint64_t                 Total;
+
+   if ( ( pBuffer == NULL ) || ( pSketch == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( Bytes < sizeof( Header ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+   }
+
+   memcpy( &Header, pIn, sizeof( Header ) );
+
+   if ( ( Header.Magic != QNT_MAGIC ) || ( Header.First > Header.End ) || ( Header.End > QNT_BIN_COUNT ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+   }
+
+   QNT_Init( pSketch );
+   pSketch->Zero = Header.Zero;
+   pSketch->Min = Header.Min;
+   pSketch->Max = Header.Max;
+   Total = Header.Zero;
+
+   for ( Bin = Header.First; Bin < Header.End; Bin++ )
+   {
+      uint32_t   Value = 0,
+                 Shift = 0;
+      uint8_t    Byte;
+
+      do
+      {
+         if ( ( Offset == Bytes ) || ( Shift > 28 ) )
+         {
+            return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+         }
+
+         Byte = pIn[ Offset++ ];
+
+         if ( ( ( Shift == 28 ) && ( Byte > 0x0f ) ) || ( ( Shift > 0 ) && ( Byte == 0 ) ) )
+         {
+            return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );   // past 32 bits, or overlong
+         }
+
+         Value |= ( uint32_t )( Byte & 0x7f ) << Shift;
+         Shift += 7;
+
+      } while ( Byte & 0x80 );
+
+      pSketch->Bins[ Bin ] = Value;
+      Total += Value;
+   }
+
+   if ( ( Total != Header.Count ) || ( Offset != Bytes ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+   }
+
+   pSketch->Count = Header.Count;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Update                                                      */
+/*                                                                            */
+/*!\brief  Counts the readings of a sample in the sensor sketches            */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample - sensors not in ValidMask are    */
+/*!\param                       skipped                                      */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Called by the sampler thread for every sample it publishes       */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR QNT_Update( P_EC_SAMPLE_STRUCT pSample )
+{
+   uint32_t   Sensor;
+
+   if ( pSample == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockExclusive( &QntLock );
+
+   if ( ! QntReady )
+   {
+      for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+      {
+         QNT_Init( &QntSensors[ Sensor ] );
+      }
+
+      QntReady = TRUE;
+   }
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      if ( pSample->ValidMask & EC_SENSOR_MASK( Sensor ) )
+      {
+         QNT_Add( &QntSensors[ Sensor ], pSample->Raw[ Sensor ] );
+      }
+   }
+
+   ReleaseSRWLockExclusive( &QntLock );
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: QNT_Snapshot                                                    */
+/*                                                                            */
+/*!\brief  Copies out the sketch of a sensor                                 */
+/*                                                                            */
+/*!\param   uint32_t              EC_SENSOR_ENUM_TYPE                         */
+/*!\param   uint32_t              non zero to start a new sketch for the      */
+/*!\param                         sensor, e.g. at the end of a day            */
+/*!\param   P_QNT_SKETCH_STRUCT   returns the sketch                          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Copy and reset are one step, so no reading is counted in both    */
+/*!\note    windows or in neither                                            */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR QNT_Snapshot( uint32_t Sensor, uint32_t Reset, P_QNT_SKETCH_STRUCT pSketch )
+{
+   if ( pSketch == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( Sensor >= SENSOR_COUNT )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockExclusive( &QntLock );
+
+   if ( QntReady )
+       {
+          *pSketch = QntSensors[ Sensor ];
+
+          if ( Reset )
+          {
+             QNT_Init( &QntSensors[ Sensor ] );
+          }
+       }
+   else
+       {
+          QNT_Init( pSketch );
+       }
+
+   ReleaseSRWLockExclusive( &QntLock );
+
+   return STATUS_SUCCESS;
+}
+
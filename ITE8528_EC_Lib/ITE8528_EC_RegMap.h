@@ -0,0 +1,440 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_RegMap.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Compile time description of the EC's SRAM registers, and the
+//!            accessors and batch read plans generated from it
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_REGMAP_INC
+#define __ITE8528_EC_REGMAP_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Internal to the library, needs C++17. Include after ITE8528_EC_Internal.h.
+//
+// Every register is a type carrying its offset, width, byte order, access mode and scale. A misdeclared
+// register - a 16 bit register whose halves are not adjacent, one that runs off the end of the SRAM, a write
+// to a read only register - and any two registers of a map that overlap fail to compile. The accessors are
+// templates over the register type, so a read is the EC call with its offset and width as constants and
+// nothing else.
+//
+
+#include <utility>
+
+#ifndef EC_FORCEINLINE
+#if defined( _MSC_VER )
+#define EC_FORCEINLINE          __forceinline
+#else
+#define EC_FORCEINLINE          inline __attribute__(( always_inline ))
+#endif
+#endif
+
+namespace ite8528
+{
+
+enum class EcByteOrder : uint8_t { LowFirst, HighFirst };
+enum class EcAccess : uint8_t { ReadOnly, WriteOnly, ReadWrite };
+
+/*!\struct EcRegDesc
+ * \brief  A register's description as a value, for the checks and plans built over a whole map
+ */
+struct EcRegDesc
+{
+   uint8_t        Offset;
+   uint8_t        Width;
+   EcByteOrder    Order;
+   EcAccess       Access;
+   uint32_t       ScaleQ16;
+};
+
+/*!\struct EcRegister
+ * \brief  A register of OffsetV .. OffsetV + WidthV - 1. Sensors override ScaleQ16 and ScaleFactor.
+ */
+template< uint8_t OffsetV, uint8_t WidthV, EcByteOrder OrderV, EcAccess AccessV >
+struct EcRegister
+{
+   static_assert( ( WidthV == 1 ) || ( WidthV == 2 ), "EC registers are 1 or 2 bytes wide" );
+   static_assert( OffsetV + WidthV <= 256, "EC register runs off the end of the SRAM" );
+   static_assert( ( WidthV == 2 ) || ( OrderV == EcByteOrder::LowFirst ), "byte order only applies to 16 bit registers" );
+
+   static constexpr uint8_t        Offset = OffsetV;
+   static constexpr uint8_t        Width = WidthV;
+   static constexpr EcByteOrder    Order = OrderV;
+   static constexpr EcAccess       Access = AccessV;
+   static constexpr uint32_t       ScaleQ16 = 1 << 16;            // raw to milli-units, x 65536
+   static constexpr double         ScaleFactor = 1.0;             // raw to the units of the double API
+};
+
+/*!\struct EcRegister16
+ * \brief  A 16 bit register declared by the offsets of its halves - the byte order follows from them
+ */
+template< uint8_t LowV, uint8_t HighV, EcAccess AccessV >
+struct EcRegister16 : EcRegister< ( LowV < HighV ) ? LowV : HighV, 2,
+                                  ( LowV < HighV ) ? EcByteOrder::LowFirst : EcByteOrder::HighFirst, AccessV >
+{
+   static_assert( ( LowV + 1 == HighV ) || ( HighV + 1 == LowV ), "the halves of a 16 bit EC register must be adjacent" );
+};
+
+//
+// scale factors are given twice, as the double the PWR_ API has always used and in Q16 for the integer API
+//
+
+constexpr bool EcScalesAgree( double ScaleFactor, uint32_t MilliPerUnit, uint32_t ScaleQ16 )
+{
+   double   Exact = ScaleFactor * MilliPerUnit * 65536.0;
+
+   return ( Exact - ScaleQ16 <= 0.5 ) && ( ScaleQ16 - Exact <= 0.5 );
+}
+
+constexpr bool EcRegsDisjoint( const EcRegDesc *pDescs, uint32_t Count )
+{
+   for ( uint32_t First = 0; First < Count; First++ )
+   {
+      for ( uint32_t Second = First + 1; Second < Count; Second++ )
+      {
+         if ( ( pDescs[ First ].Offset < pDescs[ Second ].Offset + pDescs[ Second ].Width ) &&
+              ( pDescs[ Second ].Offset < pDescs[ First ].Offset + pDescs[ First ].Width ) )
+         {
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Accessors                                                                    */
+/*                                                                               */
+/*********************************************************************************/
+
+//
+// decodes a register from an image of the SRAM, indexed by offset
+//
+
+template< typename Reg >
+EC_FORCEINLINE uint16_t EcDecode( const uint8_t *pSram )
+{
+   if constexpr ( Reg::Width == 1 )
+   {
+      return pSram[ Reg::Offset ];
+   }
+   else if constexpr ( Reg::Order == EcByteOrder::LowFirst )
+   {
+      return ( uint16_t )( ( pSram[ Reg::Offset + 1 ] << 8 ) + pSram[ Reg::Offset ] );
+   }
+   else
+   {
+      return ( uint16_t )( ( pSram[ Reg::Offset ] << 8 ) + pSram[ Reg::Offset + 1 ] );
+   }
+}
+
+//
+// both bytes of a 16 bit register come from the same burst, so the reading can not tear
+//
+
+template< typename Reg >
+EC_FORCEINLINE WINSYS_ERROR EcRead( puint16_t pRaw )
+{
+   static_assert( Reg::Access != EcAccess::WriteOnly, "EC register is write only" );
+
+   uint8_t        Sram[ Reg::Offset + Reg::Width ];
+   WINSYS_ERROR   Results;
+
+   if constexpr ( Reg::Width == 1 )
+   {
+      Results = EC_ReadByteUsingACPI( Reg::Offset, &Sram[ Reg::Offset ] );
+   }
+   else
+   {
+      Results = EC_ReadBlockUsingACPI( Reg::Offset, Reg::Width, &Sram[ Reg::Offset ] );
+   }
+
+   if ( Results == STATUS_SUCCESS )
+   {
+      *pRaw = EcDecode< Reg >( Sram );
+   }
+
+   return Results;
+}
+
+template< typename Reg >
+EC_FORCEINLINE WINSYS_ERROR EcWrite( uint16_t Value )
+{
+   static_assert( Reg::Access != EcAccess::ReadOnly, "EC register is read only" );
+
+   if constexpr ( Reg::Width == 1 )
+   {
+      return EC_WriteByteUsingACPI( Reg::Offset, ( uint8_t ) Value );
+   }
+   else
+   {
+      uint8_t        First = ( uint8_t )( ( Reg::Order == EcByteOrder::LowFirst ) ? Value : ( Value >> 8 ) );
+      uint8_t        Second = ( uint8_t )( ( Reg::Order == EcByteOrder::LowFirst ) ? ( Value >> 8 ) : Value );
+      WINSYS_ERROR   Results = EC_WriteByteUsingACPI( Reg::Offset, First );
+
+      return ( Results == STATUS_SUCCESS ) ? EC_WriteByteUsingACPI( ( uint8_t )( Reg::Offset + 1 ), Second ) : Results;
+   }
+}
+
+template< typename Reg >
+EC_FORCEINLINE uint32_t EcToMilli( uint16_t Raw )
+{
+   return ( uint32_t )( ( ( uint64_t ) Raw * Reg::ScaleQ16 + 0x8000 ) >> 16 );
+}
+
+//
+// the tachometer counts FAN_TACH_CLOCK ticks per revolution period - a count of 0 or 0xFFFF is a stopped fan
+//
+
+EC_FORCEINLINE uint16_t EcTachToRpm( uint16_t Count )
+{
+   uint32_t   Rpm;
+
+   if ( ( Count == 0 ) || ( Count == 0xFFFF ) )
+   {
+      return 0;
+   }
+
+   Rpm = ( FAN_TACH_CLOCK + Count / 2 ) / Count;
+
+   return ( uint16_t )( ( Rpm > 0xFFFF ) ? 0xFFFF : Rpm );
+}
+
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Register maps and batch read plans                                           */
+/*                                                                               */
+/*********************************************************************************/
+
+/*!\struct EcReadPlan
+ * \brief  The bursts that read one subset of a map's registers
+ */
+struct EcReadPlan
+{
+   uint8_t                 Count;
+   EC_READ_RANGE_STRUCT    Ranges[ EC_SENSOR_MAX ];
+};
+
+/*!\struct EcReadPlanTable
+ * \brief  A read plan for every subset of a map's registers, indexed by register mask
+ */
+template< uint32_t RegCount >
+struct EcReadPlanTable
+{
+   EcReadPlan              Plans[ 1 << RegCount ];
+};
+
+//
+// the fewest bursts for each subset, merging runs separated by Gap bytes or less. The registers are visited in
+// offset order, whatever order the map lists them in.
+//
+
+template< uint32_t RegCount >
+constexpr EcReadPlanTable< RegCount > EcBuildReadPlans( const EcRegDesc *pDescs, uint32_t Gap )
+{
+   EcReadPlanTable< RegCount >   Table{};
+   uint32_t                      Order[ RegCount ] = {};
+
+   for ( uint32_t Index = 0; Index < RegCount; Index++ )
+   {
+      uint32_t   Slot = Index;
+
+      for ( ; ( Slot > 0 ) && ( pDescs[ Order[ Slot - 1 ] ].Offset > pDescs[ Index ].Offset ); Slot-- )
+      {
+         Order[ Slot ] = Order[ Slot - 1 ];
+      }
+
+      Order[ Slot ] = Index;
+   }
+
+   for ( uint32_t Mask = 0; Mask < ( 1u << RegCount ); Mask++ )
+   {
+      EcReadPlan &   Plan = Table.Plans[ Mask ];
+
+      for ( uint32_t Sorted = 0; Sorted < RegCount; Sorted++ )
+      {
+         uint32_t   Index = Order[ Sorted ];
+
+         if ( Mask & ( 1u << Index ) )
+         {
+            uint32_t   Start = pDescs[ Index ].Offset;
+            uint32_t   End = Start + pDescs[ Index ].Width;
+
+            if ( ( Plan.Count > 0 ) &&
+                 ( Start <= ( uint32_t )( Plan.Ranges[ Plan.Count - 1 ].Offset + Plan.Ranges[ Plan.Count - 1 ].Count + Gap ) ) )
+            {
+               Plan.Ranges[ Plan.Count - 1 ].Count = ( uint8_t )( End - Plan.Ranges[ Plan.Count - 1 ].Offset );
+            }
+            else
+            {
+               Plan.Ranges[ Plan.Count ].Offset = ( uint8_t ) Start;
+               Plan.Ranges[ Plan.Count ].Count = ( uint8_t )( End - Start );
+               Plan.Count++;
+            }
+         }
+      }
+   }
+
+   return Table;
+}
+
+/*!\struct EcRegisterMap
+ * \brief  A set of registers that must not overlap. Index N in a mask is the Nth register.
+ */
+template< typename... Regs >
+struct EcRegisterMap
+{
+   static constexpr uint32_t    Count = sizeof...( Regs );
+   static constexpr EcRegDesc   Descs[ Count ] = { { Regs::Offset, Regs::Width, Regs::Order, Regs::Access, Regs::ScaleQ16 }... };
+
+   static_assert( EcRegsDisjoint( Descs, Count ), "EC registers overlap" );
+
+   //
+   // decodes the registers in Mask from an SRAM image into pRaw, indexed like the map
+   //
+
+   static EC_FORCEINLINE void Extract( uint32_t Mask, const uint8_t *pSram, puint16_t pRaw )
+   {
+      ExtractEach( Mask, pSram, pRaw, std::index_sequence_for< Regs... >{} );
+   }
+
+   private:
+      template< size_t... Index >
+      static EC_FORCEINLINE void ExtractEach( uint32_t Mask, const uint8_t *pSram, puint16_t pRaw, std::index_sequence< Index... > )
+      {
+         ( ( ( Mask & ( 1u << Index ) ) ? ( void )( pRaw[ Index ] = EcDecode< Regs >( pSram ) ) : ( void ) 0 ), ... );
+      }
+};
+
+
+/*********************************************************************************/
+/*                                                                               */
+/*  The PX1-C415's EC                                                            */
+/*                                                                               */
+/*********************************************************************************/
+
+struct EcRegCpuTemp : EcRegister< CPU_TEMPERATURE_OFFSET, 1, EcByteOrder::LowFirst, EcAccess::ReadOnly >
+{
+   static constexpr uint32_t       ScaleQ16 = TEMP_SCALE_Q16;
+};
+
+struct EcRegSysTemp : EcRegister< SYS_TEMPERATURE_OFFSET, 1, EcByteOrder::LowFirst, EcAccess::ReadOnly >
+{
+   static constexpr uint32_t       ScaleQ16 = TEMP_SCALE_Q16;
+};
+
+struct EcRegVCore : EcRegister16< VCORE_L_OFFSET, VCORE_H_OFFSET, EcAccess::ReadOnly >
+{
+   static constexpr uint32_t       ScaleQ16 = VCORE_SCALE_Q16;
+   static constexpr double         ScaleFactor = VCORE_SCALE_FACTOR;
+};
+
+struct EcRegV3p3 : EcRegister16< V3P3V_L_OFFSET, V3P3V_H_OFFSET, EcAccess::ReadOnly >
+{
+   static constexpr uint32_t       ScaleQ16 = V3P3_SCALE_Q16;
+   static constexpr double         ScaleFactor = V3P3_SCALE_FACTOR;
+};
+
+struct EcRegV5 : EcRegister16< V5_L_OFFSET, V5_H_OFFSET, EcAccess::ReadOnly >
+{
+   static constexpr uint32_t       ScaleQ16 = V5_SCALE_Q16;
+   static constexpr double         ScaleFactor = V5_SCALE_FACTOR;
+};
+
+struct EcRegV12 : EcRegister16< V12_L_OFFSET, V12_H_OFFSET, EcAccess::ReadOnly >
+{
+   static constexpr uint32_t       ScaleQ16 = V12_SCALE_Q16;
+   static constexpr double         ScaleFactor = V12_SCALE_FACTOR;
+};
+
+struct EcRegVDimm : EcRegister16< VDIMM_L_OFFSET, VDIMM_H_OFFSET, EcAccess::ReadOnly >
+{
+   static constexpr uint32_t       ScaleQ16 = VDIMM_SCALE_Q16;
+   static constexpr double         ScaleFactor = VDIMM_SCALE_FACTOR;
+};
+
+struct EcRegCpuFan : EcRegister16< CPU_FAN_L_OFFSET, CPU_FAN_H_OFFSET, EcAccess::ReadOnly >
+{
+   static constexpr uint32_t       ScaleQ16 = FAN_SCALE_Q16;       // of the RPM the sample holds, not the count
+};
+
+struct EcRegSmartFanCfg : EcRegister< SMART_FAN_CFG_OFFSET, 1, EcByteOrder::LowFirst, EcAccess::ReadWrite > {};
+struct EcRegSmartFanTarget1 : EcRegister< SMART_FAN_TARGET_REG1_OFFSET, 1, EcByteOrder::LowFirst, EcAccess::ReadWrite > {};
+struct EcRegSmartFanTarget2 : EcRegister< SMART_FAN_TARGET_REG2_OFFSET, 1, EcByteOrder::LowFirst, EcAccess::ReadWrite > {};
+
+//
+// SMART_FAN_TOLERANCE_OFFSET is the target 2 byte in the firmware header - the tolerance is another name for it,
+// not a register of its own
+//
+
+using EcRegSmartFanTolerance = EcRegSmartFanTarget2;
+
+static_assert( SMART_FAN_TOLERANCE_OFFSET == SMART_FAN_TARGET_REG2_OFFSET, "EcRegSmartFanTolerance assumes the tolerance is the target 2 byte" );
+
+static_assert( ( SMART_FAN_TARGET_REG1_OFFSET == SMART_FAN_CFG_OFFSET + 1 ) && ( SMART_FAN_TARGET_REG2_OFFSET == SMART_FAN_CFG_OFFSET + 2 ) &&
+               ( sizeof( FAN_SMART_CONFIG_STRUCT ) == 3 ), "FAN_SMART_CONFIG_STRUCT is transferred as one block" );
+
+struct EcRegWdtConfig : EcRegister< WDT_CONFIG_OFFSET, 1, EcByteOrder::LowFirst, EcAccess::ReadWrite > {};
+struct EcRegWdtMinutes : EcRegister< WDT_MINUTES_COUNTER_OFFSET, 1, EcByteOrder::LowFirst, EcAccess::ReadWrite > {};
+struct EcRegWdtSeconds : EcRegister< WDT_SECONDS_COUNTER_OFFSET, 1, EcByteOrder::LowFirst, EcAccess::ReadWrite > {};
+
+static_assert( EcScalesAgree( VCORE_SCALE_FACTOR, 1, VCORE_SCALE_Q16 ), "VCORE_SCALE_Q16 does not match VCORE_SCALE_FACTOR" );
+static_assert( EcScalesAgree( V3P3_SCALE_FACTOR, 1, V3P3_SCALE_Q16 ), "V3P3_SCALE_Q16 does not match V3P3_SCALE_FACTOR" );
+static_assert( EcScalesAgree( V5_SCALE_FACTOR, 1, V5_SCALE_Q16 ), "V5_SCALE_Q16 does not match V5_SCALE_FACTOR" );
+static_assert( EcScalesAgree( V12_SCALE_FACTOR, 1, V12_SCALE_Q16 ), "V12_SCALE_Q16 does not match V12_SCALE_FACTOR" );
+static_assert( EcScalesAgree( VDIMM_SCALE_FACTOR, 1, VDIMM_SCALE_Q16 ), "VDIMM_SCALE_Q16 does not match VDIMM_SCALE_FACTOR" );
+static_assert( EcScalesAgree( 1.0, 1000, TEMP_SCALE_Q16 ), "TEMP_SCALE_Q16 is not degrees to millidegrees" );
+
+//
+// every register the library knows about - declaring one over another fails here
+//
+
+using EcFullMap = EcRegisterMap< EcRegCpuTemp, EcRegSysTemp, EcRegWdtConfig, EcRegWdtMinutes, EcRegWdtSeconds,
+                                 EcRegCpuFan, EcRegSmartFanCfg, EcRegSmartFanTarget1, EcRegSmartFanTarget2,
+                                 EcRegVCore, EcRegV3p3, EcRegV5, EcRegV12, EcRegVDimm >;
+
+static_assert( EcRegsDisjoint( EcFullMap::Descs, EcFullMap::Count ), "two registers in EcFullMap share an EC offset" );
+
+//
+// the sampled sensors, indexed by EC_SENSOR_ENUM_TYPE
+//
+
+using EcSensorMap = EcRegisterMap< EcRegCpuTemp, EcRegSysTemp, EcRegVCore, EcRegV3p3, EcRegV5, EcRegV12, EcRegVDimm, EcRegCpuFan >;
+
+static_assert( EcSensorMap::Count == SENSOR_COUNT, "EcSensorMap must list every EC_SENSOR_ENUM_TYPE" );
+static_assert( EcSensorMap::Count <= EC_SENSOR_MAX, "a read plan has room for EC_SENSOR_MAX ranges" );
+
+inline constexpr EcReadPlanTable< EcSensorMap::Count >   EcSensorPlans = EcBuildReadPlans< EcSensorMap::Count >( EcSensorMap::Descs, SMP_BLOCK_MERGE_GAP );
+
+}  // namespace ite8528
+
+#endif      // #ifndef __ITE8528_EC_REGMAP_INC
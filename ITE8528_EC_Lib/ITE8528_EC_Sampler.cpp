@@ -0,0 +1,774 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Sampler.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the batch sensor query and the background sampler.
+//      Samples are kept in a ring that is drained without blocking, and a
+//      waitable event is signalled while undrained samples are waiting.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Alarms.h>
+#include <ITE8528_EC_Stats.h>
+#include <ITE8528_EC_Quantiles.h>
+#include <ITE8528_EC_Broadcast.h>
+#include "ITE8528_EC_Internal.h"
+#include "ITE8528_EC_RegMap.h"
+
+
+static EC_SAMPLE_STRUCT      SmpRing[ SMP_RING_SIZE ];
+static volatile LONG         SmpHead = 0;                  // samples written, only advanced by the sampler thread
+static volatile LONG         SmpTail = 0;                  // samples drained, only advanced by SMP_DrainSamples
+
+static SRWLOCK               SmpPinLock = SRWLOCK_INIT;    // held while a slot is written, or a run pinned
+static BOOL                  SmpPinned = FALSE;            // a peeked run is lent out, from SmpPinTail on
+static uint32_t              SmpPinTail;
+static uint32_t              SmpPinDropped;                // samples dropped while the run was pinned
+
+static SRWLOCK               SmpLatestLock = SRWLOCK_INIT;
+static EC_SAMPLE_STRUCT      SmpLatest;
+static SMP_STATS_STRUCT      SmpStats;
+
+static HANDLE                SmpNotifyEvent = NULL;        // manual reset, set while the ring holds undrained samples
+static HANDLE                SmpThread = NULL;
+static HANDLE                SmpStopEvent = NULL;
+static uint32_t              SmpIntervalMs;
+static uint32_t              SmpSensorMask;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_BuildReadRanges                                             */
+/*                                                                            */
+/*!\brief  Turns a set of sensors into the fewest contiguous EC block reads   */
+/*                                                                            */
+/*!\param   uint32_t                 mask of EC_SENSOR_ENUM_TYPE bits         */
+/*!\param   P_EC_READ_RANGE_STRUCT   array of at least SENSOR_COUNT ranges    */
+/*!\return  uint32_t        number of ranges filled in                        */
+/*                                                                            */
+/*!\note    Ranges separated by SMP_BLOCK_MERGE_GAP bytes or less are merged  */
+/*                                                                            */
+/******************************************************************************/
+uint32_t SMP_BuildReadRanges( uint32_t SensorMask, P_EC_READ_RANGE_STRUCT pRanges )
+{
+   const ite8528::EcReadPlan &   Plan = ite8528::EcSensorPlans.Plans[ SensorMask & EC_SENSOR_MASK_ALL ];
+
+   memcpy( pRanges, Plan.Ranges, Plan.Count * sizeof( EC_READ_RANGE_STRUCT ) );
+
+   return Plan.Count;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_ExtractSensors                                              */
+/*                                                                            */
+/*!\brief  Copies sensor readings out of an image of the EC's SRAM           */
+/*                                                                            */
+/*!\param   uint32_t            mask of sensors to extract                    */
+/*!\param   const uint8_t *     256 byte SRAM image, indexed by offset        */
+/*!\param   P_EC_SAMPLE_STRUCT  sample to fill in                             */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    The fan's tachometer count is converted to RPM                    */
+/*                                                                            */
+/******************************************************************************/
+void SMP_ExtractSensors( uint32_t SensorMask, const uint8_t *pSram, P_EC_SAMPLE_STRUCT pSample )
+{
+   ite8528::EcSensorMap::Extract( SensorMask, pSram, pSample->Raw );
+
+   if ( SensorMask & EC_SENSOR_MASK( SENSOR_CPU_FAN ) )
+   {
+      pSample->Raw[ SENSOR_CPU_FAN ] = ite8528::EcTachToRpm( pSample->Raw[ SENSOR_CPU_FAN ] );
+   }
+
+   pSample->ValidMask = ( uint16_t )( SensorMask & EC_SENSOR_MASK_ALL );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_QuerySensors                                                */
+/*                                                                            */
+/*!\brief  Reads a set of sensors using as few EC bursts as possible          */
+/*                                                                            */
+/*!\param   uint32_t            mask of EC_SENSOR_ENUM_TYPE bits to read      */
+/*!\param   P_EC_SAMPLE_STRUCT  pointer to sample to return the readings in   */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    16 bit sensors are read in the same burst as their low byte, so   */
+/*!\note    they can not tear. Sequence is left for the caller to fill in.    */
+/*!\note    In dual mode the bursts are split with the IO space window.       */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_QuerySensors( uint32_t SensorMask, P_EC_SAMPLE_STRUCT pSample )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pSample )
+       {
+          EC_READ_RANGE_STRUCT   Ranges[ SENSOR_COUNT ];
+          uint8_t                Sram[ 256 ];
+          uint32_t               RangeCount = SMP_BuildReadRanges( SensorMask, Ranges );
+
+          pSample->TimestampMs = EC_GetSystemTimeMs();
+
+          Results = DUAL_ReadRanges( Ranges, RangeCount, Sram );
+
+          InterlockedExchangeAdd( ( LONG volatile * ) &SmpStats.Bursts, ( LONG ) RangeCount );
+
+          if ( Results == STATUS_SUCCESS )
+          {
+             SMP_ExtractSensors( SensorMask, Sram, pSample );
+          }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_Publish                                                     */
+/*                                                                            */
+/*!\brief  Adds a sample to the ring and the broadcast ring, and signals the */
+/*         notification event                                                 */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample to publish                         */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Only called from the sampler thread. The alarm rules, statistics  */
+/*!\note    and quantile sketches are run over the sample first. A sample    */
+/*!\note    whose slot is pinned by SMP_PeekSamples() is dropped from the     */
+/*!\note    ring, and counted as an overrun.                                  */
+/*                                                                            */
+/******************************************************************************/
+static void SMP_Publish( P_EC_SAMPLE_STRUCT pSample )
+{
+   BOOL   Dropped;
+
+   pSample->Sequence = ( uint32_t ) SmpHead;
+
+   ALRM_Evaluate( pSample );
+   STAT_Update( pSample );
+   QNT_Update( pSample );
+
+   AcquireSRWLockExclusive( &SmpPinLock );
+
+   Dropped = ( SmpPinned ) && ( ( uint32_t ) SmpHead - SmpPinTail >= SMP_RING_SIZE );
+
+   if ( Dropped )
+       {
+          SmpPinDropped++;
+       }
+   else
+       {
+          SmpRing[ ( uint32_t ) SmpHead & ( SMP_RING_SIZE - 1 ) ] = *pSample;
+          MemoryBarrier();
+          InterlockedIncrement( &SmpHead );
+       }
+
+   ReleaseSRWLockExclusive( &SmpPinLock );
+
+   if ( Dropped )
+   {
+      InterlockedIncrement( ( LONG volatile * ) &SmpStats.Overruns );
+   }
+
+   AcquireSRWLockExclusive( &SmpLatestLock );
+   SmpLatest = *pSample;
+   ReleaseSRWLockExclusive( &SmpLatestLock );
+
+   BRD_Publish( pSample );
+
+   SmpStats.Samples++;
+   SetEvent( SmpNotifyEvent );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_Thread                                                      */
+/*                                                                            */
+/*!\brief  Background thread that sweeps the sensors every interval          */
+/*                                                                            */
+/*!\param   LPVOID          unused                                            */
+/*!\return  DWORD           thread exit code                                  */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI SMP_Thread( LPVOID pParam )
+{
+   EC_SAMPLE_STRUCT   Sample;
+
+   UNREFERENCED_PARAMETER( pParam );
+
+   memset( &Sample, 0, sizeof( Sample ) );
+
+   do
+   {
+      if ( SMP_QuerySensors( SmpSensorMask, &Sample ) == STATUS_SUCCESS )
+          {
+             SMP_Publish( &Sample );
+          }
+      else
+          {
+             SmpStats.Errors++;
+          }
+
+   } while ( WaitForSingleObject( SmpStopEvent, SmpIntervalMs ) == WAIT_TIMEOUT );
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_PlannedThread                                               */
+/*                                                                            */
+/*!\brief  Background thread that sweeps the sensors the planner says are    */
+/*         due, and sleeps until the next are                                 */
+/*                                                                            */
+/*!\param   LPVOID          the planner's changed event                       */
+/*!\return  DWORD           thread exit code                                  */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI SMP_PlannedThread( LPVOID pParam )
+{
+   EC_SAMPLE_STRUCT   Sample;
+   HANDLE             Handles[ 2 ] = { SmpStopEvent, ( HANDLE ) pParam };
+   uint32_t           WaitMs;
+
+   memset( &Sample, 0, sizeof( Sample ) );
+
+   do
+   {
+      uint64_t   NowMs = EC_GetMicroSecs() / 1000;
+      uint32_t   DueMask = PLAN_NextSweep( NowMs, &WaitMs );
+
+      if ( DueMask )
+      {
+         if ( SMP_QuerySensors( DueMask, &Sample ) == STATUS_SUCCESS )
+             {
+                PLAN_Feedback( &Sample, NowMs );
+                SMP_Publish( &Sample );
+             }
+         else
+             {
+                SmpStats.Errors++;
+             }
+      }
+
+   } while ( WaitForMultipleObjects( 2, Handles, FALSE, WaitMs ) != WAIT_OBJECT_0 );
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_StartThread                                                 */
+/*                                                                            */
+/*!\brief  Creates the events and starts a sampler thread                    */
+/*                                                                            */
+/*!\param   LPTHREAD_START_ROUTINE  SMP_Thread or SMP_PlannedThread          */
+/*!\param   LPVOID                  parameter for the thread                 */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Called with no sampler running                                    */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR SMP_StartThread( LPTHREAD_START_ROUTINE pRoutine, LPVOID pParam )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( SmpNotifyEvent == NULL )
+   {
+      SmpNotifyEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
+   }
+
+   if ( ( SmpNotifyEvent ) && ( ( SmpStopEvent = CreateEvent( NULL, TRUE, FALSE, NULL ) ) != NULL ) )
+   {
+      SmpThread = CreateThread( NULL, 0, pRoutine, pParam, 0, NULL );
+   }
+
+   if ( SmpThread == NULL )
+   {
+      if ( SmpStopEvent )
+      {
+         CloseHandle( SmpStopEvent );
+         SmpStopEvent = NULL;
+      }
+
+      Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+   }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_Start                                                       */
+/*                                                                            */
+/*!\brief  Starts the sampler thread                                          */
+/*                                                                            */
+/*!\param   uint32_t        sweep period in msecs, 0 = SMP_DEFAULT_INTERVAL_MS*/
+/*!\param   uint32_t        mask of sensors to read, 0 = all                  */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_Start( uint32_t IntervalMs, uint32_t SensorMask )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( SmpThread == NULL )
+       {
+          SmpIntervalMs = ( IntervalMs ) ? IntervalMs : SMP_DEFAULT_INTERVAL_MS;
+          SmpSensorMask = ( SensorMask & EC_SENSOR_MASK_ALL ) ? ( SensorMask & EC_SENSOR_MASK_ALL ) : EC_SENSOR_MASK_ALL;
+
+          Results = SMP_StartThread( SMP_Thread, NULL );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ALREADY_RUNNING );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_StartPlanned                                                */
+/*                                                                            */
+/*!\brief  Starts the sampler thread with its sweeps chosen by the planner    */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    See ITE8528_EC_Planner.h. Consumers may be registered before or   */
+/*!\note    after the sampler starts.                                         */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_StartPlanned( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( SmpThread == NULL )
+       {
+          HANDLE   ChangedEvent = PLAN_GetChangedEvent();
+
+          if ( ChangedEvent )
+              {
+                 Results = SMP_StartThread( SMP_PlannedThread, ChangedEvent );
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_ALREADY_RUNNING );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_Stop                                                        */
+/*                                                                            */
+/*!\brief  Stops the sampler thread and waits for it to exit                  */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The notification handle stays valid, and samples still in the     */
+/*!\note    ring may still be drained                                         */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_Stop( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( SmpThread != NULL )
+       {
+          SetEvent( SmpStopEvent );
+          WaitForSingleObject( SmpThread, INFINITE );
+
+          CloseHandle( SmpThread );
+          CloseHandle( SmpStopEvent );
+          SmpThread = NULL;
+          SmpStopEvent = NULL;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_GetNotifyHandle                                             */
+/*                                                                            */
+/*!\brief  Returns a waitable handle that is signalled while new samples are  */
+/*         waiting to be drained                                              */
+/*                                                                            */
+/*!\param   HANDLE *        pointer to return the event handle in             */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The handle is a manual reset event owned by the library - wait on */
+/*!\note    it with WaitForMultipleObjects() or register it with the          */
+/*!\note    application's event loop, but do not close it. It is cleared by   */
+/*!\note    SMP_DrainSamples() or SMP_PeekSamples() once the ring is empty.   */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_GetNotifyHandle( HANDLE *pHandle )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pHandle )
+       {
+          if ( SmpNotifyEvent )
+              {
+                 *pHandle = SmpNotifyEvent;
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_WaitForSamples                                              */
+/*                                                                            */
+/*!\brief  Waits for new samples to be waiting to be drained                */
+/*                                                                            */
+/*!\param   uint32_t        msecs to wait at most                             */
+/*!\return  WINSYS_ERROR    STATUS_SUCCESS once there are samples to drain,   */
+/*!\return                  STATUS_TIMEOUT if none arrived in time            */
+/*                                                                            */
+/*!\note    SMP_GetNotifyHandle() without the handle, for callers that have  */
+/*!\note    no use for a Windows event                                        */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_WaitForSamples( uint32_t TimeoutMs )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( SmpNotifyEvent == NULL )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+       }
+   else if ( WaitForSingleObject( SmpNotifyEvent, TimeoutMs ) != WAIT_OBJECT_0 )
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_TIMEOUT );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_DrainSamples                                                */
+/*                                                                            */
+/*!\brief  Copies the samples taken since the last drain, without blocking    */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  buffer to return samples in, oldest first     */
+/*!\param   uint32_t            size of the buffer, in samples                */
+/*!\param   puint32_t           returns the number of samples copied          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    There must only be one drainer. If the drainer falls more than    */
+/*!\note    SMP_RING_SIZE samples behind, the oldest are dropped and counted  */
+/*!\note    as overruns. The notification event is left set if samples remain.*/
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_DrainSamples( P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( pSamples ) && ( pCount ) )
+       {
+          uint32_t   Tail = ( uint32_t ) SmpTail;
+          uint32_t   Head;
+          uint32_t   Count = 0;
+
+          if ( SmpNotifyEvent )
+          {
+             ResetEvent( SmpNotifyEvent );            // reset before reading, so a sample published meanwhile re-signals
+          }
+
+          Head = ( uint32_t ) SmpHead;
+          MemoryBarrier();
+
+          if ( ( Head - Tail ) >= SMP_RING_SIZE )
+          {
+             InterlockedExchangeAdd( ( LONG volatile * ) &SmpStats.Overruns, ( LONG )( ( Head - Tail ) - SMP_RING_SIZE + 1 ) );
+             Tail = Head - SMP_RING_SIZE + 1;        // the slot at Head - SMP_RING_SIZE is the next to be written
+          }
+
+          while ( ( Tail != Head ) && ( Count < MaxSamples ) )
+          {
+             pSamples[ Count ] = SmpRing[ Tail & ( SMP_RING_SIZE - 1 ) ];
+             MemoryBarrier();
+
+             if ( ( ( uint32_t ) SmpHead - Tail ) < SMP_RING_SIZE )
+                 {
+                    Count++;                          // slot was not overwritten while it was copied
+                 }
+             else
+                 {
+                    InterlockedIncrement( ( LONG volatile * ) &SmpStats.Overruns );
+                 }
+
+             Tail++;
+          }
+
+          InterlockedExchange( &SmpTail, ( LONG ) Tail );
+
+          if ( ( Tail != ( uint32_t ) SmpHead ) && ( SmpNotifyEvent ) )
+          {
+             SetEvent( SmpNotifyEvent );
+          }
+
+          *pCount = Count;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_PeekSamples                                                 */
+/*                                                                            */
+/*!\brief  Returns the samples taken since the last drain, in place          */
+/*                                                                            */
+/*!\param   const EC_SAMPLE_STRUCT **  returns the oldest undrained sample    */
+/*!\param   puint32_t           returns the number of samples after it, up to */
+/*!\param                       the end of the ring                           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Does not drain anything - SMP_ReleaseSamples does, and until then */
+/*!\note    the run is pinned: the sampler drops new samples rather than      */
+/*!\note    overwrite it. Samples the sampler overwrote before the peek are   */
+/*!\note    skipped and counted as overruns, as SMP_DrainSamples does.        */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_PeekSamples( const EC_SAMPLE_STRUCT **ppSamples, puint32_t pCount )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( ( ppSamples ) && ( pCount ) )
+       {
+          uint32_t   Tail = ( uint32_t ) SmpTail;
+          uint32_t   Head;
+          uint32_t   Index;
+
+          if ( SmpNotifyEvent )
+          {
+             ResetEvent( SmpNotifyEvent );            // reset before reading, so a sample published meanwhile re-signals
+          }
+
+          //
+          // with the pin lock held no slot is being written, so the run found is whole, and pinned before the
+          // sampler can come round to it
+          //
+
+          AcquireSRWLockExclusive( &SmpPinLock );
+
+          Head = ( uint32_t ) SmpHead;
+
+          if ( ( Head - Tail ) >= SMP_RING_SIZE )
+          {
+             InterlockedExchangeAdd( ( LONG volatile * ) &SmpStats.Overruns, ( LONG )( ( Head - Tail ) - SMP_RING_SIZE + 1 ) );
+             Tail = Head - SMP_RING_SIZE + 1;        // the slot at Head - SMP_RING_SIZE is the next to be written
+             InterlockedExchange( &SmpTail, ( LONG ) Tail );
+          }
+
+          Index = Tail & ( SMP_RING_SIZE - 1 );
+
+          *ppSamples = &SmpRing[ Index ];
+          *pCount = ( Head - Tail < SMP_RING_SIZE - Index ) ? Head - Tail : SMP_RING_SIZE - Index;
+
+          if ( *pCount )
+          {
+             SmpPinned = TRUE;
+             SmpPinTail = Tail;
+             SmpPinDropped = 0;
+          }
+
+          ReleaseSRWLockExclusive( &SmpPinLock );
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_ReleaseSamples                                              */
+/*                                                                            */
+/*!\brief  Drains samples returned by SMP_PeekSamples once they are used,   */
+/*!\brief  and unpins them                                                   */
+/*                                                                            */
+/*!\param   uint32_t            number of samples to drain                    */
+/*!\param   puint32_t           returns how many samples the sampler dropped  */
+/*!\param                       while they were pinned, may be NULL           */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Dropped samples are also counted as overruns. The notification  */
+/*!\note    event is left set if samples remain.                              */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_ReleaseSamples( uint32_t Count, puint32_t pDropped )
+{
+   uint32_t   Tail = ( uint32_t ) SmpTail;
+   uint32_t   Head = ( uint32_t ) SmpHead;
+   uint32_t   Dropped;
+
+   if ( Count > Head - Tail )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockExclusive( &SmpPinLock );
+
+   InterlockedExchange( &SmpTail, ( LONG )( Tail + Count ) );
+
+   Dropped = SmpPinDropped;
+   SmpPinned = FALSE;
+   SmpPinDropped = 0;
+
+   ReleaseSRWLockExclusive( &SmpPinLock );
+
+   if ( ( Tail + Count != ( uint32_t ) SmpHead ) && ( SmpNotifyEvent ) )
+   {
+      SetEvent( SmpNotifyEvent );
+   }
+
+   if ( pDropped )
+   {
+      *pDropped = Dropped;
+   }
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_GetLatest                                                   */
+/*                                                                            */
+/*!\brief  Returns the most recent sample without touching the EC            */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  pointer to return the sample in               */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_GetLatest( P_EC_SAMPLE_STRUCT pSample )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pSample )
+       {
+          if ( SmpHead != 0 )
+              {
+                 AcquireSRWLockShared( &SmpLatestLock );
+                 *pSample = SmpLatest;
+                 ReleaseSRWLockShared( &SmpLatestLock );
+              }
+          else
+              {
+                 Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+              }
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: SMP_GetStats                                                    */
+/*                                                                            */
+/*!\brief  Returns the sampler's counters                                     */
+/*                                                                            */
+/*!\param   P_SMP_STATS_STRUCT  pointer to structure to return counters in    */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR SMP_GetStats( P_SMP_STATS_STRUCT pStats )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pStats )
+       {
+          *pStats = SmpStats;
+       }
+   else
+       {
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+       }
+
+   return Results;
+}
+
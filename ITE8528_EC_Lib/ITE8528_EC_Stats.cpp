@@ -0,0 +1,570 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Stats.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the streaming sensor statistics - the Welford
+//      baseline, EWMA, windowed min/max, and the anomaly checks run by the
+//      sampler thread.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <math.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Stats.h>
+#include "ITE8528_EC_Internal.h"
+
+
+#define STAT_WINDOW_MASK            ( STAT_MAX_WINDOW - 1 )
+#define STAT_MAX_FIRED              ( SENSOR_COUNT * 3 )
+#define STAT_CLEAR_FRACTION         0.75                              // of the limit, to clear an anomaly
+
+/*!\struct _STAT_QUEUE_STRUCT
+ * \brief  A monotonic queue over the window - the readings that can still become the window's min (or max),
+ *         oldest first. Each reading is queued and dequeued once, so keeping it costs O(1) per sample.
+ */
+typedef struct _STAT_QUEUE_STRUCT {
+                                     uint32_t     Head;
+                                     uint32_t     Tail;
+                                     uint32_t     Number[ STAT_MAX_WINDOW ];     // sample number of the reading
+                                     uint16_t     Raw[ STAT_MAX_WINDOW ];
+
+                                  } STAT_QUEUE_STRUCT, *P_STAT_QUEUE_STRUCT;
+
+/*!\struct _STAT_STATE_STRUCT
+ * \brief  Everything kept for one sensor
+ */
+typedef struct _STAT_STATE_STRUCT {
+                                     STAT_CONFIG_STRUCT   Config;
+                                     uint64_t             Samples;
+                                     double               Mean;
+                                     double               M2;             // sum of squared differences from Mean
+                                     double               Ewma;
+                                     double               BaselineMean;
+                                     double               BaselineStdDev;
+                                     double               BaselineSigma;  // BaselineStdDev, at least MinSigma
+                                     BOOL                 Learned;
+                                     uint16_t             Last;
+                                     uint16_t             Min;
+                                     uint16_t             Max;
+                                     uint16_t             Active;
+                                     uint32_t             Anomalies;
+                                     STAT_QUEUE_STRUCT    WindowMin;
+                                     STAT_QUEUE_STRUCT    WindowMax;
+
+                                  } STAT_STATE_STRUCT, *P_STAT_STATE_STRUCT;
+
+static SRWLOCK               StatLock = SRWLOCK_INIT;                 // guards everything below
+static STAT_STATE_STRUCT     StatState[ SENSOR_COUNT ];
+static BOOL                  StatReady = FALSE;
+
+static uint32_t              StatDeliver = STAT_DELIVER_EVENT_QUEUE;
+static STAT_CALLBACK         StatCallback = NULL;
+static PVOID                 StatContext = NULL;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_ResetState                                                 */
+/*                                                                            */
+/*!\brief  Forgets everything learned about a sensor, keeping its config     */
+/*                                                                            */
+/*!\param   P_STAT_STATE_STRUCT  the sensor                                   */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called with StatLock held                                        */
+/*                                                                            */
+/******************************************************************************/
+static void STAT_ResetState( P_STAT_STATE_STRUCT pState )
+{
+   STAT_CONFIG_STRUCT   Config = pState->Config;
+
+   memset( pState, 0, sizeof( *pState ) );
+   pState->Config = Config;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_Init                                                       */
+/*                                                                            */
+/*!\brief  Sets the default config on first use                             */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called with StatLock held exclusively                            */
+/*                                                                            */
+/******************************************************************************/
+static void STAT_Init( void )
+{
+   uint32_t   Sensor;
+
+   if ( StatReady )
+   {
+      return;
+   }
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      P_STAT_CONFIG_STRUCT   pConfig = &StatState[ Sensor ].Config;
+
+      pConfig->Enabled = ( Sensor >= SENSOR_VCORE ) && ( Sensor <= SENSOR_VDIMM );     // the power rails
+      pConfig->WarmupSamples = STAT_DEFAULT_WARMUP;
+      pConfig->WindowSamples = STAT_DEFAULT_WINDOW;
+      pConfig->EwmaAlpha = STAT_DEFAULT_EWMA_ALPHA;
+      pConfig->SigmaLimit = STAT_DEFAULT_SIGMA_LIMIT;
+      pConfig->SpikeLimit = STAT_DEFAULT_SPIKE_LIMIT;
+      pConfig->MinSigma = STAT_DEFAULT_MIN_SIGMA;
+   }
+
+   StatReady = TRUE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_Push                                                       */
+/*                                                                            */
+/*!\brief  Adds a reading to a monotonic window queue                        */
+/*                                                                            */
+/*!\param   P_STAT_QUEUE_STRUCT  the queue                                    */
+/*!\param   uint32_t             sample number of the reading                 */
+/*!\param   uint16_t             the reading                                  */
+/*!\param   uint32_t             window length                                */
+/*!\param   int32_t              1 for a min queue, -1 for a max queue        */
+/*!\return  uint16_t             the window's min (or max)                    */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+static uint16_t STAT_Push( P_STAT_QUEUE_STRUCT pQueue, uint32_t Number, uint16_t Raw, uint32_t Window, int32_t Sign )
+{
+   //
+   // drop the readings this one pushes out of the window first - the ring holds only STAT_MAX_WINDOW of them,
+   // and a full window plus this one would overwrite the head
+   //
+
+   while ( ( pQueue->Tail != pQueue->Head ) && ( Number - pQueue->Number[ pQueue->Head & STAT_WINDOW_MASK ] >= Window ) )
+   {
+      pQueue->Head++;
+   }
+
+   //
+   // readings behind this one that it beats can never be the answer again
+   //
+
+   while ( ( pQueue->Tail != pQueue->Head ) &&
+           ( ( int32_t ) pQueue->Raw[ ( pQueue->Tail - 1 ) & STAT_WINDOW_MASK ] * Sign >= ( int32_t ) Raw * Sign ) )
+   {
+      pQueue->Tail--;
+   }
+
+   pQueue->Number[ pQueue->Tail & STAT_WINDOW_MASK ] = Number;
+   pQueue->Raw[ pQueue->Tail & STAT_WINDOW_MASK ] = Raw;
+   pQueue->Tail++;
+
+   return pQueue->Raw[ pQueue->Head & STAT_WINDOW_MASK ];
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_Check                                                      */
+/*                                                                            */
+/*!\brief  Raises or clears one kind of anomaly                              */
+/*                                                                            */
+/*!\param   P_STAT_STATE_STRUCT   the sensor                                  */
+/*!\param   uint32_t              STAT_ANOMALY_ENUM_TYPE                      */
+/*!\param   double                deviations from normal                      */
+/*!\param   double                limit                                       */
+/*!\param   P_STAT_ANOMALY_STRUCT where to record a change, filled in except  */
+/*!\param                         for Sensor, Raw and TimestampMs             */
+/*!\return  BOOL                  TRUE if there is a change to deliver         */
+/*                                                                            */
+/*!\note    Clears at STAT_CLEAR_FRACTION of the limit, so a reading sitting  */
+/*!\note    on the limit does not flap. Spikes have no cleared state and are  */
+/*!\note    reported every time.                                              */
+/*                                                                            */
+/******************************************************************************/
+static BOOL STAT_Check( P_STAT_STATE_STRUCT pState, uint32_t Kind, double Sigmas, double Limit, P_STAT_ANOMALY_STRUCT pAnomaly )
+{
+   uint16_t   Bit = ( uint16_t )( 1 << Kind );
+   BOOL       Out = ( pState->Active & Bit ) ? ( fabs( Sigmas ) >= Limit * STAT_CLEAR_FRACTION ) : ( fabs( Sigmas ) > Limit );
+
+   if ( ( Kind != STAT_ANOMALY_SPIKE ) && ( Out == ( ( pState->Active & Bit ) != 0 ) ) )
+   {
+      return FALSE;                                   // no change
+   }
+
+   if ( ( Kind == STAT_ANOMALY_SPIKE ) && ( ! Out ) )
+   {
+      return FALSE;
+   }
+
+   if ( Kind != STAT_ANOMALY_SPIKE )
+   {
+      pState->Active ^= Bit;
+   }
+
+   if ( Out )
+   {
+      pState->Anomalies++;
+   }
+
+   pAnomaly->Kind = ( uint8_t ) Kind;
+   pAnomaly->Raised = ( uint8_t ) Out;
+   pAnomaly->Sigmas = Sigmas;
+
+   return TRUE;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_Deliver                                                    */
+/*                                                                            */
+/*!\brief  Sends an anomaly to the callback and/or the event queue           */
+/*                                                                            */
+/*!\param   P_STAT_ANOMALY_STRUCT  the anomaly                                */
+/*!\param   uint32_t               STAT_DELIVER_xxx flags                     */
+/*!\param   STAT_CALLBACK          the callback, may be NULL                  */
+/*!\param   PVOID                  context passed back to the callback        */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called without StatLock, with the delivery settings as they were  */
+/*!\note    when the anomaly fired                                            */
+/*                                                                            */
+/******************************************************************************/
+static void STAT_Deliver( P_STAT_ANOMALY_STRUCT pAnomaly, uint32_t Deliver, STAT_CALLBACK Callback, PVOID pContext )
+{
+   if ( ( Deliver & STAT_DELIVER_CALLBACK ) && ( Callback ) )
+   {
+      Callback( pAnomaly, pContext );
+   }
+
+   if ( Deliver & STAT_DELIVER_EVENT_QUEUE )
+   {
+      EC_EVENT_STRUCT   Event = { EVT_CLASS_ANOMALY };
+
+      Event.Param = ( uint8_t )( pAnomaly->Kind | ( ( pAnomaly->Raised ) ? 0 : STAT_ANOMALY_CLEARED ) );
+      Event.Id = pAnomaly->Sensor;
+      Event.TimestampUs = EC_GetMicroSecs();
+
+      EVT_Post( &Event );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_Update                                                     */
+/*                                                                            */
+/*!\brief  Updates the statistics of every enabled sensor in a sample        */
+/*                                                                            */
+/*!\param   P_EC_SAMPLE_STRUCT  the sample - sensors not in ValidMask are    */
+/*!\param                       skipped                                      */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Called by the sampler thread for every sample it publishes, and  */
+/*!\note    may be called directly with samples from elsewhere. Anomalies are */
+/*!\note    delivered after StatLock is released, so the callback and the     */
+/*!\note    event subscribers may call the STAT_ functions.                   */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR STAT_Update( P_EC_SAMPLE_STRUCT pSample )
+{
+   STAT_ANOMALY_STRUCT   Fired[ STAT_MAX_FIRED ];
+   STAT_CALLBACK         Callback;
+   PVOID                 pContext;
+   uint32_t              Deliver,
+                         FiredCount = 0,
+                         Sensor,
+                         Index;
+
+   if ( pSample == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockExclusive( &StatLock );
+
+   STAT_Init();
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      P_STAT_STATE_STRUCT   pState = &StatState[ Sensor ];
+      P_STAT_CONFIG_STRUCT  pConfig = &pState->Config;
+      uint16_t              Raw = pSample->Raw[ Sensor ];
+      double                Value = Raw,
+                            Delta;
+
+      if ( ( ! pConfig->Enabled ) || ( ( pSample->ValidMask & EC_SENSOR_MASK( Sensor ) ) == 0 ) )
+      {
+         continue;
+      }
+
+      if ( pState->Samples == 0 )
+          {
+             pState->Ewma = Value;
+             pState->Min = pState->Max = Raw;
+          }
+      else
+          {
+             pState->Ewma += pConfig->EwmaAlpha * ( Value - pState->Ewma );
+             pState->Min = ( Raw < pState->Min ) ? Raw : pState->Min;
+             pState->Max = ( Raw > pState->Max ) ? Raw : pState->Max;
+          }
+
+      STAT_Push( &pState->WindowMin, ( uint32_t ) pState->Samples, Raw, pConfig->WindowSamples, 1 );
+      STAT_Push( &pState->WindowMax, ( uint32_t ) pState->Samples, Raw, pConfig->WindowSamples, -1 );
+
+      //
+      // compare against the baseline once it has been learned
+      //
+
+      if ( pState->Learned )
+      {
+         double   Sigma = pState->BaselineSigma;
+
+         if ( STAT_Check( pState, STAT_ANOMALY_DEVIATION, ( Value - pState->BaselineMean ) / Sigma, pConfig->SigmaLimit, &Fired[ FiredCount ] ) )
+         {
+            Fired[ FiredCount++ ].Sensor = ( uint8_t ) Sensor;
+         }
+
+         if ( STAT_Check( pState, STAT_ANOMALY_DRIFT, ( pState->Ewma - pState->BaselineMean ) / Sigma, pConfig->SigmaLimit, &Fired[ FiredCount ] ) )
+         {
+            Fired[ FiredCount++ ].Sensor = ( uint8_t ) Sensor;
+         }
+
+         if ( STAT_Check( pState, STAT_ANOMALY_SPIKE, ( Value - pState->Last ) / Sigma, pConfig->SpikeLimit, &Fired[ FiredCount ] ) )
+         {
+            Fired[ FiredCount++ ].Sensor = ( uint8_t ) Sensor;
+         }
+      }
+
+      //
+      // Welford, and the baseline is what it says at the end of the warm up
+      //
+
+      pState->Samples++;
+      Delta = Value - pState->Mean;
+      pState->Mean += Delta / ( double ) pState->Samples;
+      pState->M2 += Delta * ( Value - pState->Mean );
+      pState->Last = Raw;
+
+      if ( ( ! pState->Learned ) && ( pState->Samples >= pConfig->WarmupSamples ) )
+      {
+         pState->BaselineMean = pState->Mean;
+         pState->BaselineStdDev = sqrt( pState->M2 / ( double )( pState->Samples - 1 ) );
+         pState->BaselineSigma = ( pState->BaselineStdDev < pConfig->MinSigma ) ? pConfig->MinSigma : pState->BaselineStdDev;
+         pState->Learned = TRUE;
+      }
+   }
+
+   for ( Index = 0; Index < FiredCount; Index++ )
+   {
+      Fired[ Index ].Reserved = 0;
+      Fired[ Index ].Reserved2 = 0;
+      Fired[ Index ].Raw = pSample->Raw[ Fired[ Index ].Sensor ];
+      Fired[ Index ].TimestampMs = pSample->TimestampMs;
+   }
+
+   Deliver = StatDeliver;
+   Callback = StatCallback;
+   pContext = StatContext;
+
+   ReleaseSRWLockExclusive( &StatLock );
+
+   for ( Index = 0; Index < FiredCount; Index++ )
+   {
+      STAT_Deliver( &Fired[ Index ], Deliver, Callback, pContext );
+   }
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_Configure                                                  */
+/*                                                                            */
+/*!\brief  Sets how a sensor is tracked, and starts learning it afresh       */
+/*                                                                            */
+/*!\param   uint32_t              EC_SENSOR_ENUM_TYPE                         */
+/*!\param   P_STAT_CONFIG_STRUCT  the config                                  */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR STAT_Configure( uint32_t Sensor, P_STAT_CONFIG_STRUCT pConfig )
+{
+   if ( pConfig == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( ( Sensor >= SENSOR_COUNT ) || ( pConfig->WarmupSamples < 2 ) || ( pConfig->WindowSamples == 0 ) || ( pConfig->WindowSamples > STAT_MAX_WINDOW ) ||
+        ( pConfig->EwmaAlpha <= 0.0 ) || ( pConfig->EwmaAlpha > 1.0 ) || ( pConfig->SigmaLimit <= 0.0 ) ||
+        ( pConfig->SpikeLimit <= 0.0 ) || ( pConfig->MinSigma <= 0.0 ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockExclusive( &StatLock );
+
+   STAT_Init();
+   StatState[ Sensor ].Config = *pConfig;
+   STAT_ResetState( &StatState[ Sensor ] );
+
+   ReleaseSRWLockExclusive( &StatLock );
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_Reset                                                      */
+/*                                                                            */
+/*!\brief  Forgets what has been learned about some sensors                  */
+/*                                                                            */
+/*!\param   uint32_t        EC_SENSOR_MASK() bits of the sensors to reset     */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Use after a deliberate change, e.g. a new VCore setting, so the   */
+/*!\note    new level is learned rather than reported as drift                */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR STAT_Reset( uint32_t SensorMask )
+{
+   uint32_t   Sensor;
+
+   AcquireSRWLockExclusive( &StatLock );
+
+   STAT_Init();
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      if ( SensorMask & EC_SENSOR_MASK( Sensor ) )
+      {
+         STAT_ResetState( &StatState[ Sensor ] );
+      }
+   }
+
+   ReleaseSRWLockExclusive( &StatLock );
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_SetDelivery                                                */
+/*                                                                            */
+/*!\brief  Chooses where anomalies are delivered                             */
+/*                                                                            */
+/*!\param   uint32_t        STAT_DELIVER_xxx flags                            */
+/*!\param   STAT_CALLBACK   callback for STAT_DELIVER_CALLBACK, may be NULL   */
+/*!\param   PVOID           passed to the callback                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR STAT_SetDelivery( uint32_t Flags, STAT_CALLBACK Callback, PVOID pContext )
+{
+   if ( ( Flags & STAT_DELIVER_CALLBACK ) && ( Callback == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockExclusive( &StatLock );
+
+   StatDeliver = Flags;
+   StatCallback = Callback;
+   StatContext = pContext;
+
+   ReleaseSRWLockExclusive( &StatLock );
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: STAT_Get                                                        */
+/*                                                                            */
+/*!\brief  Returns the statistics of a sensor                                */
+/*                                                                            */
+/*!\param   uint32_t              EC_SENSOR_ENUM_TYPE                         */
+/*!\param   P_STAT_SENSOR_STRUCT  pointer to structure to return them in      */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR STAT_Get( uint32_t Sensor, P_STAT_SENSOR_STRUCT pStats )
+{
+   P_STAT_STATE_STRUCT   pState;
+
+   if ( pStats == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( Sensor >= SENSOR_COUNT )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockShared( &StatLock );
+
+   pState = &StatState[ Sensor ];
+
+   memset( pStats, 0, sizeof( *pStats ) );
+   pStats->Samples = pState->Samples;
+   pStats->Mean = pState->Mean;
+   pStats->StdDev = ( pState->Samples > 1 ) ? sqrt( pState->M2 / ( double )( pState->Samples - 1 ) ) : 0.0;
+   pStats->BaselineMean = pState->BaselineMean;
+   pStats->BaselineStdDev = pState->BaselineStdDev;
+   pStats->Ewma = pState->Ewma;
+   pStats->Last = pState->Last;
+   pStats->Min = pState->Min;
+   pStats->Max = pState->Max;
+   pStats->Active = pState->Active;
+   pStats->Anomalies = pState->Anomalies;
+
+   if ( pState->Samples )
+   {
+      pStats->WindowMin = pState->WindowMin.Raw[ pState->WindowMin.Head & STAT_WINDOW_MASK ];
+      pStats->WindowMax = pState->WindowMax.Raw[ pState->WindowMax.Head & STAT_WINDOW_MASK ];
+   }
+
+   ReleaseSRWLockShared( &StatLock );
+
+   return STATUS_SUCCESS;
+}
+
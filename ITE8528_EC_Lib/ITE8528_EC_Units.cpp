@@ -0,0 +1,396 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_Units.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the integer unit conversions - single millivolt
+//      and millidegree readings, and the scalar, SSE2 and AVX2 batch kernels.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <intrin.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Units.h>
+#include "ITE8528_EC_Internal.h"
+#include "ITE8528_EC_RegMap.h"
+
+
+typedef void ( *UNIT_KERNEL )( const uint16_t *pRaw, puint32_t pMilli, uint32_t Count, uint32_t Scale );
+
+static volatile LONG         UnitKernel = UNIT_KERNEL_AUTO;           // resolved on first use
+static LONG                  UnitBest = UNIT_KERNEL_AUTO;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: UNIT_Scalar                                                     */
+/*                                                                            */
+/*!\brief  Converts raw readings one at a time                               */
+/*                                                                            */
+/*!\param   const uint16_t *    raw readings                                  */
+/*!\param   puint32_t           returns the converted readings                */
+/*!\param   uint32_t            number of readings                            */
+/*!\param   uint32_t            Q16 scale                                     */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Also finishes the readings left over by the vector kernels       */
+/*                                                                            */
+/******************************************************************************/
+static void UNIT_Scalar( const uint16_t *pRaw, puint32_t pMilli, uint32_t Count, uint32_t Scale )
+{
+   uint32_t   Index;
+
+   for ( Index = 0; Index < Count; Index++ )
+   {
+      pMilli[ Index ] = ( uint32_t )( ( ( uint64_t ) pRaw[ Index ] * Scale + 0x8000 ) >> 16 );
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: UNIT_Sse2                                                       */
+/*                                                                            */
+/*!\brief  Converts raw readings 8 at a time                                 */
+/*                                                                            */
+/*!\param   const uint16_t *    raw readings                                  */
+/*!\param   puint32_t           returns the converted readings                */
+/*!\param   uint32_t            number of readings                            */
+/*!\param   uint32_t            Q16 scale                                     */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    raw x scale is split into raw x whole part + raw x fraction, each */
+/*!\note    a 16 x 16 bit multiply whose high and low halves are interleaved */
+/*!\note    into 32 bit products                                             */
+/*                                                                            */
+/******************************************************************************/
+static void UNIT_Sse2( const uint16_t *pRaw, puint32_t pMilli, uint32_t Count, uint32_t Scale )
+{
+   const __m128i   Whole = _mm_set1_epi16( ( short )( Scale >> 16 ) );
+   const __m128i   Fraction = _mm_set1_epi16( ( short )( Scale & 0xffff ) );
+   const __m128i   Half = _mm_set1_epi32( 0x8000 );
+   uint32_t        Index;
+
+   for ( Index = 0; Index + 8 <= Count; Index += 8 )
+   {
+      __m128i   Raw = _mm_loadu_si128( ( const __m128i * ) &pRaw[ Index ] );
+      __m128i   FracLo = _mm_mullo_epi16( Raw, Fraction );
+      __m128i   FracHi = _mm_mulhi_epu16( Raw, Fraction );
+      __m128i   WholeLo = _mm_mullo_epi16( Raw, Whole );
+      __m128i   WholeHi = _mm_mulhi_epu16( Raw, Whole );
+      __m128i   Out0,
+                Out1;
+
+      Out0 = _mm_srli_epi32( _mm_add_epi32( _mm_unpacklo_epi16( FracLo, FracHi ), Half ), 16 );
+      Out1 = _mm_srli_epi32( _mm_add_epi32( _mm_unpackhi_epi16( FracLo, FracHi ), Half ), 16 );
+      Out0 = _mm_add_epi32( Out0, _mm_unpacklo_epi16( WholeLo, WholeHi ) );
+      Out1 = _mm_add_epi32( Out1, _mm_unpackhi_epi16( WholeLo, WholeHi ) );
+
+      _mm_storeu_si128( ( __m128i * ) &pMilli[ Index ], Out0 );
+      _mm_storeu_si128( ( __m128i * ) &pMilli[ Index + 4 ], Out1 );
+   }
+
+   UNIT_Scalar( &pRaw[ Index ], &pMilli[ Index ], Count - Index, Scale );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: UNIT_Avx2                                                       */
+/*                                                                            */
+/*!\brief  Converts raw readings 16 at a time                                */
+/*                                                                            */
+/*!\param   const uint16_t *    raw readings                                  */
+/*!\param   puint32_t           returns the converted readings                */
+/*!\param   uint32_t            number of readings                            */
+/*!\param   uint32_t            Q16 scale                                     */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    As UNIT_Sse2(). The unpacks work within each 128 bit lane, so    */
+/*!\note    the lanes are put back in order before storing.                  */
+/*                                                                            */
+/******************************************************************************/
+static void UNIT_Avx2( const uint16_t *pRaw, puint32_t pMilli, uint32_t Count, uint32_t Scale )
+{
+   const __m256i   Whole = _mm256_set1_epi16( ( short )( Scale >> 16 ) );
+   const __m256i   Fraction = _mm256_set1_epi16( ( short )( Scale & 0xffff ) );
+   const __m256i   Half = _mm256_set1_epi32( 0x8000 );
+   uint32_t        Index;
+
+   for ( Index = 0; Index + 16 <= Count; Index += 16 )
+   {
+      __m256i   Raw = _mm256_loadu_si256( ( const __m256i * ) &pRaw[ Index ] );
+      __m256i   FracLo = _mm256_mullo_epi16( Raw, Fraction );
+      __m256i   FracHi = _mm256_mulhi_epu16( Raw, Fraction );
+      __m256i   WholeLo = _mm256_mullo_epi16( Raw, Whole );
+      __m256i   WholeHi = _mm256_mulhi_epu16( Raw, Whole );
+      __m256i   Lo,                                   // readings 0-3 and 8-11
+                Hi;                                   // readings 4-7 and 12-15
+
+      Lo = _mm256_srli_epi32( _mm256_add_epi32( _mm256_unpacklo_epi16( FracLo, FracHi ), Half ), 16 );
+      Hi = _mm256_srli_epi32( _mm256_add_epi32( _mm256_unpackhi_epi16( FracLo, FracHi ), Half ), 16 );
+      Lo = _mm256_add_epi32( Lo, _mm256_unpacklo_epi16( WholeLo, WholeHi ) );
+      Hi = _mm256_add_epi32( Hi, _mm256_unpackhi_epi16( WholeLo, WholeHi ) );
+
+      _mm256_storeu_si256( ( __m256i * ) &pMilli[ Index ], _mm256_permute2x128_si256( Lo, Hi, 0x20 ) );
+      _mm256_storeu_si256( ( __m256i * ) &pMilli[ Index + 8 ], _mm256_permute2x128_si256( Lo, Hi, 0x31 ) );
+   }
+
+   UNIT_Scalar( &pRaw[ Index ], &pMilli[ Index ], Count - Index, Scale );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: UNIT_BestKernel                                                 */
+/*                                                                            */
+/*!\brief  Returns the fastest kernel this CPU and OS support                */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  LONG            UNIT_KERNEL_ENUM_TYPE                             */
+/*                                                                            */
+/*!\note    AVX2 needs the CPU flag and the OS saving the YMM registers      */
+/*                                                                            */
+/******************************************************************************/
+static LONG UNIT_BestKernel( void )
+{
+   int   Info[ 4 ];
+
+   if ( UnitBest != UNIT_KERNEL_AUTO )
+   {
+      return UnitBest;
+   }
+
+   __cpuid( Info, 0 );
+
+   if ( Info[ 0 ] >= 7 )
+       {
+          BOOL   OsYmm;
+
+          __cpuid( Info, 1 );
+          OsYmm = ( ( Info[ 2 ] & ( 1 << 27 ) ) != 0 ) && ( ( _xgetbv( 0 ) & 6 ) == 6 );     // OSXSAVE, XMM and YMM state
+
+          __cpuidex( Info, 7, 0 );
+          UnitBest = ( OsYmm && ( Info[ 1 ] & ( 1 << 5 ) ) ) ? UNIT_KERNEL_AVX2 : UNIT_KERNEL_SSE2;
+       }
+   else
+       {
+          UnitBest = UNIT_KERNEL_SSE2;                 // always there on x64
+       }
+
+   return UnitBest;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: UNIT_ToMilli                                                    */
+/*                                                                            */
+/*!\brief  Converts an array of one sensor's raw readings                    */
+/*                                                                            */
+/*!\param   uint32_t            EC_SENSOR_ENUM_TYPE                           */
+/*!\param   const uint16_t *    raw readings                                  */
+/*!\param   puint32_t           returns millivolts or millidegrees            */
+/*!\param   uint32_t            number of readings                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    pRaw and pMilli need no particular alignment                     */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR UNIT_ToMilli( uint32_t Sensor, const uint16_t *pRaw, puint32_t pMilli, uint32_t Count )
+{
+   LONG   Kernel = UnitKernel;
+
+   if ( ( pRaw == NULL ) || ( pMilli == NULL ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( Sensor >= SENSOR_COUNT )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   if ( Kernel == UNIT_KERNEL_AUTO )
+   {
+      Kernel = UNIT_BestKernel();
+      InterlockedCompareExchange( &UnitKernel, Kernel, UNIT_KERNEL_AUTO );
+   }
+
+   switch ( Kernel )
+   {
+      case UNIT_KERNEL_AVX2:
+         UNIT_Avx2( pRaw, pMilli, Count, ite8528::EcSensorMap::Descs[ Sensor ].ScaleQ16 );
+         break;
+
+      case UNIT_KERNEL_SSE2:
+         UNIT_Sse2( pRaw, pMilli, Count, ite8528::EcSensorMap::Descs[ Sensor ].ScaleQ16 );
+         break;
+
+      default:
+         UNIT_Scalar( pRaw, pMilli, Count, ite8528::EcSensorMap::Descs[ Sensor ].ScaleQ16 );
+         break;
+   }
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: UNIT_SetKernel                                                  */
+/*                                                                            */
+/*!\brief  Chooses the batch conversion kernel                               */
+/*                                                                            */
+/*!\param   uint32_t        UNIT_KERNEL_ENUM_TYPE                             */
+/*!\return  WINSYS_ERROR    STATUS_BAD_PARAMETER if the CPU cannot run it     */
+/*                                                                            */
+/*!\note    For benchmarks - UNIT_KERNEL_AUTO is always the fastest          */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR UNIT_SetKernel( uint32_t Kernel )
+{
+   if ( ( Kernel > UNIT_KERNEL_AVX2 ) || ( ( Kernel == UNIT_KERNEL_AVX2 ) && ( UNIT_BestKernel() != UNIT_KERNEL_AVX2 ) ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   InterlockedExchange( &UnitKernel, ( Kernel == UNIT_KERNEL_AUTO ) ? UNIT_BestKernel() : ( LONG ) Kernel );
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: UNIT_GetKernel                                                  */
+/*                                                                            */
+/*!\brief  Returns the batch conversion kernel in use                        */
+/*                                                                            */
+/*!\param   puint32_t       returns the UNIT_KERNEL_ENUM_TYPE                 */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR UNIT_GetKernel( puint32_t pKernel )
+{
+   if ( pKernel == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   *pKernel = ( UnitKernel == UNIT_KERNEL_AUTO ) ? ( uint32_t ) UNIT_BestKernel() : ( uint32_t ) UnitKernel;
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: UNIT_Read                                                       */
+/*                                                                            */
+/*!\brief  Reads one sensor and converts it                                  */
+/*                                                                            */
+/*!\param   uint32_t        EC_SENSOR_ENUM_TYPE                               */
+/*!\param   puint32_t       returns millivolts or millidegrees                */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Both bytes of a rail are read in one burst, so the reading       */
+/*!\note    cannot tear                                                       */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR UNIT_Read( uint32_t Sensor, puint32_t pMilli )
+{
+   WINSYS_ERROR       Results;
+   EC_SAMPLE_STRUCT   Sample;
+
+   Results = SMP_QuerySensors( EC_SENSOR_MASK( Sensor ), &Sample );
+
+   if ( Results == STATUS_SUCCESS )
+   {
+      UNIT_Scalar( &Sample.Raw[ Sensor ], pMilli, 1, ite8528::EcSensorMap::Descs[ Sensor ].ScaleQ16 );
+   }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: PWR_GetMilliVolts                                               */
+/*                                                                            */
+/*!\brief  Reads a power rail in integer millivolts                          */
+/*                                                                            */
+/*!\param   uint32_t        SENSOR_VCORE, _V3P3, _V5, _V12 or _VDIMM         */
+/*!\param   puint32_t       returns the millivolts                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Within 1 mV of the PWR_GetXxx() double readings, rounded         */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR PWR_GetMilliVolts( uint32_t Rail, puint32_t pMilliVolts )
+{
+   if ( pMilliVolts == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( ( Rail < SENSOR_VCORE ) || ( Rail > SENSOR_VDIMM ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   return UNIT_Read( Rail, pMilliVolts );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: TEMP_GetMilliDegrees                                            */
+/*                                                                            */
+/*!\brief  Reads a temperature in integer millidegrees C                     */
+/*                                                                            */
+/*!\param   uint32_t        SENSOR_CPU_TEMP or SENSOR_SYS_TEMP                */
+/*!\param   puint32_t       returns the millidegrees                          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    The EC reports whole degrees                                     */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR TEMP_GetMilliDegrees( uint32_t Sensor, puint32_t pMilliDegrees )
+{
+   if ( pMilliDegrees == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( Sensor > SENSOR_SYS_TEMP )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   return UNIT_Read( Sensor, pMilliDegrees );
+}
+
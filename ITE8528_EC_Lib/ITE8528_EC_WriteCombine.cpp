@@ -0,0 +1,549 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ITE8528_EC_WriteCombine.cpp
+//
+//    Project    : ACPI Embedded Controller Routines
+//
+//    Author     : agent
+//
+//    Description:
+//      This module contains the write combining buffer - EC SRAM writes held
+//      for a short window, coalesced per register and flushed as block
+//      writes of adjacent registers, with bypass registers written at once.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_WriteCombine.h>
+
+
+#define WCB_SRAM_SIZE               256
+#define WCB_MAP_WORDS               ( WCB_SRAM_SIZE / 32 )
+#define WCB_MAX_BLOCK               255                               // Count is a uint8_t
+
+#define WCB_BIT( Map, Offset )      ( ( Map )[ ( Offset ) >> 5 ] & ( 1u << ( ( Offset ) & 31 ) ) )
+#define WCB_SET( Map, Offset )      ( ( Map )[ ( Offset ) >> 5 ] |= ( 1u << ( ( Offset ) & 31 ) ) )
+#define WCB_CLEAR( Map, Offset )    ( ( Map )[ ( Offset ) >> 5 ] &= ~( 1u << ( ( Offset ) & 31 ) ) )
+
+static SRWLOCK               WcbLock = SRWLOCK_INIT;                  // guards everything below, and is held
+                                                                      // across the EC writes of a flush
+static uint8_t               WcbValue[ WCB_SRAM_SIZE ];
+static uint32_t              WcbDirty[ WCB_MAP_WORDS ];
+static uint32_t              WcbBypass[ WCB_MAP_WORDS ];
+static BOOL                  WcbReady = FALSE;
+static uint32_t              WcbWindowMs = 0;
+static WCB_STATS_STRUCT      WcbStats;
+
+static HANDLE                WcbThread = NULL;
+static HANDLE                WcbStopEvent = NULL;
+static HANDLE                WcbDirtyEvent = NULL;                    // set when the buffer goes from clean to dirty
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_Init                                                        */
+/*                                                                            */
+/*!\brief  Sets the default bypass registers on first use                    */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/*!\note    Called with WcbLock held exclusively                             */
+/*                                                                            */
+/******************************************************************************/
+static void WCB_Init( void )
+{
+   if ( ! WcbReady )
+   {
+      WCB_SET( WcbBypass, WDT_CONFIG_OFFSET );
+      WcbReady = TRUE;
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_FlushLocked                                                 */
+/*                                                                            */
+/*!\brief  Writes every run of adjacent dirty registers as one block         */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    the first failure, or success                    */
+/*                                                                            */
+/*!\note    Called with WcbLock held exclusively. Runs are written in offset */
+/*!\note    order; a run that fails stays dirty, the rest are still tried,   */
+/*!\note    and another window is opened for it.                              */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR WCB_FlushLocked( void )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS,
+                  Status;
+   uint32_t       Offset = 0,
+                  Start,
+                  Index;
+
+   if ( WcbStats.Dirty == 0 )
+   {
+      return STATUS_SUCCESS;
+   }
+
+   WcbStats.Flushes++;
+
+   while ( Offset < WCB_SRAM_SIZE )
+   {
+      if ( WcbDirty[ Offset >> 5 ] == 0 )
+      {
+         Offset = ( Offset | 31 ) + 1;                // nothing dirty in this word
+         continue;
+      }
+
+      if ( ! WCB_BIT( WcbDirty, Offset ) )
+      {
+         Offset++;
+         continue;
+      }
+
+      Start = Offset;
+
+      while ( ( Offset < WCB_SRAM_SIZE ) && ( Offset - Start < WCB_MAX_BLOCK ) && ( WCB_BIT( WcbDirty, Offset ) ) )
+      {
+         Offset++;
+      }
+
+      WcbStats.Blocks++;
+
+      if ( ( Status = EC_WriteBlockUsingACPI( ( uint8_t ) Start, ( uint8_t )( Offset - Start ), &WcbValue[ Start ] ) ) == STATUS_SUCCESS )
+          {
+             for ( Index = Start; Index < Offset; Index++ )
+             {
+                WCB_CLEAR( WcbDirty, Index );
+             }
+
+             WcbStats.Bytes += Offset - Start;
+             WcbStats.Dirty -= Offset - Start;
+          }
+      else
+          {
+             WcbStats.Errors++;
+             Results = ( Results == STATUS_SUCCESS ) ? Status : Results;
+          }
+   }
+
+   if ( ( WcbStats.Dirty ) && ( WcbDirtyEvent ) )
+   {
+      SetEvent( WcbDirtyEvent );                         // try the failures again after another window
+   }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_Put                                                         */
+/*                                                                            */
+/*!\brief  Writes one register through the buffer                            */
+/*                                                                            */
+/*!\param   uint8_t         offset into EC RAM                                */
+/*!\param   uint8_t         the value                                         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Called with WcbLock held exclusively. A bypass register, or any  */
+/*!\note    register while combining is off, is written now - after the      */
+/*!\note    flush, and not at all if the flush fails.                         */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR WCB_Put( uint8_t Offset, uint8_t Value )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   WcbStats.Writes++;
+
+   if ( ( WcbWindowMs == 0 ) || ( WCB_BIT( WcbBypass, Offset ) ) )
+       {
+          WcbStats.Bypassed++;
+
+          if ( ( Results = WCB_FlushLocked() ) == STATUS_SUCCESS )
+          {
+             Results = EC_WriteByteUsingACPI( Offset, Value );
+          }
+       }
+   else if ( WCB_BIT( WcbDirty, Offset ) )
+       {
+          WcbValue[ Offset ] = Value;
+          WcbStats.Combined++;
+       }
+   else
+       {
+          WcbValue[ Offset ] = Value;
+          WCB_SET( WcbDirty, Offset );
+
+          if ( ( WcbStats.Dirty++ == 0 ) && ( WcbDirtyEvent ) )
+          {
+             SetEvent( WcbDirtyEvent );                  // opens the window
+          }
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_Thread                                                      */
+/*                                                                            */
+/*!\brief  Flushes the buffer WindowMs after it first goes dirty             */
+/*                                                                            */
+/*!\param   LPVOID          not used                                          */
+/*!\return  DWORD           0                                                 */
+/*                                                                            */
+/*!\note    The dirty event is set by the write that opens the window, so    */
+/*!\note    the wait after it is the window itself                            */
+/*                                                                            */
+/******************************************************************************/
+static DWORD WINAPI WCB_Thread( LPVOID pParam )
+{
+   HANDLE     Handles[ 2 ] = { WcbStopEvent, WcbDirtyEvent };
+   uint32_t   WindowMs;
+
+   UNREFERENCED_PARAMETER( pParam );
+
+   while ( WaitForMultipleObjects( 2, Handles, FALSE, INFINITE ) == WAIT_OBJECT_0 + 1 )
+   {
+      AcquireSRWLockShared( &WcbLock );
+      WindowMs = WcbWindowMs;
+      ReleaseSRWLockShared( &WcbLock );
+
+      if ( WaitForSingleObject( WcbStopEvent, WindowMs ) != WAIT_TIMEOUT )
+      {
+         break;
+      }
+
+      WCB_Flush();
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_Configure                                                   */
+/*                                                                            */
+/*!\brief  Sets the combining window, starting or stopping the flush thread  */
+/*                                                                            */
+/*!\param   uint32_t        window in msecs, up to WCB_MAX_WINDOW_MS, 0 to    */
+/*!\param                   turn combining off                                */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Turning combining off flushes the buffer, and returns the result */
+/*!\note    of the flush                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR WCB_Configure( uint32_t WindowMs )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( WindowMs > WCB_MAX_WINDOW_MS )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   if ( WindowMs == 0 )
+       {
+          if ( WcbThread != NULL )
+          {
+             SetEvent( WcbStopEvent );
+             WaitForSingleObject( WcbThread, INFINITE );
+
+             CloseHandle( WcbThread );
+             CloseHandle( WcbStopEvent );
+             CloseHandle( WcbDirtyEvent );
+             WcbThread = NULL;
+             WcbStopEvent = NULL;
+             WcbDirtyEvent = NULL;
+          }
+
+          AcquireSRWLockExclusive( &WcbLock );
+          WcbWindowMs = 0;
+          Results = WCB_FlushLocked();
+          ReleaseSRWLockExclusive( &WcbLock );
+       }
+   else if ( WcbThread == NULL )
+       {
+          if ( ( ( WcbStopEvent = CreateEvent( NULL, TRUE, FALSE, NULL ) ) != NULL ) &&
+               ( ( WcbDirtyEvent = CreateEvent( NULL, FALSE, FALSE, NULL ) ) != NULL ) )
+          {
+             AcquireSRWLockExclusive( &WcbLock );
+             WCB_Init();
+             WcbWindowMs = WindowMs;
+             ReleaseSRWLockExclusive( &WcbLock );
+
+             if ( ( WcbThread = CreateThread( NULL, 0, WCB_Thread, NULL, 0, NULL ) ) == NULL )
+             {
+                AcquireSRWLockExclusive( &WcbLock );
+                WcbWindowMs = 0;
+                ReleaseSRWLockExclusive( &WcbLock );
+             }
+          }
+
+          if ( WcbThread == NULL )
+          {
+             if ( WcbStopEvent )
+             {
+                CloseHandle( WcbStopEvent );
+                WcbStopEvent = NULL;
+             }
+
+             if ( WcbDirtyEvent )
+             {
+                CloseHandle( WcbDirtyEvent );
+                WcbDirtyEvent = NULL;
+             }
+
+             Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+          }
+       }
+   else
+       {
+          AcquireSRWLockExclusive( &WcbLock );
+          WcbWindowMs = WindowMs;                        // from the next window
+          ReleaseSRWLockExclusive( &WcbLock );
+       }
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_SetBypass                                                   */
+/*                                                                            */
+/*!\brief  Sets whether writes to a register skip the buffer                 */
+/*                                                                            */
+/*!\param   uint8_t         offset into EC RAM                                */
+/*!\param   uint32_t        1 = written at once, 0 = combined                 */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    Making a register bypass flushes the buffer, so a value waiting  */
+/*!\note    for it cannot land after a later direct write                    */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR WCB_SetBypass( uint8_t Offset, uint32_t Bypass )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   AcquireSRWLockExclusive( &WcbLock );
+
+   WCB_Init();
+
+   if ( Bypass )
+       {
+          if ( WCB_BIT( WcbDirty, Offset ) )
+          {
+             Results = WCB_FlushLocked();
+          }
+
+          WCB_SET( WcbBypass, Offset );
+       }
+   else
+       {
+          WCB_CLEAR( WcbBypass, Offset );
+       }
+
+   ReleaseSRWLockExclusive( &WcbLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_Write                                                       */
+/*                                                                            */
+/*!\brief  Writes a byte to the EC's SRAM through the buffer                 */
+/*                                                                            */
+/*!\param   uint8_t         offset into EC RAM                                */
+/*!\param   uint8_t         the value                                         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    A buffered write always succeeds; its errors surface from the    */
+/*!\note    flush that writes it                                              */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR WCB_Write( uint8_t Offset, uint8_t Value )
+{
+   WINSYS_ERROR   Results;
+
+   AcquireSRWLockExclusive( &WcbLock );
+   WCB_Init();
+   Results = WCB_Put( Offset, Value );
+   ReleaseSRWLockExclusive( &WcbLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_WriteBlock                                                  */
+/*                                                                            */
+/*!\brief  Writes consecutive bytes to the EC's SRAM through the buffer      */
+/*                                                                            */
+/*!\param   uint8_t         offset into EC RAM of the first byte              */
+/*!\param   uint8_t         number of bytes                                   */
+/*!\param   puint8_t        the bytes                                         */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    With combining off the block is written in one burst. Otherwise  */
+/*!\note    each byte is buffered, and a bypass register in the block is     */
+/*!\note    written at once after the bytes before it have been flushed.     */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR WCB_WriteBlock( uint8_t Offset, uint8_t Count, puint8_t pData )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   uint32_t       Index;
+
+   if ( pData == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   if ( ( Count == 0 ) || ( ( uint32_t ) Offset + Count > WCB_SRAM_SIZE ) )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   AcquireSRWLockExclusive( &WcbLock );
+
+   WCB_Init();
+
+   if ( WcbWindowMs == 0 )
+       {
+          WcbStats.Writes += Count;
+          WcbStats.Bypassed += Count;
+
+          if ( ( Results = WCB_FlushLocked() ) == STATUS_SUCCESS )
+          {
+             Results = EC_WriteBlockUsingACPI( Offset, Count, pData );
+          }
+       }
+   else
+       {
+          for ( Index = 0; ( Index < Count ) && ( Results == STATUS_SUCCESS ); Index++ )
+          {
+             Results = WCB_Put( ( uint8_t )( Offset + Index ), pData[ Index ] );
+          }
+       }
+
+   ReleaseSRWLockExclusive( &WcbLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_Read                                                        */
+/*                                                                            */
+/*!\brief  Reads a byte, from the buffer if it is waiting there              */
+/*                                                                            */
+/*!\param   uint8_t         offset into EC RAM                                */
+/*!\param   puint8_t        where to store the value                          */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR WCB_Read( uint8_t Offset, puint8_t pValue )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+
+   if ( pValue == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockShared( &WcbLock );
+
+   if ( WCB_BIT( WcbDirty, Offset ) )
+       {
+          *pValue = WcbValue[ Offset ];
+       }
+   else
+       {
+          Results = EC_ReadByteUsingACPI( Offset, pValue );   // under the lock, so a flush cannot pass it
+       }
+
+   ReleaseSRWLockShared( &WcbLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_Flush                                                       */
+/*                                                                            */
+/*!\brief  Writes everything waiting in the buffer to the EC now             */
+/*                                                                            */
+/*!\param   <void>                                                            */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note    On success every write made before the call is in the EC         */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR WCB_Flush( void )
+{
+   WINSYS_ERROR   Results;
+
+   AcquireSRWLockExclusive( &WcbLock );
+   Results = WCB_FlushLocked();
+   ReleaseSRWLockExclusive( &WcbLock );
+
+   return Results;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: WCB_GetStats                                                    */
+/*                                                                            */
+/*!\brief  Returns the buffer's counters                                     */
+/*                                                                            */
+/*!\param   P_WCB_STATS_STRUCT  where to store the counters                   */
+/*!\return  WINSYS_ERROR    value indicating success or failure               */
+/*                                                                            */
+/*!\note                                                                      */
+/*                                                                            */
+/******************************************************************************/
+WINSYS_ERROR WCB_GetStats( P_WCB_STATS_STRUCT pStats )
+{
+   if ( pStats == NULL )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+   }
+
+   AcquireSRWLockShared( &WcbLock );
+   *pStats = WcbStats;
+   ReleaseSRWLockShared( &WcbLock );
+
+   return STATUS_SUCCESS;
+}
@@ -0,0 +1,144 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Alarms.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Threshold, hysteresis, debounce and rate of change alarms
+//!            evaluated on every sample
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_ALARMS_INC
+#define __ITE8528_EC_ALARMS_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Alarm rules are compiled into a flat table of integer comparisons in raw sensor units, which the sampler
+// thread runs over every sample it publishes. A rule is raised once its condition has held for Debounce
+// consecutive samples, and cleared once the value has come back past the threshold by Hysteresis for as
+// many samples. Rate rules compare the change since the sensor's previous reading, in raw units per second.
+//
+// Raised and cleared alarms go to the callback set with ALRM_SetDelivery() - on the sampler thread, so keep it
+// short - and/or to the event queue as EVT_CLASS_ALARM events, whose Id is the rule and Param 1 raised, 0
+// cleared. ALRM_Evaluate() may also be called directly with samples from elsewhere.
+//
+// Include after ITE8528_EC_Sampler.h.
+//
+
+/*!\enum _ALRM_KIND_ENUM_TYPE
+ * \brief  What a rule compares
+ */
+typedef enum _ALRM_KIND_ENUM_TYPE {
+                                     ALRM_ABOVE = 0,                  /*!<  reading above Threshold                     */
+                                     ALRM_BELOW = 1,                  /*!<  reading below Threshold                     */
+                                     ALRM_RISING = 2,                 /*!<  rising faster than Threshold per second     */
+                                     ALRM_FALLING = 3,                /*!<  falling faster than Threshold per second    */
+                                     ALRM_KIND_COUNT = 4,
+
+                                  } ALRM_KIND_ENUM_TYPE, *P_ALRM_KIND_ENUM_TYPE;
+
+/*!\struct _ALRM_RULE_STRUCT
+ * \brief  A rule as given to ALRM_AddRule(). Values are raw sensor units - see EC_SENSOR_ENUM_TYPE.
+ */
+typedef struct _ALRM_RULE_STRUCT {
+                                    uint8_t      Sensor;              /*!< EC_SENSOR_ENUM_TYPE                         */
+                                    uint8_t      Kind;                /*!< ALRM_KIND_ENUM_TYPE                         */
+                                    uint16_t     Debounce;            /*!< consecutive samples to raise or clear, 0 = 1 */
+                                    uint32_t     Threshold;           /*!< raw value, or raw units per second          */
+                                    uint32_t     Hysteresis;          /*!< how far back past Threshold clears the alarm */
+
+                                 } ALRM_RULE_STRUCT, *P_ALRM_RULE_STRUCT;
+
+/*!\struct _ALRM_EVENT_STRUCT
+ * \brief  An alarm as delivered to the callback
+ */
+typedef struct _ALRM_EVENT_STRUCT {
+                                     uint32_t     Rule;               /*!< id from ALRM_AddRule()                      */
+                                     uint8_t      Sensor;             /*!< EC_SENSOR_ENUM_TYPE                         */
+                                     uint8_t      Raised;             /*!< 1 raised, 0 cleared                         */
+                                     uint16_t     Raw;                /*!< the reading that raised or cleared it       */
+                                     int32_t      Value;              /*!< the value compared - reading or rate        */
+                                     uint64_t     TimestampMs;        /*!< time of the sample                          */
+
+                                  } ALRM_EVENT_STRUCT, *P_ALRM_EVENT_STRUCT;
+
+/*!\struct _ALRM_STATS_STRUCT
+ * \brief  Counters kept by the alarm engine
+ */
+typedef struct _ALRM_STATS_STRUCT {
+                                     uint32_t     Rules;              /*!< rules in the table                          */
+                                     uint32_t     Evaluations;        /*!< samples evaluated                           */
+                                     uint32_t     Raised;             /*!< alarms raised                               */
+                                     uint32_t     Cleared;            /*!< alarms cleared                              */
+                                     uint32_t     LastEvalNs;         /*!< time to run the table over the last sample  */
+                                     uint32_t     MaxEvalNs;          /*!< longest such time                           */
+
+                                  } ALRM_STATS_STRUCT, *P_ALRM_STATS_STRUCT;
+
+typedef void ( *ALRM_CALLBACK )( P_ALRM_EVENT_STRUCT pAlarm, PVOID pContext );
+
+#define ALRM_MAX_RULES                      1024
+#define ALRM_DELIVER_CALLBACK               0x01    /*!< call the ALRM_SetDelivery() callback             */
+#define ALRM_DELIVER_EVENT_QUEUE            0x02    /*!< post EVT_CLASS_ALARM events                      */
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ALRM_AddRule( P_ALRM_RULE_STRUCT pRule, puint32_t pRuleId );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ALRM_RemoveRule( uint32_t RuleId );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ALRM_SetDelivery( uint32_t Flags, ALRM_CALLBACK Callback, PVOID pContext );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ALRM_Evaluate( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ALRM_IsActive( uint32_t RuleId, puint32_t pActive );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ALRM_GetStats( P_ALRM_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ALRM_AddRule( P_ALRM_RULE_STRUCT pRule, puint32_t pRuleId );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ALRM_RemoveRule( uint32_t RuleId );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ALRM_SetDelivery( uint32_t Flags, ALRM_CALLBACK Callback, PVOID pContext );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ALRM_Evaluate( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ALRM_IsActive( uint32_t RuleId, puint32_t pActive );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ALRM_GetStats( P_ALRM_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     ALRM_AddRule( P_ALRM_RULE_STRUCT pRule, puint32_t pRuleId );
+__declspec( dllimport )    WINSYS_ERROR     ALRM_RemoveRule( uint32_t RuleId );
+__declspec( dllimport )    WINSYS_ERROR     ALRM_SetDelivery( uint32_t Flags, ALRM_CALLBACK Callback, PVOID pContext );
+__declspec( dllimport )    WINSYS_ERROR     ALRM_Evaluate( P_EC_SAMPLE_STRUCT pSample );
+__declspec( dllimport )    WINSYS_ERROR     ALRM_IsActive( uint32_t RuleId, puint32_t pActive );
+__declspec( dllimport )    WINSYS_ERROR     ALRM_GetStats( P_ALRM_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_ALARMS_INC
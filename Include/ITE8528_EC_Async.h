@@ -0,0 +1,216 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Async.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      The definitions used to submit EC requests asynchronously and
+//!            reap their completions later
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_ASYNC_INC
+#define __ITE8528_EC_ASYNC_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Asynchronous EC access. Requests are submitted with a caller chosen tag and return at once. A single I/O
+// worker thread owns the EC ports and schedules the queued requests by priority class - watchdog, then control,
+// then telemetry - and earliest deadline first within a class. It goes back to the queue after every
+// transaction, so a WDT pet waits for at most the one transaction already in progress. Telemetry reads are
+// merged into shared bursts around the most urgent read, and a burst is capped at ASYNC_TELEMETRY_MAX_BURST
+// bytes so that it can not hold the EC for long.
+//
+// Requests in a higher class overtake queued requests in a lower class, so a telemetry read may see the result
+// of a control write submitted after it. Within a class, requests without a timeout are served in submission
+// order; a timeout moves a request's deadline, and so its place in the class. Writes to the same offset are the
+// exception: they are always issued in submission order, so the register ends up holding the value submitted last.
+//
+// A request may carry a timeout, and may be cancelled by tag. Both only take effect before the request reaches
+// the EC - a transaction in progress is always finished - and the request still completes, with
+// STATUS_TIMEOUT or STATUS_CANCELLED, so that every submission gets exactly one completion.
+//
+// Request slots come from a fixed pool of ASYNC_QUEUE_DEPTH entries. A slot is returned to the pool when its
+// completion is reaped, so the completion queue can never overflow and steady state makes no allocations.
+//
+// The synchronous interfaces - EC_..., WDT_PetTimer(), WDT_ServicePetPolicy() and the sampler - do not go
+// through the queue. They take the driver lock for each transaction, as the worker does, so they interleave
+// with the worker one transaction at a time and a queued WDT pet still waits for at most the transaction in
+// progress. They are not routed through the worker because they must work without ASYNC_Start(), because the
+// worker itself pets with WDT_PetTimer(), and because a queue round trip per call would cost the sampler and
+// the pet policy more than the transaction. Every sensor lies in the first 0x34 bytes of the SRAM, so a
+// sampler burst is never longer than a merged telemetry burst.
+//
+
+/*!\enum _ASYNC_OP_ENUM_TYPE
+ * \brief  The operations that can be submitted
+ */
+typedef enum _ASYNC_OP_ENUM_TYPE {
+                                    ASYNC_OP_READ = 0,               /*!<  read one byte                             */
+                                    ASYNC_OP_WRITE = 1,              /*!<  write one byte                            */
+                                    ASYNC_OP_READ_BLOCK = 2,         /*!<  read up to ASYNC_MAX_BLOCK bytes          */
+                                    ASYNC_OP_PET_WDT = 3,            /*!<  reload the WDT minutes/seconds counters   */
+
+                                 } ASYNC_OP_ENUM_TYPE, *P_ASYNC_OP_ENUM_TYPE;
+
+/*!\enum _ASYNC_PRIO_ENUM_TYPE
+ * \brief  Scheduling classes, most urgent first
+ */
+typedef enum _ASYNC_PRIO_ENUM_TYPE {
+                                      ASYNC_PRIO_DEFAULT = 0,        /*!<  choose by operation - pets are watchdog,  */
+                                                                     /*!<  writes control and reads telemetry        */
+                                      ASYNC_PRIO_WATCHDOG = 1,       /*!<  WDT pets and configuration                */
+                                      ASYNC_PRIO_CONTROL = 2,        /*!<  writes that change the board's behaviour  */
+                                      ASYNC_PRIO_TELEMETRY = 3,      /*!<  sensor and status reads                   */
+                                      ASYNC_PRIO_COUNT = 4,          /*!<  classes are 1 .. ASYNC_PRIO_COUNT - 1     */
+
+                                   } ASYNC_PRIO_ENUM_TYPE, *P_ASYNC_PRIO_ENUM_TYPE;
+
+#define ASYNC_QUEUE_DEPTH                   128     /*!< request slots in the pool                      */
+#define ASYNC_MAX_BLOCK                     32      /*!< largest block read that can be submitted       */
+#define ASYNC_TELEMETRY_MAX_BURST           64      /*!< longest merged telemetry burst, in bytes       */
+
+//
+// deadline of a request submitted without a timeout, in usecs after submission - used to order the class and to
+// count deadline misses
+//
+
+#define ASYNC_WATCHDOG_BUDGET_US            1000
+#define ASYNC_CONTROL_BUDGET_US             10000
+#define ASYNC_TELEMETRY_BUDGET_US           100000
+
+/*!\struct _ASYNC_COMPLETION_STRUCT
+ * \brief  The result of a submitted request
+ */
+typedef struct _ASYNC_COMPLETION_STRUCT {
+                                           uint64_t       UserTag;                    /*!< tag given at submission     */
+                                           WINSYS_ERROR   Status;                     /*!< result of the request       */
+                                           uint8_t        Op;                         /*!< ASYNC_OP_ENUM_TYPE          */
+                                           uint8_t        Offset;                     /*!< EC offset of the request    */
+                                           uint8_t        Count;                      /*!< bytes returned in Data      */
+                                           uint8_t        Reserved;
+                                           uint8_t        Data[ ASYNC_MAX_BLOCK ];    /*!< bytes read                  */
+
+                                        } ASYNC_COMPLETION_STRUCT, *P_ASYNC_COMPLETION_STRUCT;
+
+/*!\struct _ASYNC_SUBMIT_STRUCT
+ * \brief  A full request description for ASYNC_SubmitEx()
+ */
+typedef struct _ASYNC_SUBMIT_STRUCT {
+                                       uint8_t        Op;             /*!< ASYNC_OP_ENUM_TYPE                          */
+                                       uint8_t        Offset;         /*!< EC offset, ignored for ASYNC_OP_PET_WDT     */
+                                       uint8_t        Count;          /*!< bytes for ASYNC_OP_READ_BLOCK               */
+                                       uint8_t        Value;          /*!< byte to write, or WDT minutes               */
+                                       uint8_t        Value2;         /*!< WDT seconds                                 */
+                                       uint8_t        Priority;       /*!< ASYNC_PRIO_ENUM_TYPE, 0 = ASYNC_PRIO_DEFAULT */
+                                                                      /*!< so a zeroed struct gets the operation's   */
+                                                                      /*!< class. Telemetry is reads only            */
+                                       uint32_t       TimeoutUs;      /*!< 0 = none, else fail with STATUS_TIMEOUT if  */
+                                                                      /*!< not started within this many usecs          */
+                                       uint64_t       UserTag;        /*!< returned in the completion                  */
+
+                                    } ASYNC_SUBMIT_STRUCT, *P_ASYNC_SUBMIT_STRUCT;
+
+/*!\struct _ASYNC_CLASS_STATS_STRUCT
+ * \brief  Queueing delay of one scheduling class - submission to the start of its EC transaction
+ */
+typedef struct _ASYNC_CLASS_STATS_STRUCT {
+                                            uint32_t     Started;           /*!< requests issued to the EC          */
+                                            uint32_t     DeadlineMisses;    /*!< started after their deadline       */
+                                            uint32_t     MaxDelayUs;        /*!< longest queueing delay             */
+                                            uint32_t     Reserved;
+                                            uint64_t     TotalDelayUs;      /*!< sum of delays, / Started = average */
+
+                                         } ASYNC_CLASS_STATS_STRUCT, *P_ASYNC_CLASS_STATS_STRUCT;
+
+/*!\struct _ASYNC_STATS_STRUCT
+ * \brief  Counters kept by the I/O worker
+ */
+typedef struct _ASYNC_STATS_STRUCT {
+                                      uint32_t     Submitted;         /*!< requests accepted                          */
+                                      uint32_t     Completed;         /*!< requests completed                         */
+                                      uint32_t     Batches;           /*!< scheduling passes of the I/O worker        */
+                                      uint32_t     Bursts;            /*!< EC transactions issued                     */
+                                      uint32_t     ReadsMerged;       /*!< reads served by another request's burst    */
+                                      uint32_t     Cancelled;         /*!< requests cancelled before they started     */
+                                      uint32_t     TimedOut;          /*!< requests whose deadline passed in the queue */
+                                      ASYNC_CLASS_STATS_STRUCT   Class[ ASYNC_PRIO_COUNT ];   /*!< by ASYNC_PRIO_ENUM_TYPE, */
+                                                                                              /*!< [ ASYNC_PRIO_DEFAULT ] unused */
+
+                                   } ASYNC_STATS_STRUCT, *P_ASYNC_STATS_STRUCT;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_Start( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_Stop( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_SubmitRead( uint8_t Offset, uint64_t UserTag );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_SubmitWrite( uint8_t Offset, uint8_t Value, uint64_t UserTag );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_SubmitReadBlock( uint8_t Offset, uint8_t Count, uint64_t UserTag );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_SubmitPet( uint8_t Mins, uint8_t Secs, uint64_t UserTag );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_SubmitEx( P_ASYNC_SUBMIT_STRUCT pSubmit );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_Cancel( uint64_t UserTag );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_GetCompletionHandle( HANDLE *pHandle );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_ReapCompletions( P_ASYNC_COMPLETION_STRUCT pCompletions, uint32_t MaxCompletions, puint32_t pCount );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     ASYNC_GetStats( P_ASYNC_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_Start( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_Stop( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitRead( uint8_t Offset, uint64_t UserTag );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitWrite( uint8_t Offset, uint8_t Value, uint64_t UserTag );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitReadBlock( uint8_t Offset, uint8_t Count, uint64_t UserTag );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitPet( uint8_t Mins, uint8_t Secs, uint64_t UserTag );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitEx( P_ASYNC_SUBMIT_STRUCT pSubmit );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_Cancel( uint64_t UserTag );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_GetCompletionHandle( HANDLE *pHandle );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_ReapCompletions( P_ASYNC_COMPLETION_STRUCT pCompletions, uint32_t MaxCompletions, puint32_t pCount );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     ASYNC_GetStats( P_ASYNC_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_Start( void );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_Stop( void );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitRead( uint8_t Offset, uint64_t UserTag );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitWrite( uint8_t Offset, uint8_t Value, uint64_t UserTag );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitReadBlock( uint8_t Offset, uint8_t Count, uint64_t UserTag );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitPet( uint8_t Mins, uint8_t Secs, uint64_t UserTag );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_SubmitEx( P_ASYNC_SUBMIT_STRUCT pSubmit );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_Cancel( uint64_t UserTag );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_GetCompletionHandle( HANDLE *pHandle );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_ReapCompletions( P_ASYNC_COMPLETION_STRUCT pCompletions, uint32_t MaxCompletions, puint32_t pCount );
+__declspec( dllimport )    WINSYS_ERROR     ASYNC_GetStats( P_ASYNC_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_ASYNC_INC
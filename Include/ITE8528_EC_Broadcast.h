@@ -0,0 +1,105 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Broadcast.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      One writer, many reader broadcast of the sampler's samples
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_BROADCAST_INC
+#define __ITE8528_EC_BROADCAST_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The broadcast ring hands every sample the sampler takes to any number of subscribers - an alarm engine, a logger,
+// an exporter - each reading at its own pace from its own cursor. Unlike SMP_DrainSamples(), a read takes nothing
+// away from the other subscribers, and nothing is locked or copied on their behalf.
+//
+// There is one writer, the sampler thread, and it never waits on or even looks at the subscribers: publishing costs
+// the same with 1 subscriber or BRD_MAX_SUBSCRIBERS. Each slot of the ring carries the number of the sample in it, so
+// a subscriber that falls more than BRD_RING_SIZE samples behind finds its samples overwritten, skips ahead to the
+// oldest one still held, and is told how many it missed.
+//
+// BRD_Subscribe() and BRD_Unsubscribe() may be called at any time; a new subscriber starts with the next sample
+// published. A subscription is read by one thread at a time. BRD_Wait() blocks until it has something to read.
+//
+// The sampler calls BRD_Publish() for every sample it takes. Applications may call it themselves - to replay or
+// inject samples - only while the sampler is stopped.
+//
+
+/*!\struct _BRD_STATS_STRUCT
+ * \brief  Counters kept by the broadcast ring, as returned by BRD_GetStats()
+ */
+typedef struct _BRD_STATS_STRUCT {
+                                    uint64_t     Published;         /*!< samples published                      */
+                                    uint64_t     Missed;            /*!< samples overwritten before read        */
+                                    uint32_t     Subscribers;       /*!< subscribed now                         */
+                                    uint32_t     Reserved;
+
+                                 } BRD_STATS_STRUCT, *P_BRD_STATS_STRUCT;
+
+#define BRD_RING_SIZE                       1024    /*!< samples held, a power of 2                       */
+#define BRD_MAX_SUBSCRIBERS                 64
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     BRD_Subscribe( puint32_t pHandle );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     BRD_Unsubscribe( uint32_t Handle );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     BRD_Read( uint32_t Handle, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount, puint32_t pMissed );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     BRD_Wait( uint32_t Handle, uint32_t TimeoutMs );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     BRD_Publish( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     BRD_GetStats( P_BRD_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     BRD_Subscribe( puint32_t pHandle );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     BRD_Unsubscribe( uint32_t Handle );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     BRD_Read( uint32_t Handle, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount, puint32_t pMissed );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     BRD_Wait( uint32_t Handle, uint32_t TimeoutMs );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     BRD_Publish( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     BRD_GetStats( P_BRD_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     BRD_Subscribe( puint32_t pHandle );
+__declspec( dllimport )    WINSYS_ERROR     BRD_Unsubscribe( uint32_t Handle );
+__declspec( dllimport )    WINSYS_ERROR     BRD_Read( uint32_t Handle, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount, puint32_t pMissed );
+__declspec( dllimport )    WINSYS_ERROR     BRD_Wait( uint32_t Handle, uint32_t TimeoutMs );
+__declspec( dllimport )    WINSYS_ERROR     BRD_Publish( P_EC_SAMPLE_STRUCT pSample );
+__declspec( dllimport )    WINSYS_ERROR     BRD_GetStats( P_BRD_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_BROADCAST_INC
@@ -0,0 +1,318 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Coro.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      C++20 coroutine awaitables for EC read, block read, write and
+//!            WDT pet operations
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_CORO_INC
+#define __ITE8528_EC_CORO_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Header only C++20 coroutine layer over the asynchronous interface in ITE8528_EC_Async.h. Include it after
+// windows.h, x86_64_port.h, WinSys_Errors.h, ITE8528_EC_Lib.h and ITE8528_EC_Async.h.
+//
+//    ite8528::EcDispatcher   Dispatcher;                       // after ASYNC_Start()
+//
+//    ite8528::EcTask Poll( ite8528::EcDispatcher &Ec, std::stop_token Stop )
+//    {
+//       auto Result = co_await Ec.Read( CPU_TEMPERATURE_OFFSET, { Stop, std::chrono::milliseconds( 50 ) } );
+//       ...
+//    }
+//
+// An awaiting coroutine is suspended while its request is queued and while the I/O worker talks to the EC,
+// so no thread is blocked. It is resumed on the executor given in its options, or else the dispatcher's
+// default executor, which resumes inline on the dispatcher's thread. A stop_token in the options cancels the
+// queued request with ASYNC_Cancel(), and a timeout becomes the request's TimeoutUs, so both are enforced by
+// the I/O worker. Either way the coroutine is resumed exactly once, by the request's completion.
+//
+// The dispatcher must be the only caller of ASYNC_ReapCompletions() while it exists.
+//
+
+#include <coroutine>
+#include <chrono>
+#include <functional>
+#include <stop_token>
+#include <thread>
+#include <exception>
+#include <optional>
+#include <string.h>
+
+namespace ite8528
+{
+
+//
+// An executor takes a suspended coroutine and arranges for it to be resumed - e.g. by posting it to a thread
+// pool or an event loop. An empty executor resumes inline.
+//
+
+using EcExecutor = std::function< void( std::coroutine_handle<> ) >;
+
+/*!\struct EcOptions
+ * \brief  Per operation options: cancellation, timeout and the executor to resume on
+ */
+struct EcOptions
+{
+   std::stop_token              Stop;                                 /*!< cancels the request when stop is requested */
+   std::chrono::microseconds    Timeout{ 0 };                         /*!< 0 = none, else deadline to start the request */
+   const EcExecutor *           pExecutor = nullptr;                  /*!< nullptr = dispatcher's default executor    */
+   uint8_t                      Priority = ASYNC_PRIO_DEFAULT;        /*!< ASYNC_PRIO_ENUM_TYPE scheduling class      */
+
+   EcOptions() = default;
+   EcOptions( std::stop_token StopToken, std::chrono::microseconds TimeoutValue = std::chrono::microseconds( 0 ),
+              const EcExecutor *pExec = nullptr, uint8_t Prio = ASYNC_PRIO_DEFAULT ) :
+      Stop( std::move( StopToken ) ), Timeout( TimeoutValue ), pExecutor( pExec ), Priority( Prio ) {}
+};
+
+/*!\struct EcResult
+ * \brief  What an awaited operation returns
+ */
+struct EcResult
+{
+   WINSYS_ERROR      Status = STATUS_SUCCESS;                         /*!< STATUS_CANCELLED / STATUS_TIMEOUT / EC error */
+   uint8_t           Count = 0;                                       /*!< bytes in Data                               */
+   uint8_t           Data[ ASYNC_MAX_BLOCK ] = {};                    /*!< bytes read                                  */
+
+   bool     Ok( void ) const { return Status == STATUS_SUCCESS; }
+   uint8_t  Byte( void ) const { return Data[ 0 ]; }
+   uint16_t Word( void ) const { return ( uint16_t )( ( Data[ 0 ] << 8 ) + Data[ 1 ] ); }          // high byte first, as CPU_FAN_H/L
+   uint16_t WordLowFirst( void ) const { return ( uint16_t )( ( Data[ 1 ] << 8 ) + Data[ 0 ] ); }  // low byte first, as the voltages
+};
+
+class EcDispatcher;
+
+/*!\class EcOperation
+ * \brief  The awaitable returned by the EcDispatcher operations. Its address is the request's ASYNC tag.
+ */
+class EcOperation
+{
+   public:
+      EcOperation( EcDispatcher &Dispatcher, const ASYNC_SUBMIT_STRUCT &Submit, const EcOptions &Options ) :
+         m_Dispatcher( Dispatcher ), m_Submit( Submit ), m_Options( Options ) {}
+
+      EcOperation( const EcOperation & ) = delete;
+      EcOperation &operator=( const EcOperation & ) = delete;
+
+      bool await_ready( void ) const noexcept { return false; }
+
+      bool await_suspend( std::coroutine_handle<> Handle ) noexcept
+      {
+         m_Handle = Handle;
+
+         if ( m_Options.Stop.stop_requested() )
+         {
+            m_Result.Status = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_CANCELLED );
+            return false;
+         }
+
+         m_Submit.UserTag = ( uint64_t )( uintptr_t ) this;
+         m_Submit.TimeoutUs = TimeoutUs( m_Options.Timeout );
+         m_Submit.Priority = m_Options.Priority;
+
+         //
+         // the stop callback is registered before submitting - if it fires first, ASYNC_Cancel() finds nothing and
+         // the request runs, which is the same outcome as a stop that arrives after the worker has started it
+         //
+
+         if ( m_Options.Stop.stop_possible() )
+         {
+            m_StopCallback.emplace( m_Options.Stop, CancelRequest{ m_Submit.UserTag } );
+         }
+
+         //
+         // once submitted, the completion may resume the coroutine on another thread at any moment, so *this must
+         // not be touched after a successful submission
+         //
+
+         WINSYS_ERROR   Status = ASYNC_SubmitEx( &m_Submit );
+
+         if ( Status != STATUS_SUCCESS )
+         {
+            m_Result.Status = Status;
+            return false;
+         }
+
+         return true;
+      }
+
+      EcResult await_resume( void ) noexcept
+      {
+         m_StopCallback.reset();
+         return m_Result;
+      }
+
+   private:
+      //
+      // TimeoutUs is 32 bits and 0 means none - a longer timeout is cut to the longest it can hold, and a negative
+      // one, already passed, to the shortest
+      //
+
+      static uint32_t TimeoutUs( std::chrono::microseconds Timeout ) noexcept
+      {
+         if ( Timeout.count() < 0 )
+         {
+            return 1;
+         }
+
+         return ( Timeout.count() > ( long long ) UINT32_MAX ) ? UINT32_MAX : ( uint32_t ) Timeout.count();
+      }
+
+      friend class EcDispatcher;
+
+      struct CancelRequest
+      {
+         uint64_t   Tag;
+         void operator()( void ) const noexcept { ASYNC_Cancel( Tag ); }
+      };
+
+      EcDispatcher &                                   m_Dispatcher;
+      ASYNC_SUBMIT_STRUCT                              m_Submit;
+      EcOptions                                        m_Options;
+      EcResult                                         m_Result;
+      std::coroutine_handle<>                          m_Handle;
+      std::optional< std::stop_callback< CancelRequest > >   m_StopCallback;
+};
+
+/*!\class EcDispatcher
+ * \brief  Reaps ASYNC completions on its own thread and resumes the coroutines waiting on them
+ */
+class EcDispatcher
+{
+   public:
+      explicit EcDispatcher( EcExecutor DefaultExecutor = EcExecutor() ) :
+         m_DefaultExecutor( std::move( DefaultExecutor ) )
+      {
+         m_StopEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
+         m_Thread = std::thread( [ this ]() { Run(); } );
+      }
+
+      ~EcDispatcher()
+      {
+         SetEvent( m_StopEvent );
+         m_Thread.join();
+         CloseHandle( m_StopEvent );
+      }
+
+      EcDispatcher( const EcDispatcher & ) = delete;
+      EcDispatcher &operator=( const EcDispatcher & ) = delete;
+
+      EcOperation Read( uint8_t Offset, const EcOptions &Options = EcOptions() )
+      {
+         return EcOperation( *this, MakeSubmit( ASYNC_OP_READ, Offset, 1, 0, 0 ), Options );
+      }
+
+      EcOperation ReadBlock( uint8_t Offset, uint8_t Count, const EcOptions &Options = EcOptions() )
+      {
+         return EcOperation( *this, MakeSubmit( ASYNC_OP_READ_BLOCK, Offset, Count, 0, 0 ), Options );
+      }
+
+      EcOperation Write( uint8_t Offset, uint8_t Value, const EcOptions &Options = EcOptions() )
+      {
+         return EcOperation( *this, MakeSubmit( ASYNC_OP_WRITE, Offset, 0, Value, 0 ), Options );
+      }
+
+      EcOperation PetWdt( uint8_t Mins, uint8_t Secs, const EcOptions &Options = EcOptions() )
+      {
+         return EcOperation( *this, MakeSubmit( ASYNC_OP_PET_WDT, 0, 0, Mins, Secs ), Options );
+      }
+
+   private:
+      static ASYNC_SUBMIT_STRUCT MakeSubmit( uint8_t Op, uint8_t Offset, uint8_t Count, uint8_t Value, uint8_t Value2 )
+      {
+         ASYNC_SUBMIT_STRUCT   Submit = {};
+
+         Submit.Op = Op;
+         Submit.Offset = Offset;
+         Submit.Count = Count;
+         Submit.Value = Value;
+         Submit.Value2 = Value2;
+
+         return Submit;
+      }
+
+      void Run( void )
+      {
+         HANDLE                    Handles[ 2 ] = { m_StopEvent, NULL };
+         ASYNC_COMPLETION_STRUCT   Completions[ 32 ];
+         uint32_t                  Count;
+
+         if ( ASYNC_GetCompletionHandle( &Handles[ 1 ] ) != STATUS_SUCCESS )
+         {
+            return;                                                   // ASYNC_Start() was not called
+         }
+
+         while ( WaitForMultipleObjects( 2, Handles, FALSE, INFINITE ) == ( WAIT_OBJECT_0 + 1 ) )
+         {
+            while ( ( ASYNC_ReapCompletions( Completions, 32, &Count ) == STATUS_SUCCESS ) && ( Count > 0 ) )
+            {
+               for ( uint32_t Index = 0; Index < Count; Index++ )
+               {
+                  EcOperation *       pOp = ( EcOperation * )( uintptr_t ) Completions[ Index ].UserTag;
+                  const EcExecutor *  pExec = ( pOp->m_Options.pExecutor ) ? pOp->m_Options.pExecutor : &m_DefaultExecutor;
+
+                  pOp->m_Result.Status = Completions[ Index ].Status;
+                  pOp->m_Result.Count = Completions[ Index ].Count;
+                  memcpy( pOp->m_Result.Data, Completions[ Index ].Data, Completions[ Index ].Count );
+
+                  if ( *pExec )
+                      {
+                         ( *pExec )( pOp->m_Handle );
+                      }
+                  else
+                      {
+                         pOp->m_Handle.resume();
+                      }
+               }
+            }
+         }
+      }
+
+      EcExecutor      m_DefaultExecutor;
+      HANDLE          m_StopEvent;
+      std::thread     m_Thread;
+};
+
+/*!\struct EcTask
+ * \brief  A minimal fire-and-forget coroutine type for EC tasks. Exceptions terminate the program, since
+ *         there is no one to report them to.
+ */
+struct EcTask
+{
+   struct promise_type
+   {
+      EcTask get_return_object( void ) noexcept { return EcTask(); }
+      std::suspend_never initial_suspend( void ) noexcept { return {}; }
+      std::suspend_never final_suspend( void ) noexcept { return {}; }
+      void return_void( void ) noexcept {}
+      void unhandled_exception( void ) noexcept { std::terminate(); }
+   };
+};
+
+}           // namespace ite8528
+
+#endif      // #ifndef __ITE8528_EC_CORO_INC
@@ -0,0 +1,141 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Daemon.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Wire protocol of the EC telemetry daemon
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_DAEMON_INC
+#define __ITE8528_EC_DAEMON_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Wire protocol of the EC telemetry daemon, ITE8528_EC_Daemon.exe. The daemon is the only process that loads
+// the library and opens the EC ports; tools talk to it over a Unix domain socket and need no port privileges,
+// only permission to open the socket file. The daemon sets a protected ACL on the socket's directory giving
+// SYSTEM and Administrators full control, and read and write access to the socket to the group named with -g,
+// so that only those accounts may connect.
+//
+// A request is an ECD_REQUEST_HEADER_STRUCT followed by ItemCount ECD_ITEM_STRUCTs, each asking for one thing -
+// the latest readings of a set of sensors, a range of history or rollups, or a set of statistics. The reply is
+// an ECD_RESPONSE_HEADER_STRUCT followed, for each item in order, by an ECD_RESULT_STRUCT and Bytes of payload.
+// An item that fails carries its error in Status and no payload; the other items are still answered.
+//
+// Readings and statistics are answered from the daemon's snapshot, refreshed each time the sampler takes a
+// sample, so no request waits on the EC. History comes from the daemon's history file, when it has one.
+//
+// Every field is little endian and the structures have no padding. A client may send several requests without
+// waiting; they are answered in order, and Tag is echoed so that replies can be matched. A request that cannot
+// be parsed closes the connection.
+//
+
+#define ECD_DEFAULT_SOCKET_PATH             "C:\\ProgramData\\WinSystems\\ITE8528_EC.sock"
+#define ECD_MAGIC                           0x31444345   /*!< "ECD1", first word of a request and a response  */
+#define ECD_MAX_ITEMS                       16           /*!< items in one request                             */
+#define ECD_MAX_CLIENTS                     32           /*!< connections served at once                       */
+#define ECD_PAYLOAD_SIZE                    ( 256 * 1024 )   /*!< payload bytes in one response, all items     */
+
+/*!\enum _ECD_ITEM_ENUM_TYPE
+ * \brief  What an ECD_ITEM_STRUCT asks for, and the payload returned for it
+ */
+typedef enum _ECD_ITEM_ENUM_TYPE {
+                                    ECD_ITEM_SENSORS = 1,         /*!< one EC_SAMPLE_STRUCT, the SensorMask sensors  */
+                                    ECD_ITEM_HISTORY = 2,         /*!< EC_SAMPLE_STRUCTs from StartMs to EndMs       */
+                                    ECD_ITEM_ROLLUP = 3,          /*!< HIST_POINT_STRUCTs from StartMs to EndMs      */
+                                    ECD_ITEM_SENSOR_STATS = 4,    /*!< a STAT_SENSOR_STRUCT per SensorMask sensor    */
+                                    ECD_ITEM_SAMPLER_STATS = 5,   /*!< one SMP_STATS_STRUCT                          */
+                                    ECD_ITEM_HISTORY_STATS = 6,   /*!< one HIST_STATS_STRUCT                         */
+                                    ECD_ITEM_DAEMON_STATS = 7,    /*!< one ECD_STATS_STRUCT                          */
+
+                                 } ECD_ITEM_ENUM_TYPE, *P_ECD_ITEM_ENUM_TYPE;
+
+/*!\struct _ECD_REQUEST_HEADER_STRUCT
+ * \brief  Starts every request
+ */
+typedef struct _ECD_REQUEST_HEADER_STRUCT {
+                                             uint32_t     Magic;          /*!< ECD_MAGIC                        */
+                                             uint32_t     Tag;            /*!< echoed in the response           */
+                                             uint32_t     ItemCount;      /*!< items following, 1..ECD_MAX_ITEMS */
+                                             uint32_t     Reserved;
+
+                                          } ECD_REQUEST_HEADER_STRUCT, *P_ECD_REQUEST_HEADER_STRUCT;
+
+/*!\struct _ECD_ITEM_STRUCT
+ * \brief  One thing asked for. Fields an item type does not use should be 0.
+ */
+typedef struct _ECD_ITEM_STRUCT {
+                                   uint32_t     Type;             /*!< ECD_ITEM_ENUM_TYPE                          */
+                                   uint32_t     SensorMask;       /*!< SENSORS and SENSOR_STATS, EC_SENSOR_MASK()  */
+                                   uint32_t     MaxCount;         /*!< HISTORY and ROLLUP, most records to return  */
+                                   uint32_t     Reserved;
+                                   uint64_t     StartMs;          /*!< HISTORY and ROLLUP, UTC msecs               */
+                                   uint64_t     EndMs;
+
+                                } ECD_ITEM_STRUCT, *P_ECD_ITEM_STRUCT;
+
+/*!\struct _ECD_RESPONSE_HEADER_STRUCT
+ * \brief  Starts every response
+ */
+typedef struct _ECD_RESPONSE_HEADER_STRUCT {
+                                              uint32_t     Magic;         /*!< ECD_MAGIC                        */
+                                              uint32_t     Tag;           /*!< from the request                 */
+                                              uint32_t     ItemCount;     /*!< results following                */
+                                              uint32_t     Bytes;         /*!< bytes following this header      */
+
+                                           } ECD_RESPONSE_HEADER_STRUCT, *P_ECD_RESPONSE_HEADER_STRUCT;
+
+/*!\struct _ECD_RESULT_STRUCT
+ * \brief  Precedes the payload of each item. HISTORY and ROLLUP items share what the other items leave of
+ *         ECD_PAYLOAD_SIZE bytes, so a long range may return fewer records than asked - ask again from the
+ *         last one returned.
+ */
+typedef struct _ECD_RESULT_STRUCT {
+                                     uint32_t     Type;           /*!< from the item                              */
+                                     uint32_t     Status;         /*!< WINSYS_ERROR for this item                 */
+                                     uint32_t     Count;          /*!< records in the payload                     */
+                                     uint32_t     Bytes;          /*!< payload bytes following                    */
+                                     uint32_t     ResolutionMs;   /*!< ROLLUP, the width of each point            */
+                                     uint32_t     Reserved;
+
+                                  } ECD_RESULT_STRUCT, *P_ECD_RESULT_STRUCT;
+
+/*!\struct _ECD_STATS_STRUCT
+ * \brief  Counters kept by the daemon, the payload of ECD_ITEM_DAEMON_STATS
+ */
+typedef struct _ECD_STATS_STRUCT {
+                                    uint64_t     Requests;          /*!< requests answered                       */
+                                    uint64_t     Items;             /*!< items answered                          */
+                                    uint64_t     BytesSent;         /*!< response bytes written                  */
+                                    uint64_t     Snapshots;         /*!< times the snapshot was refreshed        */
+                                    uint64_t     SnapshotMs;        /*!< timestamp of the snapshot's sample      */
+                                    uint32_t     Clients;           /*!< connections open now                    */
+                                    uint32_t     Accepted;          /*!< connections accepted                    */
+                                    uint32_t     Refused;           /*!< connections closed, no client slot free */
+                                    uint32_t     Malformed;         /*!< connections closed for a bad request    */
+
+                                 } ECD_STATS_STRUCT, *P_ECD_STATS_STRUCT;
+
+#endif      // #ifndef __ITE8528_EC_DAEMON_INC
@@ -0,0 +1,1189 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Driver.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      The ACPI EC protocol as a template over port, wait and lock
+//!            policies
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_DRIVER_INC
+#define __ITE8528_EC_DRIVER_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Header only, needs C++17. Include it after windows.h (on Windows), x86_64_port.h, WinSys_Errors.h and
+// ITE8528_EC_Lib.h.
+//
+//    ite8528::EcDriver< Ports, Wait, Locking >   Ec;
+//
+//    Ports     how a byte gets to and from an I/O port
+//                 InpOutPorts      the inpout driver (Windows) - what the DLL uses
+//                 DirectPorts      inb/outb inline assembly (Linux, after DirectPorts::Open())
+//                 SimulatedPorts   an in-memory EC that speaks the 62/66 protocol, for tests
+//                 RecordingPorts   another port policy, writing every operation to a trace file when asked
+//                 ReplayPorts      plays a RecordingPorts trace back, with the EC's recorded timing
+//    Wait      how to wait on the IBF/OBF/burst handshake
+//                 SpinWait         poll the status register
+//                 SpinYieldWait    poll, then yield the CPU between polls
+//                 SleepWait        poll, then sleep between polls
+//    Locking   who else may be talking to the EC
+//                 NoLock           nobody - single threaded builds
+//                 ThreadLock       other threads of this process
+//                 ProcessLock      other processes too
+//                 SharedLock       one of the above, shared by every driver instantiated with it
+//
+// Nothing is virtual. Stateless policies are static inline calls, so EcDriver< DirectPorts, SpinWait, NoLock >
+// compiles down to the in and out instructions of the handshake.
+//
+// The exported EC_ functions in ITE8528_EC_Lib.h are two instantiations of this template sharing a lock, one
+// that records and one that does not, over policies chosen when the DLL is built (see EC_DRIVER_PORTS,
+// EC_DRIVER_WAIT and EC_DRIVER_LOCK in ITE8528_EC_Lib.cpp).
+//
+
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <type_traits>
+#include <algorithm>
+#include <cstdio>
+#include <emmintrin.h>
+
+#if defined( _WIN32 )
+#include <inpout32.h>
+#else
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#endif
+
+#if defined( __linux__ )
+#include <sys/io.h>
+#endif
+
+#ifndef EC_FORCEINLINE
+#if defined( _MSC_VER )
+#define EC_FORCEINLINE          __forceinline
+#else
+#define EC_FORCEINLINE          inline __attribute__(( always_inline ))
+#endif
+#endif
+
+#define EC_SPIN_BEFORE_YIELD                64        /*!< SpinYieldWait polls this many times before it yields         */
+#define EC_SLEEP_WAIT_TRIES                 100       /*!< SleepWait polls, BURST_SLEEP_PERIOD_MILLISECS apart          */
+#define EC_TRACE_BUFFER_RECORDS             4096      /*!< RecordingPorts writes the trace this many records at a time  */
+#define EC_REPLAY_RESYNC                    16        /*!< trace actions ReplayPorts looks ahead to match one out of turn */
+#define EC_BURST_ACK                        0x90      /*!< what the EC returns for BURST_ENABLE_CMD                     */
+#define EC_PROCESS_LOCK_NAME                "Global\\ITE8528_EC_Lock"
+#define EC_PROCESS_LOCK_PATH                "/var/lock/ite8528_ec.lock"
+
+namespace ite8528
+{
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Port policies                                                                */
+/*                                                                               */
+/*********************************************************************************/
+
+#if defined( _WIN32 )
+
+/*!\struct InpOutPorts
+ * \brief  Port I/O through the inpout driver
+ */
+struct InpOutPorts
+{
+   static EC_FORCEINLINE uint8_t In( uint16_t Port ) { return DlPortReadPortUchar( Port ); }
+   static EC_FORCEINLINE void Out( uint16_t Port, uint8_t Value ) { DlPortWritePortUchar( Port, Value ); }
+};
+
+#endif
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+
+/*!\struct DirectPorts
+ * \brief  Port I/O with the in and out instructions. The process needs I/O privilege - see Open().
+ */
+struct DirectPorts
+{
+   static EC_FORCEINLINE uint8_t In( uint16_t Port )
+   {
+      uint8_t   Value;
+
+      __asm__ __volatile__( "inb %w1, %b0" : "=a"( Value ) : "Nd"( Port ) );
+      return Value;
+   }
+
+   static EC_FORCEINLINE void Out( uint16_t Port, uint8_t Value )
+   {
+      __asm__ __volatile__( "outb %b0, %w1" : : "a"( Value ), "Nd"( Port ) );
+   }
+
+#if defined( __linux__ )
+   //
+   // ioperm() only reaches the first 0x400 ports, so the IO space mapping at EC_IO_PORT needs iopl()
+   //
+
+   static bool Open( bool IoSpace = false )
+   {
+      return IoSpace ? ( iopl( 3 ) == 0 ) : ( ioperm( ACPI_EC_DATA_REG, ACPI_EC_CMND_REG - ACPI_EC_DATA_REG + 1, 1 ) == 0 );
+   }
+#endif
+};
+
+#endif
+
+/*!\class SimulatedPorts
+ * \brief  An EC in memory. Commands complete instantly unless Latency is set, in which case IBF stays set for
+ *         that many status reads after each write.
+ */
+class SimulatedPorts
+{
+   public:
+      uint8_t      Sram[ 256 ] = {};                      /*!< the EC's SRAM, also seen through the IO space mapping */
+      uint32_t     Latency = 0;                           /*!< status reads that IBF stays set for after a write      */
+      uint32_t     PortReads = 0;                         /*!< I/O cycles, for tests that count them                   */
+      uint32_t     PortWrites = 0;
+
+      uint8_t In( uint16_t Port )
+      {
+         PortReads++;
+
+         if ( Port == ACPI_EC_CMND_REG )
+             {
+                ACPI_STATUS_UNION   StatusReg;
+
+                StatusReg.Byte = 0;
+                StatusReg.Bits.Obf = m_Obf;
+                StatusReg.Bits.Ibf = ( m_Busy > 0 );
+                StatusReg.Bits.Burst = m_Burst;
+                StatusReg.Bits.Sci_Evt = ( m_QueryCount > 0 );
+
+                if ( m_Busy > 0 )
+                {
+                   m_Busy--;
+                }
+
+                return StatusReg.Byte;
+             }
+         else if ( Port == ACPI_EC_DATA_REG )
+             {
+                m_Obf = 0;
+                return m_Output;
+             }
+         else if ( ( Port >= EC_IO_PORT ) && ( Port < EC_IO_PORT + sizeof( Sram ) ) )
+             {
+                return Sram[ Port - EC_IO_PORT ];
+             }
+         else
+             {
+                return 0xFF;                              // nothing decodes it
+             }
+      }
+
+      void Out( uint16_t Port, uint8_t Value )
+      {
+         PortWrites++;
+         m_Busy = Latency;
+
+         if ( Port == ACPI_EC_CMND_REG )
+             {
+                m_Phase = PHASE_IDLE;
+
+                switch ( Value )
+                {
+                   case READ_EC_CMD:        m_Phase = PHASE_READ_ADDRESS;                break;
+                   case WRITE_EC_CMD:       m_Phase = PHASE_WRITE_ADDRESS;               break;
+                   case BURST_ENABLE_CMD:   m_Burst = 1;   Output( EC_BURST_ACK );       break;
+                   case BURST_DISABLE_CMD:  m_Burst = 0;                                 break;
+                   case QUERY_EC_CMD:       Output( PopQuery() );                        break;
+                   default:                                                              break;
+                }
+             }
+         else if ( Port == ACPI_EC_DATA_REG )
+             {
+                switch ( m_Phase )
+                {
+                   case PHASE_READ_ADDRESS:   Output( Sram[ Value ] );   m_Phase = PHASE_IDLE;          break;
+                   case PHASE_WRITE_ADDRESS:  m_Address = Value;         m_Phase = PHASE_WRITE_DATA;    break;
+                   case PHASE_WRITE_DATA:     Sram[ m_Address ] = Value; m_Phase = PHASE_IDLE;          break;
+                   default:                                                                             break;
+                }
+             }
+         else if ( ( Port >= EC_IO_PORT ) && ( Port < EC_IO_PORT + sizeof( Sram ) ) )
+             {
+                Sram[ Port - EC_IO_PORT ] = Value;
+             }
+      }
+
+      //
+      // queues an SCI query code, which sets Sci_Evt until QUERY_EC_CMD has returned it
+      //
+
+      bool PostQuery( uint8_t Code )
+      {
+         if ( m_QueryCount < sizeof( m_Queries ) )
+         {
+            m_Queries[ ( m_QueryHead + m_QueryCount++ ) % sizeof( m_Queries ) ] = Code;
+            return true;
+         }
+
+         return false;
+      }
+
+   private:
+      enum { PHASE_IDLE, PHASE_READ_ADDRESS, PHASE_WRITE_ADDRESS, PHASE_WRITE_DATA };
+
+      void Output( uint8_t Value ) { m_Output = Value; m_Obf = 1; }
+
+      uint8_t PopQuery( void )
+      {
+         uint8_t   Code = 0;
+
+         if ( m_QueryCount > 0 )
+         {
+            Code = m_Queries[ m_QueryHead ];
+            m_QueryHead = ( uint8_t )( ( m_QueryHead + 1 ) % sizeof( m_Queries ) );
+            m_QueryCount--;
+         }
+
+         return Code;
+      }
+
+      uint8_t      m_Output = 0;
+      uint8_t      m_Obf = 0;
+      uint8_t      m_Burst = 0;
+      uint8_t      m_Phase = PHASE_IDLE;
+      uint8_t      m_Address = 0;
+      uint32_t     m_Busy = 0;
+      uint8_t      m_Queries[ 32 ] = {};
+      uint8_t      m_QueryHead = 0;
+      uint8_t      m_QueryCount = 0;
+};
+
+/*!\fn    OpenTraceFile
+ * \brief  fopen(), which MSVC's SDL checks reject in favour of fopen_s()
+ */
+inline FILE *OpenTraceFile( const char *pPath, const char *pMode )
+{
+#if defined( _MSC_VER )
+   FILE   *pFile = NULL;
+
+   return ( fopen_s( &pFile, pPath, pMode ) == 0 ) ? pFile : NULL;
+#else
+   return fopen( pPath, pMode );
+#endif
+}
+
+/*!\class RecordingPorts
+ * \brief  Passes port I/O through to another port policy and, between Open() and Close(), adds every operation to
+ *         a trace file - when it completed, the port, and the byte read or written. Not recording costs one test
+ *         per operation.
+ */
+template< typename Inner >
+class RecordingPorts
+{
+   public:
+      EC_FORCEINLINE uint8_t In( uint16_t Port )
+      {
+         uint8_t   Value = m_Inner.In( Port );
+
+         if ( m_Recording.load( std::memory_order_relaxed ) )
+         {
+            Record( Port, EC_TRACE_IN, Value );
+         }
+
+         return Value;
+      }
+
+      EC_FORCEINLINE void Out( uint16_t Port, uint8_t Value )
+      {
+         m_Inner.Out( Port, Value );
+
+         if ( m_Recording.load( std::memory_order_relaxed ) )
+         {
+            Record( Port, EC_TRACE_OUT, Value );
+         }
+      }
+
+      bool IsRecording( void ) const { return m_Recording.load(); }
+
+      Inner &GetInner( void ) { return m_Inner; }
+
+      //
+      // returns false if already recording or the file cannot be created
+      //
+
+      bool Open( const char *pPath )
+      {
+         EC_TRACE_HEADER_STRUCT   Header = { EC_TRACE_MAGIC, EC_TRACE_VERSION, sizeof( EC_TRACE_RECORD_STRUCT ) };
+         bool                     Opened = false;
+
+         Acquire();
+
+         if ( m_pFile == NULL )
+         {
+            if ( ( m_pFile = OpenTraceFile( pPath, "wb" ) ) != NULL )
+            {
+               if ( fwrite( &Header, sizeof( Header ), 1, m_pFile ) == 1 )
+                   {
+                      m_Count = 0;
+                      m_Records = 0;
+                      m_LastNs = Now();
+                      m_Recording.store( true );
+                      Opened = true;
+                   }
+               else
+                   {
+                      fclose( m_pFile );
+                      m_pFile = NULL;
+                   }
+            }
+         }
+
+         Release();
+
+         return Opened;
+      }
+
+      //
+      // returns false if not recording, or some of the trace could not be written
+      //
+
+      bool Close( uint64_t *pRecords = NULL )
+      {
+         bool   Closed = false;
+
+         Acquire();
+
+         if ( m_pFile != NULL )
+         {
+            m_Recording.store( false );
+            Closed = Flush();
+            Closed = ( fclose( m_pFile ) == 0 ) && ( Closed );
+            m_pFile = NULL;
+
+            if ( pRecords != NULL )
+            {
+               *pRecords = m_Records;
+            }
+         }
+
+         Release();
+
+         return Closed;
+      }
+
+   private:
+      static uint64_t Now( void )
+      {
+         return ( uint64_t ) std::chrono::duration_cast< std::chrono::nanoseconds >(
+                                std::chrono::steady_clock::now().time_since_epoch() ).count();
+      }
+
+      //
+      // Status() and the IO space calls run outside the driver's lock, so the buffer has its own
+      //
+
+      void Acquire( void )
+      {
+         while ( m_Busy.test_and_set( std::memory_order_acquire ) )
+         {
+            _mm_pause();
+         }
+      }
+
+      void Release( void ) { m_Busy.clear( std::memory_order_release ); }
+
+      void Record( uint16_t Port, uint8_t Op, uint8_t Value )
+      {
+         uint64_t   NowNs = Now(),
+                    Delta;
+
+         Acquire();
+
+         if ( m_pFile != NULL )
+         {
+            Delta = NowNs - m_LastNs;
+
+            m_Buffer[ m_Count ].DeltaNs = ( Delta > 0xFFFFFFFF ) ? 0xFFFFFFFF : ( uint32_t ) Delta;
+            m_Buffer[ m_Count ].Port = Port;
+            m_Buffer[ m_Count ].Op = Op;
+            m_Buffer[ m_Count ].Value = Value;
+            m_LastNs = NowNs;
+
+            if ( ++m_Count == EC_TRACE_BUFFER_RECORDS )
+            {
+               //
+               // the write stalls whatever transaction is in progress - leave the stall out of the trace
+               //
+
+               Flush();
+               m_LastNs += Now() - NowNs;
+            }
+         }
+
+         Release();
+      }
+
+      bool Flush( void )
+      {
+         bool   Written = ( fwrite( m_Buffer, sizeof( m_Buffer[ 0 ] ), m_Count, m_pFile ) == m_Count );
+
+         m_Records += m_Count;
+         m_Count = 0;
+
+         return Written;
+      }
+
+      Inner                    m_Inner;
+      std::atomic< bool >      m_Recording{ false };
+      std::atomic_flag         m_Busy = ATOMIC_FLAG_INIT;
+      FILE                     *m_pFile = NULL;
+      uint64_t                 m_LastNs = 0;
+      uint64_t                 m_Records = 0;
+      uint32_t                 m_Count = 0;
+      EC_TRACE_RECORD_STRUCT   m_Buffer[ EC_TRACE_BUFFER_RECORDS ];
+};
+
+template< typename Ports > struct IsRecordingPorts : std::false_type {};
+template< typename Inner > struct IsRecordingPorts< RecordingPorts< Inner > > : std::true_type {};
+
+/*!\class ReplayPorts
+ * \brief  Answers port I/O from a trace made by RecordingPorts, so the driver can be run against a real EC's
+ *         behaviour on any machine. Single threaded.
+ *
+ * The trace is a series of actions - writes, and reads of anything but the status register - with the status
+ * reads the driver polled between them. Each action the driver takes is matched to the trace's next one, which
+ * starts a clock: status reads then return what the status register read that long after the same action on the
+ * board, so IBF, OBF and Burst stay busy for as long as they did there however fast or slow the code polling them,
+ * and a read action returns the byte read on the board. Each operation also takes as long as it typically took on
+ * the board's bus, so wait policies that count polls give up after as long as they would there.
+ *
+ * An action that is not the trace's next is counted. If one of the next EC_REPLAY_RESYNC actions in the trace
+ * matches it, replay skips ahead to that one; otherwise a write is taken as an extra and replay stays where it is,
+ * and a read returns 0xFF.
+ */
+class ReplayPorts
+{
+   public:
+      uint32_t     Mismatches = 0;                        /*!< actions that were not the trace's next                */
+      uint32_t     Unanswered = 0;                        /*!< reads the trace had no answer for, which return 0xFF  */
+      bool         PaceBus = true;                        /*!< false to answer without the bus's recorded delay      */
+
+      //
+      // loads the whole trace - returns false if it cannot be read or is not a trace
+      //
+
+      bool Open( const char *pPath )
+      {
+         EC_TRACE_HEADER_STRUCT   Header;
+         EC_TRACE_RECORD_STRUCT   Record;
+         FILE                     *pFile;
+         uint64_t                 TimeNs = 0;
+         bool                     Loaded = false;
+
+         m_Records.clear();
+         m_Times.clear();
+
+         if ( ( pFile = OpenTraceFile( pPath, "rb" ) ) != NULL )
+         {
+            if ( ( fread( &Header, sizeof( Header ), 1, pFile ) == 1 ) && ( Header.Magic == EC_TRACE_MAGIC ) &&
+                 ( Header.Version == EC_TRACE_VERSION ) && ( Header.RecordBytes == sizeof( Record ) ) )
+            {
+               while ( fread( &Record, sizeof( Record ), 1, pFile ) == 1 )
+               {
+                  TimeNs += Record.DeltaNs;
+                  m_Records.push_back( Record );
+                  m_Times.push_back( TimeNs );
+               }
+
+               m_ReadNs = TypicalNs( EC_TRACE_IN );
+               m_WriteNs = TypicalNs( EC_TRACE_OUT );
+               Loaded = true;
+            }
+
+            fclose( pFile );
+         }
+
+         Rewind();
+
+         return Loaded;
+      }
+
+      void Rewind( void )
+      {
+         Mismatches = 0;
+         Unanswered = 0;
+         m_Status = 0;
+         m_LastOp = std::chrono::steady_clock::now();
+         StartSegment( 0, 0 );
+      }
+
+      size_t Records( void ) const { return m_Records.size(); }
+
+      //
+      // true once every action in the trace has been replayed
+      //
+
+      bool Finished( void ) const { return m_NextAction >= m_Records.size(); }
+
+      uint8_t In( uint16_t Port )
+      {
+         std::chrono::steady_clock::time_point   Now = Pace( m_ReadNs );
+         size_t                                  Match;
+
+         if ( Port == ACPI_EC_CMND_REG )
+         {
+            uint64_t   Want = m_BaseNs + ( uint64_t ) std::chrono::duration_cast< std::chrono::nanoseconds >(
+                                                         Now - m_Started ).count();
+
+            for ( ; m_StatusAt < m_NextAction; m_StatusAt++ )
+            {
+               if ( ( m_StatusSeen ) && ( m_Times[ m_StatusAt ] > Want ) )
+               {
+                  break;
+               }
+
+               m_Status = m_Records[ m_StatusAt ].Value;
+               m_StatusSeen = true;
+            }
+
+            return m_Status;                              // the last status read, if the segment had none
+         }
+
+         if ( ( Match = FindAction( EC_TRACE_IN, Port, 0 ) ) < m_Records.size() )
+         {
+            StartSegment( Match + 1, m_Times[ Match ] );
+            return m_Records[ Match ].Value;
+         }
+
+         Unanswered++;
+         return 0xFF;
+      }
+
+      void Out( uint16_t Port, uint8_t Value )
+      {
+         size_t   Match;
+
+         Pace( m_WriteNs );
+
+         if ( ( Match = FindAction( EC_TRACE_OUT, Port, Value ) ) < m_Records.size() )
+         {
+            StartSegment( Match + 1, m_Times[ Match ] );
+         }
+      }
+
+   private:
+      static bool IsStatusRead( const EC_TRACE_RECORD_STRUCT &Record )
+      {
+         return ( Record.Op == EC_TRACE_IN ) && ( Record.Port == ACPI_EC_CMND_REG );
+      }
+
+      //
+      // the next action in the trace, or the first of the EC_REPLAY_RESYNC after it that matches - a read matches
+      // whatever byte it read. Returns the number of records if none does.
+      //
+
+      size_t FindAction( uint8_t Op, uint16_t Port, uint8_t Value )
+      {
+         uint32_t   Skipped = 0;
+
+         for ( size_t Index = m_NextAction; ( Index < m_Records.size() ) && ( Skipped <= EC_REPLAY_RESYNC ); Index++ )
+         {
+            if ( ! IsStatusRead( m_Records[ Index ] ) )
+            {
+               if ( ( m_Records[ Index ].Op == Op ) && ( m_Records[ Index ].Port == Port ) &&
+                    ( ( Op == EC_TRACE_IN ) || ( m_Records[ Index ].Value == Value ) ) )
+               {
+                  Mismatches += ( Skipped > 0 );
+                  return Index;
+               }
+
+               Skipped++;
+            }
+         }
+
+         Mismatches++;
+         return m_Records.size();
+      }
+
+      //
+      // the median time an operation of this kind took after a status read - the bus cycle, measured where the
+      // driver was polling
+      //
+
+      uint64_t TypicalNs( uint8_t Op ) const
+      {
+         std::vector< uint32_t >   Deltas;
+
+         for ( size_t Index = 1; Index < m_Records.size(); Index++ )
+         {
+            if ( ( m_Records[ Index ].Op == Op ) && ( IsStatusRead( m_Records[ Index - 1 ] ) ) )
+            {
+               Deltas.push_back( m_Records[ Index ].DeltaNs );
+            }
+         }
+
+         if ( Deltas.empty() )
+         {
+            return 0;
+         }
+
+         std::nth_element( Deltas.begin(), Deltas.begin() + Deltas.size() / 2, Deltas.end() );
+         return Deltas[ Deltas.size() / 2 ];
+      }
+
+      //
+      // the recorded times run from one operation completing to the next, so pace from the last one too - the
+      // driver's own time between them is already part of Ns. Returns when this operation completes.
+      //
+
+      std::chrono::steady_clock::time_point Pace( uint64_t Ns )
+      {
+         std::chrono::steady_clock::time_point   Now = std::chrono::steady_clock::now();
+
+         if ( PaceBus )
+         {
+            while ( ( uint64_t ) std::chrono::duration_cast< std::chrono::nanoseconds >( Now - m_LastOp ).count() < Ns )
+            {
+               _mm_pause();
+               Now = std::chrono::steady_clock::now();
+            }
+         }
+
+         return m_LastOp = Now;
+      }
+
+      void StartSegment( size_t First, uint64_t BaseNs )
+      {
+         m_StatusAt = First;
+         m_BaseNs = BaseNs;
+         m_StatusSeen = false;
+         m_Started = m_LastOp;
+
+         for ( m_NextAction = First; ( m_NextAction < m_Records.size() ) && ( IsStatusRead( m_Records[ m_NextAction ] ) );
+               m_NextAction++ )
+         {
+         }
+      }
+
+      std::vector< EC_TRACE_RECORD_STRUCT >    m_Records;
+      std::vector< uint64_t >                  m_Times;               // when each record completed, from the start
+      size_t                                   m_NextAction = 0;      // the action that ends this segment
+      size_t                                   m_StatusAt = 0;        // the segment's next status read
+      uint64_t                                 m_BaseNs = 0;          // trace time of the action starting it
+      std::chrono::steady_clock::time_point    m_Started;
+      std::chrono::steady_clock::time_point    m_LastOp;
+      uint64_t                                 m_ReadNs = 0;          // typical bus time of a read
+      uint64_t                                 m_WriteNs = 0;
+      uint8_t                                  m_Status = 0;
+      bool                                     m_StatusSeen = false;
+};
+
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Wait policies - Until() polls Ready() and returns false when it gives up     */
+/*                                                                               */
+/*********************************************************************************/
+
+/*!\struct SpinWait
+ * \brief  Polls up to EC_HANDSHAKE_SPIN_COUNT times. Each status read is about a microsecond on the LPC bus.
+ */
+struct SpinWait
+{
+   template< typename Ready >
+   static EC_FORCEINLINE bool Until( Ready &&IsReady )
+   {
+      for ( uint32_t Count = EC_HANDSHAKE_SPIN_COUNT; Count > 0; Count-- )
+      {
+         if ( IsReady() )
+         {
+            return true;
+         }
+
+         _mm_pause();
+      }
+
+      return false;
+   }
+};
+
+/*!\struct SpinYieldWait
+ * \brief  Polls EC_SPIN_BEFORE_YIELD times, then yields between polls, up to EC_HANDSHAKE_SPIN_COUNT polls
+ */
+struct SpinYieldWait
+{
+   template< typename Ready >
+   static EC_FORCEINLINE bool Until( Ready &&IsReady )
+   {
+      for ( uint32_t Count = 0; Count < EC_HANDSHAKE_SPIN_COUNT; Count++ )
+      {
+         if ( IsReady() )
+         {
+            return true;
+         }
+
+         if ( Count < EC_SPIN_BEFORE_YIELD )
+             {
+                _mm_pause();
+             }
+         else
+             {
+                std::this_thread::yield();
+             }
+      }
+
+      return false;
+   }
+};
+
+/*!\struct SleepWait
+ * \brief  Polls EC_SLEEP_WAIT_TRIES times, BURST_SLEEP_PERIOD_MILLISECS apart - the library's original pacing.
+ *         Too slow for burst mode transfers of more than a byte or two.
+ */
+struct SleepWait
+{
+   template< typename Ready >
+   static bool Until( Ready &&IsReady )
+   {
+      for ( uint32_t Count = 0; Count < EC_SLEEP_WAIT_TRIES; Count++ )
+      {
+         if ( IsReady() )
+         {
+            return true;
+         }
+
+         std::this_thread::sleep_for( std::chrono::milliseconds( BURST_SLEEP_PERIOD_MILLISECS ) );
+      }
+
+      return false;
+   }
+};
+
+
+/*********************************************************************************/
+/*                                                                               */
+/*  Lock policies - Lock() returns false if the lock could not be taken          */
+/*                                                                               */
+/*********************************************************************************/
+
+struct NoLock
+{
+   static EC_FORCEINLINE bool Lock( void ) { return true; }
+   static EC_FORCEINLINE void Unlock( void ) {}
+};
+
+/*!\class ThreadLock
+ * \brief  Excludes the other threads of the process. Not recursive.
+ */
+class ThreadLock
+{
+   public:
+#if defined( _WIN32 )
+      bool Lock( void ) { AcquireSRWLockExclusive( &m_Lock ); return true; }
+      void Unlock( void ) { ReleaseSRWLockExclusive( &m_Lock ); }
+
+   private:
+      SRWLOCK      m_Lock = SRWLOCK_INIT;
+#else
+      bool Lock( void ) { m_Lock.lock(); return true; }
+      void Unlock( void ) { m_Lock.unlock(); }
+
+   private:
+      std::mutex   m_Lock;
+#endif
+};
+
+/*!\class ProcessLock
+ * \brief  Excludes every thread of every process using the same lock - a named mutex on Windows, an flock()ed
+ *         file elsewhere. Created on first use.
+ */
+class ProcessLock
+{
+   public:
+#if defined( _WIN32 )
+      bool Lock( void )
+      {
+         if ( m_Mutex == NULL )
+         {
+            HANDLE   Mutex = CreateMutexA( NULL, FALSE, EC_PROCESS_LOCK_NAME );
+
+            if ( ( Mutex == NULL ) ||
+                 ( InterlockedCompareExchangePointer( &m_Mutex, Mutex, NULL ) != NULL ) )
+            {
+               if ( Mutex != NULL )
+               {
+                  CloseHandle( Mutex );                   // another thread got there first
+               }
+            }
+         }
+
+         if ( m_Mutex != NULL )
+         {
+            DWORD   Wait = WaitForSingleObject( m_Mutex, INFINITE );
+
+            return ( Wait == WAIT_OBJECT_0 ) || ( Wait == WAIT_ABANDONED );   // abandoned still hands over ownership
+         }
+
+         return false;
+      }
+
+      void Unlock( void ) { ReleaseMutex( m_Mutex ); }
+
+   private:
+      PVOID volatile   m_Mutex = NULL;
+#else
+      bool Lock( void )
+      {
+         m_Threads.lock();                               // flock() does not exclude threads sharing the descriptor
+
+         if ( m_File < 0 )
+         {
+            m_File = open( EC_PROCESS_LOCK_PATH, O_RDWR | O_CREAT | O_CLOEXEC, 0666 );
+         }
+
+         if ( ( m_File >= 0 ) && ( flock( m_File, LOCK_EX ) == 0 ) )
+         {
+            return true;
+         }
+
+         m_Threads.unlock();
+         return false;
+      }
+
+      void Unlock( void )
+      {
+         flock( m_File, LOCK_UN );
+         m_Threads.unlock();
+      }
+
+   private:
+      std::mutex   m_Threads;
+      int          m_File = -1;
+#endif
+};
+
+
+/*!\class SharedLock
+ * \brief  One Locking shared by every driver instantiated with the same SharedLock, so drivers over different
+ *         port policies still exclude each other
+ */
+template< typename Locking >
+class SharedLock
+{
+   public:
+      EC_FORCEINLINE bool Lock( void ) { return s_Locking.Lock(); }
+      EC_FORCEINLINE void Unlock( void ) { s_Locking.Unlock(); }
+
+   private:
+      static inline Locking   s_Locking;
+};
+
+
+/*********************************************************************************/
+/*                                                                               */
+/*  The driver                                                                   */
+/*                                                                               */
+/*********************************************************************************/
+
+/*!\class EcDriver
+ * \brief  The ACPI EC 62/66 protocol. Every transfer is one burst under the lock.
+ */
+template< typename Ports, typename Wait, typename Locking >
+class EcDriver
+{
+   public:
+      Ports &GetPorts( void ) { return m_Ports; }
+
+      //
+      // holds the lock across several transfers - the ...Locked() calls need it held
+      //
+
+      bool Lock( void ) { return m_Locking.Lock(); }
+      void Unlock( void ) { m_Locking.Unlock(); }
+
+      //
+      // a single port read with no side effects on the EC, so it does not take the lock
+      //
+
+      EC_FORCEINLINE uint8_t Status( void ) { return m_Ports.In( ACPI_EC_CMND_REG ); }
+
+      //
+      // the counters are only changed with the lock held; a copy taken without it may be mid update
+      //
+
+      void GetStats( P_EC_TRANSACTION_STATS_STRUCT pStats ) const { *pStats = m_Stats; }
+
+      EC_FORCEINLINE WINSYS_ERROR ReadBlock( uint8_t Offset, uint8_t Count, puint8_t pData )
+      {
+         WINSYS_ERROR   Results;
+
+         if ( pData == NULL )
+         {
+            return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+         }
+
+         if ( !m_Locking.Lock() )
+         {
+            return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+         }
+
+         Results = ReadBlockLocked( Offset, Count, pData );
+         m_Locking.Unlock();
+
+         return Results;
+      }
+
+      EC_FORCEINLINE WINSYS_ERROR WriteBlock( uint8_t Offset, uint8_t Count, const uint8_t *pData )
+      {
+         WINSYS_ERROR   Results;
+
+         if ( pData == NULL )
+         {
+            return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+         }
+
+         if ( !m_Locking.Lock() )
+         {
+            return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+         }
+
+         Results = WriteBlockLocked( Offset, Count, pData );
+         m_Locking.Unlock();
+
+         return Results;
+      }
+
+      EC_FORCEINLINE WINSYS_ERROR ReadByte( uint8_t Offset, puint8_t pData ) { return ReadBlock( Offset, 1, pData ); }
+      EC_FORCEINLINE WINSYS_ERROR WriteByte( uint8_t Offset, uint8_t Value ) { return WriteBlock( Offset, 1, &Value ); }
+
+      //
+      // drains SCI query codes while Sci_Evt is set, until the EC returns a zero code or pCodes is full
+      //
+
+      WINSYS_ERROR QueryEvents( puint8_t pCodes, uint8_t MaxCodes, puint8_t pCount )
+      {
+         WINSYS_ERROR         Results = STATUS_SUCCESS;
+         ACPI_STATUS_UNION    StatusReg;
+
+         if ( ( pCodes == NULL ) || ( pCount == NULL ) )
+         {
+            return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NULL_POINTER );
+         }
+
+         *pCount = 0;
+
+         StatusReg.Byte = Status();
+         if ( StatusReg.Bits.Sci_Evt )
+         {
+            if ( !m_Locking.Lock() )
+            {
+               return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+            }
+
+            m_Stats.QueryBursts++;
+
+            if ( ( Results = BeginBurst() ) == STATUS_SUCCESS )
+            {
+               StatusReg.Byte = Status();
+
+               while ( ( StatusReg.Bits.Sci_Evt ) && ( *pCount < MaxCodes ) && ( Results == STATUS_SUCCESS ) )
+               {
+                  if ( ( Results = WaitInputEmpty() ) == STATUS_SUCCESS )
+                  {
+                     m_Ports.Out( ACPI_EC_CMND_REG, QUERY_EC_CMD );
+                     if ( ( Results = WaitOutputFull() ) == STATUS_SUCCESS )
+                     {
+                        uint8_t   Code = m_Ports.In( ACPI_EC_DATA_REG );
+
+                        if ( Code == 0 )
+                        {
+                           break;                                 // no more events queued in the EC
+                        }
+
+                        pCodes[ ( *pCount )++ ] = Code;
+                        StatusReg.Byte = Status();
+                     }
+                  }
+               }
+
+               EndBurst();
+            }
+
+            m_Locking.Unlock();
+         }
+
+         return Results;
+      }
+
+      //
+      // the EC's host IO space mapping of its SRAM - no handshake and no lock
+      //
+
+      EC_FORCEINLINE uint8_t ReadIoSpace( uint8_t Offset ) { return m_Ports.In( ( uint16_t )( EC_IO_PORT + Offset ) ); }
+      EC_FORCEINLINE void WriteIoSpace( uint8_t Offset, uint8_t Value ) { m_Ports.Out( ( uint16_t )( EC_IO_PORT + Offset ), Value ); }
+
+      //
+      // one burst, lock already held
+      //
+
+      EC_FORCEINLINE WINSYS_ERROR ReadBlockLocked( uint8_t Offset, uint8_t Count, puint8_t pData )
+      {
+         WINSYS_ERROR   Results;
+
+         if ( ( Results = BeginBurst() ) == STATUS_SUCCESS )
+         {
+            for ( uint8_t Index = 0; ( Index < Count ) && ( Results == STATUS_SUCCESS ); Index++ )
+            {
+               if ( ( Results = WaitInputEmpty() ) == STATUS_SUCCESS )
+               {
+                  m_Ports.Out( ACPI_EC_CMND_REG, READ_EC_CMD );
+                  if ( ( Results = WaitInputEmpty() ) == STATUS_SUCCESS )
+                  {
+                     m_Ports.Out( ACPI_EC_DATA_REG, ( uint8_t )( Offset + Index ) );
+                     if ( ( Results = WaitOutputFull() ) == STATUS_SUCCESS )
+                     {
+                        pData[ Index ] = m_Ports.In( ACPI_EC_DATA_REG );
+                     }
+                  }
+               }
+            }
+
+            EndBurst();
+         }
+
+         m_Stats.ReadBursts++;
+         m_Stats.BytesRead += ( Results == STATUS_SUCCESS ) ? Count : 0;
+
+         return Results;
+      }
+
+      EC_FORCEINLINE WINSYS_ERROR WriteBlockLocked( uint8_t Offset, uint8_t Count, const uint8_t *pData )
+      {
+         WINSYS_ERROR   Results;
+
+         if ( ( Results = BeginBurst() ) == STATUS_SUCCESS )
+         {
+            for ( uint8_t Index = 0; ( Index < Count ) && ( Results == STATUS_SUCCESS ); Index++ )
+            {
+               if ( ( Results = WaitInputEmpty() ) == STATUS_SUCCESS )
+               {
+                  m_Ports.Out( ACPI_EC_CMND_REG, WRITE_EC_CMD );
+                  if ( ( Results = WaitInputEmpty() ) == STATUS_SUCCESS )
+                  {
+                     m_Ports.Out( ACPI_EC_DATA_REG, ( uint8_t )( Offset + Index ) );
+                     if ( ( Results = WaitInputEmpty() ) == STATUS_SUCCESS )
+                     {
+                        m_Ports.Out( ACPI_EC_DATA_REG, pData[ Index ] );
+                     }
+                  }
+               }
+            }
+
+            EndBurst();
+         }
+
+         m_Stats.WriteBursts++;
+         m_Stats.BytesWritten += ( Results == STATUS_SUCCESS ) ? Count : 0;
+
+         return Results;
+      }
+
+   private:
+      EC_FORCEINLINE WINSYS_ERROR WaitInputEmpty( void )
+      {
+         ACPI_STATUS_UNION   StatusReg;
+
+         if ( Wait::Until( [ & ]() { StatusReg.Byte = Status(); return StatusReg.Bits.Ibf == 0; } ) )
+         {
+            return STATUS_SUCCESS;
+         }
+
+         m_Stats.IbfTimeouts++;
+         return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_IBF_TIMEOUT );
+      }
+
+      EC_FORCEINLINE bool OutputFull( void )
+      {
+         ACPI_STATUS_UNION   StatusReg;
+
+         return Wait::Until( [ & ]() { StatusReg.Byte = Status(); return StatusReg.Bits.Obf != 0; } );
+      }
+
+      EC_FORCEINLINE WINSYS_ERROR WaitOutputFull( void )
+      {
+         if ( OutputFull() )
+         {
+            return STATUS_SUCCESS;
+         }
+
+         m_Stats.ObfTimeouts++;
+         return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_OBF_TIMEOUT );
+      }
+
+      //
+      // the EC answers BURST_ENABLE_CMD by setting Burst and returning EC_BURST_ACK. The ack is always read, so it
+      // cannot be taken for the first data byte of the transaction; if it never comes, or is not EC_BURST_ACK,
+      // the burst failed and counts in BurstTimeouts rather than ObfTimeouts
+      //
+
+      EC_FORCEINLINE WINSYS_ERROR BeginBurst( void )
+      {
+         WINSYS_ERROR   Results;
+
+         if ( ( Results = WaitInputEmpty() ) == STATUS_SUCCESS )
+         {
+            m_Ports.Out( ACPI_EC_CMND_REG, BURST_ENABLE_CMD );
+
+            if ( ( OutputFull() == false ) || ( m_Ports.In( ACPI_EC_DATA_REG ) != EC_BURST_ACK ) )
+            {
+               m_Stats.BurstTimeouts++;
+               Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BURST_ACK_TIMEOUT );
+            }
+         }
+
+         return Results;
+      }
+
+      EC_FORCEINLINE void EndBurst( void )
+      {
+         if ( WaitInputEmpty() == STATUS_SUCCESS )
+         {
+            m_Ports.Out( ACPI_EC_CMND_REG, BURST_DISABLE_CMD );   // release the EC from burst mode
+         }
+      }
+
+      Ports                         m_Ports;
+      Locking                       m_Locking;
+      EC_TRANSACTION_STATS_STRUCT   m_Stats = {};
+};
+
+}  // namespace ite8528
+
+#endif      // #ifndef __ITE8528_EC_DRIVER_INC
@@ -0,0 +1,156 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Dual.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Sensor sweeps split across the ACPI and IO space paths
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_DUAL_INC
+#define __ITE8528_EC_DUAL_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The EC's SRAM can be read two ways: burst reads through the ACPI ports 0x62/0x66, paced by the IBF/OBF
+// handshake, and plain port reads of the IO space window at EC_IO_PORT, which need no handshake but may
+// tear a 16 bit register the EC is updating. The two do not share any port, so they can run at once.
+//
+// In dual mode SMP_QuerySensors() - and so the sampler - splits each sweep's bursts between the two: the
+// calling thread reads its share through ACPI while a helper thread reads the rest through the IO space
+// window, and the results are merged into the one sample. The split follows a cost model of each path -
+// burst setup and per byte time for ACPI, per byte time for the IO space, and the thread hand off - so a
+// sweep too small to gain stays on ACPI. IO space ranges are read until two reads agree, so they do not
+// tear.
+//
+// Whether the firmware tolerates both at once is board specific, so DUAL_SelfTest() must pass before
+// dual mode is used. It:
+//
+//    checks the IO space window reads the same SRAM as ACPI, using the smart fan and WDT registers as
+//    probes since they only change when written
+//    calibrates the cost model and times full sweeps on ACPI, on the IO space window and split
+//    reads the probes and every sensor through both paths at once, Iterations times, looking for ACPI
+//    failures that do not happen alone and probe reads that disagree
+//
+// and turns dual mode on only if nothing interfered and split sweeps are faster. If the ACPI share of a
+// split sweep fails, the sweep is read again on ACPI alone; after DUAL_MAX_FAILURES of those in a row dual
+// mode turns itself off.
+//
+
+/*!\enum _DUAL_MODE_ENUM_TYPE
+ * \brief  How sweeps are read
+ */
+typedef enum _DUAL_MODE_ENUM_TYPE {
+                                    DUAL_MODE_SINGLE = 0,          /*!<  ACPI bursts only, the default          */
+                                    DUAL_MODE_DUAL = 1,            /*!<  split across ACPI and IO space         */
+
+                                 } DUAL_MODE_ENUM_TYPE, *P_DUAL_MODE_ENUM_TYPE;
+
+/*!\enum _DUAL_FAULT_ENUM_TYPE
+ * \brief  Why dual mode was refused or dropped
+ */
+typedef enum _DUAL_FAULT_ENUM_TYPE {
+                                     DUAL_FAULT_NONE = 0,           /*!<  no fault                               */
+                                     DUAL_FAULT_ACPI = 1,           /*!<  ACPI reads failed on their own         */
+                                     DUAL_FAULT_WINDOW = 2,         /*!<  IO space does not read the same SRAM   */
+                                     DUAL_FAULT_INTERFERENCE = 3,   /*!<  the paths disturbed each other         */
+                                     DUAL_FAULT_NO_GAIN = 4,        /*!<  split sweeps were not faster           */
+                                     DUAL_FAULT_RUNTIME = 5,        /*!<  DUAL_MAX_FAILURES split sweeps failed  */
+
+                                  } DUAL_FAULT_ENUM_TYPE, *P_DUAL_FAULT_ENUM_TYPE;
+
+/*!\struct _DUAL_TEST_STRUCT
+ * \brief  The findings of DUAL_SelfTest()
+ */
+typedef struct _DUAL_TEST_STRUCT {
+                                    uint32_t     Fault;             /*!< DUAL_FAULT_ENUM_TYPE                     */
+                                    uint32_t     Enabled;           /*!< 1 = dual mode was turned on              */
+                                    uint32_t     Iterations;        /*!< rounds of each phase run                 */
+                                    uint32_t     AcpiErrorsAlone;   /*!< ACPI failures with the IO path idle      */
+                                    uint32_t     AcpiErrorsShared;  /*!< ACPI failures with both paths busy       */
+                                    uint32_t     Mismatches;        /*!< probe reads that disagreed               */
+                                    uint32_t     Tears;             /*!< IO space ranges that needed a reread     */
+                                    uint32_t     Reserved;
+                                    double       AcpiSweepUs;       /*!< mean full sweep on ACPI                  */
+                                    double       IoSweepUs;         /*!< mean full sweep on IO space              */
+                                    double       DualSweepUs;       /*!< mean full sweep split across both        */
+                                    double       AcpiBurstUs;       /*!< calibrated ACPI burst setup              */
+                                    double       AcpiByteUs;        /*!< calibrated ACPI time per byte            */
+                                    double       IoByteUs;          /*!< calibrated IO space time per byte        */
+                                    double       HandoffUs;         /*!< calibrated helper thread round trip      */
+
+                                 } DUAL_TEST_STRUCT, *P_DUAL_TEST_STRUCT;
+
+/*!\struct _DUAL_STATS_STRUCT
+ * \brief  Counters kept in dual mode, as returned by DUAL_GetStats()
+ */
+typedef struct _DUAL_STATS_STRUCT {
+                                     uint32_t     Mode;              /*!< DUAL_MODE_ENUM_TYPE                     */
+                                     uint32_t     Fault;             /*!< why dual mode was last dropped          */
+                                     uint64_t     SplitSweeps;       /*!< sweeps read across both paths           */
+                                     uint64_t     AcpiSweeps;        /*!< sweeps left on ACPI by the cost model   */
+                                     uint64_t     Retries;           /*!< split sweeps read again on ACPI         */
+                                     uint64_t     AcpiBytes;         /*!< bytes read through ACPI                 */
+                                     uint64_t     IoBytes;           /*!< bytes read through IO space             */
+                                     uint64_t     Tears;             /*!< IO space ranges that needed a reread    */
+                                     uint64_t     IoFallbacks;       /*!< IO space ranges read again on ACPI      */
+
+                                  } DUAL_STATS_STRUCT, *P_DUAL_STATS_STRUCT;
+
+#define DUAL_DEFAULT_ITERATIONS             200
+#define DUAL_MAX_FAILURES                   3       /*!< failed split sweeps in a row before dropping dual mode */
+#define DUAL_IO_READS                       4       /*!< most reads of an IO space range looking for two equal */
+#define DUAL_MIN_GAIN                       0.9     /*!< split sweeps must take at most this much of ACPI's    */
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     DUAL_SelfTest( uint32_t Iterations, P_DUAL_TEST_STRUCT pResult );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     DUAL_SetMode( uint32_t Mode );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     DUAL_GetStats( P_DUAL_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     DUAL_SelfTest( uint32_t Iterations, P_DUAL_TEST_STRUCT pResult );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     DUAL_SetMode( uint32_t Mode );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     DUAL_GetStats( P_DUAL_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     DUAL_SelfTest( uint32_t Iterations, P_DUAL_TEST_STRUCT pResult );
+__declspec( dllimport )    WINSYS_ERROR     DUAL_SetMode( uint32_t Mode );
+__declspec( dllimport )    WINSYS_ERROR     DUAL_GetStats( P_DUAL_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_DUAL_INC
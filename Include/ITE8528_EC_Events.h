@@ -0,0 +1,156 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Events.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      The definitions used to receive SCI events from the embedded
+//!            controller instead of polling the sensors
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_EVENTS_INC
+#define __ITE8528_EC_EVENTS_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The EC signals conditions to the host by setting Sci_Evt in the ACPI status register. The host then
+// issues QUERY_EC_CMD, and the EC returns a query code identifying the event. Query code values are
+// defined by the EC firmware, so the library maps them to event classes through a table that the
+// application fills in with EVT_MapQueryCode(). Unmapped codes are delivered as EVT_CLASS_UNKNOWN.
+//
+
+/*!\enum _EVT_CLASS_ENUM_TYPE
+ * \brief  The classes of events that callbacks may be registered for
+ */
+typedef enum _EVT_CLASS_ENUM_TYPE {
+                                     EVT_CLASS_UNKNOWN = 0,           /*!<  query code with no class mapping            */
+                                     EVT_CLASS_THERMAL_TRIP = 1,      /*!<  a temperature crossed an EC trip point      */
+                                     EVT_CLASS_FAN_FAULT = 2,         /*!<  the EC detected a fan failure               */
+                                     EVT_CLASS_WDT = 3,               /*!<  a WDT event, e.g. pre-timeout warning       */
+                                     EVT_CLASS_FALLBACK_POLL = 4,     /*!<  periodic fallback poll, no query code       */
+                                     EVT_CLASS_ALARM = 5,             /*!<  an ALRM_ rule was raised or cleared         */
+                                     EVT_CLASS_ANOMALY = 6,           /*!<  a STAT_ anomaly was raised or cleared       */
+                                     EVT_CLASS_GOVERNOR = 7,          /*!<  the GOV_ governor changed mode              */
+                                     EVT_CLASS_COUNT = 8,             /*!<  number of event classes                     */
+                                     EVT_CLASS_ALL = 0xff,            /*!<  register for every class                    */
+
+                                  } EVT_CLASS_ENUM_TYPE, *P_EVT_CLASS_ENUM_TYPE;
+
+/*!\struct _EC_EVENT_STRUCT
+ * \brief  An event as delivered to a registered callback
+ */
+typedef struct _EC_EVENT_STRUCT {
+                                   EVT_CLASS_ENUM_TYPE    Class;          /*!< class the query code is mapped to         */
+                                   uint8_t                QueryCode;      /*!< code returned by QUERY_EC_CMD, 0 for poll */
+                                   uint8_t                Param;          /*!< EVT_CLASS_ALARM: 1 raised, 0 cleared     */
+                                                                          /*!< EVT_CLASS_ANOMALY: kind, | 0x80 cleared  */
+                                                                          /*!< EVT_CLASS_GOVERNOR: the new mode          */
+                                   uint16_t               Id;             /*!< EVT_CLASS_ALARM: the rule id              */
+                                                                          /*!< EVT_CLASS_ANOMALY: the sensor             */
+                                                                          /*!< EVT_CLASS_GOVERNOR: the fail-safe reason  */
+                                   uint64_t               TimestampUs;    /*!< time the code was drained, in usecs       */
+
+                                } EC_EVENT_STRUCT, *P_EC_EVENT_STRUCT;
+
+/*!\struct _EVT_STATS_STRUCT
+ * \brief  Counters kept by the event subsystem
+ */
+typedef struct _EVT_STATS_STRUCT {
+                                    uint32_t     StatusReads;        /*!< cheap Sci_Evt checks of the status register */
+                                    uint32_t     DrainBursts;        /*!< bursts in which query codes were drained    */
+                                    uint32_t     EventsDispatched;   /*!< query codes delivered to callbacks          */
+                                    uint32_t     FallbackPolls;      /*!< fallback poll events delivered              */
+                                    uint32_t     QueueOverruns;      /*!< queued events dropped before being drained  */
+
+                                 } EVT_STATS_STRUCT, *P_EVT_STATS_STRUCT;
+
+//
+// event callbacks are called on the thread that drains the events - the EVT_Start() thread, or the caller of
+// EVT_Poll(). They must not call EVT_UnregisterCallback().
+//
+
+typedef void ( *EVT_CALLBACK )( P_EC_EVENT_STRUCT pEvent, PVOID pContext );
+
+#define EVT_MAX_CALLBACKS                   16      /*!< number of callback registrations supported         */
+#define EVT_MAX_QUERY_BURST                 32      /*!< most query codes drained in a single burst          */
+#define EVT_DEFAULT_WATCH_INTERVAL_MS       2       /*!< default period of the Sci_Evt status check          */
+#define EVT_DEFAULT_FALLBACK_POLL_MS        5000    /*!< default period of the fallback poll, 0 = disabled   */
+
+//
+// Besides the callbacks, every event is also queued for applications that run their own event loop. The
+// handle from EVT_GetNotifyHandle() is signalled while the queue holds events, and EVT_DrainEvents() empties it
+// in batches without blocking.
+//
+
+#define EVT_QUEUE_SIZE                      256     /*!< events held for EVT_DrainEvents, power of 2         */
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_MapQueryCode( uint8_t QueryCode, EVT_CLASS_ENUM_TYPE Class );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_RegisterCallback( EVT_CLASS_ENUM_TYPE Class, EVT_CALLBACK Callback, PVOID pContext, puint32_t pHandle );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_UnregisterCallback( uint32_t Handle );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_Poll( puint32_t pDispatched );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_Start( uint32_t WatchIntervalMs, uint32_t FallbackPollMs );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_Stop( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_GetNotifyHandle( HANDLE *pHandle );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_DrainEvents( P_EC_EVENT_STRUCT pEvents, uint32_t MaxEvents, puint32_t pCount );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EVT_GetStats( P_EVT_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_MapQueryCode( uint8_t QueryCode, EVT_CLASS_ENUM_TYPE Class );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_RegisterCallback( EVT_CLASS_ENUM_TYPE Class, EVT_CALLBACK Callback, PVOID pContext, puint32_t pHandle );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_UnregisterCallback( uint32_t Handle );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_Poll( puint32_t pDispatched );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_Start( uint32_t WatchIntervalMs, uint32_t FallbackPollMs );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_Stop( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_GetNotifyHandle( HANDLE *pHandle );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_DrainEvents( P_EC_EVENT_STRUCT pEvents, uint32_t MaxEvents, puint32_t pCount );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EVT_GetStats( P_EVT_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     EVT_MapQueryCode( uint8_t QueryCode, EVT_CLASS_ENUM_TYPE Class );
+__declspec( dllimport )    WINSYS_ERROR     EVT_RegisterCallback( EVT_CLASS_ENUM_TYPE Class, EVT_CALLBACK Callback, PVOID pContext, puint32_t pHandle );
+__declspec( dllimport )    WINSYS_ERROR     EVT_UnregisterCallback( uint32_t Handle );
+__declspec( dllimport )    WINSYS_ERROR     EVT_Poll( puint32_t pDispatched );
+__declspec( dllimport )    WINSYS_ERROR     EVT_Start( uint32_t WatchIntervalMs, uint32_t FallbackPollMs );
+__declspec( dllimport )    WINSYS_ERROR     EVT_Stop( void );
+__declspec( dllimport )    WINSYS_ERROR     EVT_GetNotifyHandle( HANDLE *pHandle );
+__declspec( dllimport )    WINSYS_ERROR     EVT_DrainEvents( P_EC_EVENT_STRUCT pEvents, uint32_t MaxEvents, puint32_t pCount );
+__declspec( dllimport )    WINSYS_ERROR     EVT_GetStats( P_EVT_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_EVENTS_INC
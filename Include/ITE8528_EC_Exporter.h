@@ -0,0 +1,101 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Exporter.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      OpenMetrics exporter for the EC readings and library counters
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_EXPORTER_INC
+#define __ITE8528_EC_EXPORTER_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The exporter serves the EC's readings to Prometheus style scrapers in the OpenMetrics text format, over HTTP on
+// 127.0.0.1:Port. GET /metrics returns the temperatures, the power rails, the fan RPM, the WDT state and the
+// library's EC transaction and sampler counters; anything else gets a 404 or 405.
+//
+// Scrapes never touch the EC. A refresh thread reads the WDT and collects the latest sample and the counters into a
+// snapshot every RefreshMs, and each scrape renders that snapshot into buffers owned by the worker thread answering
+// it - nothing is allocated after OMX_Start(). The sensors come from SMP_GetLatest(), so start the sampler (or the
+// daemon) as well; until it has taken a sample only the WDT and counters are published. ite8528_sample_timestamp_seconds
+// shows how old the readings are.
+//
+// OMX_WORKER_COUNT scrapes are answered at once; more connections wait in the listen backlog. A connection that
+// does not send its request within OMX_RECEIVE_TIMEOUT_MS is dropped.
+//
+
+/*!\struct _OMX_STATS_STRUCT
+ * \brief  Counters kept by the exporter, as returned by OMX_GetStats()
+ */
+typedef struct _OMX_STATS_STRUCT {
+                                    uint64_t     Scrapes;           /*!< GET /metrics answered                  */
+                                    uint64_t     Rejected;          /*!< other requests, answered 4xx           */
+                                    uint64_t     Errors;            /*!< dropped connections, full buffers   */
+                                    uint64_t     Refreshes;         /*!< snapshots taken                        */
+                                    uint64_t     RenderUs;          /*!< total usecs spent rendering            */
+                                    uint32_t     MaxRenderUs;       /*!< longest render                         */
+                                    uint32_t     LastBytes;         /*!< body size of the last scrape           */
+
+                                 } OMX_STATS_STRUCT, *P_OMX_STATS_STRUCT;
+
+#define OMX_DEFAULT_PORT                    9528    /*!< port served on 127.0.0.1                         */
+#define OMX_DEFAULT_REFRESH_MS              1000
+#define OMX_WORKER_COUNT                    8       /*!< scrapes answered at once                         */
+#define OMX_RECEIVE_TIMEOUT_MS              2000
+#define OMX_REQUEST_SIZE                    2048    /*!< longest request header accepted                  */
+#define OMX_BODY_SIZE                       8192    /*!< room for a rendered scrape                        */
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     OMX_Start( uint16_t Port, uint32_t RefreshMs );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     OMX_Stop( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     OMX_GetStats( P_OMX_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     OMX_Start( uint16_t Port, uint32_t RefreshMs );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     OMX_Stop( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     OMX_GetStats( P_OMX_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     OMX_Start( uint16_t Port, uint32_t RefreshMs );
+__declspec( dllimport )    WINSYS_ERROR     OMX_Stop( void );
+__declspec( dllimport )    WINSYS_ERROR     OMX_GetStats( P_OMX_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_EXPORTER_INC
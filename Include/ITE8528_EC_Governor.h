@@ -0,0 +1,203 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Governor.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Closed loop thermal governor driving the smart fan target
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_GOVERNOR_INC
+#define __ITE8528_EC_GOVERNOR_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The governor is an optional thread that takes over from the EC's own smart fan response. Every PeriodMs it
+// reads the selected temperatures and the fan in one sweep, runs a PID loop on the hottest temperature, and
+// drives one smart fan target register with the result:
+//
+//    output = bias + Kp * error + integral + Kd * d(temperature)/dt
+//
+// where error is the temperature less SetpointC, so positive gains raise the target as it gets hotter - use
+// negative gains if the firmware treats the register the other way round. The bias is the value the register
+// held when the governor started, so taking over does not kick the fan. The derivative is taken on the
+// temperature, not the error, so a setpoint change does not kick it either, and is smoothed by DerivativeAlpha.
+// Integration stops while the output is pinned at OutputMin or OutputMax in the direction it would push it
+// (conditional integration), so the loop does not wind up while the fan is already flat out.
+//
+// The output is only written when it has moved Deadband counts from the value last written, when it reaches
+// OutputMin or OutputMax, or every RefreshMs in case the firmware has reset the register - small wobbles cost
+// no EC traffic at all.
+//
+// GOV_SetOverride() holds the target at a fixed value while the loop keeps measuring; GOV_Resume() hands back
+// to the loop without a bump. The governor latches into fail-safe, writing FailsafeOutput, when:
+//
+//    MaxErrors EC reads or writes fail in a row
+//    the temperature reaches FailsafeTempC
+//    the fan stays below StallRpm for StallPeriods periods while the output is above OutputMin
+//    GOV_Failsafe() is called
+//
+// and stays there, overrides included, until GOV_Resume(). Every change of mode is posted to the event queue as
+// an EVT_CLASS_GOVERNOR event, whose Param is the new GOV_MODE_ENUM_TYPE and Id the GOV_FAILSAFE_ENUM_TYPE.
+//
+// The period is scheduled against absolute deadlines so it does not drift; how late each period started is
+// kept as the jitter statistics in GOV_STATUS_STRUCT.
+//
+// Include after ITE8528_EC_Sampler.h.
+//
+
+/*!\enum _GOV_MODE_ENUM_TYPE
+ * \brief  What is driving the target register
+ */
+typedef enum _GOV_MODE_ENUM_TYPE {
+                                   GOV_MODE_STOPPED = 0,         /*!<  the governor is not running                 */
+                                   GOV_MODE_AUTO = 1,            /*!<  the PID loop                                */
+                                   GOV_MODE_OVERRIDE = 2,        /*!<  the value given to GOV_SetOverride()        */
+                                   GOV_MODE_FAILSAFE = 3,        /*!<  FailsafeOutput, until GOV_Resume()          */
+
+                                } GOV_MODE_ENUM_TYPE, *P_GOV_MODE_ENUM_TYPE;
+
+/*!\enum _GOV_FAILSAFE_ENUM_TYPE
+ * \brief  Why the governor went to fail-safe
+ */
+typedef enum _GOV_FAILSAFE_ENUM_TYPE {
+                                       GOV_FAILSAFE_NONE = 0,         /*!<  not in fail-safe                       */
+                                       GOV_FAILSAFE_EC_ERRORS = 1,    /*!<  MaxErrors failures in a row            */
+                                       GOV_FAILSAFE_OVER_TEMP = 2,    /*!<  reached FailsafeTempC                  */
+                                       GOV_FAILSAFE_FAN_STALL = 3,    /*!<  below StallRpm for StallPeriods        */
+                                       GOV_FAILSAFE_FORCED = 4,       /*!<  GOV_Failsafe() was called              */
+
+                                    } GOV_FAILSAFE_ENUM_TYPE, *P_GOV_FAILSAFE_ENUM_TYPE;
+
+/*!\struct _GOV_CONFIG_STRUCT
+ * \brief  How the governor runs, as given to GOV_Start()
+ */
+typedef struct _GOV_CONFIG_STRUCT {
+                                     uint32_t     PeriodMs;          /*!< control period, GOV_MIN_PERIOD_MS up     */
+                                     uint32_t     InputMask;         /*!< SENSOR_CPU_TEMP and/or SENSOR_SYS_TEMP   */
+                                     uint8_t      Target;            /*!< GOV_TARGET_1 or GOV_TARGET_2             */
+                                     uint8_t      OutputMin;         /*!< lowest value written                     */
+                                     uint8_t      OutputMax;         /*!< highest value written                    */
+                                     uint8_t      Deadband;          /*!< counts moved before a write, 1 or more   */
+                                     uint8_t      FailsafeOutput;    /*!< written in fail-safe                     */
+                                     uint8_t      RestoreOnStop;     /*!< 1 = write the bias back on GOV_Stop()    */
+                                     uint16_t     StallRpm;          /*!< 0 = no stall check                       */
+                                     uint32_t     StallPeriods;      /*!< stalled periods before fail-safe         */
+                                     uint32_t     MaxErrors;         /*!< failures in a row before fail-safe       */
+                                     uint32_t     RefreshMs;         /*!< rewrite an unchanged output, 0 = never   */
+                                     uint32_t     Reserved;
+                                     double       SetpointC;         /*!< temperature held, degrees C              */
+                                     double       Kp;                /*!< counts per degree                        */
+                                     double       Ki;                /*!< counts per degree second                 */
+                                     double       Kd;                /*!< counts per degree per second             */
+                                     double       DerivativeAlpha;   /*!< derivative smoothing, 0 to 1, 1 = none   */
+                                     double       FailsafeTempC;     /*!< 0 = no over temperature check            */
+
+                                  } GOV_CONFIG_STRUCT, *P_GOV_CONFIG_STRUCT;
+
+/*!\struct _GOV_STATUS_STRUCT
+ * \brief  The state of the governor, as returned by GOV_GetStatus()
+ */
+typedef struct _GOV_STATUS_STRUCT {
+                                     uint32_t     Mode;              /*!< GOV_MODE_ENUM_TYPE                       */
+                                     uint32_t     FailsafeReason;    /*!< GOV_FAILSAFE_ENUM_TYPE                   */
+                                     uint64_t     Periods;           /*!< control periods run                      */
+                                     uint64_t     Writes;            /*!< target register writes                   */
+                                     uint64_t     Suppressed;        /*!< outputs not written, inside the deadband */
+                                     uint32_t     Errors;            /*!< EC reads and writes that failed          */
+                                     uint32_t     Overruns;          /*!< periods skipped because the loop was late */
+                                     double       TempC;             /*!< last temperature controlled              */
+                                     double       Demand;            /*!< last loop output before rounding         */
+                                     double       Integral;          /*!< integral term                            */
+                                     uint16_t     Rpm;               /*!< last fan speed                           */
+                                     uint8_t      Bias;              /*!< target register value at start           */
+                                     uint8_t      Output;            /*!< last value written                       */
+                                     int32_t      JitterLastUs;      /*!< lateness of the last period start        */
+                                     int32_t      JitterMinUs;       /*!< earliest period start                    */
+                                     int32_t      JitterMaxUs;       /*!< latest period start                      */
+                                     double       JitterMeanUs;      /*!< mean lateness                            */
+                                     double       JitterStdDevUs;    /*!< deviation of the lateness                */
+                                     uint32_t     LoopLastUs;        /*!< time the last period took                */
+                                     uint32_t     LoopMaxUs;         /*!< longest period                           */
+
+                                  } GOV_STATUS_STRUCT, *P_GOV_STATUS_STRUCT;
+
+#define GOV_TARGET_1                        1       /*!< drive SMART_FAN_TARGET_REG1_OFFSET               */
+#define GOV_TARGET_2                        2       /*!< drive SMART_FAN_TARGET_REG2_OFFSET               */
+#define GOV_MIN_PERIOD_MS                   10
+#define GOV_DEFAULT_PERIOD_MS               500
+#define GOV_DEFAULT_SETPOINT_C              70.0
+#define GOV_DEFAULT_KP                      4.0
+#define GOV_DEFAULT_KI                      0.2
+#define GOV_DEFAULT_KD                      0.0
+#define GOV_DEFAULT_DERIVATIVE_ALPHA        0.3
+#define GOV_DEFAULT_DEADBAND                2
+#define GOV_DEFAULT_REFRESH_MS              10000
+#define GOV_DEFAULT_MAX_ERRORS              4
+#define GOV_DEFAULT_FAILSAFE_TEMP_C         95.0
+#define GOV_DEFAULT_STALL_PERIODS           8
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     GOV_GetDefaultConfig( P_GOV_CONFIG_STRUCT pConfig );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     GOV_Start( P_GOV_CONFIG_STRUCT pConfig );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     GOV_Stop( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     GOV_SetOverride( uint8_t Output );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     GOV_Failsafe( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     GOV_Resume( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     GOV_GetStatus( P_GOV_STATUS_STRUCT pStatus );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     GOV_GetDefaultConfig( P_GOV_CONFIG_STRUCT pConfig );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     GOV_Start( P_GOV_CONFIG_STRUCT pConfig );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     GOV_Stop( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     GOV_SetOverride( uint8_t Output );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     GOV_Failsafe( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     GOV_Resume( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     GOV_GetStatus( P_GOV_STATUS_STRUCT pStatus );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     GOV_GetDefaultConfig( P_GOV_CONFIG_STRUCT pConfig );
+__declspec( dllimport )    WINSYS_ERROR     GOV_Start( P_GOV_CONFIG_STRUCT pConfig );
+__declspec( dllimport )    WINSYS_ERROR     GOV_Stop( void );
+__declspec( dllimport )    WINSYS_ERROR     GOV_SetOverride( uint8_t Output );
+__declspec( dllimport )    WINSYS_ERROR     GOV_Failsafe( void );
+__declspec( dllimport )    WINSYS_ERROR     GOV_Resume( void );
+__declspec( dllimport )    WINSYS_ERROR     GOV_GetStatus( P_GOV_STATUS_STRUCT pStatus );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_GOVERNOR_INC
@@ -0,0 +1,192 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_History.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Memory mapped circular sample history with delta of delta and
+//!            XOR varint compression
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_HISTORY_INC
+#define __ITE8528_EC_HISTORY_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The history file is a ring of fixed size blocks behind a file header, mapped into memory. Each block holds
+// the samples from one stretch of time:
+//
+//    HIST_BLOCK_HEADER_STRUCT   the first sample in full, and the commit word
+//    payload                    one record per later sample -
+//                                  control varint    bit 0 = a timestamp delta of delta follows,
+//                                                    bit 1 + n = sensor n's reading changed
+//                                  [ zigzag varint ] change in the sampling interval, in msecs
+//                                  [ varint ... ]    new reading XOR old reading, per changed sensor
+//
+// A steady 1 Hz sample with no change is a single 0 byte, and the control stays one byte while only the
+// interval and sensors 0-5 change. Every sample in a block has the same ValidMask - a
+// sample with a different mask starts a new block.
+//
+// Appending writes the record first and then publishes it with one aligned 32 bit store of the commit word
+// (sample count and payload bytes), so a crash at any point leaves the block decodable up to the last whole
+// sample. A block is started by clearing its sequence number, filling in the header and checksum, and then
+// setting the sequence number; on open, blocks whose checksum does not match are ignored.
+//
+// Blocks may be read in place with HIST_GetBlock() and decoded with HIST_DecodeBlock(). The writer reuses the
+// oldest block when the ring is full, so a reader holding a block should check that its Sequence has not
+// changed after decoding it.
+//
+
+#define HIST_BLOCK_SIZE                     4096      /*!< bytes per block, including its header          */
+#define HIST_DEFAULT_BLOCKS                 1024      /*!< about 4 weeks of 1 Hz samples of 7 sensors      */
+#define HIST_MAGIC                          0x53484345   /*!< "ECHS"                                       */
+#define HIST_VERSION                        2
+
+/*!\struct _HIST_FILE_HEADER_STRUCT
+ * \brief  The start of the history file. The file header takes one block.
+ */
+typedef struct _HIST_FILE_HEADER_STRUCT {
+                                           uint32_t     Magic;            /*!< HIST_MAGIC                       */
+                                           uint32_t     Version;          /*!< HIST_VERSION                     */
+                                           uint32_t     BlockSize;        /*!< HIST_BLOCK_SIZE                  */
+                                           uint32_t     BlockCount;       /*!< blocks in the ring               */
+                                           uint32_t     Reserved[ 3 ];
+                                           uint32_t     Checksum;         /*!< FNV-1a of the fields above       */
+
+                                        } HIST_FILE_HEADER_STRUCT, *P_HIST_FILE_HEADER_STRUCT;
+
+/*!\struct _HIST_BLOCK_HEADER_STRUCT
+ * \brief  The start of every block
+ */
+typedef struct _HIST_BLOCK_HEADER_STRUCT {
+                                            uint64_t     Sequence;        /*!< 0 = empty, else order written    */
+                                            uint64_t     FirstMs;         /*!< timestamp of the first sample    */
+                                            uint64_t     LastMs;          /*!< of the last sample, 0 while open */
+                                            uint32_t     Commit;          /*!< samples << 16 | payload bytes    */
+                                            uint32_t     Checksum;        /*!< FNV-1a of Sequence, FirstMs,     */
+                                                                          /*!< ValidMask and Base               */
+                                            uint16_t     ValidMask;       /*!< sensors in every sample          */
+                                            uint16_t     Base[ EC_SENSOR_MAX ];   /*!< the first sample          */
+                                            uint8_t      Reserved[ 14 ];
+
+                                         } HIST_BLOCK_HEADER_STRUCT, *P_HIST_BLOCK_HEADER_STRUCT;
+
+#define HIST_PAYLOAD_SIZE                   ( HIST_BLOCK_SIZE - sizeof( HIST_BLOCK_HEADER_STRUCT ) )
+#define HIST_COMMIT_SAMPLES( Commit )       ( ( Commit ) >> 16 )
+#define HIST_COMMIT_BYTES( Commit )         ( ( Commit ) & 0xffff )
+
+/*!\struct _HIST_STATS_STRUCT
+ * \brief  Size and span of the history
+ */
+typedef struct _HIST_STATS_STRUCT {
+                                     uint32_t     BlockCount;         /*!< blocks in the ring                  */
+                                     uint32_t     BlocksUsed;         /*!< blocks holding samples              */
+                                     uint64_t     Samples;            /*!< samples held                        */
+                                     uint64_t     Bytes;              /*!< block headers + payload in use      */
+                                     uint32_t     BytesPerSampleX100; /*!< Bytes / Samples x 100               */
+                                     uint32_t     Reserved;
+                                     uint64_t     OldestMs;           /*!< timestamp of the oldest sample      */
+                                     uint64_t     NewestMs;           /*!< timestamp of the newest sample      */
+
+                                  } HIST_STATS_STRUCT, *P_HIST_STATS_STRUCT;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Rollups summarise the history at coarser resolutions so that long range queries do not decode every
+// sample. Each level is a ring of fixed time buckets updated as samples are appended - adding a sample costs
+// the same at every level, whatever the bucket width. The rollups live in memory and are rebuilt from the
+// history file by HIST_Open().
+//
+//    level    bucket    buckets    span
+//      0       10 s       8640     1 day
+//      1        1 min     4320     3 days
+//      2       10 min     4320     30 days
+//      3        1 h       4392     6 months
+//
+
+#define HIST_ROLLUP_LEVELS                  4
+
+/*!\struct _HIST_POINT_STRUCT
+ * \brief  One rollup bucket. Readings are in raw units, as in EC_SAMPLE_STRUCT.
+ */
+typedef struct _HIST_POINT_STRUCT {
+                                     uint64_t     StartMs;            /*!< start of the bucket, UTC msecs      */
+                                     uint32_t     Samples;            /*!< samples in the bucket               */
+                                     uint16_t     ValidMask;          /*!< sensors seen in the bucket          */
+                                     uint16_t     Reserved;
+                                     uint16_t     Min[ EC_SENSOR_MAX ];   /*!< lowest reading                  */
+                                     uint16_t     Max[ EC_SENSOR_MAX ];   /*!< highest reading                 */
+                                     uint16_t     Mean[ EC_SENSOR_MAX ];  /*!< mean reading, rounded           */
+
+                                  } HIST_POINT_STRUCT, *P_HIST_POINT_STRUCT;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_Open( const char *pPath, uint32_t BlockCount );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_Close( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_Append( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_Flush( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_Query( uint64_t StartMs, uint64_t EndMs, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_QueryRollup( uint64_t StartMs, uint64_t EndMs, uint32_t MaxPoints, P_HIST_POINT_STRUCT pPoints, puint32_t pCount, puint32_t pResolutionMs );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_GetBlock( uint32_t Index, const void **ppBlock, puint32_t pBytes );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_DecodeBlock( const void *pBlock, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     HIST_GetStats( P_HIST_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_Open( const char *pPath, uint32_t BlockCount );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_Close( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_Append( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_Flush( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_Query( uint64_t StartMs, uint64_t EndMs, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_QueryRollup( uint64_t StartMs, uint64_t EndMs, uint32_t MaxPoints, P_HIST_POINT_STRUCT pPoints, puint32_t pCount, puint32_t pResolutionMs );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_GetBlock( uint32_t Index, const void **ppBlock, puint32_t pBytes );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_DecodeBlock( const void *pBlock, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     HIST_GetStats( P_HIST_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     HIST_Open( const char *pPath, uint32_t BlockCount );
+__declspec( dllimport )    WINSYS_ERROR     HIST_Close( void );
+__declspec( dllimport )    WINSYS_ERROR     HIST_Append( P_EC_SAMPLE_STRUCT pSample );
+__declspec( dllimport )    WINSYS_ERROR     HIST_Flush( void );
+__declspec( dllimport )    WINSYS_ERROR     HIST_Query( uint64_t StartMs, uint64_t EndMs, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+__declspec( dllimport )    WINSYS_ERROR     HIST_QueryRollup( uint64_t StartMs, uint64_t EndMs, uint32_t MaxPoints, P_HIST_POINT_STRUCT pPoints, puint32_t pCount, puint32_t pResolutionMs );
+__declspec( dllimport )    WINSYS_ERROR     HIST_GetBlock( uint32_t Index, const void **ppBlock, puint32_t pBytes );
+__declspec( dllimport )    WINSYS_ERROR     HIST_DecodeBlock( const void *pBlock, P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+__declspec( dllimport )    WINSYS_ERROR     HIST_GetStats( P_HIST_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_HISTORY_INC
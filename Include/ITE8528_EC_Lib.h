@@ -133,6 +133,41 @@ typedef enum _WDT_MODE_ENUM_TYPE {
 
                                  } WDT_MODE_ENUM_TYPE, *P_WDT_MODE_ENUM_TYPE;
 
+/*!\struct _WDT_STATUS_STRUCT
+ * \brief  The live state of the WDT as read back from the EC. The EC counts the active counter register down, so
+ *         the counter values are the time left before the WDT fires, to the resolution of the active mode
+ */
+typedef struct _WDT_STATUS_STRUCT {
+                                     uint8_t              Enabled;        /*!< 1 = WDT is enabled and counting down      */
+                                     WDT_MODE_ENUM_TYPE   Mode;           /*!< countdown mode from the config register   */
+                                     uint8_t              Minutes;        /*!< raw minutes counter register              */
+                                     uint8_t              Seconds;        /*!< raw seconds counter register              */
+                                     uint32_t             RemainingMs;    /*!< worst case (lowest) time left, in msecs   */
+
+                                  } WDT_STATUS_STRUCT, *P_WDT_STATUS_STRUCT;
+
+/*!\struct _WDT_PET_POLICY_STRUCT
+ * \brief  State for the adaptive WDT petting policy. The caller fills in the reload values and safety margin with
+ *         WDT_InitPetPolicy(), then calls WDT_ServicePetPolicy() each time the returned check interval expires. The
+ *         WDT is only petted when the time left drops to the safety margin plus the measured EC latencies.
+ */
+typedef struct _WDT_PET_POLICY_STRUCT {
+                                          uint8_t      ReloadMinutes;      /*!< minutes value written on each pet           */
+                                          uint8_t      ReloadSeconds;      /*!< seconds value written on each pet           */
+                                          uint32_t     SafetyMarginMs;     /*!< time left at which the WDT must be petted   */
+                                          uint32_t     MaxCheckIntervalMs; /*!< upper bound on the returned check interval  */
+
+                                          uint32_t     PetLatencyUs;       /*!< decaying worst case pet latency             */
+                                          uint32_t     ReadLatencyUs;      /*!< decaying worst case status read latency     */
+                                          uint32_t     PetCount;           /*!< number of pets issued by the policy         */
+                                          uint32_t     CheckCount;         /*!< number of status reads made by the policy   */
+
+                                      } WDT_PET_POLICY_STRUCT, *P_WDT_PET_POLICY_STRUCT;
+
+#define WDT_POLICY_MIN_CHECK_INTERVAL_MS    10         /*!< never ask the caller to check back sooner than this        */
+#define WDT_POLICY_DEFAULT_MAX_CHECK_MS     60000      /*!< default upper bound on the policy's check interval         */
+#define WDT_POLICY_ERROR_RETRY_MS           250        /*!< check interval after a status read fails                   */
+
 /////////////////////////////
 //
 // the fan control
@@ -145,6 +180,20 @@ typedef enum _WDT_MODE_ENUM_TYPE {
 #define SMART_FAN_TARGET_REG2_OFFSET        0x18       // Smart Fan Target Reg 2
 #define SMART_FAN_TOLERANCE_OFFSET          0x18       // Smart Fan Tolerance Reg
 
+#define FAN_TACH_CLOCK                      1350000    // RPM = FAN_TACH_CLOCK / tach count
+
+/*!\struct _FAN_SMART_CONFIG_STRUCT
+ * \brief  The smart fan registers, SMART_FAN_CFG_OFFSET through SMART_FAN_TARGET_REG2_OFFSET. The firmware
+ *         header gives SMART_FAN_TOLERANCE_OFFSET the same offset as target 2, so the tolerance is not a
+ *         separate field - Target2 is that byte.
+ */
+typedef struct _FAN_SMART_CONFIG_STRUCT {
+                                           uint8_t      Config;         /*!< SMART_FAN_CFG_OFFSET          */
+                                           uint8_t      Target1;        /*!< SMART_FAN_TARGET_REG1_OFFSET  */
+                                           uint8_t      Target2;        /*!< SMART_FAN_TARGET_REG2_OFFSET, also the tolerance */
+
+                                        } FAN_SMART_CONFIG_STRUCT, *P_FAN_SMART_CONFIG_STRUCT;
+
 /////////////////////////////
 //
 // the voltage sensor
@@ -164,6 +213,19 @@ typedef enum _WDT_MODE_ENUM_TYPE {
 #define V3P3_SCALE_FACTOR                   5.8651
 #define V5_SCALE_FACTOR                     9.38416
 #define V12_SCALE_FACTOR                    19.3548
+#define VDIMM_SCALE_FACTOR                  VCORE_SCALE_FACTOR    // same 3V range as VCore
+
+//
+// the scale factors above x 65536, rounded - millivolts = ( raw x SCALE_Q16 + 0x8000 ) >> 16
+//
+
+#define VCORE_SCALE_Q16                     192188
+#define V3P3_SCALE_Q16                      384375
+#define V5_SCALE_Q16                        615000
+#define V12_SCALE_Q16                       1268436
+#define VDIMM_SCALE_Q16                     VCORE_SCALE_Q16
+#define TEMP_SCALE_Q16                      ( 1000 << 16 )    // degrees to millidegrees
+#define FAN_SCALE_Q16                       ( 1000 << 16 )    // RPM to milli-RPM
 
 
 
@@ -187,6 +249,64 @@ typedef enum _WDT_MODE_ENUM_TYPE {
 
 #define BURST_SLEEP_PERIOD_MILLISECS        1       //50
 
+//
+// Block transfers stay in burst mode for the whole transfer and poll the status register for the IBF/OBF
+// handshake instead of sleeping, so that consecutive bytes fit inside the EC's burst timing. Each status read
+// is roughly a microsecond on the LPC bus.
+//
+
+#define EC_HANDSHAKE_SPIN_COUNT             10000   /*!< status reads before an IBF/OBF wait gives up */
+
+/*!\struct _EC_TRANSACTION_STATS_STRUCT
+ * \brief  Counters of the ACPI transactions made by the driver, as returned by EC_GetTransactionStats(). Each burst
+ *         is one transaction, however many bytes it moves.
+ */
+typedef struct _EC_TRANSACTION_STATS_STRUCT {
+                                               uint64_t     ReadBursts;        /*!< read transactions                   */
+                                               uint64_t     WriteBursts;       /*!< write transactions                  */
+                                               uint64_t     QueryBursts;       /*!< SCI query code drains               */
+                                               uint64_t     BytesRead;         /*!< bytes read by transactions that ok'd */
+                                               uint64_t     BytesWritten;      /*!< bytes written by ones that ok'd     */
+                                               uint32_t     IbfTimeouts;       /*!< STATUS_IBF_TIMEOUT failures         */
+                                               uint32_t     ObfTimeouts;       /*!< STATUS_OBF_TIMEOUT failures         */
+                                               uint32_t     BurstTimeouts;     /*!< STATUS_BURST_ACK_TIMEOUT failures   */
+                                               uint32_t     Reserved;
+
+                                            } EC_TRANSACTION_STATS_STRUCT, *P_EC_TRANSACTION_STATS_STRUCT;
+
+//
+// EC_StartRecording() captures every port operation the driver makes to a trace file: an EC_TRACE_HEADER_STRUCT,
+// then one EC_TRACE_RECORD_STRUCT per operation, little endian. ite8528::ReplayPorts in ITE8528_EC_Driver.h plays
+// a trace back, answering the driver the way the EC did and as slowly as it did.
+//
+
+#define EC_TRACE_MAGIC                      0x52544345    /*!< "ECTR"                                     */
+#define EC_TRACE_VERSION                    1
+#define EC_TRACE_IN                         0             /*!< EC_TRACE_RECORD_STRUCT Op, a port read     */
+#define EC_TRACE_OUT                        1             /*!< a port write                               */
+
+/*!\struct _EC_TRACE_HEADER_STRUCT
+ * \brief  Starts a trace file
+ */
+typedef struct _EC_TRACE_HEADER_STRUCT {
+                                          uint32_t     Magic;             /*!< EC_TRACE_MAGIC                      */
+                                          uint16_t     Version;           /*!< EC_TRACE_VERSION                    */
+                                          uint16_t     RecordBytes;       /*!< sizeof( EC_TRACE_RECORD_STRUCT )    */
+
+                                       } EC_TRACE_HEADER_STRUCT, *P_EC_TRACE_HEADER_STRUCT;
+
+/*!\struct _EC_TRACE_RECORD_STRUCT
+ * \brief  One port operation in a trace file
+ */
+typedef struct _EC_TRACE_RECORD_STRUCT {
+                                          uint32_t     DeltaNs;           /*!< nsecs since the previous operation
+                                                                               completed, saturating at 0xFFFFFFFF */
+                                          uint16_t     Port;
+                                          uint8_t      Op;                /*!< EC_TRACE_IN or EC_TRACE_OUT         */
+                                          uint8_t      Value;             /*!< byte read or written                */
+
+                                       } EC_TRACE_RECORD_STRUCT, *P_EC_TRACE_RECORD_STRUCT;
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -204,6 +324,13 @@ extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_WriteByteUsingACPI( uin
 extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_ReadByteUsingACPI( uint8_t Offset, puint8_t pData );
 extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_WriteByteUsingIOSpace( uint8_t Offset, uint8_t Value );
 extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_ReadByteUsingIOSpace( uint8_t Offset, puint8_t pData );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_ReadBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_WriteBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_GetStatusUsingACPI( puint8_t pStatus );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_QueryEventsUsingACPI( puint8_t pCodes, uint8_t MaxCodes, puint8_t pCount );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_GetTransactionStats( P_EC_TRANSACTION_STATS_STRUCT pStats );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_StartRecording( const char *pPath );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     EC_StopRecording( puint64_t pRecords );
 
 extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_Disable( void );
 extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_Enable( void );
@@ -211,6 +338,9 @@ extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_Start( WDT_MODE_ENUM_T
 extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_SetSecondsCounter( uint8_t Secs );
 extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_SetMinutesCounter( uint8_t Mins );
 extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_PetTimer( uint8_t Mins, uint8_t Secs );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_GetStatus( P_WDT_STATUS_STRUCT pStatus );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_InitPetPolicy( P_WDT_PET_POLICY_STRUCT pPolicy, uint8_t Mins, uint8_t Secs, uint32_t SafetyMarginMs );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WDT_ServicePetPolicy( P_WDT_PET_POLICY_STRUCT pPolicy, puint32_t pNextCheckMs );
 
 
 extern "C" __declspec( dllexport )   WINSYS_ERROR     PWR_GetDimmV( pdouble_t pVolts );
@@ -222,6 +352,10 @@ extern "C" __declspec( dllexport )   WINSYS_ERROR     PWR_GetVCore( pdouble_t pV
 extern "C" __declspec( dllexport )   WINSYS_ERROR     TEMP_GetCPU( puint8_t pTemp );
 extern "C" __declspec( dllexport )   WINSYS_ERROR     TEMP_GetSYS( puint8_t pTemp );
 
+extern "C" __declspec( dllexport )   WINSYS_ERROR     FAN_GetCPU( puint16_t pRpm );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     FAN_GetSmartConfig( P_FAN_SMART_CONFIG_STRUCT pConfig );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     FAN_SetSmartConfig( P_FAN_SMART_CONFIG_STRUCT pConfig );
+
 #else
 //
 // Applications using the DLL need to import the DLL functions using the prototypes below. Also note
@@ -237,6 +371,13 @@ extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_WriteByteUsingACPI( ui
 extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_ReadByteUsingACPI( uint8_t Offset, puint8_t pData );
 extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_WriteByteUsingIOSpace( uint8_t Offset, uint8_t Value );
 extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_ReadByteUsingIOSpace( uint8_t Offset, puint8_t pData );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_ReadBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_WriteBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_GetStatusUsingACPI( puint8_t pStatus );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_QueryEventsUsingACPI( puint8_t pCodes, uint8_t MaxCodes, puint8_t pCount );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_GetTransactionStats( P_EC_TRANSACTION_STATS_STRUCT pStats );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_StartRecording( const char *pPath );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     EC_StopRecording( puint64_t pRecords );
 
 extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_Disable( void );
 extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_Enable( void );
@@ -244,6 +385,9 @@ extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_Start( WDT_MODE_ENUM_
 extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_SetSecondsCounter( uint8_t Secs );
 extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_SetMinutesCounter( uint8_t Mins );
 extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_PetTimer( uint8_t Mins, uint8_t Secs );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_GetStatus( P_WDT_STATUS_STRUCT pStatus );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_InitPetPolicy( P_WDT_PET_POLICY_STRUCT pPolicy, uint8_t Mins, uint8_t Secs, uint32_t SafetyMarginMs );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WDT_ServicePetPolicy( P_WDT_PET_POLICY_STRUCT pPolicy, puint32_t pNextCheckMs );
 
 extern "C" __declspec( dllimport )    WINSYS_ERROR     PWR_GetDimmV( pdouble_t pVolts );
 extern "C" __declspec( dllimport )    WINSYS_ERROR     PWR_Get12V( pdouble_t pVolts );
@@ -254,12 +398,23 @@ extern "C" __declspec( dllimport )    WINSYS_ERROR     PWR_GetVCore( pdouble_t p
 extern "C" __declspec( dllimport )    WINSYS_ERROR     TEMP_GetCPU( puint8_t pTemp );
 extern "C" __declspec( dllimport )    WINSYS_ERROR     TEMP_GetSYS( puint8_t pTemp );
 
+extern "C" __declspec( dllimport )    WINSYS_ERROR     FAN_GetCPU( puint16_t pRpm );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     FAN_GetSmartConfig( P_FAN_SMART_CONFIG_STRUCT pConfig );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     FAN_SetSmartConfig( P_FAN_SMART_CONFIG_STRUCT pConfig );
+
 #else
 
 __declspec( dllimport )    WINSYS_ERROR     EC_WriteByteUsingACPI( uint8_t Offset, uint8_t Value );
 __declspec( dllimport )    WINSYS_ERROR     EC_ReadByteUsingACPI( uint8_t Offset, puint8_t pData );
 __declspec( dllimport )    WINSYS_ERROR     EC_WriteByteUsingIOSpace( uint8_t Offset, uint8_t Value );
 __declspec( dllimport )    WINSYS_ERROR     EC_ReadByteUsingIOSpace( uint8_t Offset, puint8_t pData );
+__declspec( dllimport )    WINSYS_ERROR     EC_ReadBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData );
+__declspec( dllimport )    WINSYS_ERROR     EC_WriteBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData );
+__declspec( dllimport )    WINSYS_ERROR     EC_GetStatusUsingACPI( puint8_t pStatus );
+__declspec( dllimport )    WINSYS_ERROR     EC_QueryEventsUsingACPI( puint8_t pCodes, uint8_t MaxCodes, puint8_t pCount );
+__declspec( dllimport )    WINSYS_ERROR     EC_GetTransactionStats( P_EC_TRANSACTION_STATS_STRUCT pStats );
+__declspec( dllimport )    WINSYS_ERROR     EC_StartRecording( const char *pPath );
+__declspec( dllimport )    WINSYS_ERROR     EC_StopRecording( puint64_t pRecords );
 
 __declspec( dllimport )    WINSYS_ERROR     WDT_Disable( void );
 __declspec( dllimport )    WINSYS_ERROR     WDT_Enable( void );
@@ -267,6 +422,9 @@ __declspec( dllimport )    WINSYS_ERROR     WDT_Start( WDT_MODE_ENUM_TYPE Mode )
 __declspec( dllimport )    WINSYS_ERROR     WDT_SetSecondsCounter( uint8_t Secs );
 __declspec( dllimport )    WINSYS_ERROR     WDT_SetMinutesCounter( uint8_t Mins );
 __declspec( dllimport )    WINSYS_ERROR     WDT_PetTimer( uint8_t Mins, uint8_t Secs );
+__declspec( dllimport )    WINSYS_ERROR     WDT_GetStatus( P_WDT_STATUS_STRUCT pStatus );
+__declspec( dllimport )    WINSYS_ERROR     WDT_InitPetPolicy( P_WDT_PET_POLICY_STRUCT pPolicy, uint8_t Mins, uint8_t Secs, uint32_t SafetyMarginMs );
+__declspec( dllimport )    WINSYS_ERROR     WDT_ServicePetPolicy( P_WDT_PET_POLICY_STRUCT pPolicy, puint32_t pNextCheckMs );
 
 
 __declspec( dllimport )    WINSYS_ERROR     PWR_GetDimmV( pdouble_t pVolts );
@@ -278,6 +436,10 @@ __declspec( dllimport )    WINSYS_ERROR     PWR_GetVCore( pdouble_t pVolts );
 __declspec( dllimport )    WINSYS_ERROR     TEMP_GetCPU( puint8_t pTemp );
 __declspec( dllimport )    WINSYS_ERROR     TEMP_GetSYS( puint8_t pTemp );
 
+__declspec( dllimport )    WINSYS_ERROR     FAN_GetCPU( puint16_t pRpm );
+__declspec( dllimport )    WINSYS_ERROR     FAN_GetSmartConfig( P_FAN_SMART_CONFIG_STRUCT pConfig );
+__declspec( dllimport )    WINSYS_ERROR     FAN_SetSmartConfig( P_FAN_SMART_CONFIG_STRUCT pConfig );
+
 #endif
 
 #endif      // #ifdef _DLL_BUILD
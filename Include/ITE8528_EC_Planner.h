@@ -0,0 +1,125 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Planner.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Sensor polling planner - merges per consumer rates into shared
+//!            burst sweeps
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_PLANNER_INC
+#define __ITE8528_EC_PLANNER_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Consumers register the sensors they want and how often. The planner reads each sensor at the fastest rate any
+// consumer asked for, with every period rounded to PLAN_TICK_QUANTUM_MS and every read aligned to a multiple
+// of its period, so reads of different sensors fall on common ticks. The sensors due on a tick are read as one
+// sweep, with SMP_BLOCK_MERGE_GAP merging, and published through the sampler ring - see SMP_StartPlanned().
+// Samples from a planned sampler only hold the sensors due on their tick, so check ValidMask.
+//
+// A sensor may instead be sampled adaptively with PLAN_SetAdaptive(). Its period then moves between a minimum
+// and a maximum, doubling each time the reading has stayed within a deadband for a number of reads, and
+// dropping at once - to the period at which the reading would move by about the deadband - when it changes
+// faster. Nearing a configured threshold forces the minimum period. Adaptive periods are the minimum times a
+// power of 2, so adaptive sensors still share ticks with each other and with the fixed rate ones. An adaptive
+// sensor is never read slower than the fastest consumer registered for it.
+//
+// PLAN_GetStats() compares the plan with each consumer polling its own sensors a byte at a time, as the TEMP_
+// and PWR_ functions do.
+//
+
+#define PLAN_MAX_CONSUMERS                  32
+#define PLAN_TICK_QUANTUM_MS                10         /*!< periods are rounded to a multiple of this          */
+#define PLAN_MAX_HYPERPERIOD_MS             3600000    /*!< the plan statistics cover at most this long a cycle */
+
+#define PLAN_ADAPT_DEFAULT_STABLE_READS     4          /*!< stable reads before backing off, if 0 is given     */
+
+/*!\struct _PLAN_ADAPT_STRUCT
+ * \brief  Adaptive sampling bounds for one sensor. Deadband, Threshold and Margin are in the sensor's raw units.
+ */
+typedef struct _PLAN_ADAPT_STRUCT {
+                                     uint32_t     MinPeriodMs;         /*!< fastest rate, while changing or near Threshold */
+                                     uint32_t     MaxPeriodMs;         /*!< slowest rate, while stable                 */
+                                     uint16_t     Deadband;            /*!< change that still counts as stable         */
+                                     uint16_t     StableReads;         /*!< stable reads before the period doubles     */
+                                     uint16_t     Threshold;           /*!< reading to watch for, 0 = none             */
+                                     uint16_t     Margin;              /*!< within this of Threshold = MinPeriodMs     */
+
+                                  } PLAN_ADAPT_STRUCT, *P_PLAN_ADAPT_STRUCT;
+
+/*!\struct _PLAN_STATS_STRUCT
+ * \brief  The current plan, and what it saves
+ */
+typedef struct _PLAN_STATS_STRUCT {
+                                     uint32_t     Consumers;           /*!< registered consumers                      */
+                                     uint32_t     SensorMask;          /*!< sensors read by the plan                  */
+                                     uint32_t     TickMs;              /*!< GCD of the sensor periods                 */
+                                     uint32_t     HyperperiodMs;       /*!< LCM of the sensor periods - the plan repeats */
+                                     uint32_t     PlannedTpsX1000;     /*!< EC transactions per second x 1000, planned */
+                                     uint32_t     NaiveTpsX1000;       /*!< same, with independent byte polling       */
+                                     uint32_t     Sweeps;              /*!< sweeps handed to the sampler              */
+                                     uint32_t     Bursts;              /*!< EC block reads in those sweeps            */
+                                     uint32_t     SensorReads;         /*!< sensor readings in those sweeps           */
+                                     uint32_t     MissedTicks;         /*!< due reads skipped because a sweep was late */
+                                     uint32_t     AdaptSpeedups;       /*!< adaptive periods shortened                */
+                                     uint32_t     AdaptBackoffs;       /*!< adaptive periods doubled                  */
+
+                                  } PLAN_STATS_STRUCT, *P_PLAN_STATS_STRUCT;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     PLAN_Register( uint32_t SensorMask, uint32_t PeriodMs, puint32_t pConsumer );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     PLAN_Unregister( uint32_t Consumer );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     PLAN_SetAdaptive( uint32_t Sensor, P_PLAN_ADAPT_STRUCT pAdapt );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     PLAN_GetStats( P_PLAN_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     PLAN_Register( uint32_t SensorMask, uint32_t PeriodMs, puint32_t pConsumer );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     PLAN_Unregister( uint32_t Consumer );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     PLAN_SetAdaptive( uint32_t Sensor, P_PLAN_ADAPT_STRUCT pAdapt );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     PLAN_GetStats( P_PLAN_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     PLAN_Register( uint32_t SensorMask, uint32_t PeriodMs, puint32_t pConsumer );
+__declspec( dllimport )    WINSYS_ERROR     PLAN_Unregister( uint32_t Consumer );
+__declspec( dllimport )    WINSYS_ERROR     PLAN_SetAdaptive( uint32_t Sensor, P_PLAN_ADAPT_STRUCT pAdapt );
+__declspec( dllimport )    WINSYS_ERROR     PLAN_GetStats( P_PLAN_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_PLANNER_INC
@@ -0,0 +1,110 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Quantiles.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Mergeable fixed memory quantile sketches of the sensor readings
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_QUANTILES_INC
+#define __ITE8528_EC_QUANTILES_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// A DDSketch with 1% relative accuracy. Reading x (raw units, 1 to 65535) is counted in bin
+// ceil( log( x ) / log( gamma ) ), gamma = 1.01 / 0.99, and a quantile is answered with the midpoint of its
+// bin, which is within 1% of the true reading. Raw readings are bounded, so 556 bins cover every reading -
+// a sketch never has to collapse bins, and merging two sketches is adding their bins, with no loss.
+//
+// The sampler feeds one sketch per sensor. QNT_Snapshot() copies a sensor's sketch out, optionally starting a
+// new one, e.g. once a day. Sketches from any window or box can then be merged with QNT_Merge() and queried
+// with QNT_Quantile(). QNT_Serialize() packs a sketch into a few hundred bytes for sending off the box.
+//
+// Include after ITE8528_EC_Sampler.h.
+//
+
+#define QNT_RELATIVE_ACCURACY               0.01
+#define QNT_BIN_COUNT                       556       /*!< bins for readings 1 to 65535         */
+#define QNT_MAGIC                           0x314b5351   /*!< "QSK1", first word of a serialized sketch */
+#define QNT_MAX_SERIALIZED                  ( 24 + QNT_BIN_COUNT * 5 )   /*!< worst case QNT_Serialize() */
+
+/*!\struct _QNT_SKETCH_STRUCT
+ * \brief  A quantile sketch, about 2.2 KB. Initialise with QNT_Init() before use.
+ */
+typedef struct _QNT_SKETCH_STRUCT {
+                                     uint64_t     Count;              /*!< readings counted                        */
+                                     uint32_t     Zero;               /*!< readings of 0                           */
+                                     uint16_t     Min;                /*!< lowest reading, exact                   */
+                                     uint16_t     Max;                /*!< highest reading, exact                  */
+                                     uint32_t     Bins[ QNT_BIN_COUNT ];
+
+                                  } QNT_SKETCH_STRUCT, *P_QNT_SKETCH_STRUCT;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     QNT_Init( P_QNT_SKETCH_STRUCT pSketch );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     QNT_Add( P_QNT_SKETCH_STRUCT pSketch, uint16_t Raw );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     QNT_Merge( P_QNT_SKETCH_STRUCT pSketch, const QNT_SKETCH_STRUCT *pOther );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     QNT_Quantile( const QNT_SKETCH_STRUCT *pSketch, double Quantile, pdouble_t pValue );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     QNT_Serialize( const QNT_SKETCH_STRUCT *pSketch, void *pBuffer, uint32_t Size, puint32_t pBytes );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     QNT_Deserialize( const void *pBuffer, uint32_t Bytes, P_QNT_SKETCH_STRUCT pSketch );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     QNT_Update( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     QNT_Snapshot( uint32_t Sensor, uint32_t Reset, P_QNT_SKETCH_STRUCT pSketch );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     QNT_Init( P_QNT_SKETCH_STRUCT pSketch );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     QNT_Add( P_QNT_SKETCH_STRUCT pSketch, uint16_t Raw );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     QNT_Merge( P_QNT_SKETCH_STRUCT pSketch, const QNT_SKETCH_STRUCT *pOther );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     QNT_Quantile( const QNT_SKETCH_STRUCT *pSketch, double Quantile, pdouble_t pValue );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     QNT_Serialize( const QNT_SKETCH_STRUCT *pSketch, void *pBuffer, uint32_t Size, puint32_t pBytes );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     QNT_Deserialize( const void *pBuffer, uint32_t Bytes, P_QNT_SKETCH_STRUCT pSketch );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     QNT_Update( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     QNT_Snapshot( uint32_t Sensor, uint32_t Reset, P_QNT_SKETCH_STRUCT pSketch );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     QNT_Init( P_QNT_SKETCH_STRUCT pSketch );
+__declspec( dllimport )    WINSYS_ERROR     QNT_Add( P_QNT_SKETCH_STRUCT pSketch, uint16_t Raw );
+__declspec( dllimport )    WINSYS_ERROR     QNT_Merge( P_QNT_SKETCH_STRUCT pSketch, const QNT_SKETCH_STRUCT *pOther );
+__declspec( dllimport )    WINSYS_ERROR     QNT_Quantile( const QNT_SKETCH_STRUCT *pSketch, double Quantile, pdouble_t pValue );
+__declspec( dllimport )    WINSYS_ERROR     QNT_Serialize( const QNT_SKETCH_STRUCT *pSketch, void *pBuffer, uint32_t Size, puint32_t pBytes );
+__declspec( dllimport )    WINSYS_ERROR     QNT_Deserialize( const void *pBuffer, uint32_t Bytes, P_QNT_SKETCH_STRUCT pSketch );
+__declspec( dllimport )    WINSYS_ERROR     QNT_Update( P_EC_SAMPLE_STRUCT pSample );
+__declspec( dllimport )    WINSYS_ERROR     QNT_Snapshot( uint32_t Sensor, uint32_t Reset, P_QNT_SKETCH_STRUCT pSketch );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_QUANTILES_INC
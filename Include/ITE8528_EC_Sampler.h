@@ -0,0 +1,156 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Sampler.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      The definitions used to read the EC sensors in batches, and to
+//!            sample them periodically on a background thread
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_SAMPLER_INC
+#define __ITE8528_EC_SAMPLER_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The sensors that can be read in a batch. Readings are kept as the raw EC register contents -
+// temperatures in degrees C, voltages in ADC counts to be multiplied by their scale factor.
+//
+
+/*!\enum _EC_SENSOR_ENUM_TYPE
+ * \brief  An enumeration of the EC sensors, used as an index into EC_SAMPLE_STRUCT.Raw and as a bit number
+ *         in sensor masks
+ */
+typedef enum _EC_SENSOR_ENUM_TYPE {
+                                     SENSOR_CPU_TEMP = 0,          /*!<  CPU temperature, degrees C            */
+                                     SENSOR_SYS_TEMP = 1,          /*!<  system temperature, degrees C         */
+                                     SENSOR_VCORE = 2,             /*!<  VCore rail, x VCORE_SCALE_FACTOR      */
+                                     SENSOR_V3P3 = 3,              /*!<  3.3V rail, x V3P3_SCALE_FACTOR        */
+                                     SENSOR_V5 = 4,                /*!<  5V rail, x V5_SCALE_FACTOR            */
+                                     SENSOR_V12 = 5,               /*!<  12V rail, x V12_SCALE_FACTOR          */
+                                     SENSOR_VDIMM = 6,             /*!<  DIMM rail, x VDIMM_SCALE_FACTOR       */
+                                     SENSOR_CPU_FAN = 7,           /*!<  CPU fan, RPM                          */
+                                     SENSOR_COUNT = 8,             /*!<  number of sensors                     */
+
+                                  } EC_SENSOR_ENUM_TYPE, *P_EC_SENSOR_ENUM_TYPE;
+
+#define EC_SENSOR_MAX                       8                               /*!< room in a sample for all sensors  */
+#define EC_SENSOR_MASK( Sensor )            ( ( uint32_t ) 1 << ( Sensor ) )
+#define EC_SENSOR_MASK_ALL                  ( EC_SENSOR_MASK( SENSOR_COUNT ) - 1 )
+
+/*!\struct _EC_SAMPLE_STRUCT
+ * \brief  One batch reading of the EC sensors. Only the sensors with their bit set in ValidMask were read.
+ */
+typedef struct _EC_SAMPLE_STRUCT {
+                                    uint64_t     TimestampMs;              /*!< UTC msecs since 1970 when read       */
+                                    uint32_t     Sequence;                 /*!< sampler sequence number              */
+                                    uint16_t     ValidMask;                /*!< sensors read in this sample          */
+                                    uint16_t     Reserved;
+                                    uint16_t     Raw[ EC_SENSOR_MAX ];     /*!< raw readings, by EC_SENSOR_ENUM_TYPE */
+
+                                 } EC_SAMPLE_STRUCT, *P_EC_SAMPLE_STRUCT;
+
+/*!\struct _SMP_STATS_STRUCT
+ * \brief  Counters kept by the sampler
+ */
+typedef struct _SMP_STATS_STRUCT {
+                                    uint32_t     Samples;             /*!< samples added to the ring             */
+                                    uint32_t     Errors;              /*!< sweeps that failed                    */
+                                    uint32_t     Overruns;            /*!< samples lost because the ring was full */
+                                    uint32_t     Bursts;              /*!< EC block reads issued by sweeps       */
+
+                                 } SMP_STATS_STRUCT, *P_SMP_STATS_STRUCT;
+
+//
+// Adjacent register ranges closer together than this are read in one burst, since reading a few unused bytes
+// is cheaper than negotiating another burst
+//
+
+#define SMP_BLOCK_MERGE_GAP                 4
+#define SMP_RING_SIZE                       1024    /*!< samples held for SMP_DrainSamples, power of 2  */
+#define SMP_DEFAULT_INTERVAL_MS             1000
+
+//
+// SMP_PeekSamples() is SMP_DrainSamples() without the copy - it returns the undrained samples where they lie in the
+// ring, up to the ring's end, and SMP_ReleaseSamples() drains them once they have been used. The run is pinned until
+// then: the sampler never waits for the reader, so once it has come round to the run it drops the samples it takes
+// instead of writing over the run, and SMP_ReleaseSamples() says how many it dropped. Peek and drain share the one
+// drainer's position - use one or the other.
+//
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_QuerySensors( uint32_t SensorMask, P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_Start( uint32_t IntervalMs, uint32_t SensorMask );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_StartPlanned( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_Stop( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_GetNotifyHandle( HANDLE *pHandle );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_WaitForSamples( uint32_t TimeoutMs );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_DrainSamples( P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_PeekSamples( const EC_SAMPLE_STRUCT **ppSamples, puint32_t pCount );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_ReleaseSamples( uint32_t Count, puint32_t pDropped );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_GetLatest( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     SMP_GetStats( P_SMP_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_QuerySensors( uint32_t SensorMask, P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_Start( uint32_t IntervalMs, uint32_t SensorMask );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_StartPlanned( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_Stop( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_GetNotifyHandle( HANDLE *pHandle );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_WaitForSamples( uint32_t TimeoutMs );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_DrainSamples( P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_PeekSamples( const EC_SAMPLE_STRUCT **ppSamples, puint32_t pCount );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_ReleaseSamples( uint32_t Count, puint32_t pDropped );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_GetLatest( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     SMP_GetStats( P_SMP_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     SMP_QuerySensors( uint32_t SensorMask, P_EC_SAMPLE_STRUCT pSample );
+__declspec( dllimport )    WINSYS_ERROR     SMP_Start( uint32_t IntervalMs, uint32_t SensorMask );
+__declspec( dllimport )    WINSYS_ERROR     SMP_StartPlanned( void );
+__declspec( dllimport )    WINSYS_ERROR     SMP_Stop( void );
+__declspec( dllimport )    WINSYS_ERROR     SMP_GetNotifyHandle( HANDLE *pHandle );
+__declspec( dllimport )    WINSYS_ERROR     SMP_WaitForSamples( uint32_t TimeoutMs );
+__declspec( dllimport )    WINSYS_ERROR     SMP_DrainSamples( P_EC_SAMPLE_STRUCT pSamples, uint32_t MaxSamples, puint32_t pCount );
+__declspec( dllimport )    WINSYS_ERROR     SMP_PeekSamples( const EC_SAMPLE_STRUCT **ppSamples, puint32_t pCount );
+__declspec( dllimport )    WINSYS_ERROR     SMP_ReleaseSamples( uint32_t Count, puint32_t pDropped );
+__declspec( dllimport )    WINSYS_ERROR     SMP_GetLatest( P_EC_SAMPLE_STRUCT pSample );
+__declspec( dllimport )    WINSYS_ERROR     SMP_GetStats( P_SMP_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_SAMPLER_INC
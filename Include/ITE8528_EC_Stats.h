@@ -0,0 +1,170 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Stats.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Streaming per sensor statistics and anomaly detection
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_STATS_INC
+#define __ITE8528_EC_STATS_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Every sample the sampler publishes updates, for each enabled sensor, in constant time and memory:
+//
+//    Welford mean and variance     of every reading, and the baseline - the mean and deviation of the first
+//                                  WarmupSamples readings, which is then held until STAT_Reset()
+//    EWMA                          the recent level, for catching slow drift away from the baseline
+//    lifetime and windowed min/max the window is the last WindowSamples readings
+//
+// Once the baseline has been learned, a reading further than SigmaLimit standard deviations from
+// the baseline mean raises a DEVIATION anomaly (e.g. a brownout), an EWMA that far away raises DRIFT (a
+// regulator wandering off), and a change from the previous reading of more than SpikeLimit deviations is a
+// SPIKE. DEVIATION and DRIFT are cleared when the value comes back inside three quarters of the limit; a SPIKE
+// is reported once.
+// The deviation used is never less than MinSigma, so a rail that sits on one raw value does not alarm on its
+// first LSB of noise.
+//
+// Anomalies go to the callback set with STAT_SetDelivery() - on the sampler thread - and/or to the event
+// queue as EVT_CLASS_ANOMALY events, whose Id is the sensor and Param the STAT_ANOMALY_ENUM_TYPE, with
+// STAT_ANOMALY_CLEARED set when cleared.
+//
+// All values are in raw sensor units - see EC_SENSOR_ENUM_TYPE. The power rails are enabled by default.
+//
+// Include after ITE8528_EC_Sampler.h.
+//
+
+/*!\enum _STAT_ANOMALY_ENUM_TYPE
+ * \brief  The kinds of anomaly
+ */
+typedef enum _STAT_ANOMALY_ENUM_TYPE {
+                                       STAT_ANOMALY_DEVIATION = 1,    /*!<  reading far from the baseline               */
+                                       STAT_ANOMALY_DRIFT = 2,        /*!<  EWMA far from the baseline                  */
+                                       STAT_ANOMALY_SPIKE = 3,        /*!<  reading far from the previous reading       */
+
+                                    } STAT_ANOMALY_ENUM_TYPE, *P_STAT_ANOMALY_ENUM_TYPE;
+
+#define STAT_ANOMALY_CLEARED                0x80    /*!< or'ed into the event Param when an anomaly clears  */
+
+/*!\struct _STAT_CONFIG_STRUCT
+ * \brief  How a sensor is tracked, as given to STAT_Configure()
+ */
+typedef struct _STAT_CONFIG_STRUCT {
+                                      uint32_t     Enabled;           /*!< 0 = not tracked                             */
+                                      uint32_t     WarmupSamples;     /*!< readings learned as the baseline, 2 or more */
+                                      uint32_t     WindowSamples;     /*!< windowed min/max span, 1 to STAT_MAX_WINDOW */
+                                      uint32_t     Reserved;
+                                      double       EwmaAlpha;         /*!< weight of each new reading, 0 to 1          */
+                                      double       SigmaLimit;        /*!< deviations from baseline for DEVIATION/DRIFT */
+                                      double       SpikeLimit;        /*!< deviations between readings for a SPIKE     */
+                                      double       MinSigma;          /*!< floor on the deviation, raw units           */
+
+                                   } STAT_CONFIG_STRUCT, *P_STAT_CONFIG_STRUCT;
+
+/*!\struct _STAT_SENSOR_STRUCT
+ * \brief  The statistics of one sensor, as returned by STAT_Get()
+ */
+typedef struct _STAT_SENSOR_STRUCT {
+                                      uint64_t     Samples;           /*!< readings seen                               */
+                                      double       Mean;              /*!< mean of every reading                       */
+                                      double       StdDev;            /*!< standard deviation of every reading         */
+                                      double       BaselineMean;      /*!< mean of the baseline, 0 while learning      */
+                                      double       BaselineStdDev;    /*!< deviation of the baseline, before MinSigma  */
+                                      double       Ewma;              /*!< exponentially weighted recent mean          */
+                                      uint16_t     Last;              /*!< latest reading                              */
+                                      uint16_t     Min;               /*!< lowest reading seen                         */
+                                      uint16_t     Max;               /*!< highest reading seen                        */
+                                      uint16_t     WindowMin;         /*!< lowest of the last WindowSamples readings   */
+                                      uint16_t     WindowMax;         /*!< highest of the last WindowSamples readings  */
+                                      uint16_t     Active;            /*!< bit n set = anomaly kind n active           */
+                                      uint32_t     Anomalies;         /*!< anomalies raised                            */
+
+                                   } STAT_SENSOR_STRUCT, *P_STAT_SENSOR_STRUCT;
+
+/*!\struct _STAT_ANOMALY_STRUCT
+ * \brief  An anomaly as delivered to the callback
+ */
+typedef struct _STAT_ANOMALY_STRUCT {
+                                       uint8_t      Sensor;           /*!< EC_SENSOR_ENUM_TYPE                         */
+                                       uint8_t      Kind;             /*!< STAT_ANOMALY_ENUM_TYPE                      */
+                                       uint8_t      Raised;           /*!< 1 raised, 0 cleared                         */
+                                       uint8_t      Reserved;
+                                       uint16_t     Raw;              /*!< the reading                                 */
+                                       uint16_t     Reserved2;
+                                       double       Sigmas;           /*!< how many deviations away it was             */
+                                       uint64_t     TimestampMs;      /*!< time of the sample                          */
+
+                                    } STAT_ANOMALY_STRUCT, *P_STAT_ANOMALY_STRUCT;
+
+typedef void ( *STAT_CALLBACK )( P_STAT_ANOMALY_STRUCT pAnomaly, PVOID pContext );
+
+#define STAT_MAX_WINDOW                     256     /*!< longest min/max window, power of 2               */
+#define STAT_DEFAULT_WARMUP                 256
+#define STAT_DEFAULT_WINDOW                 60
+#define STAT_DEFAULT_EWMA_ALPHA             0.05
+#define STAT_DEFAULT_SIGMA_LIMIT            4.0
+#define STAT_DEFAULT_SPIKE_LIMIT            6.0
+#define STAT_DEFAULT_MIN_SIGMA              1.0
+#define STAT_DELIVER_CALLBACK               0x01    /*!< call the STAT_SetDelivery() callback             */
+#define STAT_DELIVER_EVENT_QUEUE            0x02    /*!< post EVT_CLASS_ANOMALY events                    */
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     STAT_Configure( uint32_t Sensor, P_STAT_CONFIG_STRUCT pConfig );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     STAT_Reset( uint32_t SensorMask );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     STAT_SetDelivery( uint32_t Flags, STAT_CALLBACK Callback, PVOID pContext );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     STAT_Update( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     STAT_Get( uint32_t Sensor, P_STAT_SENSOR_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     STAT_Configure( uint32_t Sensor, P_STAT_CONFIG_STRUCT pConfig );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     STAT_Reset( uint32_t SensorMask );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     STAT_SetDelivery( uint32_t Flags, STAT_CALLBACK Callback, PVOID pContext );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     STAT_Update( P_EC_SAMPLE_STRUCT pSample );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     STAT_Get( uint32_t Sensor, P_STAT_SENSOR_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     STAT_Configure( uint32_t Sensor, P_STAT_CONFIG_STRUCT pConfig );
+__declspec( dllimport )    WINSYS_ERROR     STAT_Reset( uint32_t SensorMask );
+__declspec( dllimport )    WINSYS_ERROR     STAT_SetDelivery( uint32_t Flags, STAT_CALLBACK Callback, PVOID pContext );
+__declspec( dllimport )    WINSYS_ERROR     STAT_Update( P_EC_SAMPLE_STRUCT pSample );
+__declspec( dllimport )    WINSYS_ERROR     STAT_Get( uint32_t Sensor, P_STAT_SENSOR_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_STATS_INC
@@ -0,0 +1,94 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_Units.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Integer millivolt and millidegree readings, and batch conversion of
+//!            raw sensor readings
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_UNITS_INC
+#define __ITE8528_EC_UNITS_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Raw readings are converted with the Q16 constants in ITE8528_EC_Lib.h - one integer multiply, add and shift,
+// no floating point. The power rails convert to millivolts and the temperatures to millidegrees C.
+//
+// UNIT_ToMilli() converts arrays of one sensor's raw readings, e.g. a column pulled out of SMP_DrainSamples()
+// or HIST_Query() results. It runs an AVX2 kernel where the CPU and OS support it, else SSE2, else plain C;
+// UNIT_SetKernel() forces one, for comparing them. Every kernel gives the same result.
+//
+// Include after ITE8528_EC_Sampler.h.
+//
+
+/*!\enum _UNIT_KERNEL_ENUM_TYPE
+ * \brief  The batch conversion kernels
+ */
+typedef enum _UNIT_KERNEL_ENUM_TYPE {
+                                       UNIT_KERNEL_AUTO = 0,          /*!<  the fastest the CPU supports                */
+                                       UNIT_KERNEL_SCALAR = 1,        /*!<  plain C                                     */
+                                       UNIT_KERNEL_SSE2 = 2,          /*!<  8 readings at a time                        */
+                                       UNIT_KERNEL_AVX2 = 3,          /*!<  16 readings at a time                       */
+
+                                    } UNIT_KERNEL_ENUM_TYPE, *P_UNIT_KERNEL_ENUM_TYPE;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     PWR_GetMilliVolts( uint32_t Rail, puint32_t pMilliVolts );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     TEMP_GetMilliDegrees( uint32_t Sensor, puint32_t pMilliDegrees );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     UNIT_ToMilli( uint32_t Sensor, const uint16_t *pRaw, puint32_t pMilli, uint32_t Count );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     UNIT_SetKernel( uint32_t Kernel );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     UNIT_GetKernel( puint32_t pKernel );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     PWR_GetMilliVolts( uint32_t Rail, puint32_t pMilliVolts );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     TEMP_GetMilliDegrees( uint32_t Sensor, puint32_t pMilliDegrees );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     UNIT_ToMilli( uint32_t Sensor, const uint16_t *pRaw, puint32_t pMilli, uint32_t Count );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     UNIT_SetKernel( uint32_t Kernel );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     UNIT_GetKernel( puint32_t pKernel );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     PWR_GetMilliVolts( uint32_t Rail, puint32_t pMilliVolts );
+__declspec( dllimport )    WINSYS_ERROR     TEMP_GetMilliDegrees( uint32_t Sensor, puint32_t pMilliDegrees );
+__declspec( dllimport )    WINSYS_ERROR     UNIT_ToMilli( uint32_t Sensor, const uint16_t *pRaw, puint32_t pMilli, uint32_t Count );
+__declspec( dllimport )    WINSYS_ERROR     UNIT_SetKernel( uint32_t Kernel );
+__declspec( dllimport )    WINSYS_ERROR     UNIT_GetKernel( puint32_t pKernel );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_UNITS_INC
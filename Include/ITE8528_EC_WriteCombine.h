@@ -0,0 +1,121 @@
+//****************************************************************************
+//
+//!\copyright 2026 by WinSystems Inc.
+//!
+//!  Permission is hereby granted to the purchaser of WinSystems CPU products
+//!  to distribute any binary file or files compiled using this source code
+//!  directly or in any work derived by the user from this file. In no case
+//!  may the source code, original or derived from this file, be distributed
+//!  to any third party except by explicit permission of WinSystems. This file
+//!  is distributed on an "As-is" basis and no warranty as to performance or
+//!  fitness of purposes is expressed or implied. In no case shall WinSystems
+//!  be liable for any direct or indirect loss or damage, real or consequential
+//!  resulting from the usage of this source code. It is the user's sole re-
+//!  sponsibility to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//  Filename   ITE8528_EC_WriteCombine.h
+//
+//  Project    ACPI Embedded Controller Routines
+//
+//!\brief      Write combining buffer for EC configuration registers
+//
+//!\author     agent
+//!
+//!\version    0.1
+//!
+//!\date       10/19/26
+//!
+//****************************************************************************
+#ifndef __ITE8528_EC_WRITECOMBINE_INC
+#define __ITE8528_EC_WRITECOMBINE_INC
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The write combining buffer holds writes to the EC's SRAM for up to WindowMs, so that rewriting a register
+// several times in quick succession - a fan target and tolerance being tuned, WDT counters being reloaded -
+// costs one EC write of the last value instead of a burst transaction each. When the window closes the dirty
+// registers are written as runs of adjacent offsets, one EC_WriteBlockUsingACPI() burst per run.
+//
+// The window opens at the first write into a clean buffer and is not extended by later writes, so no write
+// waits longer than WindowMs. A WindowMs of 0, the default, turns combining off and WCB_Write() writes
+// straight through.
+//
+// Ordering:
+//
+//    WCB_Flush() returns once every write made before it is in the EC, and is the only ordering point
+//    between writes to different registers - within a window they reach the EC in offset order, not in
+//    the order they were made. Writes to the same register always keep their order; only the last survives.
+//
+//    A bypass register is written immediately, after flushing everything written before it - so a WDT
+//    timeout buffered before enabling the WDT still lands first. WDT_CONFIG_OFFSET is a bypass register by
+//    default; WCB_SetBypass() changes the set.
+//
+//    WCB_Read() returns a buffered value when there is one. The EC_ functions know nothing of the buffer -
+//    flush before reading or writing a buffered register through them.
+//
+// A block that fails is kept dirty and tried again at the next flush. Call WCB_Flush(), or WCB_Configure( 0 ),
+// before exiting, or the last window's writes are lost.
+//
+
+/*!\struct _WCB_STATS_STRUCT
+ * \brief  Counters kept by the write combining buffer, as returned by WCB_GetStats()
+ */
+typedef struct _WCB_STATS_STRUCT {
+                                    uint64_t     Writes;            /*!< bytes given to WCB_Write/WriteBlock     */
+                                    uint64_t     Combined;          /*!< writes replaced before being flushed    */
+                                    uint64_t     Bypassed;          /*!< writes that skipped the buffer          */
+                                    uint64_t     Flushes;           /*!< flushes that found dirty registers      */
+                                    uint64_t     Blocks;            /*!< block writes made by flushes            */
+                                    uint64_t     Bytes;             /*!< bytes written by flushes                */
+                                    uint32_t     Errors;            /*!< block writes that failed                */
+                                    uint32_t     Dirty;             /*!< registers waiting now                   */
+
+                                 } WCB_STATS_STRUCT, *P_WCB_STATS_STRUCT;
+
+#define WCB_MAX_WINDOW_MS                   1000    /*!< longest combining window                         */
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// function prototypes
+//
+
+#ifdef __DLL_BUILD
+
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WCB_Configure( uint32_t WindowMs );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WCB_SetBypass( uint8_t Offset, uint32_t Bypass );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WCB_Write( uint8_t Offset, uint8_t Value );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WCB_WriteBlock( uint8_t Offset, uint8_t Count, puint8_t pData );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WCB_Read( uint8_t Offset, puint8_t pValue );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WCB_Flush( void );
+extern "C" __declspec( dllexport )   WINSYS_ERROR     WCB_GetStats( P_WCB_STATS_STRUCT pStats );
+
+#else
+
+#ifdef __CPLUSPLUS
+
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WCB_Configure( uint32_t WindowMs );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WCB_SetBypass( uint8_t Offset, uint32_t Bypass );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WCB_Write( uint8_t Offset, uint8_t Value );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WCB_WriteBlock( uint8_t Offset, uint8_t Count, puint8_t pData );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WCB_Read( uint8_t Offset, puint8_t pValue );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WCB_Flush( void );
+extern "C" __declspec( dllimport )    WINSYS_ERROR     WCB_GetStats( P_WCB_STATS_STRUCT pStats );
+
+#else
+
+__declspec( dllimport )    WINSYS_ERROR     WCB_Configure( uint32_t WindowMs );
+__declspec( dllimport )    WINSYS_ERROR     WCB_SetBypass( uint8_t Offset, uint32_t Bypass );
+__declspec( dllimport )    WINSYS_ERROR     WCB_Write( uint8_t Offset, uint8_t Value );
+__declspec( dllimport )    WINSYS_ERROR     WCB_WriteBlock( uint8_t Offset, uint8_t Count, puint8_t pData );
+__declspec( dllimport )    WINSYS_ERROR     WCB_Read( uint8_t Offset, puint8_t pValue );
+__declspec( dllimport )    WINSYS_ERROR     WCB_Flush( void );
+__declspec( dllimport )    WINSYS_ERROR     WCB_GetStats( P_WCB_STATS_STRUCT pStats );
+
+#endif
+
+#endif      // #ifdef __DLL_BUILD
+
+#endif      // #ifndef __ITE8528_EC_WRITECOMBINE_INC
@@ -43,6 +43,18 @@
 
 typedef uint32_t        WINSYS_ERROR;
 
+//
+// the winerror.h values used below, for builds that do not include windows.h
+//
+
+#ifndef S_OK
+#define S_OK                                    0
+#endif
+
+#ifndef FACILITY_PIX
+#define FACILITY_PIX                            2748
+#endif
+
 //
 // top 2 bits define the error type (error, warning, info, success)
 //
@@ -75,5 +87,15 @@ typedef uint32_t        WINSYS_ERROR;
 #define STATUS_INDEX_OUT_OF_RANGE               5
 #define STATUS_ENUMERATION_OUT_OF_RANGE         6
 #define STATUS_BURST_ACK_TIMEOUT                7
-
-
+#define STATUS_OBF_TIMEOUT                      8
+#define STATUS_IBF_TIMEOUT                      9
+#define STATUS_ALREADY_RUNNING                  10
+#define STATUS_NOT_RUNNING                      11
+#define STATUS_NO_RESOURCES                     12
+#define STATUS_QUEUE_FULL                       13
+#define STATUS_CANCELLED                        14
+#define STATUS_TIMEOUT                          15
+#define STATUS_NOT_FOUND                        16
+#define STATUS_FILE_ERROR                       17
+#define STATUS_BAD_FORMAT                       18
+#define STATUS_BUFFER_TOO_SMALL                 19
@@ -46,13 +46,11 @@ typedef void *  PVOID;
 typedef void *  pvoid;
 
 //typedef          _int8     int8_t;
-typedef unsigned _int8     uint8_t;
-typedef          _int16    int16_t;
-typedef unsigned _int16    uint16_t;
-typedef          _int32    int32_t;
-typedef unsigned _int32    uint32_t;
-typedef          _int64    int64_t;
-typedef unsigned _int64    uint64_t;
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
 
 typedef uint8_t  *puint8_t;
 typedef uint16_t *puint16_t;
@@ -66,6 +64,22 @@ typedef int64_t  *pint64_t;
 typedef float    *pfloat_t;
 typedef double   *pdouble_t;
 
+//
+// __declspec( dllexport ) / __declspec( dllimport ) mean nothing outside MSVC
+//
+
+#if !defined( _WIN32 ) && !defined( __declspec )
+#define __declspec( Attribute )
+#endif
+
+//
+// the headers pass waitable objects around as HANDLEs, which windows.h declares on Windows
+//
+
+#if !defined( _WIN32 )
+typedef void     *HANDLE;
+#endif
+
 #ifdef __KERNEL_BUILD
 #define true	1
 #define TRUE	true
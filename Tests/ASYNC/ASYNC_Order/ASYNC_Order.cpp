@@ -0,0 +1,221 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : ASYNC_Order.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Checks the order the I/O worker completes queued requests in: control
+//      reads earliest deadline first, two writes to the same register in
+//      submission order although the second is more urgent, and telemetry
+//      reads of the same offset in submission order. Each group is queued
+//      behind a block read, so the worker sees the whole group at once. The
+//      writes put back the value the WDT minutes counter already holds.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Async.h>
+#include <string.h>
+
+#define PLUG_TAG              100         // block read the worker is busy with while a group is queued
+#define ORDER_MAX             8
+
+#define TEST_FAILED           WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT )
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: Submit                                                          */
+/*                                                                            */
+/*!\brief  Submits one request                                               */
+/*                                                                            */
+/*!\param   uint8_t             ASYNC_OP_ENUM_TYPE                            */
+/*!\param   uint8_t             EC offset                                     */
+/*!\param   uint8_t             byte count of a block read, or byte to write  */
+/*!\param   uint8_t             ASYNC_PRIO_ENUM_TYPE                          */
+/*!\param   uint32_t            timeout in usecs, 0 = none                    */
+/*!\param   uint64_t            tag                                           */
+/*!\return  WINSYS_ERROR        value indicating success or failure           */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR Submit( uint8_t Op, uint8_t Offset, uint8_t CountOrValue, uint8_t Priority, uint32_t TimeoutUs, uint64_t Tag )
+{
+   ASYNC_SUBMIT_STRUCT   Request;
+
+   memset( &Request, 0, sizeof( Request ) );
+
+   Request.Op = Op;
+   Request.Offset = Offset;
+   Request.Count = ( Op == ASYNC_OP_READ_BLOCK ) ? CountOrValue : 1;
+   Request.Value = CountOrValue;
+   Request.Priority = Priority;
+   Request.TimeoutUs = TimeoutUs;
+   Request.UserTag = Tag;
+
+   return ASYNC_SubmitEx( &Request );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: Expect                                                          */
+/*                                                                            */
+/*!\brief  Reaps completions until the plug and a group are back, and checks */
+/*!\brief  the group came back in the expected order                         */
+/*                                                                            */
+/*!\param   const char *        name of the group, for the report             */
+/*!\param   const uint64_t *    tags of the group in the expected order       */
+/*!\param   uint32_t            number of tags                                */
+/*!\return  WINSYS_ERROR        value indicating success or failure           */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR Expect( const char *pName, const uint64_t *pTags, uint32_t Count )
+{
+   ASYNC_COMPLETION_STRUCT   Completions[ ORDER_MAX + 1 ];
+   HANDLE                    Completion;
+   uint64_t                  Order[ ORDER_MAX + 1 ];
+   uint32_t                  Reaped = 0,
+                             Got,
+                             Index;
+   WINSYS_ERROR              Results = STATUS_SUCCESS;
+
+   ASYNC_GetCompletionHandle( &Completion );
+
+   while ( Reaped < Count + 1 )
+   {
+      if ( WaitForSingleObject( Completion, 2000 ) != WAIT_OBJECT_0 )
+      {
+         printf( "%s: only %u of %u completions\n", pName, Reaped, Count + 1 );
+         return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_TIMEOUT );
+      }
+
+      ASYNC_ReapCompletions( Completions, Count + 1 - Reaped, &Got );
+
+      for ( Index = 0; Index < Got; Index++ )
+      {
+         if ( Completions[ Index ].Status != STATUS_SUCCESS )
+         {
+            printf( "%s: request %llu failed, 0x%08X\n", pName, Completions[ Index ].UserTag, Completions[ Index ].Status );
+            Results = TEST_FAILED;
+         }
+
+         Order[ Reaped++ ] = Completions[ Index ].UserTag;
+      }
+   }
+
+   printf( "%s:", pName );
+
+   for ( Index = 0, Got = 0; Index < Count + 1; Index++ )
+   {
+      if ( Order[ Index ] != PLUG_TAG )
+      {
+         printf( " %llu", Order[ Index ] );
+
+         if ( Order[ Index ] != pTags[ Got++ ] )
+         {
+            Results = TEST_FAILED;
+         }
+      }
+   }
+
+   printf( "%s\n", ( Results == STATUS_SUCCESS ) ? "" : " - out of order" );
+
+   return Results;
+}
+
+WINSYS_ERROR main()
+{
+   static const uint64_t   Deadlines[] = { 4, 3, 2, 1 };
+   static const uint64_t   Writes[] = { 11, 12 };
+   static const uint64_t   Reads[] = { 21, 22, 23 };
+   WINSYS_ERROR            Results,
+                           Failed = STATUS_SUCCESS;
+   uint8_t                 Minutes;
+
+   if ( ( Results = EC_ReadByteUsingACPI( WDT_MINUTES_COUNTER_OFFSET, &Minutes ) ) != STATUS_SUCCESS )
+   {
+      printf( "EC_ReadByteUsingACPI failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   if ( ( Results = ASYNC_Start() ) != STATUS_SUCCESS )
+   {
+      printf( "ASYNC_Start failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   //
+   // control reads with deadlines 400, 300, 200 and 100 msecs out complete nearest deadline first
+   //
+
+   Submit( ASYNC_OP_READ_BLOCK, 0, ASYNC_MAX_BLOCK, ASYNC_PRIO_CONTROL, 0, PLUG_TAG );
+   Submit( ASYNC_OP_READ, CPU_TEMPERATURE_OFFSET, 0, ASYNC_PRIO_CONTROL, 400000, 1 );
+   Submit( ASYNC_OP_READ, CPU_TEMPERATURE_OFFSET, 0, ASYNC_PRIO_CONTROL, 300000, 2 );
+   Submit( ASYNC_OP_READ, CPU_TEMPERATURE_OFFSET, 0, ASYNC_PRIO_CONTROL, 200000, 3 );
+   Submit( ASYNC_OP_READ, CPU_TEMPERATURE_OFFSET, 0, ASYNC_PRIO_CONTROL, 100000, 4 );
+
+   if ( ( Results = Expect( "earliest deadline first", Deadlines, 4 ) ) != STATUS_SUCCESS )
+   {
+      Failed = Results;
+   }
+
+   //
+   // the second write to the register is more urgent, but must not overtake the first
+   //
+
+   Submit( ASYNC_OP_READ_BLOCK, 0, ASYNC_MAX_BLOCK, ASYNC_PRIO_CONTROL, 0, PLUG_TAG );
+   Submit( ASYNC_OP_WRITE, WDT_MINUTES_COUNTER_OFFSET, Minutes, ASYNC_PRIO_CONTROL, 400000, 11 );
+   Submit( ASYNC_OP_WRITE, WDT_MINUTES_COUNTER_OFFSET, Minutes, ASYNC_PRIO_CONTROL, 100000, 12 );
+
+   if ( ( Results = Expect( "writes in submission order", Writes, 2 ) ) != STATUS_SUCCESS )
+   {
+      Failed = Results;
+   }
+
+   //
+   // telemetry reads of one offset share a burst, and complete in submission order
+   //
+
+   Submit( ASYNC_OP_READ_BLOCK, 0, ASYNC_MAX_BLOCK, ASYNC_PRIO_CONTROL, 0, PLUG_TAG );
+   Submit( ASYNC_OP_READ, SYS_TEMPERATURE_OFFSET, 0, ASYNC_PRIO_TELEMETRY, 0, 21 );
+   Submit( ASYNC_OP_READ, SYS_TEMPERATURE_OFFSET, 0, ASYNC_PRIO_TELEMETRY, 0, 22 );
+   Submit( ASYNC_OP_READ, SYS_TEMPERATURE_OFFSET, 0, ASYNC_PRIO_TELEMETRY, 0, 23 );
+
+   if ( ( Results = Expect( "telemetry reads", Reads, 3 ) ) != STATUS_SUCCESS )
+   {
+      Failed = Results;
+   }
+
+   ASYNC_Stop();
+
+   printf( "%s\n", ( Failed == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   return Failed;
+}
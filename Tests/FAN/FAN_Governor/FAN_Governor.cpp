@@ -0,0 +1,93 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : FAN_Governor.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Runs the thermal governor for a minute, printing its status every
+//      second, overriding the fan for ten seconds in the middle, then stops
+//      it and restores the target register
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Governor.h>
+
+#define RUN_SECONDS         60
+#define OVERRIDE_AT         20
+#define RESUME_AT           30
+
+WINSYS_ERROR main()
+{
+   GOV_CONFIG_STRUCT   Config;
+   GOV_STATUS_STRUCT   Status;
+   WINSYS_ERROR        Results;
+   uint32_t            Second;
+
+   GOV_GetDefaultConfig( &Config );
+   Config.PeriodMs = 250;
+
+   if ( ( Results = GOV_Start( &Config ) ) != STATUS_SUCCESS )
+   {
+      printf( "GOV_Start failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   for ( Second = 1; Second <= RUN_SECONDS; Second++ )
+   {
+      Sleep( 1000 );
+
+      if ( Second == OVERRIDE_AT )
+          {
+             GOV_SetOverride( 0xFF );
+          }
+      else if ( Second == RESUME_AT )
+          {
+             GOV_Resume();
+          }
+
+      GOV_GetStatus( &Status );
+
+      printf( "%2u mode %u  %5.1f C  %5u RPM  out 0x%02X (%6.1f)  writes %llu  jitter %d..%d us, mean %.0f sd %.0f  loop max %u us\n",
+              Second, Status.Mode, Status.TempC, Status.Rpm, Status.Output, Status.Demand, Status.Writes,
+              Status.JitterMinUs, Status.JitterMaxUs, Status.JitterMeanUs, Status.JitterStdDevUs, Status.LoopMaxUs );
+   }
+
+   Results = GOV_Stop();
+
+   GOV_GetStatus( &Status );
+   printf( "%llu periods, %llu writes, %llu held back by the deadband, %u errors, %u overruns\n", Status.Periods,
+           Status.Writes, Status.Suppressed, Status.Errors, Status.Overruns );
+
+   return Results;
+}
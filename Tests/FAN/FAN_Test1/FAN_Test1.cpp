@@ -0,0 +1,82 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : FAN_Test1.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Reads the CPU fan speed and the smart fan settings, then reads the fan
+//      together with the temperatures in one batch query
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+
+WINSYS_ERROR main()
+{
+   uint16_t                  Rpm;
+   FAN_SMART_CONFIG_STRUCT   Config;
+   EC_SAMPLE_STRUCT          Sample;
+   WINSYS_ERROR              Status;
+
+   if ( ( Status = FAN_GetCPU( &Rpm ) ) == STATUS_SUCCESS )
+       {
+          printf( "CPU fan = %u RPM\n", Rpm );
+
+          if ( ( Status = FAN_GetSmartConfig( &Config ) ) == STATUS_SUCCESS )
+              {
+                 printf( "Smart fan config = 0x%02X, targets = 0x%02X 0x%02X\n", Config.Config, Config.Target1, Config.Target2 );
+
+                 Status = SMP_QuerySensors( EC_SENSOR_MASK( SENSOR_CPU_TEMP ) | EC_SENSOR_MASK( SENSOR_SYS_TEMP ) |
+                                            EC_SENSOR_MASK( SENSOR_CPU_FAN ), &Sample );
+                 if ( Status == STATUS_SUCCESS )
+                     {
+                        printf( "CPU %u C, SYS %u C, fan %u RPM\n", Sample.Raw[ SENSOR_CPU_TEMP ],
+                                Sample.Raw[ SENSOR_SYS_TEMP ], Sample.Raw[ SENSOR_CPU_FAN ] );
+                     }
+                 else
+                     {
+                        printf( "SMP_QuerySensors failed, 0x%08X\n", Status );
+                     }
+              }
+          else
+              {
+                 printf( "FAN_GetSmartConfig failed, 0x%08X\n", Status );
+              }
+       }
+   else
+       {
+          printf( "FAN_GetCPU failed, 0x%08X\n", Status );
+       }
+
+   return Status;
+}
@@ -0,0 +1,198 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : HIST_Codec.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Round trips samples through the history encoder and decoder. Every
+//      sensor, the CPU fan included, changes on its own and all together,
+//      with and without a change in the sampling interval, and the samples
+//      read back with HIST_Query() and HIST_DecodeBlock() must match the
+//      samples appended
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_History.h>
+#include <string.h>
+
+#define HIST_TEST_FILE        "HIST_Codec.bin"
+#define HIST_TEST_BLOCKS      8
+#define HIST_TEST_START_MS    1790000000000ULL
+#define HIST_TEST_SAMPLES     ( 2 + SENSOR_COUNT * 2 + 4 )
+
+static EC_SAMPLE_STRUCT   Appended[ HIST_TEST_SAMPLES ];
+static EC_SAMPLE_STRUCT   Decoded[ HIST_TEST_SAMPLES + 1 ];
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: Compare                                                         */
+/*                                                                            */
+/*!\brief  Checks decoded samples against the samples appended              */
+/*                                                                            */
+/*!\param   const char *        what decoded them, for the report            */
+/*!\param   uint32_t            samples decoded                               */
+/*!\return  WINSYS_ERROR        STATUS_BAD_FORMAT on a mismatch               */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR Compare( const char *pWhat, uint32_t Count )
+{
+   uint32_t   Index;
+
+   printf( "%s: %u of %u samples\n", pWhat, Count, HIST_TEST_SAMPLES );
+
+   if ( Count != HIST_TEST_SAMPLES )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+   }
+
+   for ( Index = 0; Index < Count; Index++ )
+   {
+      if ( ( Decoded[ Index ].TimestampMs != Appended[ Index ].TimestampMs ) ||
+           ( Decoded[ Index ].ValidMask != Appended[ Index ].ValidMask ) ||
+           ( memcmp( Decoded[ Index ].Raw, Appended[ Index ].Raw, sizeof( Decoded[ Index ].Raw ) ) ) )
+      {
+         printf( "   sample %u differs: time %llu / %llu, fan 0x%04X / 0x%04X\n", Index,
+                 ( unsigned long long ) Decoded[ Index ].TimestampMs, ( unsigned long long ) Appended[ Index ].TimestampMs,
+                 Decoded[ Index ].Raw[ SENSOR_CPU_FAN ], Appended[ Index ].Raw[ SENSOR_CPU_FAN ] );
+         return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+      }
+   }
+
+   return STATUS_SUCCESS;
+}
+
+WINSYS_ERROR main()
+{
+   WINSYS_ERROR       Results;
+   EC_SAMPLE_STRUCT   Sample;
+   uint32_t           Index = 0,
+                      Sensor,
+                      Count,
+                      Bytes;
+   uint64_t           IntervalMs = 1000;
+   const void         *pBlock;
+
+   //
+   // a steady start, then each sensor changing alone on a steady interval and then alone with the interval
+   // changing, then every sensor at once with and without an interval change
+   //
+
+   memset( &Sample, 0, sizeof( Sample ) );
+   Sample.TimestampMs = HIST_TEST_START_MS;
+   Sample.ValidMask = ( uint16_t ) EC_SENSOR_MASK_ALL;
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      Sample.Raw[ Sensor ] = ( uint16_t )( 0x0100 + Sensor );
+   }
+
+   Appended[ Index++ ] = Sample;
+   Sample.TimestampMs += IntervalMs;
+   Appended[ Index++ ] = Sample;
+
+   for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+   {
+      Sample.TimestampMs += IntervalMs;
+      Sample.Raw[ Sensor ] ^= 0x0001;
+      Appended[ Index++ ] = Sample;
+
+      IntervalMs += 250;
+      Sample.TimestampMs += IntervalMs;
+      Sample.Raw[ Sensor ] ^= 0xa5c3;
+      Appended[ Index++ ] = Sample;
+   }
+
+   for ( Count = 0; Count < 4; Count++ )
+   {
+      if ( Count & 1 )
+      {
+         IntervalMs -= 100;
+      }
+
+      Sample.TimestampMs += IntervalMs;
+
+      for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+      {
+         Sample.Raw[ Sensor ] = ( uint16_t )( Sample.Raw[ Sensor ] + 0x1111 * ( Count + 1 ) );
+      }
+
+      Appended[ Index++ ] = Sample;
+   }
+
+   DeleteFileA( HIST_TEST_FILE );
+
+   if ( ( Results = HIST_Open( HIST_TEST_FILE, HIST_TEST_BLOCKS ) ) != STATUS_SUCCESS )
+   {
+      printf( "HIST_Open failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   for ( Index = 0; ( Index < HIST_TEST_SAMPLES ) && ( Results == STATUS_SUCCESS ); Index++ )
+   {
+      Results = HIST_Append( &Appended[ Index ] );
+   }
+
+   if ( Results != STATUS_SUCCESS )
+       {
+          printf( "HIST_Append failed, 0x%08X\n", Results );
+       }
+   else if ( ( Results = HIST_Query( 0, ~0ULL, Decoded, HIST_TEST_SAMPLES + 1, &Count ) ) != STATUS_SUCCESS )
+       {
+          printf( "HIST_Query failed, 0x%08X\n", Results );
+       }
+   else if ( ( Results = Compare( "HIST_Query", Count ) ) == STATUS_SUCCESS )
+       {
+          //
+          // all the samples share a ValidMask, so they are all in the first block
+          //
+
+          if ( ( Results = HIST_GetBlock( 0, &pBlock, &Bytes ) ) == STATUS_SUCCESS )
+          {
+             memset( Decoded, 0, sizeof( Decoded ) );
+
+             if ( ( Results = HIST_DecodeBlock( pBlock, Decoded, HIST_TEST_SAMPLES + 1, &Count ) ) == STATUS_SUCCESS )
+             {
+                Results = Compare( "HIST_DecodeBlock", Count );
+                printf( "block bytes: %u\n", Bytes );
+             }
+          }
+       }
+
+   HIST_Close();
+   DeleteFileA( HIST_TEST_FILE );
+
+   printf( "%s\n", ( Results == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   return Results;
+}
@@ -0,0 +1,429 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : HIST_Reopen.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Appends a few blocks of samples to a history file, closes it, writes
+//      an uncommitted record past the commit word of the newest block as a
+//      crash would leave it, and reopens it. The samples and stats must come
+//      back as they were before closing, and a sample appended after
+//      reopening must continue the newest block. Before and after reopening,
+//      each rollup level is queried and every point checked against the
+//      samples in its bucket, including a query asking for fewer points than
+//      even the hourly level has, which gets only the newest hours
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_History.h>
+#include <string.h>
+
+#define HIST_TEST_FILE        "HIST_Reopen.bin"
+#define HIST_TEST_BLOCKS      16
+#define HIST_TEST_START_MS    1790000000000ULL
+#define HIST_TEST_SAMPLES     3000
+#define HIST_TEST_POINTS      1000
+
+/*!\struct _ROLLUP_QUERY_STRUCT
+ * \brief  A rollup query over all the samples, and the bucket width it should get
+ */
+typedef struct _ROLLUP_QUERY_STRUCT {
+                                       uint32_t     MaxPoints;
+                                       uint32_t     ResolutionMs;
+
+                                    } ROLLUP_QUERY_STRUCT, *P_ROLLUP_QUERY_STRUCT;
+
+//
+// the samples span about 50 minutes, so each query picks the finest level with fewer buckets than MaxPoints -
+// except the last, where even the hourly buckets are one too many and only the newest hour comes back
+//
+
+static const ROLLUP_QUERY_STRUCT   Queries[] = {
+                                                  { HIST_TEST_POINTS, 10000 },
+                                                  { 100, 60000 },
+                                                  { 10, 600000 },
+                                                  { 2, 3600000 },
+                                                  { 1, 3600000 },
+                                               };
+
+static EC_SAMPLE_STRUCT    Appended[ HIST_TEST_SAMPLES + 1 ];
+static EC_SAMPLE_STRUCT    Decoded[ HIST_TEST_SAMPLES + 2 ];
+static HIST_POINT_STRUCT   Points[ HIST_TEST_POINTS ];
+
+#define TEST_FAILED           WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT )
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: Check                                                           */
+/*                                                                            */
+/*!\brief  Queries the whole history and checks it against the samples      */
+/*!\brief  appended                                                          */
+/*                                                                            */
+/*!\param   const char *        when, for the report                          */
+/*!\param   uint32_t            samples appended so far                       */
+/*!\return  WINSYS_ERROR        value indicating success or failure           */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR Check( const char *pWhen, uint32_t Expected )
+{
+   WINSYS_ERROR   Results;
+   uint32_t       Count,
+                  Index;
+
+   if ( ( Results = HIST_Query( 0, ~0ULL, Decoded, HIST_TEST_SAMPLES + 2, &Count ) ) != STATUS_SUCCESS )
+   {
+      printf( "%s: HIST_Query failed, 0x%08X\n", pWhen, Results );
+      return Results;
+   }
+
+   printf( "%s: %u of %u samples\n", pWhen, Count, Expected );
+
+   if ( Count != Expected )
+   {
+      return TEST_FAILED;
+   }
+
+   for ( Index = 0; Index < Count; Index++ )
+   {
+      if ( ( Decoded[ Index ].TimestampMs != Appended[ Index ].TimestampMs ) ||
+           ( Decoded[ Index ].ValidMask != Appended[ Index ].ValidMask ) ||
+           ( memcmp( Decoded[ Index ].Raw, Appended[ Index ].Raw, sizeof( Decoded[ Index ].Raw ) ) ) )
+      {
+         printf( "   sample %u differs\n", Index );
+         return TEST_FAILED;
+      }
+   }
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: CheckRollups                                                    */
+/*                                                                            */
+/*!\brief  Queries the rollups at each level and checks every point against */
+/*!\brief  the samples appended in its bucket                               */
+/*                                                                            */
+/*!\param   const char *        when, for the report                          */
+/*!\param   uint32_t            samples appended so far                       */
+/*!\return  WINSYS_ERROR        value indicating success or failure           */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR CheckRollups( const char *pWhen, uint32_t Expected )
+{
+   HIST_POINT_STRUCT   Point;
+   WINSYS_ERROR        Results;
+   uint64_t            StartMs = HIST_TEST_START_MS,
+                       EndMs = Appended[ Expected - 1 ].TimestampMs,
+                       FirstMs;
+   uint32_t            Query,
+                       Count,
+                       ResolutionMs,
+                       Index,
+                       Sample,
+                       Sensor,
+                       Total,
+                       Covered,
+                       Readings[ EC_SENSOR_MAX ];
+   uint64_t            Sum[ EC_SENSOR_MAX ];
+
+   for ( Query = 0; Query < sizeof( Queries ) / sizeof( Queries[ 0 ] ); Query++ )
+   {
+      if ( ( Results = HIST_QueryRollup( StartMs, EndMs, Queries[ Query ].MaxPoints, Points, &Count, &ResolutionMs ) ) != STATUS_SUCCESS )
+      {
+         printf( "%s: HIST_QueryRollup failed, 0x%08X\n", pWhen, Results );
+         return Results;
+      }
+
+      printf( "%s: at most %4u points - %3u points of %7u msecs\n", pWhen, Queries[ Query ].MaxPoints, Count, ResolutionMs );
+
+      if ( ( ResolutionMs != Queries[ Query ].ResolutionMs ) || ( Count == 0 ) || ( Count > Queries[ Query ].MaxPoints ) )
+      {
+         return TEST_FAILED;
+      }
+
+      //
+      // the buckets that can come back are the newest MaxPoints of those the range touches
+      //
+
+      FirstMs = ( StartMs / ResolutionMs ) * ResolutionMs;
+
+      if ( EndMs / ResolutionMs - StartMs / ResolutionMs >= Queries[ Query ].MaxPoints )
+      {
+         FirstMs = ( EndMs / ResolutionMs + 1 - Queries[ Query ].MaxPoints ) * ResolutionMs;
+      }
+
+      for ( Sample = 0, Covered = 0; Sample < Expected; Sample++ )
+      {
+         Covered += ( Appended[ Sample ].TimestampMs >= FirstMs );
+      }
+
+      for ( Index = 0, Total = 0; Index < Count; Index++ )
+      {
+         memset( &Point, 0, sizeof( Point ) );
+         memset( Sum, 0, sizeof( Sum ) );
+         memset( Readings, 0, sizeof( Readings ) );
+         Point.StartMs = Points[ Index ].StartMs;
+
+         for ( Sample = 0; Sample < Expected; Sample++ )
+         {
+            if ( ( Appended[ Sample ].TimestampMs < Point.StartMs ) || ( Appended[ Sample ].TimestampMs >= Point.StartMs + ResolutionMs ) )
+            {
+               continue;
+            }
+
+            Point.Samples++;
+            Point.ValidMask |= Appended[ Sample ].ValidMask;
+
+            for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+            {
+               uint16_t   Raw = Appended[ Sample ].Raw[ Sensor ];
+
+               if ( ( Appended[ Sample ].ValidMask & EC_SENSOR_MASK( Sensor ) ) == 0 )
+               {
+                  continue;
+               }
+
+               if ( ( Readings[ Sensor ] == 0 ) || ( Raw < Point.Min[ Sensor ] ) )
+               {
+                  Point.Min[ Sensor ] = Raw;
+               }
+
+               if ( Raw > Point.Max[ Sensor ] )
+               {
+                  Point.Max[ Sensor ] = Raw;
+               }
+
+               Sum[ Sensor ] += Raw;
+               Readings[ Sensor ]++;
+            }
+         }
+
+         for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+         {
+            if ( Readings[ Sensor ] )
+            {
+               Point.Mean[ Sensor ] = ( uint16_t )( ( Sum[ Sensor ] + Readings[ Sensor ] / 2 ) / Readings[ Sensor ] );
+            }
+         }
+
+         if ( ( Point.StartMs % ResolutionMs ) || ( Point.StartMs < FirstMs ) || ( memcmp( &Point, &Points[ Index ], sizeof( Point ) ) ) )
+         {
+            printf( "   point %u, %u msecs buckets, differs\n", Index, ResolutionMs );
+            return TEST_FAILED;
+         }
+
+         Total += Points[ Index ].Samples;
+      }
+
+      if ( Total != Covered )
+      {
+         printf( "   %u of %u samples in the points\n", Total, Covered );
+         return TEST_FAILED;
+      }
+   }
+
+   return STATUS_SUCCESS;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: TearNewestBlock                                                 */
+/*                                                                            */
+/*!\brief  Writes a record past the commit word of the newest block without */
+/*!\brief  committing it, as a crash part way through HIST_Append() would    */
+/*                                                                            */
+/*!\return  WINSYS_ERROR        value indicating success or failure           */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR TearNewestBlock( void )
+{
+   HIST_BLOCK_HEADER_STRUCT   Header;
+   FILE                       *pFile;
+   uint64_t                   Newest = 0;
+   long                       NewestAt = 0;
+   uint32_t                   Block;
+   uint8_t                    Torn[ 16 ];
+
+   if ( fopen_s( &pFile, HIST_TEST_FILE, "r+b" ) != 0 )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+   }
+
+   for ( Block = 0; Block < HIST_TEST_BLOCKS; Block++ )
+   {
+      fseek( pFile, ( long )( Block + 1 ) * HIST_BLOCK_SIZE, SEEK_SET );
+
+      if ( ( fread( &Header, sizeof( Header ), 1, pFile ) == 1 ) && ( Header.Sequence > Newest ) )
+      {
+         Newest = Header.Sequence;
+         NewestAt = ( long )( Block + 1 ) * HIST_BLOCK_SIZE;
+      }
+   }
+
+   if ( Newest )
+   {
+      fseek( pFile, NewestAt, SEEK_SET );
+      fread( &Header, sizeof( Header ), 1, pFile );
+
+      memset( Torn, 0xff, sizeof( Torn ) );
+      fseek( pFile, NewestAt + ( long ) sizeof( Header ) + ( long ) HIST_COMMIT_BYTES( Header.Commit ), SEEK_SET );
+      fwrite( Torn, sizeof( Torn ), 1, pFile );
+   }
+
+   fclose( pFile );
+
+   return ( Newest ) ? STATUS_SUCCESS : WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_FOUND );
+}
+
+WINSYS_ERROR main()
+{
+   WINSYS_ERROR        Results = STATUS_SUCCESS;
+   HIST_STATS_STRUCT   StatsBefore,
+                       StatsAfter;
+   EC_SAMPLE_STRUCT    Sample;
+   uint32_t            Index,
+                       Sensor;
+
+   //
+   // about 1 Hz with some jitter and slowly moving readings; the CPU fan drops out of the samples half way,
+   // which starts a new block
+   //
+
+   memset( &Sample, 0, sizeof( Sample ) );
+   Sample.TimestampMs = HIST_TEST_START_MS;
+
+   for ( Index = 0; Index < HIST_TEST_SAMPLES; Index++ )
+   {
+      Sample.TimestampMs += 1000 + ( ( Index % 7 ) == 0 ) * 3;
+      Sample.ValidMask = ( uint16_t )( ( Index < HIST_TEST_SAMPLES / 2 ) ? EC_SENSOR_MASK_ALL : ( EC_SENSOR_MASK_ALL & ~EC_SENSOR_MASK( SENSOR_CPU_FAN ) ) );
+
+      for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+      {
+         Sample.Raw[ Sensor ] = ( uint16_t )( 0x0300 + Sensor * 16 + ( ( Index / ( Sensor + 3 ) ) % 5 ) );
+      }
+
+      Sample.Raw[ SENSOR_CPU_FAN ] = ( Sample.ValidMask & EC_SENSOR_MASK( SENSOR_CPU_FAN ) ) ? ( uint16_t )( 2400 + ( Index % 11 ) * 13 ) : 0;
+
+      Appended[ Index ] = Sample;
+   }
+
+   DeleteFileA( HIST_TEST_FILE );
+
+   if ( ( Results = HIST_Open( HIST_TEST_FILE, HIST_TEST_BLOCKS ) ) != STATUS_SUCCESS )
+   {
+      printf( "HIST_Open failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   for ( Index = 0; ( Index < HIST_TEST_SAMPLES ) && ( Results == STATUS_SUCCESS ); Index++ )
+   {
+      Results = HIST_Append( &Appended[ Index ] );
+   }
+
+   if ( Results == STATUS_SUCCESS )
+   {
+      if ( ( Results = Check( "before close", HIST_TEST_SAMPLES ) ) == STATUS_SUCCESS )
+      {
+         HIST_GetStats( &StatsBefore );
+         printf( "blocks used: %u, bytes/sample x100: %u\n", StatsBefore.BlocksUsed, StatsBefore.BytesPerSampleX100 );
+
+         Results = CheckRollups( "before close", HIST_TEST_SAMPLES );
+      }
+   }
+
+   HIST_Close();
+
+   if ( ( Results == STATUS_SUCCESS ) && ( StatsBefore.BlocksUsed < 3 ) )
+   {
+      printf( "the samples should span at least 3 blocks\n" );
+      Results = TEST_FAILED;
+   }
+
+   if ( Results == STATUS_SUCCESS )
+   {
+      Results = TearNewestBlock();
+   }
+
+   if ( ( Results == STATUS_SUCCESS ) && ( ( Results = HIST_Open( HIST_TEST_FILE, 0 ) ) == STATUS_SUCCESS ) )
+   {
+      //
+      // the rollups are rebuilt from the file, and must match the samples at every level again
+      //
+
+      if ( ( ( Results = Check( "after reopen", HIST_TEST_SAMPLES ) ) == STATUS_SUCCESS ) &&
+           ( ( Results = CheckRollups( "after reopen", HIST_TEST_SAMPLES ) ) == STATUS_SUCCESS ) )
+      {
+         HIST_GetStats( &StatsAfter );
+
+         if ( ( StatsAfter.Samples != StatsBefore.Samples ) || ( StatsAfter.Bytes != StatsBefore.Bytes ) )
+         {
+            printf( "stats differ after reopening\n" );
+            Results = TEST_FAILED;
+         }
+      }
+
+      //
+      // the encoder resumes from the newest sample, so the next sample lands in the same block
+      //
+
+      if ( Results == STATUS_SUCCESS )
+      {
+         Sample.TimestampMs += 1000;
+         Sample.Raw[ SENSOR_CPU_TEMP ]++;
+         Appended[ HIST_TEST_SAMPLES ] = Sample;
+
+         if ( ( Results = HIST_Append( &Sample ) ) == STATUS_SUCCESS )
+         {
+            HIST_GetStats( &StatsAfter );
+
+            if ( ( ( Results = Check( "appended after reopen", HIST_TEST_SAMPLES + 1 ) ) == STATUS_SUCCESS ) &&
+                 ( ( Results = CheckRollups( "appended after reopen", HIST_TEST_SAMPLES + 1 ) ) == STATUS_SUCCESS ) &&
+                 ( StatsAfter.BlocksUsed != StatsBefore.BlocksUsed ) )
+            {
+               printf( "the sample started a new block\n" );
+               Results = TEST_FAILED;
+            }
+         }
+      }
+
+      HIST_Close();
+   }
+
+   DeleteFileA( HIST_TEST_FILE );
+
+   printf( "%s\n", ( Results == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   return Results;
+}
@@ -0,0 +1,276 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : PERF_Alarms.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Runs a scripted sequence of samples through ALRM_Evaluate() and checks
+//      the alarms raised and cleared - debounce, a glitch restarting the
+//      count, hysteresis holding an alarm, and a rate rule. Then loads a few
+//      hundred rules and reports how long a sample takes to evaluate. Needs
+//      no EC hardware.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Alarms.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_RULES           300
+#define BENCH_SAMPLES         100000
+#define SCRIPT_START_MS       1000000ULL
+#define MAX_FIRED             32
+
+/*!\struct _FIRED_STRUCT
+ * \brief  An alarm the script expects, or one the callback saw
+ */
+typedef struct _FIRED_STRUCT {
+                                uint32_t     Step;                   // script step, from 1
+                                uint32_t     Rule;                   // index into RuleIds
+                                uint32_t     Raised;
+
+                             } FIRED_STRUCT, *P_FIRED_STRUCT;
+
+//
+// CPU and SYS temperatures, a sample a second. The CPU rule is ABOVE 80 with hysteresis 5 and debounce 3, the SYS
+// rule BELOW 40 with hysteresis 5 and debounce 2, and the rate rule CPU RISING faster than 10 per second
+//
+
+static const uint16_t        Script[][ 2 ] = {
+                                                { 70, 50 },    //  1
+                                                { 81, 50 },    //  2  ABOVE 1 of 3, RISING raised
+                                                { 81, 50 },    //  3  ABOVE 2 of 3, RISING cleared
+                                                { 70, 50 },    //  4  glitch - ABOVE count restarts
+                                                { 81, 50 },    //  5  ABOVE 1 of 3, RISING raised
+                                                { 81, 50 },    //  6  ABOVE 2 of 3, RISING cleared
+                                                { 81, 39 },    //  7  ABOVE raised, BELOW 1 of 2
+                                                { 78, 39 },    //  8  inside the ABOVE hysteresis band, BELOW raised
+                                                { 74, 44 },    //  9  ABOVE clearing 1 of 3, inside the BELOW band
+                                                { 74, 46 },    // 10  ABOVE clearing 2 of 3, BELOW clearing 1 of 2
+                                                { 76, 46 },    // 11  back inside the band - ABOVE count restarts, BELOW cleared
+                                                { 74, 50 },    // 12
+                                                { 74, 50 },    // 13
+                                                { 74, 50 },    // 14  ABOVE cleared
+                                             };
+
+static const FIRED_STRUCT    Expected[] = { { 2, 2, 1 }, { 3, 2, 0 }, { 5, 2, 1 }, { 6, 2, 0 }, { 7, 0, 1 }, { 8, 1, 1 }, { 11, 1, 0 }, { 14, 0, 0 } };
+
+static uint32_t              RuleIds[ 3 ];
+static FIRED_STRUCT          Fired[ MAX_FIRED ];
+static uint32_t              FiredCount = 0;
+static uint32_t              BenchFired = 0;
+static uint32_t              EvalNs[ BENCH_SAMPLES ];
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OnScriptAlarm                                                   */
+/*                                                                            */
+/*!\brief  Records an alarm raised or cleared by the script                  */
+/*                                                                            */
+/*!\param   P_ALRM_EVENT_STRUCT the alarm                                    */
+/*!\param   PVOID               unused                                        */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/******************************************************************************/
+static void OnScriptAlarm( P_ALRM_EVENT_STRUCT pAlarm, PVOID pContext )
+{
+   uint32_t   Rule;
+
+   UNREFERENCED_PARAMETER( pContext );
+
+   for ( Rule = 0; ( Rule < 3 ) && ( RuleIds[ Rule ] != pAlarm->Rule ); Rule++ )
+   {
+   }
+
+   if ( FiredCount < MAX_FIRED )
+   {
+      Fired[ FiredCount ].Step = ( uint32_t )( ( pAlarm->TimestampMs - SCRIPT_START_MS ) / 1000 ) + 1;
+      Fired[ FiredCount ].Rule = Rule;
+      Fired[ FiredCount ].Raised = pAlarm->Raised;
+      FiredCount++;
+   }
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: OnBenchAlarm                                                    */
+/*                                                                            */
+/*!\brief  Counts the alarms raised and cleared by the benchmark             */
+/*                                                                            */
+/*!\param   P_ALRM_EVENT_STRUCT the alarm                                    */
+/*!\param   PVOID               unused                                        */
+/*!\return  <void>                                                            */
+/*                                                                            */
+/******************************************************************************/
+static void OnBenchAlarm( P_ALRM_EVENT_STRUCT pAlarm, PVOID pContext )
+{
+   UNREFERENCED_PARAMETER( pAlarm );
+   UNREFERENCED_PARAMETER( pContext );
+
+   BenchFired++;
+}
+
+static int CompareNs( const void *pA, const void *pB )
+{
+   uint32_t   A = *( const uint32_t * ) pA,
+              B = *( const uint32_t * ) pB;
+
+   return ( A > B ) - ( A < B );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: RunScript                                                       */
+/*                                                                            */
+/*!\brief  Runs the script through the alarm engine and checks the alarms   */
+/*                                                                            */
+/*!\return  WINSYS_ERROR        value indicating success or failure           */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR RunScript( void )
+{
+   ALRM_RULE_STRUCT   Above = { SENSOR_CPU_TEMP, ALRM_ABOVE, 3, 80, 5 },
+                      Below = { SENSOR_SYS_TEMP, ALRM_BELOW, 2, 40, 5 },
+                      Rising = { SENSOR_CPU_TEMP, ALRM_RISING, 1, 10, 0 };
+   EC_SAMPLE_STRUCT   Sample;
+   WINSYS_ERROR       Results = STATUS_SUCCESS;
+   uint32_t           Step,
+                      Index;
+
+   ALRM_AddRule( &Above, &RuleIds[ 0 ] );
+   ALRM_AddRule( &Below, &RuleIds[ 1 ] );
+   ALRM_AddRule( &Rising, &RuleIds[ 2 ] );
+   ALRM_SetDelivery( ALRM_DELIVER_CALLBACK, OnScriptAlarm, NULL );
+
+   memset( &Sample, 0, sizeof( Sample ) );
+   Sample.ValidMask = EC_SENSOR_MASK( SENSOR_CPU_TEMP ) | EC_SENSOR_MASK( SENSOR_SYS_TEMP );
+
+   for ( Step = 0; Step < sizeof( Script ) / sizeof( Script[ 0 ] ); Step++ )
+   {
+      Sample.TimestampMs = SCRIPT_START_MS + Step * 1000;
+      Sample.Sequence = Step;
+      Sample.Raw[ SENSOR_CPU_TEMP ] = Script[ Step ][ 0 ];
+      Sample.Raw[ SENSOR_SYS_TEMP ] = Script[ Step ][ 1 ];
+
+      ALRM_Evaluate( &Sample );
+   }
+
+   for ( Index = 0; Index < FiredCount; Index++ )
+   {
+      printf( "step %2u  rule %u  %s\n", Fired[ Index ].Step, Fired[ Index ].Rule, ( Fired[ Index ].Raised ) ? "raised" : "cleared" );
+   }
+
+   if ( ( FiredCount != sizeof( Expected ) / sizeof( Expected[ 0 ] ) ) || ( memcmp( Fired, Expected, sizeof( Expected ) ) ) )
+   {
+      printf( "expected %u alarms:\n", ( uint32_t )( sizeof( Expected ) / sizeof( Expected[ 0 ] ) ) );
+
+      for ( Index = 0; Index < sizeof( Expected ) / sizeof( Expected[ 0 ] ); Index++ )
+      {
+         printf( "step %2u  rule %u  %s\n", Expected[ Index ].Step, Expected[ Index ].Rule, ( Expected[ Index ].Raised ) ? "raised" : "cleared" );
+      }
+
+      Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+   }
+
+   for ( Index = 0; Index < 3; Index++ )
+   {
+      ALRM_RemoveRule( RuleIds[ Index ] );
+   }
+
+   return Results;
+}
+
+WINSYS_ERROR main()
+{
+   ALRM_RULE_STRUCT    Rule;
+   ALRM_STATS_STRUCT   Stats;
+   EC_SAMPLE_STRUCT    Sample;
+   WINSYS_ERROR        Results;
+   uint64_t            TotalNs = 0;
+   uint32_t            Index,
+                       Sensor,
+                       RuleId;
+
+   Results = RunScript();
+   printf( "debounce and hysteresis %s\n\n", ( Results == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   //
+   // every kind on every sensor, with thresholds spread over the readings so that some rules move each sample
+   //
+
+   for ( Index = 0; Index < BENCH_RULES; Index++ )
+   {
+      Rule.Sensor = ( uint8_t )( Index % SENSOR_COUNT );
+      Rule.Kind = ( uint8_t )( Index % ALRM_KIND_COUNT );
+      Rule.Debounce = ( uint16_t )( 1 + Index % 4 );
+      Rule.Threshold = 40 + Index % 50;
+      Rule.Hysteresis = 2;
+
+      ALRM_AddRule( &Rule, &RuleId );
+   }
+
+   ALRM_SetDelivery( ALRM_DELIVER_CALLBACK, OnBenchAlarm, NULL );
+
+   memset( &Sample, 0, sizeof( Sample ) );
+   Sample.ValidMask = EC_SENSOR_MASK_ALL;
+
+   for ( Index = 0; Index < BENCH_SAMPLES; Index++ )
+   {
+      Sample.TimestampMs = SCRIPT_START_MS + Index * 100;
+      Sample.Sequence = Index;
+
+      for ( Sensor = 0; Sensor < SENSOR_COUNT; Sensor++ )
+      {
+         Sample.Raw[ Sensor ] = ( uint16_t )( 40 + ( Index / 50 + Sensor ) % 50 + ( ( Index * 2654435761u ) >> 30 ) );
+      }
+
+      ALRM_Evaluate( &Sample );
+      ALRM_GetStats( &Stats );
+
+      EvalNs[ Index ] = Stats.LastEvalNs;
+      TotalNs += Stats.LastEvalNs;
+   }
+
+   qsort( EvalNs, BENCH_SAMPLES, sizeof( EvalNs[ 0 ] ), CompareNs );
+
+   printf( "%u rules, %u samples, %u alarms raised or cleared\n", Stats.Rules, BENCH_SAMPLES, BenchFired );
+   printf( "evaluation  mean %6.1f ns  min %6u ns  median %6u ns  99%% %6u ns  max %6u ns\n",
+           ( double ) TotalNs / BENCH_SAMPLES, EvalNs[ 0 ], EvalNs[ BENCH_SAMPLES / 2 ], EvalNs[ BENCH_SAMPLES * 99 / 100 ], EvalNs[ BENCH_SAMPLES - 1 ] );
+   printf( "            %6.2f ns per rule at the median, %s 1 usec per sample\n",
+           ( double ) EvalNs[ BENCH_SAMPLES / 2 ] / Stats.Rules, ( EvalNs[ BENCH_SAMPLES / 2 ] < 1000 ) ? "under" : "OVER" );
+
+   printf( "%s\n", ( Results == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   return Results;
+}
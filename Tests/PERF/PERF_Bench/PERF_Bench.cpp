@@ -0,0 +1,144 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : PERF_Bench.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Benchmark of the batch raw to millivolt conversion kernels. Needs no
+//      EC hardware.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <math.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Units.h>
+
+#define BENCH_SAMPLES         ( 16 * 1024 * 1024 )
+#define BENCH_PASSES          8
+#define BENCH_CACHED          8192                  // samples that stay in L1 with their results
+
+static const char    *KernelNames[] = { "auto", "scalar", "SSE2", "AVX2" };
+
+WINSYS_ERROR main()
+{
+   uint16_t        *pRaw = new uint16_t[ BENCH_SAMPLES ];
+   uint32_t        *pReference = new uint32_t[ BENCH_SAMPLES ];
+   uint32_t        *pMilli = new uint32_t[ BENCH_SAMPLES ];
+   uint32_t        Index,
+                   Pass,
+                   Kernel,
+                   MaxError = 0;
+   LARGE_INTEGER   Start,
+                   End,
+                   Frequency;
+   WINSYS_ERROR    Status = STATUS_SUCCESS;
+
+   QueryPerformanceFrequency( &Frequency );
+
+   //
+   // every raw value, then a noisy 12V rail - the 10 bit ADC reads around 620
+   //
+
+   for ( Index = 0; Index < BENCH_SAMPLES; Index++ )
+   {
+      pRaw[ Index ] = ( Index < 65536 ) ? ( uint16_t ) Index : ( uint16_t )( 600 + ( Index * 2654435761u >> 27 ) );
+   }
+
+   //
+   // the double conversion PWR_Get12V() does, rounded, as the reference and the baseline time
+   //
+
+   QueryPerformanceCounter( &Start );
+   for ( Index = 0; Index < BENCH_SAMPLES; Index++ )
+   {
+      pReference[ Index ] = ( uint32_t )( pRaw[ Index ] * V12_SCALE_FACTOR + 0.5 );
+   }
+   QueryPerformanceCounter( &End );
+
+   printf( "%u samples, 12V rail\n", BENCH_SAMPLES );
+   printf( "double           %8.1f Msamples/s\n", BENCH_SAMPLES / ( ( double )( End.QuadPart - Start.QuadPart ) / Frequency.QuadPart ) / 1e6 );
+
+   for ( Kernel = UNIT_KERNEL_SCALAR; Kernel <= UNIT_KERNEL_AVX2; Kernel++ )
+   {
+      if ( UNIT_SetKernel( Kernel ) != STATUS_SUCCESS )
+      {
+         printf( "%-16s not supported by this CPU\n", KernelNames[ Kernel ] );
+         continue;
+      }
+
+      double   Cached;
+
+      QueryPerformanceCounter( &Start );
+      for ( Pass = 0; Pass < BENCH_SAMPLES / BENCH_CACHED; Pass++ )
+      {
+         UNIT_ToMilli( SENSOR_V12, pRaw, pMilli, BENCH_CACHED );
+      }
+      QueryPerformanceCounter( &End );
+
+      Cached = ( double ) BENCH_SAMPLES / ( ( double )( End.QuadPart - Start.QuadPart ) / Frequency.QuadPart ) / 1e6;
+
+      QueryPerformanceCounter( &Start );
+      for ( Pass = 0; Pass < BENCH_PASSES; Pass++ )
+      {
+         UNIT_ToMilli( SENSOR_V12, pRaw, pMilli, BENCH_SAMPLES );
+      }
+      QueryPerformanceCounter( &End );
+
+      for ( Index = 0; Index < BENCH_SAMPLES; Index++ )
+      {
+         uint32_t   Error = ( pMilli[ Index ] > pReference[ Index ] ) ? pMilli[ Index ] - pReference[ Index ] : pReference[ Index ] - pMilli[ Index ];
+
+         MaxError = ( Error > MaxError ) ? Error : MaxError;
+      }
+
+      printf( "%-16s %8.1f Msamples/s, %8.1f Msamples/s in cache\n", KernelNames[ Kernel ],
+              ( double ) BENCH_SAMPLES * BENCH_PASSES / ( ( double )( End.QuadPart - Start.QuadPart ) / Frequency.QuadPart ) / 1e6, Cached );
+   }
+
+   UNIT_SetKernel( UNIT_KERNEL_AUTO );
+   UNIT_GetKernel( &Kernel );
+
+   printf( "largest difference from the double conversion %u mV\n", MaxError );
+   printf( "UNIT_KERNEL_AUTO uses %s\n", KernelNames[ Kernel ] );
+
+   if ( MaxError > 1 )
+   {
+      Status = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+   }
+
+   delete [] pRaw;
+   delete [] pReference;
+   delete [] pMilli;
+
+   return Status;
+}
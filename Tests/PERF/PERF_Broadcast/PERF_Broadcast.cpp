@@ -0,0 +1,212 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : PERF_Broadcast.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Publishes samples into the broadcast ring with 1 to 32 subscribers
+//      reading them, and reports the cost of a publish, what each subscriber
+//      read and missed, and any sample it got out of order
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Broadcast.h>
+
+#define MAX_READERS           32
+#define PUBLISH_COUNT         1000000
+#define READ_BATCH            64
+
+typedef struct _READER_STRUCT {
+                                 uint32_t    Handle;
+                                 uint64_t    Read;
+                                 uint64_t    Missed;
+                                 uint64_t    Disordered;
+
+                              } READER_STRUCT;
+
+static volatile LONG    Running;
+static READER_STRUCT    Readers[ MAX_READERS ];
+
+static DWORD WINAPI Reader( LPVOID pParam )
+{
+   READER_STRUCT      *pReader = ( READER_STRUCT * ) pParam;
+   EC_SAMPLE_STRUCT   Samples[ READ_BATCH ];
+   uint32_t           Count,
+                      Missed,
+                      Expected = 0,
+                      Index;
+   uint64_t           Skipped = 0;
+   BOOL               Stopping;
+
+   do
+   {
+      Stopping = ( Running == 0 );
+
+      if ( BRD_Read( pReader->Handle, Samples, READ_BATCH, &Count, &Missed ) != STATUS_SUCCESS )
+      {
+         break;
+      }
+
+      //
+      // every sample must be newer than the last, and the ones skipped over must be the ones reported missed
+      //
+
+      for ( Index = 0; Index < Count; Index++ )
+      {
+         if ( Samples[ Index ].Sequence < Expected )
+             {
+                pReader->Disordered++;
+             }
+         else
+             {
+                Skipped += Samples[ Index ].Sequence - Expected;
+             }
+
+         Expected = Samples[ Index ].Sequence + 1;
+      }
+
+      pReader->Read += Count;
+      pReader->Missed += Missed;
+
+      if ( Count == 0 )
+      {
+         SwitchToThread();
+      }
+
+   } while ( ( ! Stopping ) || ( Count ) );
+
+   Skipped += PUBLISH_COUNT - Expected;
+
+   if ( Skipped != pReader->Missed )
+   {
+      pReader->Disordered++;
+   }
+
+   return 0;
+}
+
+static WINSYS_ERROR Run( uint32_t ReaderCount )
+{
+   HANDLE             Threads[ MAX_READERS ];
+   EC_SAMPLE_STRUCT   Sample;
+   LARGE_INTEGER      Frequency,
+                      Start,
+                      Stop;
+   WINSYS_ERROR       Results = STATUS_SUCCESS;
+   uint64_t           Read = 0,
+                      Missed = 0,
+                      Disordered = 0;
+   uint32_t           Index;
+
+   memset( &Sample, 0, sizeof( Sample ) );
+   memset( Readers, 0, sizeof( Readers ) );
+   Running = 1;
+
+   for ( Index = 0; Index < ReaderCount; Index++ )
+   {
+      if ( ( Results = BRD_Subscribe( &Readers[ Index ].Handle ) ) != STATUS_SUCCESS )
+      {
+         printf( "BRD_Subscribe failed, 0x%08X\n", Results );
+         ReaderCount = Index;
+         break;
+      }
+   }
+
+   for ( Index = 0; Index < ReaderCount; Index++ )
+   {
+      Threads[ Index ] = CreateThread( NULL, 0, Reader, &Readers[ Index ], 0, NULL );
+   }
+
+   QueryPerformanceFrequency( &Frequency );
+   QueryPerformanceCounter( &Start );
+
+   for ( Sample.Sequence = 0; Sample.Sequence < PUBLISH_COUNT; Sample.Sequence++ )
+   {
+      BRD_Publish( &Sample );
+   }
+
+   QueryPerformanceCounter( &Stop );
+
+   InterlockedExchange( &Running, 0 );
+
+   if ( ReaderCount )
+   {
+      WaitForMultipleObjects( ReaderCount, Threads, TRUE, INFINITE );
+   }
+
+   for ( Index = 0; Index < ReaderCount; Index++ )
+   {
+      CloseHandle( Threads[ Index ] );
+      BRD_Unsubscribe( Readers[ Index ].Handle );
+
+      Read += Readers[ Index ].Read;
+      Missed += Readers[ Index ].Missed;
+      Disordered += Readers[ Index ].Disordered;
+   }
+
+   printf( "%2u subscribers: %6.1f ns per publish, %10llu read, %10llu missed, %llu out of order\n", ReaderCount,
+           ( double )( Stop.QuadPart - Start.QuadPart ) * 1e9 / Frequency.QuadPart / PUBLISH_COUNT, Read, Missed, Disordered );
+
+   if ( ( Read + Missed != ( uint64_t ) ReaderCount * PUBLISH_COUNT ) || ( Disordered ) )
+   {
+      printf( "   subscribers lost track of the samples\n" );
+      Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+   }
+
+   return Results;
+}
+
+WINSYS_ERROR main()
+{
+   BRD_STATS_STRUCT   Stats;
+   WINSYS_ERROR       Results = STATUS_SUCCESS;
+   uint32_t           ReaderCount;
+
+   //
+   // the sampler stays stopped, which makes this thread the ring's one writer
+   //
+
+   for ( ReaderCount = 1; ReaderCount <= MAX_READERS; ReaderCount *= 2 )
+   {
+      if ( Results == STATUS_SUCCESS )
+      {
+         Results = Run( ReaderCount );
+      }
+   }
+
+   BRD_GetStats( &Stats );
+   printf( "%llu published, %llu missed, %u still subscribed\n", Stats.Published, Stats.Missed, Stats.Subscribers );
+
+   return Results;
+}
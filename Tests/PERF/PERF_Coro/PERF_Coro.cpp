@@ -0,0 +1,144 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : PERF_Coro.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Builds ITE8528_EC_Coro.h as C++20 and runs a coroutine over it: the
+//      CPU fan and VCore words are read through the awaitables and checked
+//      against byte reads, and an operation whose stop was requested up
+//      front must complete with STATUS_CANCELLED
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Async.h>
+#include <ITE8528_EC_Coro.h>
+#include <stdlib.h>
+
+#define FAN_COUNT_SLACK       64          // the fan may move between the two reads
+
+static HANDLE          DoneEvent;
+static WINSYS_ERROR    CoroResults = STATUS_SUCCESS;
+
+static ite8528::EcTask Check( ite8528::EcDispatcher &Ec )
+{
+   ite8528::EcResult   Result;
+   uint8_t             High,
+                       Low;
+   uint16_t            Word;
+
+   Result = co_await Ec.ReadBlock( CPU_FAN_H_OFFSET, 2 );
+   if ( ( Result.Ok() ) && ( ( CoroResults = EC_ReadByteUsingACPI( CPU_FAN_H_OFFSET, &High ) ) == STATUS_SUCCESS ) &&
+        ( ( CoroResults = EC_ReadByteUsingACPI( CPU_FAN_L_OFFSET, &Low ) ) == STATUS_SUCCESS ) )
+       {
+          Word = ( uint16_t )( ( High << 8 ) + Low );
+          printf( "CPU fan count: awaited 0x%04X, bytes 0x%04X\n", Result.Word(), Word );
+
+          if ( abs( ( int ) Result.Word() - ( int ) Word ) > FAN_COUNT_SLACK )
+          {
+             printf( "   Word() does not match CPU_FAN_H/L\n" );
+             CoroResults = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+          }
+       }
+   else if ( ! Result.Ok() )
+       {
+          CoroResults = Result.Status;
+       }
+
+   if ( CoroResults == STATUS_SUCCESS )
+   {
+      Result = co_await Ec.ReadBlock( VCORE_L_OFFSET, 2 );
+      if ( ( Result.Ok() ) && ( ( CoroResults = EC_ReadByteUsingACPI( VCORE_H_OFFSET, &High ) ) == STATUS_SUCCESS ) &&
+           ( ( CoroResults = EC_ReadByteUsingACPI( VCORE_L_OFFSET, &Low ) ) == STATUS_SUCCESS ) )
+          {
+             printf( "VCore: awaited 0x%04X, bytes 0x%04X\n", Result.WordLowFirst(), ( High << 8 ) + Low );
+          }
+      else if ( ! Result.Ok() )
+          {
+             CoroResults = Result.Status;
+          }
+   }
+
+   if ( CoroResults == STATUS_SUCCESS )
+   {
+      std::stop_source   Stop;
+
+      Stop.request_stop();
+
+      Result = co_await Ec.Read( CPU_TEMPERATURE_OFFSET, { Stop.get_token() } );
+      printf( "read after stop: 0x%08X\n", Result.Status );
+
+      if ( Result.Status != WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_CANCELLED ) )
+      {
+         CoroResults = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+      }
+   }
+
+   SetEvent( DoneEvent );
+}
+
+WINSYS_ERROR main()
+{
+   WINSYS_ERROR   Results;
+
+   if ( ( Results = ASYNC_Start() ) != STATUS_SUCCESS )
+   {
+      printf( "ASYNC_Start failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   DoneEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
+
+   {
+      ite8528::EcDispatcher   Dispatcher;
+
+      Check( Dispatcher );
+
+      if ( WaitForSingleObject( DoneEvent, 5000 ) != WAIT_OBJECT_0 )
+          {
+             printf( "coroutine did not finish\n" );
+             Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_TIMEOUT );
+          }
+      else
+          {
+             Results = CoroResults;
+          }
+   }
+
+   CloseHandle( DoneEvent );
+   ASYNC_Stop();
+
+   printf( "%s\n", ( Results == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   return Results;
+}
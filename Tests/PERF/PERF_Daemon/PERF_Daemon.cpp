@@ -0,0 +1,229 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : PERF_Daemon.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Compares the sensor reads per second of several tools each reading the
+//      EC themselves with the same tools asking a running ITE8528_EC_Daemon
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <winsock2.h>
+#include <windows.h>
+#include <afunix.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_History.h>
+#include <ITE8528_EC_Stats.h>
+#include <ITE8528_EC_Daemon.h>
+
+#define TOOL_COUNT            8
+#define RUN_MS                5000
+
+static volatile LONG    Running = 1;
+static uint64_t         Reads[ TOOL_COUNT ];
+
+//
+// one request for the readings and statistics of every sensor, and room for its reply
+//
+
+typedef struct _REQUEST_STRUCT {
+                                  ECD_REQUEST_HEADER_STRUCT   Header;
+                                  ECD_ITEM_STRUCT             Items[ 2 ];
+
+                               } REQUEST_STRUCT;
+
+typedef struct _REPLY_STRUCT {
+                                ECD_RESPONSE_HEADER_STRUCT   Header;
+                                ECD_RESULT_STRUCT            SensorsResult;
+                                EC_SAMPLE_STRUCT             Sample;
+                                ECD_RESULT_STRUCT            StatsResult;
+                                STAT_SENSOR_STRUCT           Stats[ SENSOR_COUNT ];
+
+                             } REPLY_STRUCT;
+
+static SOCKET Connect( void )
+{
+   SOCKADDR_UN   Address;
+   SOCKET        Socket;
+
+   memset( &Address, 0, sizeof( Address ) );
+   Address.sun_family = AF_UNIX;
+   strcpy_s( Address.sun_path, sizeof( Address.sun_path ), ECD_DEFAULT_SOCKET_PATH );
+
+   if ( ( Socket = socket( AF_UNIX, SOCK_STREAM, 0 ) ) != INVALID_SOCKET )
+   {
+      if ( connect( Socket, ( SOCKADDR * ) &Address, sizeof( Address ) ) != 0 )
+      {
+         closesocket( Socket );
+         Socket = INVALID_SOCKET;
+      }
+   }
+
+   return Socket;
+}
+
+static BOOL Ask( SOCKET Socket, REQUEST_STRUCT *pRequest, REPLY_STRUCT *pReply )
+{
+   char   *pNext = ( char * ) pReply;
+   int    Want = sizeof( pReply->Header ),
+          Got;
+
+   if ( send( Socket, ( const char * ) pRequest, sizeof( *pRequest ), 0 ) != sizeof( *pRequest ) )
+   {
+      return FALSE;
+   }
+
+   while ( Want )
+   {
+      if ( ( Got = recv( Socket, pNext, Want, 0 ) ) <= 0 )
+      {
+         return FALSE;
+      }
+
+      pNext += Got;
+      Want -= Got;
+
+      if ( ( Want == 0 ) && ( pNext == ( char * ) pReply + sizeof( pReply->Header ) ) )
+      {
+         if ( pReply->Header.Bytes > sizeof( *pReply ) - sizeof( pReply->Header ) )
+         {
+            return FALSE;
+         }
+
+         Want = pReply->Header.Bytes;
+      }
+   }
+
+   return ( pReply->SensorsResult.Status == STATUS_SUCCESS );
+}
+
+static DWORD WINAPI DirectTool( LPVOID pParam )
+{
+   uint64_t           *pReads = ( uint64_t * ) pParam;
+   EC_SAMPLE_STRUCT   Sample;
+
+   while ( Running )
+   {
+      if ( SMP_QuerySensors( EC_SENSOR_MASK_ALL, &Sample ) == STATUS_SUCCESS )
+      {
+         ( *pReads )++;
+      }
+   }
+
+   return 0;
+}
+
+static DWORD WINAPI DaemonTool( LPVOID pParam )
+{
+   uint64_t         *pReads = ( uint64_t * ) pParam;
+   REQUEST_STRUCT   Request;
+   REPLY_STRUCT     Reply;
+   SOCKET           Socket;
+
+   memset( &Request, 0, sizeof( Request ) );
+   Request.Header.Magic = ECD_MAGIC;
+   Request.Header.ItemCount = 2;
+   Request.Items[ 0 ].Type = ECD_ITEM_SENSORS;
+   Request.Items[ 0 ].SensorMask = EC_SENSOR_MASK_ALL;
+   Request.Items[ 1 ].Type = ECD_ITEM_SENSOR_STATS;
+   Request.Items[ 1 ].SensorMask = EC_SENSOR_MASK_ALL;
+
+   if ( ( Socket = Connect() ) != INVALID_SOCKET )
+   {
+      while ( ( Running ) && ( Ask( Socket, &Request, &Reply ) ) )
+      {
+         Request.Header.Tag++;
+         ( *pReads )++;
+      }
+
+      closesocket( Socket );
+   }
+
+   return 0;
+}
+
+static double Run( LPTHREAD_START_ROUTINE pTool )
+{
+   HANDLE     Threads[ TOOL_COUNT ];
+   uint64_t   Total = 0;
+   uint32_t   Index;
+
+   Running = 1;
+
+   for ( Index = 0; Index < TOOL_COUNT; Index++ )
+   {
+      Reads[ Index ] = 0;
+      Threads[ Index ] = CreateThread( NULL, 0, pTool, &Reads[ Index ], 0, NULL );
+   }
+
+   Sleep( RUN_MS );
+   InterlockedExchange( &Running, 0 );
+   WaitForMultipleObjects( TOOL_COUNT, Threads, TRUE, INFINITE );
+
+   for ( Index = 0; Index < TOOL_COUNT; Index++ )
+   {
+      CloseHandle( Threads[ Index ] );
+      Total += Reads[ Index ];
+   }
+
+   return ( double ) Total * 1000.0 / RUN_MS;
+}
+
+WINSYS_ERROR main()
+{
+   WSADATA   WsaData;
+   SOCKET    Socket;
+
+   if ( WSAStartup( MAKEWORD( 2, 2 ), &WsaData ) != 0 )
+   {
+      printf( "WSAStartup failed\n" );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+   }
+
+   printf( "%u tools reading every sensor themselves: %.0f reads/s\n", TOOL_COUNT, Run( DirectTool ) );
+
+   if ( ( Socket = Connect() ) == INVALID_SOCKET )
+       {
+          printf( "no daemon listening on %s - start ITE8528_EC_Daemon and run again\n", ECD_DEFAULT_SOCKET_PATH );
+       }
+   else
+       {
+          closesocket( Socket );
+          printf( "%u tools asking the daemon for every sensor and its statistics: %.0f reads/s\n", TOOL_COUNT,
+                  Run( DaemonTool ) );
+       }
+
+   WSACleanup();
+
+   return STATUS_SUCCESS;
+}
@@ -0,0 +1,94 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : PERF_Dual.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Runs the dual path self-test and reports whether splitting sweeps
+//      across the ACPI and IO space paths is safe and faster on this board,
+//      then times full sensor queries in whichever mode it chose
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Dual.h>
+
+#define QUERY_COUNT           1000
+
+static const char    *FaultNames[] = { "none", "ACPI reads fail", "IO space window differs", "interference",
+                                       "no gain", "runtime failures" };
+
+WINSYS_ERROR main()
+{
+   DUAL_TEST_STRUCT    Test;
+   DUAL_STATS_STRUCT   Stats;
+   EC_SAMPLE_STRUCT    Sample;
+   LARGE_INTEGER       Frequency,
+                       Start,
+                       Stop;
+   WINSYS_ERROR        Results;
+   uint32_t            Index;
+
+   if ( ( Results = DUAL_SelfTest( 0, &Test ) ) != STATUS_SUCCESS )
+   {
+      printf( "DUAL_SelfTest failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   printf( "self-test: %s, dual mode %s\n", FaultNames[ Test.Fault ], ( Test.Enabled ) ? "on" : "off" );
+   printf( "   ACPI errors %u alone, %u shared; %u probe mismatches; %u torn IO space reads\n", Test.AcpiErrorsAlone,
+           Test.AcpiErrorsShared, Test.Mismatches, Test.Tears );
+   printf( "   sweep: ACPI %.1f us, IO space %.1f us, split %.1f us\n", Test.AcpiSweepUs, Test.IoSweepUs, Test.DualSweepUs );
+   printf( "   model: burst %.2f us + %.2f us/byte, IO space %.2f us/byte, hand off %.2f us\n", Test.AcpiBurstUs, Test.AcpiByteUs,
+           Test.IoByteUs, Test.HandoffUs );
+
+   QueryPerformanceFrequency( &Frequency );
+   QueryPerformanceCounter( &Start );
+
+   for ( Index = 0; ( Index < QUERY_COUNT ) && ( Results == STATUS_SUCCESS ); Index++ )
+   {
+      Results = SMP_QuerySensors( EC_SENSOR_MASK_ALL, &Sample );
+   }
+
+   QueryPerformanceCounter( &Stop );
+
+   DUAL_GetStats( &Stats );
+
+   printf( "%u queries of every sensor: %.1f us each, %llu split, %llu retried, %llu torn, %llu fell back to ACPI\n", Index,
+           ( double )( Stop.QuadPart - Start.QuadPart ) * 1000000.0 / Frequency.QuadPart / Index, Stats.SplitSweeps,
+           Stats.Retries, Stats.Tears, Stats.IoFallbacks );
+
+   DUAL_SetMode( DUAL_MODE_SINGLE );
+
+   return Results;
+}
@@ -0,0 +1,212 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : PERF_Exporter.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Starts the sampler and the OpenMetrics exporter, then scrapes it from
+//      many threads at once and reports the scrape latency percentiles
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <winsock2.h>
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Exporter.h>
+
+#define SCRAPER_COUNT         64
+#define RUN_MS                5000
+#define BUCKET_US             10                                  // latency histogram resolution
+#define BUCKET_COUNT          10000                               // the last bucket holds everything slower
+
+static const char       Request[] = "GET /metrics HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                                    "Accept: application/openmetrics-text; version=1.0.0\r\n\r\n";
+
+static volatile LONG    Running = 1;
+static uint32_t         Latency[ SCRAPER_COUNT ][ BUCKET_COUNT ];
+static uint32_t         Failures[ SCRAPER_COUNT ];
+static uint32_t         MaxUs[ SCRAPER_COUNT ];
+static LARGE_INTEGER    Frequency;
+
+static BOOL Scrape( char *pReply, int Size )
+{
+   SOCKADDR_IN   Address;
+   SOCKET        Socket;
+   int           Got = 0,
+                 Read;
+
+   memset( &Address, 0, sizeof( Address ) );
+   Address.sin_family = AF_INET;
+   Address.sin_port = htons( OMX_DEFAULT_PORT );
+   Address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+   if ( ( Socket = socket( AF_INET, SOCK_STREAM, IPPROTO_TCP ) ) == INVALID_SOCKET )
+   {
+      return FALSE;
+   }
+
+   if ( ( connect( Socket, ( SOCKADDR * ) &Address, sizeof( Address ) ) == 0 ) &&
+        ( send( Socket, Request, sizeof( Request ) - 1, 0 ) == sizeof( Request ) - 1 ) )
+   {
+      while ( ( Got < Size - 1 ) && ( ( Read = recv( Socket, &pReply[ Got ], Size - 1 - Got, 0 ) ) > 0 ) )
+      {
+         Got += Read;
+      }
+   }
+
+   closesocket( Socket );
+   pReply[ Got ] = '\0';
+
+   return ( strncmp( pReply, "HTTP/1.1 200 ", 13 ) == 0 ) && ( Got > 6 ) && ( strcmp( &pReply[ Got - 6 ], "# EOF\n" ) == 0 );
+}
+
+static DWORD WINAPI Scraper( LPVOID pParam )
+{
+   uint32_t        Id = ( uint32_t )( uintptr_t ) pParam;
+   LARGE_INTEGER   Start,
+                   Stop;
+   uint64_t        Us;
+   static char     Replies[ SCRAPER_COUNT ][ OMX_BODY_SIZE + 512 ];
+
+   while ( Running )
+   {
+      QueryPerformanceCounter( &Start );
+
+      if ( ! Scrape( Replies[ Id ], sizeof( Replies[ Id ] ) ) )
+      {
+         Failures[ Id ]++;
+         continue;
+      }
+
+      QueryPerformanceCounter( &Stop );
+
+      Us = ( uint64_t )( Stop.QuadPart - Start.QuadPart ) * 1000000 / Frequency.QuadPart;
+
+      Latency[ Id ][ ( Us / BUCKET_US < BUCKET_COUNT ) ? Us / BUCKET_US : BUCKET_COUNT - 1 ]++;
+      MaxUs[ Id ] = ( ( uint32_t ) Us > MaxUs[ Id ] ) ? ( uint32_t ) Us : MaxUs[ Id ];
+   }
+
+   return 0;
+}
+
+static uint32_t Percentile( uint64_t Total, uint32_t Percent )
+{
+   uint64_t   Want = ( Total * Percent + 99 ) / 100,
+              Seen = 0;
+   uint32_t   Bucket,
+              Id;
+
+   for ( Bucket = 0; Bucket < BUCKET_COUNT; Bucket++ )
+   {
+      for ( Id = 0; Id < SCRAPER_COUNT; Id++ )
+      {
+         Seen += Latency[ Id ][ Bucket ];
+      }
+
+      if ( Seen >= Want )
+      {
+         break;
+      }
+   }
+
+   return ( Bucket + 1 ) * BUCKET_US;
+}
+
+WINSYS_ERROR main()
+{
+   HANDLE             Threads[ SCRAPER_COUNT ];
+   OMX_STATS_STRUCT   Stats;
+   WSADATA            WsaData;
+   WINSYS_ERROR       Results;
+   uint64_t           Total = 0;
+   uint32_t           Errors = 0,
+                      Max = 0,
+                      Id,
+                      Bucket;
+
+   QueryPerformanceFrequency( &Frequency );
+
+   if ( WSAStartup( MAKEWORD( 2, 2 ), &WsaData ) != 0 )
+   {
+      printf( "WSAStartup failed\n" );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NO_RESOURCES );
+   }
+
+   if ( ( ( Results = SMP_Start( SMP_DEFAULT_INTERVAL_MS, EC_SENSOR_MASK_ALL ) ) != STATUS_SUCCESS ) ||
+        ( ( Results = OMX_Start( OMX_DEFAULT_PORT, OMX_DEFAULT_REFRESH_MS ) ) != STATUS_SUCCESS ) )
+   {
+      printf( "starting the sampler and exporter failed, 0x%08X\n", Results );
+      SMP_Stop();
+      WSACleanup();
+      return Results;
+   }
+
+   for ( Id = 0; Id < SCRAPER_COUNT; Id++ )
+   {
+      Threads[ Id ] = CreateThread( NULL, 0, Scraper, ( LPVOID )( uintptr_t ) Id, 0, NULL );
+   }
+
+   Sleep( RUN_MS );
+   InterlockedExchange( &Running, 0 );
+   WaitForMultipleObjects( SCRAPER_COUNT, Threads, TRUE, INFINITE );
+
+   for ( Id = 0; Id < SCRAPER_COUNT; Id++ )
+   {
+      CloseHandle( Threads[ Id ] );
+
+      for ( Bucket = 0; Bucket < BUCKET_COUNT; Bucket++ )
+      {
+         Total += Latency[ Id ][ Bucket ];
+      }
+
+      Errors += Failures[ Id ];
+      Max = ( MaxUs[ Id ] > Max ) ? MaxUs[ Id ] : Max;
+   }
+
+   OMX_GetStats( &Stats );
+   OMX_Stop();
+   SMP_Stop();
+   WSACleanup();
+
+   if ( Total == 0 )
+   {
+      printf( "no scrape succeeded, %u failed\n", Errors );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_NOT_RUNNING );
+   }
+
+   printf( "%u scrapers: %.0f scrapes/s, %u failed\n", SCRAPER_COUNT, ( double ) Total * 1000.0 / RUN_MS, Errors );
+   printf( "   latency p50 <= %u us, p99 <= %u us, max %u us\n", Percentile( Total, 50 ), Percentile( Total, 99 ), Max );
+   printf( "   render %.1f us average, %u us max, %u bytes\n", ( double ) Stats.RenderUs / Stats.Scrapes, Stats.MaxRenderUs,
+           Stats.LastBytes );
+
+   return STATUS_SUCCESS;
+}
@@ -0,0 +1,288 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : PERF_Replay.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      "PERF_Replay record <trace>" reads the sensor registers on the board
+//      through the DLL with EC_StartRecording() capturing the port traffic.
+//      "PERF_Replay replay <trace>" runs the same reads against the trace
+//      with each spinning wait policy and reports the read latencies, so a
+//      protocol or scheduling change can be measured against the board's EC
+//      without the board. "PERF_Replay simulate <trace>" records the reads
+//      against SimulatedPorts instead and replays them, checking the data,
+//      so the round trip also runs on Linux - see the Makefile.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//    10/19/26      0.2       simulate, and builds on Linux without the DLL
+//
+///****************************************************************************
+
+#if defined( _WIN32 )
+#include "stdafx.h"
+#include <windows.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Driver.h>
+
+#define PASS_COUNT            1000
+
+typedef struct _SPAN_STRUCT {
+                               uint8_t     Offset;
+                               uint8_t     Count;
+
+                            } SPAN_STRUCT;
+
+//
+// the blocks the sampler reads - temperatures, WDT, fan and voltages
+//
+
+static const SPAN_STRUCT   Spans[] = { { CPU_TEMPERATURE_OFFSET, 4 }, { WDT_CONFIG_OFFSET, 3 }, { CPU_FAN_H_OFFSET, 2 },
+                                       { VCORE_L_OFFSET, 6 }, { V12_L_OFFSET, 4 } };
+
+#define SPAN_COUNT            ( sizeof( Spans ) / sizeof( Spans[ 0 ] ) )
+
+static uint32_t            LatencyNs[ PASS_COUNT * SPAN_COUNT ];
+
+//
+// the same reads in the same order whether recording or replaying, timing each one
+//
+
+template< typename ReadBlock >
+static uint32_t Workload( ReadBlock &&Read )
+{
+   std::chrono::steady_clock::time_point   Start;
+   uint8_t                                 Data[ 8 ];
+   uint32_t                                Failures = 0,
+                                           Pass,
+                                           Span;
+
+   for ( Pass = 0; Pass < PASS_COUNT; Pass++ )
+   {
+      for ( Span = 0; Span < SPAN_COUNT; Span++ )
+      {
+         Start = std::chrono::steady_clock::now();
+
+         if ( Read( Spans[ Span ].Offset, Spans[ Span ].Count, Data ) != STATUS_SUCCESS )
+         {
+            Failures++;
+         }
+
+         LatencyNs[ Pass * SPAN_COUNT + Span ] = ( uint32_t ) std::chrono::duration_cast< std::chrono::nanoseconds >(
+                                                    std::chrono::steady_clock::now() - Start ).count();
+      }
+   }
+
+   return Failures;
+}
+
+static void Report( const char *pName, uint32_t Failures )
+{
+   uint64_t   Total = 0;
+   uint32_t   Index;
+
+   for ( Index = 0; Index < PASS_COUNT * SPAN_COUNT; Index++ )
+   {
+      Total += LatencyNs[ Index ];
+   }
+
+   std::sort( LatencyNs, LatencyNs + PASS_COUNT * SPAN_COUNT );
+
+   printf( "%-14s %u reads, %u failed: mean %.1f us, p50 %.1f us, p99 %.1f us, max %.1f us\n", pName,
+           ( uint32_t )( PASS_COUNT * SPAN_COUNT ), Failures, ( double ) Total / ( PASS_COUNT * SPAN_COUNT ) / 1000.0,
+           LatencyNs[ PASS_COUNT * SPAN_COUNT / 2 ] / 1000.0, LatencyNs[ PASS_COUNT * SPAN_COUNT * 99 / 100 ] / 1000.0,
+           LatencyNs[ PASS_COUNT * SPAN_COUNT - 1 ] / 1000.0 );
+}
+
+#if defined( _WIN32 )
+
+static WINSYS_ERROR Record( const char *pPath )
+{
+   WINSYS_ERROR   Results;
+   uint64_t       Records = 0;
+   uint32_t       Failures;
+
+   if ( ( Results = EC_StartRecording( pPath ) ) != STATUS_SUCCESS )
+   {
+      printf( "EC_StartRecording failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   Failures = Workload( []( uint8_t Offset, uint8_t Count, puint8_t pData ) { return EC_ReadBlockUsingACPI( Offset, Count, pData ); } );
+
+   if ( ( Results = EC_StopRecording( &Records ) ) != STATUS_SUCCESS )
+   {
+      printf( "EC_StopRecording failed, 0x%08X\n", Results );
+      return Results;
+   }
+
+   Report( "board", Failures );
+   printf( "%llu port operations recorded to %s\n", Records, pPath );
+
+   return STATUS_SUCCESS;
+}
+
+#endif
+
+//
+// pExpected, when given, is the SRAM the trace was recorded from, and a replayed read that returns anything else
+// fails
+//
+
+template< typename Wait >
+static WINSYS_ERROR Replay( const char *pName, const char *pPath, const uint8_t *pExpected = NULL )
+{
+   ite8528::EcDriver< ite8528::ReplayPorts, Wait, ite8528::NoLock >   Driver;
+   ite8528::ReplayPorts                                              &Ports = Driver.GetPorts();
+   EC_TRANSACTION_STATS_STRUCT                                       Stats;
+   uint32_t                                                          Failures;
+
+   if ( ! Ports.Open( pPath ) )
+   {
+      printf( "%s is not a trace\n", pPath );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+   }
+
+   Failures = Workload( [ & ]( uint8_t Offset, uint8_t Count, puint8_t pData )
+                        {
+                           WINSYS_ERROR   Results = Driver.ReadBlock( Offset, Count, pData );
+
+                           if ( ( Results == STATUS_SUCCESS ) && ( pExpected ) && ( memcmp( pData, pExpected + Offset, Count ) ) )
+                           {
+                              Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+                           }
+
+                           return Results;
+                        } );
+
+   Driver.GetStats( &Stats );
+   Report( pName, Failures );
+   printf( "   %u operations out of turn, %u reads unanswered, %s, %u IBF %u OBF %u burst timeouts\n",
+           Ports.Mismatches, Ports.Unanswered, Ports.Finished() ? "trace finished" : "trace not finished",
+           Stats.IbfTimeouts, Stats.ObfTimeouts, Stats.BurstTimeouts );
+
+   return ( ( Ports.Mismatches == 0 ) && ( ( pExpected == NULL ) || ( Failures == 0 ) ) ) ? STATUS_SUCCESS :
+          WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+}
+
+//
+// records the reads against SimulatedPorts, with IBF held for a few status reads after each write so the trace
+// has handshake waits in it, then replays the trace with each spinning wait policy
+//
+
+static WINSYS_ERROR Simulate( const char *pPath )
+{
+   ite8528::EcDriver< ite8528::RecordingPorts< ite8528::SimulatedPorts >, ite8528::SpinWait, ite8528::NoLock >   Driver;
+   ite8528::RecordingPorts< ite8528::SimulatedPorts >   &Ports = Driver.GetPorts();
+   ite8528::SimulatedPorts                              &Ec = Ports.GetInner();
+   WINSYS_ERROR                                         Results;
+   uint64_t                                             Records = 0;
+   uint32_t                                             Failures,
+                                                        Index;
+
+   for ( Index = 0; Index < sizeof( Ec.Sram ); Index++ )
+   {
+      Ec.Sram[ Index ] = ( uint8_t )( Index * 7 + 3 );
+   }
+
+   Ec.Latency = 2;
+
+   if ( ! Ports.Open( pPath ) )
+   {
+      printf( "cannot create %s\n", pPath );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+   }
+
+   Failures = Workload( [ & ]( uint8_t Offset, uint8_t Count, puint8_t pData ) { return Driver.ReadBlock( Offset, Count, pData ); } );
+
+   if ( ! Ports.Close( &Records ) )
+   {
+      printf( "%s was not written\n", pPath );
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_FILE_ERROR );
+   }
+
+   Report( "simulated", Failures );
+   printf( "%llu port operations recorded to %s\n", ( unsigned long long ) Records, pPath );
+
+   if ( Failures )
+   {
+      return WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT );
+   }
+
+   if ( ( Results = Replay< ite8528::SpinWait >( "SpinWait", pPath, Ec.Sram ) ) == STATUS_SUCCESS )
+   {
+      Results = Replay< ite8528::SpinYieldWait >( "SpinYieldWait", pPath, Ec.Sram );
+   }
+
+   return Results;
+}
+
+//
+// an exit status is 8 bits, too few for a WINSYS_ERROR
+//
+
+#if defined( _WIN32 )
+WINSYS_ERROR main( int argc, char *argv[] )
+#else
+int main( int argc, char *argv[] )
+#endif
+{
+   WINSYS_ERROR   Results;
+
+   if ( ( argc == 3 ) && ( strcmp( argv[ 1 ], "replay" ) == 0 ) )
+       {
+          if ( ( Results = Replay< ite8528::SpinWait >( "SpinWait", argv[ 2 ] ) ) == STATUS_SUCCESS )
+          {
+             Results = Replay< ite8528::SpinYieldWait >( "SpinYieldWait", argv[ 2 ] );
+          }
+       }
+   else if ( ( argc == 3 ) && ( strcmp( argv[ 1 ], "simulate" ) == 0 ) )
+       {
+          Results = Simulate( argv[ 2 ] );
+       }
+#if defined( _WIN32 )
+   else if ( ( argc == 3 ) && ( strcmp( argv[ 1 ], "record" ) == 0 ) )
+       {
+          Results = Record( argv[ 2 ] );
+       }
+#endif
+   else
+       {
+          printf( "usage: PERF_Replay record|replay|simulate <trace file>\n" );
+          Results = WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_PARAMETER );
+       }
+
+#if defined( _WIN32 )
+   return Results;
+#else
+   return ( Results == STATUS_SUCCESS ) ? 0 : 1;
+#endif
+}
@@ -0,0 +1,316 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : QNT_Sketch.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Counts a known mix of readings in a quantile sketch and checks that
+//      each quantile is within QNT_RELATIVE_ACCURACY of the exact one. It
+//      also checks that sketches of three slices of the readings merge into
+//      the sketch of them all, that a sketch survives QNT_Serialize() and
+//      QNT_Deserialize() unchanged, and that truncated or damaged packed
+//      sketches are rejected. Needs no EC hardware.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Quantiles.h>
+#include <string.h>
+
+#define TEST_READINGS         200000
+#define TEST_SLICES           3
+
+//
+// the packed header, as QNT_Serialize() writes it: magic, zero count, count, min, max, first bin, end bin
+//
+
+#define WIRE_MAGIC_AT         0
+#define WIRE_COUNT_AT         8
+#define WIRE_FIRST_AT         20
+#define WIRE_END_AT           22
+#define WIRE_HEADER_BYTES     24
+
+#define TEST_FAILED           WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT )
+
+static const double         Quantiles[] = { 0.0, 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0 };
+
+static uint32_t             Histogram[ 65536 ];
+static QNT_SKETCH_STRUCT    All,
+                            Slices[ TEST_SLICES ],
+                            Merged,
+                            Unpacked;
+static uint8_t              Packed[ QNT_MAX_SERIALIZED ],
+                            Damaged[ QNT_MAX_SERIALIZED + 1 ];
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: Exact                                                           */
+/*                                                                            */
+/*!\brief  Returns the reading of a quantile's rank, ranked as QNT_Quantile() */
+/*!\brief  ranks them                                                        */
+/*                                                                            */
+/*!\param   double              quantile, 0 to 1                              */
+/*!\return  uint32_t            the reading                                   */
+/*                                                                            */
+/******************************************************************************/
+static uint32_t Exact( double Quantile )
+{
+   uint64_t   Rank = ( uint64_t )( Quantile * ( double )( TEST_READINGS - 1 ) ),
+              Seen = 0;
+   uint32_t   Raw;
+
+   for ( Raw = 0; Raw < 65535; Raw++ )
+   {
+      Seen += Histogram[ Raw ];
+
+      if ( Rank < Seen )
+      {
+         break;
+      }
+   }
+
+   return Raw;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: Rejected                                                        */
+/*                                                                            */
+/*!\brief  Checks QNT_Deserialize() turns down a damaged packed sketch       */
+/*                                                                            */
+/*!\param   const char *        what was damaged, for the report              */
+/*!\param   uint32_t            bytes of Damaged to unpack                    */
+/*!\return  WINSYS_ERROR        value indicating success or failure           */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR Rejected( const char *pWhat, uint32_t Bytes )
+{
+   WINSYS_ERROR   Results = QNT_Deserialize( Damaged, Bytes, &Unpacked );
+
+   if ( ( Results & 0xFFFF ) != STATUS_BAD_FORMAT )
+   {
+      printf( "%s: 0x%08X, should be rejected\n", pWhat, Results );
+      return TEST_FAILED;
+   }
+
+   return STATUS_SUCCESS;
+}
+
+WINSYS_ERROR main()
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   uint32_t       Index,
+                  Slice,
+                  Raw,
+                  Bytes,
+                  Random = 7;
+   uint16_t       Bin;
+   double         Estimate,
+                  Error,
+                  Worst = 0.0;
+
+   QNT_Init( &All );
+   QNT_Init( &Merged );
+
+   for ( Slice = 0; Slice < TEST_SLICES; Slice++ )
+   {
+      QNT_Init( &Slices[ Slice ] );
+   }
+
+   //
+   // a rail sitting near 620 with a little noise, a temperature spread over 30 to 90, rare readings across
+   // the whole range and a few zeros - cut into three slices of unequal size
+   //
+
+   for ( Index = 0; Index < TEST_READINGS; Index++ )
+   {
+      Random = Random * 1103515245 + 12345;
+
+      switch ( Index % 10 )
+      {
+         case 0:
+         case 1:
+         case 2:
+         case 3:
+         case 4:  Raw = 618 + ( Random >> 16 ) % 5;                            break;
+         case 5:
+         case 6:
+         case 7:
+         case 8:  Raw = 30 + ( Random >> 16 ) % 61;                            break;
+         default: Raw = ( Index % 1000 == 9 ) ? 0 : 1 + ( Random >> 8 ) % 65535;  break;
+      }
+
+      Histogram[ Raw ]++;
+      QNT_Add( &All, ( uint16_t ) Raw );
+      QNT_Add( &Slices[ ( Index % 7 ) % TEST_SLICES ], ( uint16_t ) Raw );
+   }
+
+   for ( Index = 0; Index < sizeof( Quantiles ) / sizeof( Quantiles[ 0 ] ); Index++ )
+   {
+      QNT_Quantile( &All, Quantiles[ Index ], &Estimate );
+
+      Raw = Exact( Quantiles[ Index ] );
+      Error = ( Raw ) ? ( ( Estimate > Raw ) ? Estimate - Raw : Raw - Estimate ) / Raw : Estimate;
+      Worst = ( Error > Worst ) ? Error : Worst;
+
+      printf( "q%-6.3f  exact %5u  sketch %9.2f  error %.3f%%\n", Quantiles[ Index ], Raw, Estimate, 100.0 * Error );
+
+      if ( Error > QNT_RELATIVE_ACCURACY )
+      {
+         Results = TEST_FAILED;
+      }
+   }
+
+   printf( "worst error %.3f%%, %s %.0f%%\n", 100.0 * Worst, ( Worst <= QNT_RELATIVE_ACCURACY ) ? "within" : "OUTSIDE", 100.0 * QNT_RELATIVE_ACCURACY );
+
+   //
+   // bins are never collapsed, so merging is exact
+   //
+
+   for ( Slice = 0; Slice < TEST_SLICES; Slice++ )
+   {
+      QNT_Merge( &Merged, &Slices[ Slice ] );
+   }
+
+   if ( memcmp( &Merged, &All, sizeof( All ) ) )
+   {
+      printf( "the merged slices differ from the sketch of all the readings\n" );
+      Results = TEST_FAILED;
+   }
+
+   //
+   // a packed sketch comes back as it was, and does not fit one byte short
+   //
+
+   if ( ( QNT_Serialize( &All, Packed, sizeof( Packed ), &Bytes ) != STATUS_SUCCESS ) ||
+        ( QNT_Deserialize( Packed, Bytes, &Unpacked ) != STATUS_SUCCESS ) || ( memcmp( &Unpacked, &All, sizeof( All ) ) ) )
+   {
+      printf( "the sketch did not survive packing\n" );
+      Results = TEST_FAILED;
+   }
+
+   printf( "%u readings packed in %u bytes\n", TEST_READINGS, Bytes );
+
+   if ( ( QNT_Serialize( &All, Damaged, Bytes - 1, &Index ) & 0xFFFF ) != STATUS_BUFFER_TOO_SMALL )
+   {
+      printf( "packing into %u bytes should fail\n", Bytes - 1 );
+      Results = TEST_FAILED;
+   }
+
+   //
+   // damaged copies are rejected
+   //
+
+   memcpy( Damaged, Packed, Bytes );
+
+   for ( Index = 0; Index < Bytes; Index++ )
+   {
+      if ( Rejected( "truncated", Index ) != STATUS_SUCCESS )
+      {
+         printf( "   at %u of %u bytes\n", Index, Bytes );
+         Results = TEST_FAILED;
+         break;
+      }
+   }
+
+   Damaged[ Bytes ] = 0;
+
+   if ( Rejected( "a byte past the end", Bytes + 1 ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   Damaged[ WIRE_MAGIC_AT ] ^= 0x01;
+
+   if ( Rejected( "bad magic", Bytes ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   memcpy( Damaged, Packed, Bytes );
+   Damaged[ WIRE_COUNT_AT ] ^= 0x01;
+
+   if ( Rejected( "count not matching the bins", Bytes ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   memcpy( Damaged, Packed, Bytes );
+   Bin = QNT_BIN_COUNT + 1;
+   memcpy( &Damaged[ WIRE_END_AT ], &Bin, sizeof( Bin ) );
+
+   if ( Rejected( "bins past the last", Bytes ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   memcpy( Damaged, Packed, Bytes );
+   memcpy( &Bin, &Damaged[ WIRE_END_AT ], sizeof( Bin ) );
+   memcpy( &Damaged[ WIRE_FIRST_AT ], &Bin, sizeof( Bin ) );
+   Bin--;
+   memcpy( &Damaged[ WIRE_END_AT ], &Bin, sizeof( Bin ) );
+
+   if ( Rejected( "first bin after the end", Bytes ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   //
+   // one reading in bin 0, its count packed overlong as 0x81 0x00
+   //
+
+   memset( Damaged, 0, WIRE_HEADER_BYTES );
+   Index = QNT_MAGIC;
+   memcpy( &Damaged[ WIRE_MAGIC_AT ], &Index, sizeof( Index ) );
+   Damaged[ WIRE_COUNT_AT ] = 1;
+   Damaged[ WIRE_END_AT ] = 1;
+   Damaged[ WIRE_HEADER_BYTES ] = 0x81;
+   Damaged[ WIRE_HEADER_BYTES + 1 ] = 0x00;
+
+   if ( Rejected( "overlong count", WIRE_HEADER_BYTES + 2 ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   Damaged[ WIRE_HEADER_BYTES ] = 0x01;
+
+   if ( QNT_Deserialize( Damaged, WIRE_HEADER_BYTES + 1, &Unpacked ) != STATUS_SUCCESS )
+   {
+      printf( "the same count packed shortest should be accepted\n" );
+      Results = TEST_FAILED;
+   }
+
+   printf( "%s\n", ( Results == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   return Results;
+}
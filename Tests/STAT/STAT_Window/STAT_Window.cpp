@@ -0,0 +1,155 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : STAT_Window.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Feeds STAT_Update() a rising ramp, a falling ramp and then noise, and
+//      after every sample checks the windowed min/max against the last
+//      WindowSamples readings. The ramps keep every reading of the window in
+//      the min (or max) queue, so at STAT_MAX_WINDOW they fill it. Needs no
+//      EC hardware.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Sampler.h>
+#include <ITE8528_EC_Stats.h>
+#include <string.h>
+
+#define RAMP_SAMPLES          ( 3 * STAT_MAX_WINDOW )
+#define NOISE_SAMPLES         4000
+#define TEST_SAMPLES          ( 2 * RAMP_SAMPLES + NOISE_SAMPLES )
+
+#define TEST_FAILED           WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT )
+
+//
+// a window per sensor - the longest allowed, the default, one just short of a power of 2, and a single reading
+//
+
+static const uint32_t   Sensors[] = { SENSOR_V12, SENSOR_V5, SENSOR_V3P3, SENSOR_VCORE };
+static const uint32_t   Windows[] = { STAT_MAX_WINDOW, STAT_DEFAULT_WINDOW, 127, 1 };
+
+static uint16_t         Readings[ TEST_SAMPLES ];
+
+WINSYS_ERROR main()
+{
+   STAT_CONFIG_STRUCT   Config;
+   STAT_SENSOR_STRUCT   Stats;
+   EC_SAMPLE_STRUCT     Sample;
+   WINSYS_ERROR         Results = STATUS_SUCCESS;
+   uint32_t             Index,
+                        Test,
+                        Back,
+                        Random = 1;
+   uint16_t             Min,
+                        Max;
+
+   memset( &Config, 0, sizeof( Config ) );
+   Config.Enabled = 1;
+   Config.WarmupSamples = STAT_DEFAULT_WARMUP;
+   Config.EwmaAlpha = STAT_DEFAULT_EWMA_ALPHA;
+   Config.SigmaLimit = STAT_DEFAULT_SIGMA_LIMIT;
+   Config.SpikeLimit = STAT_DEFAULT_SPIKE_LIMIT;
+   Config.MinSigma = STAT_DEFAULT_MIN_SIGMA;
+   Config.WindowSamples = STAT_MAX_WINDOW + 1;
+
+   if ( STAT_Configure( SENSOR_V12, &Config ) == STATUS_SUCCESS )
+   {
+      printf( "a window of %u samples was accepted\n", Config.WindowSamples );
+      Results = TEST_FAILED;
+   }
+
+   for ( Test = 0; Test < sizeof( Sensors ) / sizeof( Sensors[ 0 ] ); Test++ )
+   {
+      Config.WindowSamples = Windows[ Test ];
+      STAT_Configure( Sensors[ Test ], &Config );
+   }
+
+   for ( Index = 0; Index < TEST_SAMPLES; Index++ )
+   {
+      if ( Index < RAMP_SAMPLES )
+      {
+         Readings[ Index ] = ( uint16_t )( 0x0100 + Index );
+      }
+      else if ( Index < 2 * RAMP_SAMPLES )
+      {
+         Readings[ Index ] = ( uint16_t )( 0x0100 + 2 * RAMP_SAMPLES - Index );
+      }
+      else
+      {
+         Random = Random * 1103515245 + 12345;
+         Readings[ Index ] = ( uint16_t )( 0x0200 + ( Random >> 16 ) % 64 );
+      }
+   }
+
+   memset( &Sample, 0, sizeof( Sample ) );
+   Sample.ValidMask = EC_SENSOR_MASK_ALL;
+
+   for ( Index = 0; ( Index < TEST_SAMPLES ) && ( Results == STATUS_SUCCESS ); Index++ )
+   {
+      Sample.TimestampMs = 1000ULL * Index;
+      Sample.Sequence = Index;
+
+      for ( Test = 0; Test < sizeof( Sensors ) / sizeof( Sensors[ 0 ] ); Test++ )
+      {
+         Sample.Raw[ Sensors[ Test ] ] = Readings[ Index ];
+      }
+
+      STAT_Update( &Sample );
+
+      for ( Test = 0; Test < sizeof( Sensors ) / sizeof( Sensors[ 0 ] ); Test++ )
+      {
+         Min = Max = Readings[ Index ];
+
+         for ( Back = 1; ( Back < Windows[ Test ] ) && ( Back <= Index ); Back++ )
+         {
+            Min = ( Readings[ Index - Back ] < Min ) ? Readings[ Index - Back ] : Min;
+            Max = ( Readings[ Index - Back ] > Max ) ? Readings[ Index - Back ] : Max;
+         }
+
+         STAT_Get( Sensors[ Test ], &Stats );
+
+         if ( ( Stats.WindowMin != Min ) || ( Stats.WindowMax != Max ) )
+         {
+            printf( "sample %u, window %u: min/max 0x%04X/0x%04X, should be 0x%04X/0x%04X\n",
+                    Index, Windows[ Test ], Stats.WindowMin, Stats.WindowMax, Min, Max );
+            Results = TEST_FAILED;
+         }
+      }
+   }
+
+   printf( "%u samples, windows of %u, %u, %u and %u\n", Index, Windows[ 0 ], Windows[ 1 ], Windows[ 2 ], Windows[ 3 ] );
+   printf( "%s\n", ( Results == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   return Results;
+}
@@ -0,0 +1,263 @@
+//****************************************************************************
+//
+//    Copyright 2026 by WinSystems Inc.
+//
+//    Permission is hereby granted to the purchaser of WinSystems GPIO cards
+//    and CPU products incorporating a GPIO device, to distribute any binary
+//    file or files compiled using this source code directly or in any work
+//    derived by the user from this file. In no case may the source code,
+//    original or derived from this file, be distributed to any third party
+//    except by explicit permission of WinSystems. This file is distributed
+//    on an "As-is" basis and no warranty as to performance or fitness of pur-
+//    poses is expressed or implied. In no case shall WinSystems be liable for
+//    any direct or indirect loss or damage, real or consequential resulting
+//    from the usage of this source code. It is the user's sole responsibility
+//    to determine fitness for any considered purpose.
+//
+///****************************************************************************
+//
+//    Name       : WCB_Combine.cpp
+//
+//    Project    : ACPI Embedded Controller Library
+//
+//    Author     : agent
+//
+//    Description:
+//      Builds the write combining buffer against an EC simulated with
+//      ite8528::SimulatedPorts, in place of the library's EC_ functions, and
+//      checks the EC writes it makes: rewrites of a register combined into
+//      one, adjacent dirty registers written as one block in offset order,
+//      WDT_CONFIG_OFFSET written straight through, and anything buffered
+//      flushed before such a bypass write. Needs no EC hardware - it does not
+//      use the DLL.
+//
+///****************************************************************************
+//
+//      Date      Revision    Description
+//    --------    --------    ---------------------------------------------
+//    10/19/26      0.1       Original
+//
+///****************************************************************************
+
+#include "stdafx.h"
+#include <windows.h>
+#include <x86_64_port.h>
+#include <WinSys_Errors.h>
+#include <ITE8528_EC_Lib.h>
+#include <ITE8528_EC_Driver.h>
+#include <ITE8528_EC_WriteCombine.h>
+#include <string.h>
+
+#define MAX_WRITES            16
+
+#define TEST_FAILED           WINS_ERROR( WINDOWS_ERROR, WINDOWS_CUSTOMER_CODE, WINSYS_FACILITY_ACPI_EC_ACCESS, STATUS_BAD_FORMAT )
+
+/*!\struct _EC_WRITE_STRUCT
+ * \brief  A write the buffer made to the EC - Count 0 is a single byte write
+ */
+typedef struct _EC_WRITE_STRUCT {
+                                   uint8_t      Offset;
+                                   uint8_t      Count;
+
+                                } EC_WRITE_STRUCT, *P_EC_WRITE_STRUCT;
+
+static ite8528::EcDriver< ite8528::SimulatedPorts, ite8528::SpinWait, ite8528::NoLock >   Ec;
+
+static EC_WRITE_STRUCT   Writes[ MAX_WRITES ];
+static uint32_t          WriteCount = 0;
+
+//
+// the EC access the write combining buffer uses, over the simulated EC
+//
+
+WINSYS_ERROR EC_ReadByteUsingACPI( uint8_t Offset, puint8_t pValue )
+{
+   return Ec.ReadByte( Offset, pValue );
+}
+
+WINSYS_ERROR EC_WriteByteUsingACPI( uint8_t Offset, uint8_t Value )
+{
+   if ( WriteCount < MAX_WRITES )
+   {
+      Writes[ WriteCount ].Offset = Offset;
+      Writes[ WriteCount ].Count = 0;
+   }
+
+   WriteCount++;
+
+   return Ec.WriteByte( Offset, Value );
+}
+
+WINSYS_ERROR EC_WriteBlockUsingACPI( uint8_t Offset, uint8_t Count, puint8_t pData )
+{
+   if ( WriteCount < MAX_WRITES )
+   {
+      Writes[ WriteCount ].Offset = Offset;
+      Writes[ WriteCount ].Count = Count;
+   }
+
+   WriteCount++;
+
+   return Ec.WriteBlock( Offset, Count, pData );
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function: Expect                                                          */
+/*                                                                            */
+/*!\brief  Checks the EC writes made since the last check                    */
+/*                                                                            */
+/*!\param   const char *              what was done, for the report           */
+/*!\param   const EC_WRITE_STRUCT *   the writes expected, in order           */
+/*!\param   uint32_t                  number of writes                        */
+/*!\return  WINSYS_ERROR              value indicating success or failure     */
+/*                                                                            */
+/******************************************************************************/
+static WINSYS_ERROR Expect( const char *pWhat, const EC_WRITE_STRUCT *pExpected, uint32_t Count )
+{
+   WINSYS_ERROR   Results = STATUS_SUCCESS;
+   uint32_t       Index;
+
+   printf( "%s:", pWhat );
+
+   for ( Index = 0; ( Index < WriteCount ) && ( Index < MAX_WRITES ); Index++ )
+   {
+      if ( Writes[ Index ].Count )
+          {
+             printf( " block 0x%02X-0x%02X", Writes[ Index ].Offset, Writes[ Index ].Offset + Writes[ Index ].Count - 1 );
+          }
+      else
+          {
+             printf( " byte 0x%02X", Writes[ Index ].Offset );
+          }
+   }
+
+   if ( ( WriteCount != Count ) || ( ( Count ) && ( memcmp( Writes, pExpected, Count * sizeof( EC_WRITE_STRUCT ) ) ) ) )
+   {
+      printf( " - should be" );
+
+      for ( Index = 0; Index < Count; Index++ )
+      {
+         printf( ( pExpected[ Index ].Count ) ? " block 0x%02X x%u" : " byte 0x%02X", pExpected[ Index ].Offset, pExpected[ Index ].Count );
+      }
+
+      Results = TEST_FAILED;
+   }
+
+   printf( "\n" );
+   WriteCount = 0;
+
+   return Results;
+}
+
+WINSYS_ERROR main()
+{
+   static const EC_WRITE_STRUCT   Runs[] = { { WDT_MINUTES_COUNTER_OFFSET, 2 }, { SMART_FAN_CFG_OFFSET, 3 }, { V12_L_OFFSET, 1 } };
+   static const EC_WRITE_STRUCT   BeforeBypass[] = { { SMART_FAN_TARGET_REG1_OFFSET, 1 }, { V12_L_OFFSET, 1 }, { WDT_CONFIG_OFFSET, 0 } };
+   static const EC_WRITE_STRUCT   Bypass[] = { { WDT_CONFIG_OFFSET, 0 } };
+   static const EC_WRITE_STRUCT   Through[] = { { V12_L_OFFSET, 0 } };
+   ite8528::SimulatedPorts        &Sim = Ec.GetPorts();
+   WCB_STATS_STRUCT               Stats;
+   WINSYS_ERROR                   Results = STATUS_SUCCESS;
+   uint32_t                       Index;
+   uint8_t                        Value;
+
+   //
+   // the longest window, so nothing is flushed behind the test's back
+   //
+
+   WCB_Configure( WCB_MAX_WINDOW_MS );
+
+   //
+   // five rounds of tuning the smart fan and reloading the WDT counters, one stray register, in no particular
+   // order - three runs of adjacent registers, written in offset order with the last values
+   //
+
+   for ( Index = 0; Index < 5; Index++ )
+   {
+      WCB_Write( SMART_FAN_TARGET_REG2_OFFSET, ( uint8_t )( 20 + Index ) );
+      WCB_Write( WDT_SECONDS_COUNTER_OFFSET, ( uint8_t )( 30 + Index ) );
+      WCB_Write( SMART_FAN_CFG_OFFSET, ( uint8_t )( 0x80 | Index ) );
+      WCB_Write( SMART_FAN_TARGET_REG1_OFFSET, ( uint8_t )( 10 + Index ) );
+      WCB_Write( WDT_MINUTES_COUNTER_OFFSET, ( uint8_t )( 1 + Index ) );
+   }
+
+   WCB_Write( V12_L_OFFSET, 0x5A );
+
+   if ( ( WCB_Read( SMART_FAN_TARGET_REG1_OFFSET, &Value ) != STATUS_SUCCESS ) || ( Value != 14 ) ||
+        ( Sim.Sram[ SMART_FAN_TARGET_REG1_OFFSET ] != 0 ) || ( WriteCount != 0 ) )
+   {
+      printf( "before the flush, WCB_Read should return the buffered value and the EC be untouched\n" );
+      Results = TEST_FAILED;
+   }
+
+   WCB_Flush();
+
+   if ( Expect( "combined", Runs, sizeof( Runs ) / sizeof( Runs[ 0 ] ) ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   if ( ( Sim.Sram[ WDT_MINUTES_COUNTER_OFFSET ] != 5 ) || ( Sim.Sram[ WDT_SECONDS_COUNTER_OFFSET ] != 34 ) ||
+        ( Sim.Sram[ SMART_FAN_CFG_OFFSET ] != 0x84 ) || ( Sim.Sram[ SMART_FAN_TARGET_REG1_OFFSET ] != 14 ) ||
+        ( Sim.Sram[ SMART_FAN_TARGET_REG2_OFFSET ] != 24 ) || ( Sim.Sram[ V12_L_OFFSET ] != 0x5A ) )
+   {
+      printf( "the EC does not hold the last values written\n" );
+      Results = TEST_FAILED;
+   }
+
+   WCB_GetStats( &Stats );
+
+   if ( ( Stats.Writes != 26 ) || ( Stats.Combined != 20 ) || ( Stats.Blocks != 3 ) || ( Stats.Bytes != 6 ) || ( Stats.Dirty != 0 ) )
+   {
+      printf( "writes %llu combined %llu blocks %llu bytes %llu dirty %u\n", ( unsigned long long ) Stats.Writes,
+              ( unsigned long long ) Stats.Combined, ( unsigned long long ) Stats.Blocks, ( unsigned long long ) Stats.Bytes, Stats.Dirty );
+      Results = TEST_FAILED;
+   }
+
+   //
+   // enabling the WDT flushes the writes made before it, then goes straight to the EC
+   //
+
+   WCB_Write( V12_L_OFFSET, 0x5B );
+   WCB_Write( SMART_FAN_TARGET_REG1_OFFSET, 15 );
+   WCB_Write( WDT_CONFIG_OFFSET, 0x81 );
+
+   if ( ( Expect( "bypass with writes buffered", BeforeBypass, sizeof( BeforeBypass ) / sizeof( BeforeBypass[ 0 ] ) ) != STATUS_SUCCESS ) ||
+        ( Sim.Sram[ WDT_CONFIG_OFFSET ] != 0x81 ) || ( Sim.Sram[ V12_L_OFFSET ] != 0x5B ) )
+   {
+      Results = TEST_FAILED;
+   }
+
+   WCB_Write( WDT_CONFIG_OFFSET, 0x00 );
+
+   if ( Expect( "bypass with nothing buffered", Bypass, sizeof( Bypass ) / sizeof( Bypass[ 0 ] ) ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   //
+   // a register made a bypass register, and then combining turned off, are written through
+   //
+
+   WCB_SetBypass( V12_L_OFFSET, 1 );
+   WCB_Write( V12_L_OFFSET, 0x5C );
+
+   if ( Expect( "added bypass", Through, sizeof( Through ) / sizeof( Through[ 0 ] ) ) != STATUS_SUCCESS )
+   {
+      Results = TEST_FAILED;
+   }
+
+   WCB_SetBypass( V12_L_OFFSET, 0 );
+   WCB_Configure( 0 );
+   WCB_Write( V12_L_OFFSET, 0x5D );
+
+   if ( ( Expect( "combining off", Through, sizeof( Through ) / sizeof( Through[ 0 ] ) ) != STATUS_SUCCESS ) || ( Sim.Sram[ V12_L_OFFSET ] != 0x5D ) )
+   {
+      Results = TEST_FAILED;
+   }
+
+   printf( "%s\n", ( Results == STATUS_SUCCESS ) ? "passed" : "FAILED" );
+
+   return Results;
+}